@@ -14,13 +14,24 @@ echo "Building Zombie Shooter for Web..."
 emcc \
     zombie/main.cpp \
     zombie/game.cpp \
+    zombie/render.cpp \
+    zombie/simulation.cpp \
+    zombie/allocation.cpp \
     zombie/player.cpp \
     zombie/zombie.cpp \
     zombie/bullet.cpp \
     zombie/maze.cpp \
+    zombie/distance_field.cpp \
     zombie/key.cpp \
     zombie/weapon.cpp \
     zombie/healthboost.cpp \
+    zombie/collision.cpp \
+    zombie/flame.cpp \
+    zombie/pathfinding.cpp \
+    zombie/profiler.cpp \
+    zombie/replay.cpp \
+    zombie/trace.cpp \
+    zombie/world_stream.cpp \
     -o zombie_shooter.html \
     -s USE_SDL=2 \
     -s USE_SDL_MIXER=2 \
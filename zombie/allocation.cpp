@@ -0,0 +1,127 @@
+#include "allocation.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+const char* allocationTagName(AllocationTag tag) {
+    switch (tag) {
+        case AllocationTag::OTHER: return "OTHER";
+        case AllocationTag::MAZE: return "MAZE";
+        case AllocationTag::ZOMBIES: return "ZOMBIES";
+        case AllocationTag::BULLETS: return "BULLETS";
+        case AllocationTag::ITEMS: return "ITEMS";
+        case AllocationTag::RENDER: return "RENDER";
+        case AllocationTag::COUNT: break;
+    }
+    return "UNKNOWN";
+}
+
+#ifdef ZOMBIE_TRACK_ALLOCATIONS
+
+namespace {
+    // Constant-initialised, so they work for allocations made before main
+    std::atomic<std::uint64_t> allocationCount{0};
+    std::atomic<std::uint64_t> freeCount{0};
+    std::atomic<std::int64_t> liveBytes{0};
+    std::atomic<std::int64_t> peakBytes{0};
+    std::array<std::atomic<std::int64_t>, ALLOCATION_TAG_COUNT> tagBytes{};
+    std::array<std::atomic<std::int64_t>, ALLOCATION_TAG_COUNT> tagBlocks{};
+
+    thread_local AllocationTag currentTag = AllocationTag::OTHER;
+
+    // Sits in front of every block; keeps the block at the default new alignment
+    struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) BlockHeader {
+        std::size_t size;
+        AllocationTag tag;
+    };
+
+    void* allocate(std::size_t size) {
+        auto* header = static_cast<BlockHeader*>(std::malloc(sizeof(BlockHeader) + size));
+        if (!header) return nullptr;
+        header->size = size;
+        header->tag = currentTag;
+
+        int tag = static_cast<int>(header->tag);
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        std::int64_t bytes = static_cast<std::int64_t>(size);
+        tagBytes[tag].fetch_add(bytes, std::memory_order_relaxed);
+        tagBlocks[tag].fetch_add(1, std::memory_order_relaxed);
+        std::int64_t live = liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        std::int64_t peak = peakBytes.load(std::memory_order_relaxed);
+        while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+        return header + 1;
+    }
+
+    void release(void* pointer) {
+        if (!pointer) return;
+        BlockHeader* header = static_cast<BlockHeader*>(pointer) - 1;
+        int tag = static_cast<int>(header->tag);
+        freeCount.fetch_add(1, std::memory_order_relaxed);
+        tagBytes[tag].fetch_sub(static_cast<std::int64_t>(header->size), std::memory_order_relaxed);
+        tagBlocks[tag].fetch_sub(1, std::memory_order_relaxed);
+        liveBytes.fetch_sub(static_cast<std::int64_t>(header->size), std::memory_order_relaxed);
+        std::free(header);
+    }
+}
+
+AllocationScope::AllocationScope(AllocationTag tag) : previous(currentTag) {
+    currentTag = tag;
+}
+
+AllocationScope::~AllocationScope() {
+    currentTag = previous;
+}
+
+AllocationStats getAllocationStats() {
+    AllocationStats stats;
+    stats.enabled = true;
+    stats.allocations = allocationCount.load(std::memory_order_relaxed);
+    stats.frees = freeCount.load(std::memory_order_relaxed);
+    stats.liveBytes = liveBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = peakBytes.load(std::memory_order_relaxed);
+    for (int tag = 0; tag < ALLOCATION_TAG_COUNT; tag++) {
+        stats.liveBytesByTag[tag] = tagBytes[tag].load(std::memory_order_relaxed);
+        stats.liveBlocksByTag[tag] = tagBlocks[tag].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+std::uint64_t getAllocationCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+// Every form that can pair with another's delete is replaced, so no block
+// reaches release() without a header
+void* operator new(std::size_t size) {
+    void* pointer = allocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    void* pointer = allocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void operator delete(void* pointer) noexcept { release(pointer); }
+void operator delete[](void* pointer) noexcept { release(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { release(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { release(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { release(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { release(pointer); }
+
+#else
+
+AllocationStats getAllocationStats() {
+    return {};
+}
+
+std::uint64_t getAllocationCount() {
+    return 0;
+}
+
+#endif
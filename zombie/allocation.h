@@ -0,0 +1,84 @@
+#ifndef ZOMBIE_ALLOCATION_H
+#define ZOMBIE_ALLOCATION_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Heap allocation tracking, compiled in with ZOMBIE_TRACK_ALLOCATIONS
+// (bazel --config=alloc). Global operator new/delete are replaced to count
+// every allocation in the process, on any thread, and to charge its bytes to
+// the tag in effect on the allocating thread; the tag travels with the block
+// so it is credited back on delete. Over-aligned (align_val_t) allocations
+// go straight to the C library and aren't counted.
+//
+// Without the define nothing is replaced, the tags compile to nothing and
+// getAllocationStats() reports enabled = false.
+
+enum class AllocationTag : std::uint8_t {
+    OTHER,    // Everything outside a tagged scope
+    MAZE,     // Tiles, distance fields, world chunks
+    ZOMBIES,  // Zombies and hunters, with their paths
+    BULLETS,
+    ITEMS,    // Keys, weapons and health boosts
+    RENDER,   // Per-frame view buffers (sprite lists)
+    COUNT
+};
+
+constexpr int ALLOCATION_TAG_COUNT = static_cast<int>(AllocationTag::COUNT);
+
+const char* allocationTagName(AllocationTag tag);
+
+struct AllocationStats {
+    bool enabled = false;
+    std::uint64_t allocations = 0;  // Since startup
+    std::uint64_t frees = 0;
+    std::int64_t liveBytes = 0;
+    std::int64_t peakBytes = 0;     // Highest liveBytes so far
+    std::array<std::int64_t, ALLOCATION_TAG_COUNT> liveBytesByTag{};
+    std::array<std::int64_t, ALLOCATION_TAG_COUNT> liveBlocksByTag{};
+};
+
+AllocationStats getAllocationStats();
+
+// Allocations since startup; one relaxed load, cheap enough for every frame
+std::uint64_t getAllocationCount();
+
+#ifdef ZOMBIE_TRACK_ALLOCATIONS
+
+// Charges this thread's allocations to tag until it goes out of scope
+class AllocationScope {
+public:
+    explicit AllocationScope(AllocationTag tag);
+    ~AllocationScope();
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+private:
+    AllocationTag previous;
+};
+
+#else
+
+class AllocationScope {
+public:
+    explicit AllocationScope(AllocationTag) {}
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+};
+
+#endif
+
+// Base for entities whose objects are charged to Tag wherever they are
+// created (make_unique in a spawner, a worker thread building a level).
+// Empty, so it adds nothing to the object.
+template <AllocationTag Tag>
+struct TaggedAllocation {
+    static void* operator new(std::size_t size) {
+        AllocationScope scope(Tag);
+        return ::operator new(size);
+    }
+    static void operator delete(void* pointer) noexcept { ::operator delete(pointer); }
+};
+
+#endif
@@ -0,0 +1,239 @@
+#include "autopilot.h"
+#include "collision_math.h"
+#include "pathfinding.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+    constexpr float TILE = static_cast<float>(Maze::TILE_SIZE);
+
+    float tileCentre(int tile) {
+        return (tile + 0.5f) * TILE;
+    }
+
+    float wrapAngle(float angle) {
+        while (angle > M_PI) angle -= 2.0f * M_PI;
+        while (angle < -M_PI) angle += 2.0f * M_PI;
+        return angle;
+    }
+
+    // The same exact grid walk bullets use, so a clear shot really lands
+    bool clearShot(const Maze& maze, float x1, float y1, float x2, float y2) {
+        auto isWall = [&maze](int tileX, int tileY) { return maze.isWall(tileX, tileY); };
+        return traceGridSegment(x1, y1, x2, y2, TILE, isWall) < 0.0f;
+    }
+
+    // Tile of the nearest (straight-line) position, or false if there is none.
+    // Whatever is on tileX/tileY on entry (the current goal) counts as half as
+    // far, so two similar targets don't take turns as the player moves.
+    template <typename Items, typename Wanted>
+    bool nearestTile(const Items& items, float px, float py, float maxDistance, Wanted wanted, int& tileX, int& tileY) {
+        int currentX = tileX;
+        int currentY = tileY;
+        float best = maxDistance * maxDistance;
+        bool found = false;
+        for (const auto& item : items) {
+            if (!wanted(*item)) continue;
+            float dx = item->getX() - px;
+            float dy = item->getY() - py;
+            float distanceSq = dx * dx + dy * dy;
+            if (static_cast<int>(item->getX() / TILE) == currentX && static_cast<int>(item->getY() / TILE) == currentY) {
+                distanceSq *= 0.25f;
+            }
+            if (distanceSq < best) {
+                best = distanceSq;
+                tileX = static_cast<int>(item->getX() / TILE);
+                tileY = static_cast<int>(item->getY() / TILE);
+                found = true;
+            }
+        }
+        return found;
+    }
+}
+
+bool Autopilot::isShortWalk(const Maze& maze, float fromX, float fromY, int toX, int toY) {
+    return findTilePath(maze, static_cast<int>(fromX / TILE), static_cast<int>(fromY / TILE), toX, toY, detour,
+                        DETOUR_BUDGET) &&
+           detour.size() <= static_cast<size_t>(DETOUR_TILES);
+}
+
+bool Autopilot::chooseGoal(const PlayState& state, int& goalX, int& goalY) {
+    const Player& player = *state.player;
+    const Maze& maze = *state.maze;
+    float px = player.getX();
+    float py = player.getY();
+    const float anywhere = std::numeric_limits<float>::max();
+
+    goalX = pathGoalX;
+    goalY = pathGoalY;
+
+    // Evacuate when the Blue Alert sounds
+    if (state.blueAlertActive && state.blueRoomX >= 0) {
+        goalX = state.blueRoomX;
+        goalY = state.blueRoomY;
+        return true;
+    }
+
+    // Detour for health when hurt, and for weapons or ammo not already in
+    // hand, if they are a short walk away (not just behind a wall). A
+    // candidate that isn't leaves the current goal alone.
+    int pickupX = pathGoalX, pickupY = pathGoalY;
+    if (player.getHealth() < player.getMaxHealth() &&
+        nearestTile(state.healthBoosts, px, py, DETOUR_TILES * TILE,
+                    [](const HealthBoost& boost) { return !boost.isCollected(); }, pickupX, pickupY) &&
+        isShortWalk(maze, px, py, pickupX, pickupY)) {
+        goalX = pickupX;
+        goalY = pickupY;
+        return true;
+    }
+    auto worthTaking = [&player](const WeaponPickup& pickup) {
+        if (pickup.isCollected()) return false;
+        if (!pickup.getIsAmmo()) return !player.hasWeapon(pickup.getType());
+        return player.hasWeapon(pickup.getType()) && getWeaponStats(pickup.getType()).maxAmmo >= 0;
+    };
+    pickupX = pathGoalX;
+    pickupY = pathGoalY;
+    if (nearestTile(state.weaponPickups, px, py, DETOUR_TILES * TILE, worthTaking, pickupX, pickupY) &&
+        isShortWalk(maze, px, py, pickupX, pickupY)) {
+        goalX = pickupX;
+        goalY = pickupY;
+        return true;
+    }
+
+    // Keys, then the exit
+    if (player.getKeys() < maze.getRequiredKeyCount(state.currentLevel) &&
+        nearestTile(state.keys, px, py, anywhere, [](const Key& key) { return !key.isCollected(); }, goalX, goalY)) {
+        return true;
+    }
+    const DistanceField& exitField = maze.getExitField();
+    int x = static_cast<int>(px / TILE);
+    int y = static_cast<int>(py / TILE);
+    if (exitField.getDistance(x, y) >= 0) {
+        int nextX, nextY;
+        while (exitField.getNextStep(x, y, nextX, nextY)) {  // Down the field to the nearest exit tile
+            x = nextX;
+            y = nextY;
+        }
+        goalX = x;
+        goalY = y;
+        return true;
+    }
+
+    // Nothing to collect (Soldier waves, the endless world): go hunting
+    auto alive = [](const Zombie& zombie) { return !zombie.isDead(); };
+    return nearestTile(state.zombies, px, py, anywhere, alive, goalX, goalY);
+}
+
+void Autopilot::manageWeapons(Player& player) {
+    bool spareAmmo = player.getAmmoInSlot(1 - player.getCurrentWeaponSlot()) != 0;
+    if (player.isUsingMelee()) {
+        if (!player.isOutOfAmmo() || spareAmmo) {
+            player.setUsingMelee(false);
+            actions.push_back(ReplayAction::TOGGLE_MELEE);
+        }
+    } else if (player.isOutOfAmmo()) {
+        if (spareAmmo) {
+            player.switchWeapon();
+            actions.push_back(ReplayAction::SWITCH_WEAPON);
+        } else {
+            player.setUsingMelee(true);
+            actions.push_back(ReplayAction::TOGGLE_MELEE);
+        }
+    }
+}
+
+TickInput Autopilot::update(PlayState& state) {
+    actions.clear();
+    keys.fill(0);
+    TickInput input;
+    input.keyState = keys.data();
+    if (!state.player || state.player->isDead()) return input;
+
+    Player& player = *state.player;
+    const Maze& maze = *state.maze;
+    float px = player.getX();
+    float py = player.getY();
+    int tileX = static_cast<int>(px / TILE);
+    int tileY = static_cast<int>(py / TILE);
+
+    manageWeapons(player);
+
+    // Route to the goal, refreshed when it moves and every REPATH_TICKS
+    int goalX = -1, goalY = -1;
+    bool hasGoal = chooseGoal(state, goalX, goalY);
+    ticksSinceRepath++;
+    if (hasGoal && (goalX != pathGoalX || goalY != pathGoalY || pathIndex >= path.size() ||
+                    ticksSinceRepath >= REPATH_TICKS)) {
+        findTilePath(maze, tileX, tileY, goalX, goalY, path);
+        pathIndex = 0;
+        pathGoalX = goalX;
+        pathGoalY = goalY;
+        ticksSinceRepath = 0;
+        repaths++;
+    }
+    while (pathIndex < path.size() &&
+           std::hypot(tileCentre(path[pathIndex].first) - px, tileCentre(path[pathIndex].second) - py) < TILE * 0.4f) {
+        pathIndex++;
+    }
+
+    bool moving = false;
+    float moveAngle = player.getAngle();
+    if (pathIndex < path.size()) {
+        moveAngle = std::atan2(tileCentre(path[pathIndex].second) - py, tileCentre(path[pathIndex].first) - px);
+        moving = true;
+    } else if (hasGoal && std::hypot(tileCentre(goalX) - px, tileCentre(goalY) - py) > TILE * 0.25f) {
+        moveAngle = std::atan2(tileCentre(goalY) - py, tileCentre(goalX) - px);  // Last stretch inside the goal tile
+        moving = true;
+    }
+
+    // Wedged on a corner or in a crowd: hold a random heading for a moment
+    if (++ticksSinceCheck >= STUCK_CHECK_TICKS) {
+        if (moving && wiggleTicks == 0 && std::hypot(px - checkX, py - checkY) < STUCK_DISTANCE) {
+            wiggleTicks = WIGGLE_TICKS;
+            wiggleAngle = rng.nextFloat(-M_PI, M_PI);
+            ticksSinceRepath = REPATH_TICKS;  // Fresh route once free
+            unsticks++;
+        }
+        checkX = px;
+        checkY = py;
+        ticksSinceCheck = 0;
+    }
+    if (wiggleTicks > 0) {
+        wiggleTicks--;
+        moveAngle = wiggleAngle;
+        moving = true;
+    }
+
+    // Aim at the nearest zombie or hunter in sight, otherwise where it's going
+    const WeaponStats weapon = getWeaponStats(player.getCurrentWeapon());
+    float range = weapon.isMelee ? weapon.meleeRange : SIGHT_TILES * TILE;
+    const Zombie* target = nullptr;
+    float best = range * range;
+    for (const auto* group : {&state.zombies, &state.hunters}) {
+        for (const auto& zombie : *group) {
+            if (zombie->isDead()) continue;
+            float dx = zombie->getX() - px;
+            float dy = zombie->getY() - py;
+            float distanceSq = dx * dx + dy * dy;
+            if (distanceSq < best && clearShot(maze, px, py, zombie->getX(), zombie->getY())) {
+                best = distanceSq;
+                target = zombie.get();
+            }
+        }
+    }
+    float aim = target ? std::atan2(target->getY() - py, target->getX() - px) : moveAngle;
+    player.setAngle(aim);
+    player.setPitch(0.0f);
+    input.firing = target != nullptr;
+
+    // Keys relative to the aim: the nearest of the eight walk directions
+    if (moving) {
+        int octant = static_cast<int>(std::lround(wrapAngle(moveAngle - aim) / (M_PI / 4.0f)));
+        octant = (octant + 8) % 8;  // 0 ahead, 2 right, 4 behind, 6 left
+        if (octant == 7 || octant == 0 || octant == 1) keys[SDL_SCANCODE_W] = 1;
+        if (octant >= 3 && octant <= 5) keys[SDL_SCANCODE_S] = 1;
+        if (octant >= 1 && octant <= 3) keys[SDL_SCANCODE_D] = 1;
+        if (octant >= 5 && octant <= 7) keys[SDL_SCANCODE_A] = 1;
+    }
+    return input;
+}
@@ -0,0 +1,65 @@
+#ifndef ZOMBIE_AUTOPILOT_H
+#define ZOMBIE_AUTOPILOT_H
+
+#include <SDL.h>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "replay.h"
+#include "rng.h"
+#include "simulation.h"
+
+// Scripted player for soak and load tests (zombie_sim_headless --autopilot).
+// Each tick it picks a goal - the safe room during a Blue Alert, health or
+// a new weapon close by, the nearest key, the exit, or failing those the
+// nearest zombie - follows the A* route there and shoots whatever it can
+// see on the way. It plays through the same controls a person has (held
+// keys, trigger, aim, weapon switch), so its sessions record and replay.
+class Autopilot {
+public:
+    explicit Autopilot(std::uint64_t seed = Rng::DEFAULT_SEED) : rng(seed) {}
+
+    // Aims and switches weapons on state.player, and returns the keys and
+    // trigger to pass to stepSimulation this tick
+    TickInput update(PlayState& state);
+
+    // Weapon switches / melee toggles made by the last update, for recording
+    const std::vector<ReplayAction>& getActions() const { return actions; }
+
+    int getRepathCount() const { return repaths; }
+    int getUnstickCount() const { return unsticks; }  // Times it was wedged and wiggled free
+
+private:
+    static constexpr int REPATH_TICKS = 30;        // Route refresh while the goal stays put
+    static constexpr int STUCK_CHECK_TICKS = 60;   // How often progress is measured
+    static constexpr float STUCK_DISTANCE = 8.0f;  // Pixels; less than this counts as wedged
+    static constexpr int WIGGLE_TICKS = 20;        // Random heading held to get unstuck
+    static constexpr int SIGHT_TILES = 10;         // Targets further away are ignored
+    static constexpr int DETOUR_TILES = 8;         // Walk to a pickup worth leaving the route for
+    static constexpr int DETOUR_BUDGET = 256;      // A* expansions spent checking that walk
+
+    bool chooseGoal(const PlayState& state, int& goalX, int& goalY);
+    bool isShortWalk(const Maze& maze, float fromX, float fromY, int toX, int toY);
+    void manageWeapons(Player& player);
+
+    std::array<Uint8, SDL_NUM_SCANCODES> keys{};
+    std::vector<ReplayAction> actions;
+    Rng rng;  // Wiggle headings
+
+    std::vector<std::pair<int, int>> path;    // Tiles still to walk
+    std::vector<std::pair<int, int>> detour;  // Scratch for isShortWalk
+    size_t pathIndex = 0;
+    int pathGoalX = -1, pathGoalY = -1;
+    int ticksSinceRepath = 0;
+
+    float checkX = 0.0f, checkY = 0.0f;  // Position at the last progress check
+    int ticksSinceCheck = 0;
+    int wiggleTicks = 0;
+    float wiggleAngle = 0.0f;
+
+    int repaths = 0;
+    int unsticks = 0;
+};
+
+#endif
@@ -1,9 +1,11 @@
 #include "bullet.h"
 #include "maze.h"
+#include "collision_math.h"
 #include <cmath>
 
 Bullet::Bullet(float x, float y, float dirX, float dirY, int damage, float speed, bool isExplosive, float explosionRadius)
-    : x(x), y(y), dirX(dirX), dirY(dirY), active(true), damage(damage), speed(speed), explosive(isExplosive), explosionRadius(explosionRadius) {
+    : x(x), y(y), prevX(x), prevY(y), dirX(dirX), dirY(dirY), active(true), hitWall(false), stepAccumulator(0.0f),
+      damage(damage), speed(speed), explosive(isExplosive), explosionRadius(explosionRadius) {
     // Normalize direction
     float len = std::sqrt(dirX * dirX + dirY * dirY);
     if (len > 0) {
@@ -13,17 +15,34 @@ Bullet::Bullet(float x, float y, float dirX, float dirY, int damage, float speed
 }
 
 void Bullet::update(float deltaTime, const Maze& maze) {
-    if (!active) return;
+    prevX = x;
+    prevY = y;
+    if (!active || hitWall) return;
+
+    stepAccumulator += deltaTime;
+    int steps = static_cast<int>(stepAccumulator / FIXED_STEP);
+    stepAccumulator -= steps * FIXED_STEP;
+    if (steps > MAX_STEPS_PER_UPDATE) steps = MAX_STEPS_PER_UPDATE;
+
+    float stepX = dirX * speed * FIXED_STEP;
+    float stepY = dirY * speed * FIXED_STEP;
+    auto isWall = [&maze](int tileX, int tileY) { return maze.isWall(tileX, tileY); };
 
-    x += dirX * speed * deltaTime;
-    y += dirY * speed * deltaTime;
+    for (int i = 0; i < steps; i++) {
+        float nextX = x + stepX;
+        float nextY = y + stepY;
 
-    // Check collision with walls
-    int tileX = static_cast<int>(x / Maze::TILE_SIZE);
-    int tileY = static_cast<int>(y / Maze::TILE_SIZE);
+        // Exact segment-vs-grid test for this step
+        float t = traceGridSegment(x, y, nextX, nextY, static_cast<float>(Maze::TILE_SIZE), isWall);
+        if (t >= 0.0f) {
+            x += stepX * t;
+            y += stepY * t;
+            hitWall = true;
+            return;
+        }
 
-    if (maze.isWall(tileX, tileY)) {
-        active = false;
+        x = nextX;
+        y = nextY;
     }
 }
 
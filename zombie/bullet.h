@@ -2,21 +2,33 @@
 #define ZOMBIE_BULLET_H
 
 #include <SDL.h>
+#include "allocation.h"
 
 class Maze;
 
-class Bullet {
+class Bullet : public TaggedAllocation<AllocationTag::BULLETS> {
 public:
     Bullet(float x, float y, float dirX, float dirY, int damage, float speed = 400.0f, bool isExplosive = false, float explosionRadius = 0.0f);
 
+    // Advances in FIXED_STEP increments (leftover time carries to the next
+    // call) and stops exactly where the path first enters a wall tile
     void update(float deltaTime, const Maze& maze);
     void render(SDL_Renderer* renderer) const;
 
     bool isActive() const { return active; }
     void deactivate() { active = false; }
 
+    // Wall impact during the last update; the bullet rests at the impact point
+    // until the collision phase resolves it (explodes or deactivates it)
+    bool hasHitWall() const { return hitWall; }
+
     float getX() const { return x; }
     float getY() const { return y; }
+    void translate(float dx, float dy) { x += dx; y += dy; prevX += dx; prevY += dy; }
+    float getPrevX() const { return prevX; }  // Position before the last update
+    float getPrevY() const { return prevY; }
+    float getRenderX(float alpha) const { return prevX + (x - prevX) * alpha; }  // For drawing between ticks
+    float getRenderY(float alpha) const { return prevY + (y - prevY) * alpha; }
     float getRadius() const { return radius; }
     int getDamage() const { return damage; }
     bool isExplosive() const { return explosive; }
@@ -24,14 +36,19 @@ public:
 
 private:
     float x, y;
+    float prevX, prevY;
     float dirX, dirY;
     bool active;
+    bool hitWall;
+    float stepAccumulator;    // Unsimulated time carried between updates
     int damage;
     float speed;
     bool explosive;           // True for grenades
     float explosionRadius;    // Radius of explosion damage
 
     static constexpr float radius = 4.0f;
+    static constexpr float FIXED_STEP = 1.0f / 120.0f;  // Projectile integration step
+    static constexpr int MAX_STEPS_PER_UPDATE = 30;      // Drop time beyond a quarter second stall
 };
 
 #endif
@@ -0,0 +1,104 @@
+#include "collision.h"
+#include <cmath>
+
+void CollisionWorld::reset(float worldWidth, float worldHeight, float newCellSize) {
+    // Cells grow on big maps so the per-tick rebuild stays O(bodies), not O(area)
+    cellSize = std::max(newCellSize, std::max(worldWidth, worldHeight) / MAX_GRID_DIMENSION);
+    cols = std::max(1, static_cast<int>(std::ceil(worldWidth / cellSize)));
+    rows = std::max(1, static_cast<int>(std::ceil(worldHeight / cellSize)));
+    maxBodyRadius = 0.0f;
+
+    bodies.clear();
+    probes.clear();
+    contacts.clear();
+    cellStart.assign(cols * rows + 1, 0);
+    cellBodies.clear();
+}
+
+void CollisionWorld::addBody(ColliderCategory category, int index, float x, float y, float radius) {
+    bodies.push_back({x, y, radius, category, index});
+    maxBodyRadius = std::max(maxBodyRadius, radius);
+}
+
+void CollisionWorld::addProbe(ColliderCategory category, int index, float x, float y, float radius, std::uint32_t bodyMask) {
+    probes.push_back({x, y, x, y, radius, bodyMask, category, index});
+}
+
+void CollisionWorld::addSweptProbe(ColliderCategory category, int index, float x0, float y0, float x1, float y1,
+                                   float radius, std::uint32_t bodyMask) {
+    probes.push_back({x0, y0, x1, y1, radius, bodyMask, category, index});
+}
+
+int CollisionWorld::cellIndex(float x, float y) const {
+    int cx = std::clamp(static_cast<int>(x / cellSize), 0, cols - 1);
+    int cy = std::clamp(static_cast<int>(y / cellSize), 0, rows - 1);
+    return cy * cols + cx;
+}
+
+void CollisionWorld::cellRange(float minX, float minY, float maxX, float maxY,
+                               int& minCX, int& minCY, int& maxCX, int& maxCY) const {
+    minCX = std::clamp(static_cast<int>(std::floor(minX / cellSize)), 0, cols - 1);
+    minCY = std::clamp(static_cast<int>(std::floor(minY / cellSize)), 0, rows - 1);
+    maxCX = std::clamp(static_cast<int>(std::floor(maxX / cellSize)), 0, cols - 1);
+    maxCY = std::clamp(static_cast<int>(std::floor(maxY / cellSize)), 0, rows - 1);
+}
+
+void CollisionWorld::build() {
+    // Counting sort: count per cell, prefix sum, then scatter back to front
+    // so each cellStart entry ends up at the first body of its cell
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    for (const auto& body : bodies) {
+        cellStart[cellIndex(body.x, body.y)]++;
+    }
+    for (size_t i = 1; i < cellStart.size(); i++) {
+        cellStart[i] += cellStart[i - 1];
+    }
+
+    cellBodies.resize(bodies.size());
+    for (int i = static_cast<int>(bodies.size()) - 1; i >= 0; i--) {
+        cellBodies[--cellStart[cellIndex(bodies[i].x, bodies[i].y)]] = i;
+    }
+}
+
+const std::vector<Contact>& CollisionWorld::findContacts() {
+    contacts.clear();
+
+    for (const auto& probe : probes) {
+        float reach = probe.radius + maxBodyRadius;
+        int minCX, minCY, maxCX, maxCY;
+        cellRange(std::min(probe.x0, probe.x1) - reach, std::min(probe.y0, probe.y1) - reach,
+                  std::max(probe.x0, probe.x1) + reach, std::max(probe.y0, probe.y1) + reach,
+                  minCX, minCY, maxCX, maxCY);
+
+        float dx = probe.x1 - probe.x0;
+        float dy = probe.y1 - probe.y0;
+        bool isSwept = (dx != 0.0f || dy != 0.0f);
+        size_t groupStart = contacts.size();
+
+        for (int cy = minCY; cy <= maxCY; cy++) {
+            for (int cx = minCX; cx <= maxCX; cx++) {
+                int cell = cy * cols + cx;
+                for (int i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+                    const Body& body = bodies[cellBodies[i]];
+                    if (!(categoryBit(body.category) & probe.bodyMask)) continue;
+
+                    float t;
+                    if (isSwept) {
+                        t = rayCircleHitTime(probe.x0, probe.y0, dx, dy, body.x, body.y, probe.radius + body.radius);
+                    } else {
+                        t = circlesOverlap(probe.x0, probe.y0, probe.radius, body.x, body.y, body.radius) ? 0.0f : -1.0f;
+                    }
+
+                    if (t >= 0.0f) {
+                        contacts.push_back({probe.category, probe.index, body.category, body.index, t});
+                    }
+                }
+            }
+        }
+
+        std::stable_sort(contacts.begin() + groupStart, contacts.end(),
+                         [](const Contact& a, const Contact& b) { return a.t < b.t; });
+    }
+
+    return contacts;
+}
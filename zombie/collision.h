@@ -0,0 +1,109 @@
+#ifndef ZOMBIE_COLLISION_H
+#define ZOMBIE_COLLISION_H
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include "collision_math.h"
+
+// What an entry in the collision world belongs to. The index stored next to
+// it points back into the matching PlayState vector.
+enum class ColliderCategory : std::uint8_t {
+    PLAYER,
+    ZOMBIE,
+    HUNTER,
+    KEY,
+    WEAPON,
+    HEALTH,
+    BULLET
+};
+
+constexpr std::uint32_t categoryBit(ColliderCategory category) {
+    return 1u << static_cast<std::uint32_t>(category);
+}
+
+// A probe (player, bullet) touching a body (zombie, pickup, ...)
+struct Contact {
+    ColliderCategory probeCategory;
+    int probeIndex;
+    ColliderCategory bodyCategory;
+    int bodyIndex;
+    float t;  // Fraction along a swept probe where contact starts (0 for static probes)
+};
+
+// Uniform grid broadphase rebuilt once per tick.
+// Bodies are passive circles bucketed by their centre; probes are circles or
+// swept circles that query the grid for the categories in their mask.
+class CollisionWorld {
+public:
+    void reset(float worldWidth, float worldHeight, float cellSize = DEFAULT_CELL_SIZE);
+
+    void addBody(ColliderCategory category, int index, float x, float y, float radius);
+    void addProbe(ColliderCategory category, int index, float x, float y, float radius, std::uint32_t bodyMask);
+    void addSweptProbe(ColliderCategory category, int index, float x0, float y0, float x1, float y1,
+                       float radius, std::uint32_t bodyMask);
+
+    // Bucket bodies into cells; call after all bodies are added
+    void build();
+
+    // Contacts grouped by probe in insertion order, each group sorted by t
+    const std::vector<Contact>& findContacts();
+
+    // Visit bodies in mask whose centre lies within radius of (x, y).
+    // fn(category, index, distanceSquared)
+    template <typename Fn>
+    void queryCircle(float x, float y, float radius, std::uint32_t bodyMask, Fn&& fn) const {
+        int minCX, minCY, maxCX, maxCY;
+        cellRange(x - radius, y - radius, x + radius, y + radius, minCX, minCY, maxCX, maxCY);
+        float radiusSq = radius * radius;
+        for (int cy = minCY; cy <= maxCY; cy++) {
+            for (int cx = minCX; cx <= maxCX; cx++) {
+                int cell = cy * cols + cx;
+                for (int i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+                    const Body& body = bodies[cellBodies[i]];
+                    if (!(categoryBit(body.category) & bodyMask)) continue;
+                    float distSq = distanceSquared(x, y, body.x, body.y);
+                    if (distSq <= radiusSq) {
+                        fn(body.category, body.index, distSq);
+                    }
+                }
+            }
+        }
+    }
+
+    int getBodyCount() const { return static_cast<int>(bodies.size()); }
+    int getProbeCount() const { return static_cast<int>(probes.size()); }
+
+    static constexpr float DEFAULT_CELL_SIZE = 60.0f;  // Two maze tiles
+    static constexpr float MAX_GRID_DIMENSION = 128.0f;  // Cells per side at most
+
+private:
+    struct Body {
+        float x, y, radius;
+        ColliderCategory category;
+        int index;
+    };
+
+    struct Probe {
+        float x0, y0, x1, y1, radius;
+        std::uint32_t bodyMask;
+        ColliderCategory category;
+        int index;
+    };
+
+    void cellRange(float minX, float minY, float maxX, float maxY,
+                   int& minCX, int& minCY, int& maxCX, int& maxCY) const;
+    int cellIndex(float x, float y) const;
+
+    float cellSize = DEFAULT_CELL_SIZE;
+    int cols = 1, rows = 1;
+    float maxBodyRadius = 0.0f;  // Probes widen their query by this so bodies only live in one cell
+
+    std::vector<Body> bodies;
+    std::vector<Probe> probes;
+    std::vector<int> cellStart;   // Prefix sums, size cols*rows + 1
+    std::vector<int> cellBodies;  // Body indices ordered by cell
+    std::vector<Contact> contacts;
+};
+
+#endif
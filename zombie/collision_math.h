@@ -0,0 +1,94 @@
+#ifndef ZOMBIE_COLLISION_MATH_H
+#define ZOMBIE_COLLISION_MATH_H
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+// Header-only collision primitives. Everything compares squared distances so
+// the hot loops never need a square root; only rayCircleHitTime takes one,
+// and only once a hit is already known.
+
+constexpr float distanceSquared(float ax, float ay, float bx, float by) {
+    float dx = bx - ax;
+    float dy = by - ay;
+    return dx * dx + dy * dy;
+}
+
+// Strictly overlapping circles (touching edges do not count)
+constexpr bool circlesOverlap(float ax, float ay, float ar, float bx, float by, float br) {
+    float r = ar + br;
+    return distanceSquared(ax, ay, bx, by) < r * r;
+}
+
+// Point inside or on the circle
+constexpr bool pointInCircle(float px, float py, float cx, float cy, float r) {
+    return distanceSquared(px, py, cx, cy) <= r * r;
+}
+
+// Segment (x0,y0)->(x0+dx,y0+dy) against a circle. Returns the fraction t in
+// [0, 1] where the segment first enters the circle, 0 if it starts inside,
+// or -1 if it misses.
+inline float rayCircleHitTime(float x0, float y0, float dx, float dy, float cx, float cy, float r) {
+    float mx = x0 - cx;
+    float my = y0 - cy;
+    float c = mx * mx + my * my - r * r;
+    if (c < 0.0f) return 0.0f;
+
+    float a = dx * dx + dy * dy;
+    float b = mx * dx + my * dy;
+    if (a <= 0.0f || b >= 0.0f) return -1.0f;  // Not moving, or moving away
+
+    float disc = b * b - a * c;
+    if (disc < 0.0f) return -1.0f;
+
+    float t = (-b - std::sqrt(disc)) / a;
+    return t <= 1.0f ? t : -1.0f;
+}
+
+// Grid DDA: visit every tile the segment (x0,y0)->(x1,y1) crosses, in order,
+// and return the fraction t where it enters the first tile for which
+// isSolid(tileX, tileY) is true. Returns 0 if it starts inside a solid tile
+// and -1 if the whole segment is clear. Exact, so nothing can tunnel through
+// a one-tile wall however far the segment reaches.
+template <typename IsSolid>
+float traceGridSegment(float x0, float y0, float x1, float y1, float cellSize, IsSolid&& isSolid) {
+    int tileX = static_cast<int>(std::floor(x0 / cellSize));
+    int tileY = static_cast<int>(std::floor(y0 / cellSize));
+    if (isSolid(tileX, tileY)) return 0.0f;
+
+    int endX = static_cast<int>(std::floor(x1 / cellSize));
+    int endY = static_cast<int>(std::floor(y1 / cellSize));
+    int remaining = std::abs(endX - tileX) + std::abs(endY - tileY);
+    if (remaining == 0) return -1.0f;
+
+    constexpr float INF = std::numeric_limits<float>::infinity();
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    int stepX = dx > 0.0f ? 1 : (dx < 0.0f ? -1 : 0);
+    int stepY = dy > 0.0f ? 1 : (dy < 0.0f ? -1 : 0);
+
+    // t at the next vertical / horizontal grid line, and t per whole tile
+    float tMaxX = stepX > 0 ? ((tileX + 1) * cellSize - x0) / dx : (stepX < 0 ? (tileX * cellSize - x0) / dx : INF);
+    float tMaxY = stepY > 0 ? ((tileY + 1) * cellSize - y0) / dy : (stepY < 0 ? (tileY * cellSize - y0) / dy : INF);
+    float tDeltaX = stepX != 0 ? cellSize / std::abs(dx) : INF;
+    float tDeltaY = stepY != 0 ? cellSize / std::abs(dy) : INF;
+
+    for (; remaining > 0; remaining--) {
+        float t;
+        if (tMaxX < tMaxY) {
+            tileX += stepX;
+            t = tMaxX;
+            tMaxX += tDeltaX;
+        } else {
+            tileY += stepY;
+            t = tMaxY;
+            tMaxY += tDeltaY;
+        }
+        if (t > 1.0f) break;
+        if (isSolid(tileX, tileY)) return t;
+    }
+    return -1.0f;
+}
+
+#endif
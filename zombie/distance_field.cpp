@@ -0,0 +1,74 @@
+#include "distance_field.h"
+#include "allocation.h"
+#include "maze.h"
+
+namespace {
+    // Direction codes: the step a tile takes toward its target
+    const int STEP_X[] = {1, -1, 0, 0};
+    const int STEP_Y[] = {0, 0, 1, -1};
+
+    // BFS queue reused across builds on the same thread (mazes are built on
+    // the main thread and on level/chunk workers)
+    thread_local std::vector<int> queue;
+}
+
+void DistanceField::clear() {
+    width = 0;
+    height = 0;
+    paddedWidth = 0;
+    distances.clear();
+    directions.clear();
+}
+
+void DistanceField::build(const Maze& maze, const std::vector<std::pair<int, int>>& targets) {
+    AllocationScope allocations(AllocationTag::MAZE);
+    width = maze.getWidth();
+    height = maze.getHeight();
+    paddedWidth = width + 2;
+    distances.assign(static_cast<size_t>(paddedWidth) * (height + 2), BLOCKED);
+    directions.assign((distances.size() + 3) / 4, 0);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (!maze.isWall(x, y)) distances[paddedIndex(x, y)] = UNREACHABLE;
+        }
+    }
+
+    // Every target starts the search at distance 0; the queue doubles as the
+    // visit order, so no separate frontier is needed
+    queue.clear();
+    queue.reserve(static_cast<size_t>(width) * height);
+    for (auto [x, y] : targets) {
+        if (x < 0 || x >= width || y < 0 || y >= height) continue;
+        int index = paddedIndex(x, y);
+        if (distances[index] == UNREACHABLE) {
+            distances[index] = 0;
+            queue.push_back(index);
+        }
+    }
+
+    // Walls and the border hold BLOCKED, so only unvisited open tiles match
+    const int offsets[] = {1, -1, paddedWidth, -paddedWidth};
+    for (size_t head = 0; head < queue.size(); head++) {
+        int index = queue[head];
+        std::uint16_t nextDistance = distances[index] < MAX_DISTANCE ? distances[index] + 1 : MAX_DISTANCE;
+
+        for (int dir = 0; dir < 4; dir++) {
+            int next = index + offsets[dir];
+            if (distances[next] != UNREACHABLE) continue;
+
+            distances[next] = nextDistance;
+            int back = dir ^ 1;  // Step from next back toward index
+            directions[next / 4] |= static_cast<std::uint8_t>(back << ((next % 4) * 2));
+            queue.push_back(next);
+        }
+    }
+}
+
+bool DistanceField::getNextStep(int x, int y, int& nextX, int& nextY) const {
+    if (getDistance(x, y) <= 0) return false;
+    int index = paddedIndex(x, y);
+    int dir = (directions[index / 4] >> ((index % 4) * 2)) & 3;
+    nextX = x + STEP_X[dir];
+    nextY = y + STEP_Y[dir];
+    return true;
+}
@@ -0,0 +1,50 @@
+#ifndef ZOMBIE_DISTANCE_FIELD_H
+#define ZOMBIE_DISTANCE_FIELD_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class Maze;
+
+// Route length from every open tile to the nearest of a fixed set of target
+// tiles, plus the first step of that route. Built once with a 4-way
+// multi-source BFS; after that every query is a table lookup.
+//
+// Stored compactly: 2 bytes of distance and 2 bits of direction per tile,
+// over the maze plus a one-tile border so the search needs no bounds checks.
+class DistanceField {
+public:
+    static constexpr std::uint16_t UNREACHABLE = 0xffff;   // Open tile with no route
+    static constexpr std::uint16_t BLOCKED = 0xfffe;       // Wall or border
+    static constexpr std::uint16_t MAX_DISTANCE = 0xfffd;  // Longer routes saturate here
+
+    // Targets are tile coordinates; ones on walls or off the map are ignored
+    void build(const Maze& maze, const std::vector<std::pair<int, int>>& targets);
+    void clear();
+
+    bool isEmpty() const { return distances.empty(); }
+
+    // Tiles to the nearest target, or -1 if there is no route (walls, off map)
+    int getDistance(int x, int y) const {
+        if (x < 0 || x >= width || y < 0 || y >= height) return -1;
+        std::uint16_t d = distances[paddedIndex(x, y)];
+        return d >= BLOCKED ? -1 : d;
+    }
+
+    // The neighbouring tile one step closer to the nearest target. False on
+    // a target itself or where there is no route.
+    bool getNextStep(int x, int y, int& nextX, int& nextY) const;
+
+private:
+    int width = 0;
+    int height = 0;
+    int paddedWidth = 0;
+
+    int paddedIndex(int x, int y) const { return (y + 1) * paddedWidth + x + 1; }
+
+    std::vector<std::uint16_t> distances;
+    std::vector<std::uint8_t> directions;  // 2 bits per tile, four tiles per byte
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef ZOMBIE_EVENTS_H
+#define ZOMBIE_EVENTS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Things the simulation reports to presentation (audio, HUD, logging, high
+// scores). The simulation only pushes; Game::run drains once per frame.
+enum class GameEventType : std::uint8_t {
+    SHOT_FIRED,        // detail = WeaponType
+    FLAME_FIRED,       // One flamethrower burst (no bullet)
+    MELEE_HIT,
+    ZOMBIE_KILLED,
+    HUNTER_KILLED,
+    EXPLOSION,         // amount = zombies killed, detail = hunters killed
+    PLAYER_DAMAGED,    // amount = health left, detail = 1 if by a hunter
+    PLAYER_DIED,       // amount = life score, detail = 1 if by a hunter; carries the run
+    KEY_COLLECTED,     // amount = keys held, detail = keys required
+    WEAPON_PICKED_UP,  // detail = WeaponType
+    AMMO_PICKED_UP,    // amount = rounds, detail = WeaponType
+    HEALTH_COLLECTED,  // amount = health, detail = 1 if it healed
+    ZOMBIE_GROAN,      // amount = volume (see MAX_EVENT_VOLUME), detail = 0 groan / 1 moan
+    HUNTER_BREATH,     // amount = volume
+    PROXIMITY_BEEP     // amount = volume
+};
+
+// Volumes in events use SDL_mixer's 0..MIX_MAX_VOLUME scale
+constexpr int MAX_EVENT_VOLUME = 128;
+
+struct GameEvent {
+    GameEventType type;
+    float x, y;   // World position where it happened (0 when not meaningful)
+    int amount;   // See GameEventType
+    int detail;
+
+    // The run it ended, for PLAYER_DIED: later ticks in the same frame may
+    // already have started a new one by the time it is drained
+    int totalScore = 0;
+    int level = 0;
+    std::uint8_t mazeType = 0;    // MazeType
+    std::uint8_t difficulty = 0;  // Difficulty
+};
+
+// Bounded lock-free single-producer/single-consumer ring. push() and pop()
+// may run on different threads; each side only writes its own index.
+template <typename T, std::size_t Capacity>
+class SpscRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Returns false (and drops the item) when the ring is full
+    bool push(const T& item) {
+        std::size_t write = writeIndex.load(std::memory_order_relaxed);
+        if (write - readIndex.load(std::memory_order_acquire) == Capacity) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        buffer[write & (Capacity - 1)] = item;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& out) {
+        std::size_t read = readIndex.load(std::memory_order_relaxed);
+        if (read == writeIndex.load(std::memory_order_acquire)) {
+            return false;
+        }
+        out = buffer[read & (Capacity - 1)];
+        readIndex.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t size() const {
+        return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_acquire);
+    }
+
+    std::size_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    alignas(64) std::atomic<std::size_t> writeIndex{0};  // Owned by the producer
+    alignas(64) std::atomic<std::size_t> readIndex{0};   // Owned by the consumer
+    std::atomic<std::size_t> dropped{0};
+    std::array<T, Capacity> buffer;
+};
+
+using GameEventQueue = SpscRing<GameEvent, 1024>;
+
+#endif
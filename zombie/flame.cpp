@@ -0,0 +1,91 @@
+#include "flame.h"
+#include "maze.h"
+#include "rng.h"
+#include <cmath>
+#include <algorithm>
+
+FlameSystem::FlameSystem()
+    : particles(), head(0), count(0), clock(0.0f), lastEmitClock(-1.0f), damageTimer(0.0f),
+      coneX(0.0f), coneY(0.0f), coneAngle(0.0f) {}
+
+void FlameSystem::emit(float x, float y, float angle, Rng& rng) {
+    coneX = x;
+    coneY = y;
+    coneAngle = angle;
+
+    // Start the damage clock fresh on a new trigger pull
+    if (!isFiring()) damageTimer = 0.0f;
+    lastEmitClock = clock;
+
+    for (int i = 0; i < PARTICLES_PER_BURST; i++) {
+        // Ring buffer: when full, the oldest particle is overwritten
+        if (count == CAPACITY) {
+            head = (head + 1) % CAPACITY;
+            count--;
+        }
+
+        float jitter = rng.nextFloat(-SPREAD, SPREAD);
+        float speed = SPEED * rng.nextFloat(0.75f, 1.25f);
+        FlameParticle& p = particles[(head + count) % CAPACITY];
+        p.x = x;
+        p.y = y;
+        p.vx = std::cos(angle + jitter) * speed;
+        p.vy = std::sin(angle + jitter) * speed;
+        p.age = 0.0f;
+        p.alive = true;
+        count++;
+    }
+}
+
+void FlameSystem::update(float deltaTime, const Maze& maze) {
+    clock += deltaTime;
+    if (isFiring()) {
+        damageTimer += deltaTime;
+    }
+
+    float drag = std::max(0.0f, 1.0f - DRAG * deltaTime);
+    for (int i = 0; i < count; i++) {
+        FlameParticle& p = particles[(head + i) % CAPACITY];
+        p.age += deltaTime;
+        if (!p.alive) continue;
+
+        p.x += p.vx * deltaTime;
+        p.y += p.vy * deltaTime;
+        p.vx *= drag;
+        p.vy *= drag;
+
+        if (maze.isWall(static_cast<int>(p.x / Maze::TILE_SIZE), static_cast<int>(p.y / Maze::TILE_SIZE))) {
+            p.alive = false;  // Burned out against a wall
+        }
+    }
+
+    // Particles share one lifetime and are emitted in order, so expiry only
+    // ever happens at the head of the ring
+    while (count > 0 && particles[head].age >= LIFETIME) {
+        head = (head + 1) % CAPACITY;
+        count--;
+    }
+}
+
+void FlameSystem::clear() {
+    head = 0;
+    count = 0;
+    damageTimer = 0.0f;
+    lastEmitClock = clock - FIRE_WINDOW - 1.0f;
+}
+
+void FlameSystem::translate(float dx, float dy) {
+    for (int i = 0; i < count; i++) {
+        FlameParticle& p = particles[(head + i) % CAPACITY];
+        p.x += dx;
+        p.y += dy;
+    }
+    coneX += dx;
+    coneY += dy;
+}
+
+bool FlameSystem::takeDamageTick() {
+    if (damageTimer < DAMAGE_INTERVAL) return false;
+    damageTimer -= DAMAGE_INTERVAL;
+    return true;
+}
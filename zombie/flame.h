@@ -0,0 +1,64 @@
+#ifndef ZOMBIE_FLAME_H
+#define ZOMBIE_FLAME_H
+
+#include <array>
+
+class Maze;
+class Rng;
+
+struct FlameParticle {
+    float x, y;
+    float vx, vy;
+    float age;    // Seconds since emission
+    bool alive;   // False once it has burned out against a wall
+};
+
+// Flamethrower effect: a fixed ring buffer of short-lived particles plus the
+// cone used for damage. Particles are purely visual; damage is applied by
+// the game as one cone query every DAMAGE_INTERVAL while the trigger is held.
+class FlameSystem {
+public:
+    FlameSystem();
+
+    // Spray a burst from (x, y) toward angle, jittered from rng; also
+    // re-aims the damage cone
+    void emit(float x, float y, float angle, Rng& rng);
+    void update(float deltaTime, const Maze& maze);
+    void clear();
+    void translate(float dx, float dy);  // Shift live particles and the cone with the world origin
+
+    // True once per DAMAGE_INTERVAL of continuous fire
+    bool takeDamageTick();
+    bool isFiring() const { return clock - lastEmitClock <= FIRE_WINDOW; }
+
+    float getConeX() const { return coneX; }
+    float getConeY() const { return coneY; }
+    float getConeAngle() const { return coneAngle; }
+
+    // Oldest particle first
+    int getCount() const { return count; }
+    const FlameParticle& getParticle(int i) const { return particles[(head + i) % CAPACITY]; }
+
+    static constexpr int CAPACITY = 256;
+    static constexpr int PARTICLES_PER_BURST = 3;
+    static constexpr float LIFETIME = 0.45f;           // Seconds a particle lives
+    static constexpr float SPEED = 320.0f;             // Initial particle speed
+    static constexpr float DRAG = 2.5f;                // Velocity falloff per second
+    static constexpr float SPREAD = 0.26f;             // Max angle jitter per particle (~15 degrees)
+    static constexpr float RANGE = 150.0f;             // Damage cone length (5 tiles; the old puffs flew to the next wall)
+    static constexpr float CONE_HALF_ANGLE = 0.35f;    // Damage cone half width (~20 degrees)
+    static constexpr float DAMAGE_INTERVAL = 0.04f;    // The weapon's fireRate, so 25 damage/s per target as before
+    static constexpr float FIRE_WINDOW = 0.1f;         // Stays "firing" this long after the last burst
+
+private:
+    std::array<FlameParticle, CAPACITY> particles;
+    int head;   // Index of the oldest particle
+    int count;  // Live slots starting at head
+
+    float clock;           // Simulation time seen by this system
+    float lastEmitClock;
+    float damageTimer;
+    float coneX, coneY, coneAngle;
+};
+
+#endif
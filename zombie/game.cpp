@@ -1,11 +1,22 @@
 #include "game.h"
+#include "allocation.h"
 #include "maze.h"
 #include "player.h"
+#include "profiler.h"
 #include "zombie.h"
 #include "bullet.h"
 #include "key.h"
 #include "weapon.h"
 #include "healthboost.h"
+#include "collision.h"
+#include "flame.h"
+#include "events.h"
+#include "rng.h"
+#include "trace.h"
+#include "render.h"
+#include "replay.h"
+#include "simulation.h"
+#include "world_stream.h"
 #include <SDL_mixer.h>
 #include <iostream>
 #include <fstream>
@@ -16,6 +27,10 @@
 #include <cmath>
 #include <string>
 #include <cstdlib>
+#include <random>
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif
 
 namespace {
     // Sound effects
@@ -165,27 +180,6 @@ namespace {
         }
     }
 
-    // Helper function to randomly select a zombie type
-    ZombieType getRandomZombieType() {
-        int roll = rand() % 100;  // 0-99
-
-        // Distribution:
-        // 50% NORMAL (0-49)
-        // 25% FAST (50-74)
-        // 15% TANK (75-89)
-        // 10% RUNNER (90-99)
-
-        if (roll < 50) {
-            return ZombieType::NORMAL;
-        } else if (roll < 75) {
-            return ZombieType::FAST;
-        } else if (roll < 90) {
-            return ZombieType::TANK;
-        } else {
-            return ZombieType::RUNNER;
-        }
-    }
-
     // High Score System
     struct HighScoreEntry {
         int score;
@@ -279,87 +273,6 @@ namespace {
         }
     }
 
-    struct PlayState {
-        std::unique_ptr<Maze> maze;
-        std::unique_ptr<Player> player;
-        std::vector<std::unique_ptr<Zombie>> zombies;
-        std::vector<std::unique_ptr<Key>> keys;
-        std::vector<std::unique_ptr<Bullet>> bullets;
-        std::vector<std::unique_ptr<WeaponPickup>> weaponPickups;
-        std::vector<std::unique_ptr<HealthBoost>> healthBoosts;
-        Uint32 deathTime = 0;
-
-        // Score tracking
-        int score = 0;
-        int zombiesKilled = 0;
-        int totalScore = 0;  // Persistent score across respawns
-        Uint32 gameStartTime = 0;
-
-        // Zombie spawning
-        float spawnTimer = 0.0f;
-        int totalZombiesSpawned = 0;
-        int initialZombieCount = 15;
-        int minZombieCount = 8;
-        int maxZombieCount = 25;
-        int zombieMaxHealth = 3;  // Health per zombie based on difficulty
-
-        // Screen shake
-        float screenShake = 0.0f;
-        float shakeOffsetX = 0.0f;
-        float shakeOffsetY = 0.0f;
-
-        // Proximity beep system
-        float proximityBeepTimer = 0.0f;
-        float proximityBeepInterval = 2.0f;  // Start at 2 seconds
-
-        // HUD toggles
-        bool showScore = true;
-        bool showMinimap = true;
-        bool showArrow = true;
-
-        // Infinite mode tracking
-        int currentLevel = 1;  // Track which level/wave the player is on
-        MazeType mazeType = MazeType::STANDARD;  // Track the current maze type
-
-        // Soldier mode wave tracking
-        int currentWave = 1;
-        bool waveActive = false;
-        float waveDelayTimer = 0.0f;
-        float waveDelay = 5.0f;  // 5 seconds between waves
-
-        // Difficulty tracking (for testing mode checks)
-        Difficulty difficulty = Difficulty::NORMAL;
-
-        // Testing/Debug panel (F1 to toggle, only works in TESTING mode)
-        bool showTestingPanel = false;
-        bool godMode = false;  // Immortality
-        int selectedWeaponSpawn = 0;  // For weapon spawning dropdown
-        int selectedZombieType = 0;  // For zombie spawning
-        bool spawnAtCrosshair = false;  // If true, spawn at crosshair; if false, spawn at player
-
-        // Blood Moon event (happens every 2 minutes for 30 seconds)
-        float bloodMoonTimer = 0.0f;
-        bool bloodMoonActive = false;
-        float bloodMoonDuration = 30.0f;  // 30 seconds of blood moon
-        float bloodMoonInterval = 120.0f;  // Every 2 minutes (120 seconds)
-        float bloodMoonSpawnMultiplier = 8.0f;  // Spawn 8x more zombies during blood moon!
-
-        // Blue Alert event - player must evacuate to safe room
-        float blueAlertTimer = 0.0f;
-        bool blueAlertActive = false;
-        float blueAlertDuration = 45.0f;  // 45 seconds to reach safe room
-        float blueAlertInterval = 180.0f;  // Every 3 minutes (180 seconds)
-        int blueRoomX = -1, blueRoomY = -1;  // Safe room coordinates
-        bool inSafeRoom = false;  // Is player currently in safe room
-        bool safeRoomLocked = false;  // Room locks after alert ends
-
-        // Hunter Phase - dark entities chase player after failed evacuation
-        bool hunterPhaseActive = false;
-        float hunterPhaseTimer = 0.0f;
-        float hunterPhaseDuration = 60.0f;  // 1 minute of terror!
-        std::vector<std::unique_ptr<Zombie>> hunters;  // Dark fast entities
-    };
-
     struct MenuState {
         GameState currentState = GameState::MENU;
         Difficulty difficulty = Difficulty::NORMAL;
@@ -373,11 +286,6 @@ namespace {
         bool codeError = false;  // Whether there was an error
     };
 
-    constexpr int INITIAL_ZOMBIE_COUNT = 15;  // Start with more zombies for bigger maze
-    constexpr int MIN_ZOMBIE_COUNT = 8;  // Spawn more when below this
-    constexpr int MAX_ZOMBIE_COUNT = 25;  // Don't spawn more than this
-    constexpr float SPAWN_CHECK_INTERVAL = 5.0f;  // Check every 5 seconds
-
     // Simple text rendering using rectangles
     void renderChar(SDL_Renderer* renderer, char c, int x, int y, int size) {
         // Simple 5x7 bitmap font patterns
@@ -687,6 +595,9 @@ namespace {
                 pixels[2][2] = true;
                 pixels[4][2] = true;
                 break;
+            case '.':
+                pixels[6][2] = true;
+                break;
             default:
                 break;
         }
@@ -709,38 +620,6 @@ namespace {
         }
     }
 
-    void applyDifficulty(PlayState& state, Difficulty difficulty) {
-        state.difficulty = difficulty;  // Store difficulty in PlayState
-
-        switch (difficulty) {
-            case Difficulty::EASY:
-                state.initialZombieCount = 10;
-                state.minZombieCount = 5;
-                state.maxZombieCount = 15;
-                state.zombieMaxHealth = 2;  // Easy: 2 hits to kill
-                break;
-            case Difficulty::NORMAL:
-                state.initialZombieCount = 15;
-                state.minZombieCount = 8;
-                state.maxZombieCount = 25;
-                state.zombieMaxHealth = 3;  // Normal: 3 hits to kill
-                break;
-            case Difficulty::HARD:
-                state.initialZombieCount = 20;
-                state.minZombieCount = 12;
-                state.maxZombieCount = 35;
-                state.zombieMaxHealth = 5;  // Hard: 5 hits to kill
-                break;
-            case Difficulty::TESTING:
-                state.initialZombieCount = 2;
-                state.minZombieCount = 0;
-                state.maxZombieCount = 5;
-                state.zombieMaxHealth = 1;  // Testing: 1 hit to kill
-                // Weapon setup happens AFTER player is created (see initializeGame)
-                break;
-        }
-    }
-
     void renderMainMenu(SDL_Renderer* renderer, const MenuState& menu) {
         // Title box
         SDL_Rect titleBox = {Game::SCREEN_WIDTH/2 - 200, 100, 400, 80};
@@ -1097,1403 +976,6 @@ namespace {
         renderText(renderer, "W S ARROWS   ENTER", Game::SCREEN_WIDTH/2 - 108, 580, 2);
     }
 
-    // Check if there's a clear line of sight between two points (no walls in between)
-    bool hasLineOfSight(const Maze* maze, float x1, float y1, float x2, float y2) {
-        float dx = x2 - x1;
-        float dy = y2 - y1;
-        float distance = std::sqrt(dx * dx + dy * dy);
-
-        // Normalize direction
-        dx /= distance;
-        dy /= distance;
-
-        // Step along the ray and check for walls
-        float step = 5.0f;  // Check every 5 units
-        for (float t = 0; t < distance; t += step) {
-            float checkX = x1 + dx * t;
-            float checkY = y1 + dy * t;
-
-            int tileX = static_cast<int>(checkX / Maze::TILE_SIZE);
-            int tileY = static_cast<int>(checkY / Maze::TILE_SIZE);
-
-            if (maze->isWall(tileX, tileY)) {
-                return false;  // Wall found, no line of sight
-            }
-        }
-
-        return true;  // No walls found, clear line of sight
-    }
-
-    void renderFirstPersonView(SDL_Renderer* renderer, const PlayState& state) {
-        // Guard against null player (game not initialized yet)
-        if (!state.player) {
-            // Render black screen if player not initialized
-            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-            SDL_RenderClear(renderer);
-            return;
-        }
-
-        const int SCREEN_WIDTH = Game::SCREEN_WIDTH;
-        const int SCREEN_HEIGHT = Game::SCREEN_HEIGHT;
-        const float FOV = 75.0f * M_PI / 180.0f;  // 75 degree field of view - wider for better visibility
-        const int NUM_RAYS = SCREEN_WIDTH;
-
-        float playerX = state.player->getX();
-        float playerY = state.player->getY();
-        float playerAngle = state.player->getAngle();
-        float playerPitch = state.player->getPitch();
-
-        // Apply screen shake to camera angle
-        float shakeAngle = state.screenShake * ((float)rand() / RAND_MAX - 0.5f) * 0.1f;
-        playerAngle += shakeAngle;
-
-        // Calculate pitch offset for vertical look
-        int pitchOffset = static_cast<int>(playerPitch * SCREEN_HEIGHT * 1.5f);
-
-        // Render ceiling with dark, oppressive gradient (very dark)
-        // Ceiling extends from top of screen to horizon (adjusted by pitch)
-        int horizonLine = SCREEN_HEIGHT / 2 + pitchOffset;
-        for (int y = 0; y < horizonLine && y < SCREEN_HEIGHT; y++) {
-            float gradient = (float)y / (horizonLine > 0 ? horizonLine : 1);
-            int r = 5 + (int)(5 * gradient);
-            int g = 5 + (int)(5 * gradient);
-            int b = 10 + (int)(5 * gradient);
-            SDL_SetRenderDrawColor(renderer, r, g, b, 255);
-            SDL_RenderDrawLine(renderer, 0, y, SCREEN_WIDTH, y);
-        }
-
-        // Render floor with very dark gradient (almost black)
-        // Floor extends from horizon to bottom of screen
-        // Note: Blue safe room visible via blue walls only (floor raycasting was too slow)
-        for (int y = horizonLine; y < SCREEN_HEIGHT; y++) {
-            if (y < 0) continue;
-            float gradient = (float)(y - horizonLine) / ((SCREEN_HEIGHT - horizonLine) > 0 ? (SCREEN_HEIGHT - horizonLine) : 1);
-            int baseColor = 3 + (int)(8 * gradient);
-            SDL_SetRenderDrawColor(renderer, baseColor, baseColor, baseColor - 2, 255);
-            SDL_RenderDrawLine(renderer, 0, y, SCREEN_WIDTH, y);
-        }
-
-        // Cast rays for each column of the screen
-        for (int x = 0; x < NUM_RAYS; x++) {
-            // Calculate ray angle
-            float rayAngle = playerAngle - (FOV / 2.0f) + (static_cast<float>(x) / NUM_RAYS) * FOV;
-
-            float rayDirX = std::cos(rayAngle);
-            float rayDirY = std::sin(rayAngle);
-
-            // DDA raycasting
-            float rayX = playerX;
-            float rayY = playerY;
-            float deltaX = std::abs(1.0f / rayDirX);
-            float deltaY = std::abs(1.0f / rayDirY);
-
-            int mapX = static_cast<int>(rayX / Maze::TILE_SIZE);
-            int mapY = static_cast<int>(rayY / Maze::TILE_SIZE);
-
-            int stepX = (rayDirX > 0) ? 1 : -1;
-            int stepY = (rayDirY > 0) ? 1 : -1;
-
-            float sideDistX = (rayDirX > 0) ? ((mapX + 1) * Maze::TILE_SIZE - rayX) / Maze::TILE_SIZE * deltaX
-                                             : (rayX - mapX * Maze::TILE_SIZE) / Maze::TILE_SIZE * deltaX;
-            float sideDistY = (rayDirY > 0) ? ((mapY + 1) * Maze::TILE_SIZE - rayY) / Maze::TILE_SIZE * deltaY
-                                             : (rayY - mapY * Maze::TILE_SIZE) / Maze::TILE_SIZE * deltaY;
-
-            bool hit = false;
-            int side = 0;  // 0 = vertical wall, 1 = horizontal wall
-            float perpWallDist = 0.0f;
-            bool isSafeRoomWall = false;  // Track if we hit a safe room wall
-
-            // DDA algorithm
-            while (!hit && perpWallDist < 2000.0f) {
-                if (sideDistX < sideDistY) {
-                    sideDistX += deltaX;
-                    mapX += stepX;
-                    side = 0;
-                } else {
-                    sideDistY += deltaY;
-                    mapY += stepY;
-                    side = 1;
-                }
-
-                if (state.maze->isWall(mapX, mapY)) {
-                    hit = true;
-                    // Check if this is a safe room wall (but locked safe rooms act as walls)
-                    isSafeRoomWall = state.maze->isSafeRoom(mapX, mapY) && !state.safeRoomLocked;
-                }
-            }
-
-            // Calculate perpendicular wall distance
-            if (side == 0) {
-                perpWallDist = (mapX * Maze::TILE_SIZE - rayX + (1 - stepX) * Maze::TILE_SIZE / 2) / rayDirX;
-            } else {
-                perpWallDist = (mapY * Maze::TILE_SIZE - rayY + (1 - stepY) * Maze::TILE_SIZE / 2) / rayDirY;
-            }
-
-            // Calculate wall height on screen
-            int wallHeight = (int)(SCREEN_HEIGHT / (perpWallDist + 0.1f) * Maze::TILE_SIZE);
-
-            // Apply pitch offset for vertical look
-            int drawStart = SCREEN_HEIGHT / 2 - wallHeight / 2 + pitchOffset;
-            int drawEnd = SCREEN_HEIGHT / 2 + wallHeight / 2 + pitchOffset;
-
-            if (drawStart < 0) drawStart = 0;
-            if (drawEnd >= SCREEN_HEIGHT) drawEnd = SCREEN_HEIGHT - 1;
-
-            // Color based on wall type, side, and distance
-            int baseColor, colorR, colorG, colorB;
-            float distanceFade = std::max(0.0f, 1.0f - perpWallDist / 400.0f);  // Fog falloff
-            distanceFade = distanceFade * distanceFade;  // Square it for exponential falloff
-
-            if (isSafeRoomWall) {
-                // BLUE SAFE ROOM WALLS - bright and glowing
-                int blueBase = side == 0 ? 180 : 150;  // Brighter blue for safe room
-                colorR = static_cast<int>(50 * distanceFade);   // Low red
-                colorG = static_cast<int>(120 * distanceFade);  // Medium green
-                colorB = static_cast<int>(blueBase * distanceFade);  // High blue
-
-                // Add pulsing glow effect to safe room
-                float pulseAmount = 0.5f + 0.5f * std::sin(SDL_GetTicks() * 0.003f);
-                colorB = std::min(255, static_cast<int>(colorB * (1.0f + 0.3f * pulseAmount)));
-            } else {
-                // Normal walls - dark and creepy
-                baseColor = side == 0 ? 35 : 25;  // Very dark gray/brown walls
-                int color = static_cast<int>(baseColor * distanceFade);
-
-                // Add subtle texture variation based on wall position (blood stains, decay)
-                int colorVariation = ((mapX * 7 + mapY * 13) % 8) - 4;
-                color = std::max(0, std::min(255, color + colorVariation));
-
-                // Add eerie red tint to some walls (blood stained)
-                int redTint = ((mapX * 11 + mapY * 17) % 20) > 15 ? 10 : 0;
-
-                colorR = color + redTint;
-                colorG = color * 0.8f;
-                colorB = color * 0.8f;
-            }
-
-            // Calculate texture coordinate for brick pattern
-            float wallX;
-            if (side == 0) {
-                wallX = rayY + perpWallDist * rayDirY;
-            } else {
-                wallX = rayX + perpWallDist * rayDirX;
-            }
-            wallX -= std::floor(wallX);
-
-            // Draw main wall column
-            SDL_SetRenderDrawColor(renderer, colorR, colorG, colorB, 255);
-            SDL_RenderDrawLine(renderer, x, drawStart, x, drawEnd);
-
-            int wallHeightPx = drawEnd - drawStart;
-
-            if (isSafeRoomWall) {
-                // Safe room gets glowing highlights instead of bricks
-                // Add bright vertical highlights to make it glow
-                if (((int)(wallX * 8) % 2) == 0) {  // Vertical glow lines
-                    for (int y = drawStart; y < drawEnd; y += 2) {
-                        SDL_SetRenderDrawColor(renderer,
-                            std::min(255, colorR + 30),
-                            std::min(255, colorG + 50),
-                            std::min(255, colorB + 60),
-                            255);
-                        SDL_RenderDrawPoint(renderer, x, y);
-                    }
-                }
-            } else {
-                // Normal walls get brick pattern and blood
-                // Draw optimized brick pattern (horizontal mortar lines) - darker mortar
-                int brickRows = 6;
-                for (int i = 1; i < brickRows; i++) {
-                    int mortarY = drawStart + (wallHeightPx * i) / brickRows;
-                    if (mortarY >= drawStart && mortarY < drawEnd) {
-                        SDL_SetRenderDrawColor(renderer, colorR * 0.3f, colorG * 0.3f, colorB * 0.3f, 255);
-                        SDL_RenderDrawPoint(renderer, x, mortarY);
-                    }
-                }
-
-                // Draw vertical mortar lines based on texture coordinate - darker
-                int brickCol = (int)(wallX * 4);  // 4 bricks horizontally
-                if ((wallX * 4.0f - brickCol) < 0.1f) {  // Vertical mortar
-                    for (int y = drawStart; y < drawEnd; y += 3) {  // Every 3rd pixel for performance
-                        SDL_SetRenderDrawColor(renderer, colorR * 0.3f, colorG * 0.3f, colorB * 0.3f, 255);
-                        SDL_RenderDrawPoint(renderer, x, y);
-                    }
-                }
-
-                // Add creepy blood drips on some walls
-                int redTint = ((mapX * 11 + mapY * 17) % 20) > 15 ? 10 : 0;
-                if (redTint > 0 && wallHeightPx > 30) {
-                    int dripY = drawStart + wallHeightPx / 3;
-                    SDL_SetRenderDrawColor(renderer, 60, 10, 10, static_cast<int>(200 * distanceFade));
-                    SDL_RenderDrawPoint(renderer, x, dripY);
-                    SDL_RenderDrawPoint(renderer, x, dripY + 1);
-                }
-            }
-        }
-
-        // Render sprites (zombies, keys, weapons, bullets) in 3D
-        // Collect all visible sprites with distance
-        struct Sprite {
-            float x, y;
-            float distance;
-            int type;  // 0=zombie, 1=key, 2=weapon, 3=bullet, 4=exit
-            SDL_Color color;
-            const Zombie* zombie;  // Pointer to zombie for health bar rendering
-            int health;
-            int maxHealth;
-        };
-        std::vector<Sprite> sprites;
-
-        // Add zombies
-        for (const auto& zombie : state.zombies) {
-            if (!zombie->isDead()) {
-                float dx = zombie->getX() - playerX;
-                float dy = zombie->getY() - playerY;
-                float distance = std::sqrt(dx * dx + dy * dy);
-
-                // Check line-of-sight for all zombies (no wall-hacking)
-                if (distance < 2000.0f && hasLineOfSight(state.maze.get(), playerX, playerY, zombie->getX(), zombie->getY())) {
-                    sprites.push_back({zombie->getX(), zombie->getY(), distance, 0, {100, 255, 100, 255},
-                                     zombie.get(), zombie->getHealth(), zombie->getMaxHealth()});  // Store zombie pointer and health
-                }
-            }
-        }
-
-        // Add hunters (scary dark entities with red eyes)
-        for (const auto& hunter : state.hunters) {
-            if (!hunter->isDead()) {
-                float dx = hunter->getX() - playerX;
-                float dy = hunter->getY() - playerY;
-                float distance = std::sqrt(dx * dx + dy * dy);
-
-                // Hunters need line-of-sight (can't see through walls)
-                if (distance < 2000.0f && hasLineOfSight(state.maze.get(), playerX, playerY, hunter->getX(), hunter->getY())) {
-                    sprites.push_back({hunter->getX(), hunter->getY(), distance, 0, {30, 30, 35, 255},  // Very dark gray/black
-                                     hunter.get(), hunter->getHealth(), hunter->getMaxHealth()});
-                }
-            }
-        }
-
-        // Add bullets
-        for (const auto& bullet : state.bullets) {
-            if (bullet->isActive()) {
-                float dx = bullet->getX() - playerX;
-                float dy = bullet->getY() - playerY;
-                float distance = std::sqrt(dx * dx + dy * dy);
-                if (distance < 1000.0f) {
-                    sprites.push_back({bullet->getX(), bullet->getY(), distance, 3, {255, 255, 100, 255}, nullptr, 0, 0});
-                }
-            }
-        }
-
-        // Add keys
-        for (const auto& key : state.keys) {
-            if (!key->isCollected()) {
-                float dx = key->getX() - playerX;
-                float dy = key->getY() - playerY;
-                float distance = std::sqrt(dx * dx + dy * dy);
-                if (distance < 1000.0f && hasLineOfSight(state.maze.get(), playerX, playerY, key->getX(), key->getY())) {
-                    sprites.push_back({key->getX(), key->getY(), distance, 1, {255, 255, 0, 255}, nullptr, 0, 0});
-                }
-            }
-        }
-
-        // Add weapon pickups
-        for (const auto& weapon : state.weaponPickups) {
-            if (!weapon->isCollected()) {
-                float dx = weapon->getX() - playerX;
-                float dy = weapon->getY() - playerY;
-                float distance = std::sqrt(dx * dx + dy * dy);
-                if (distance < 1000.0f && hasLineOfSight(state.maze.get(), playerX, playerY, weapon->getX(), weapon->getY())) {
-                    sprites.push_back({weapon->getX(), weapon->getY(), distance, 2,
-                        weapon->getIsAmmo() ? SDL_Color{255, 200, 50, 255} : SDL_Color{100, 200, 255, 255}, nullptr, 0, 0});
-                }
-            }
-        }
-
-        // Add health boosts
-        for (const auto& healthBoost : state.healthBoosts) {
-            if (!healthBoost->isCollected()) {
-                float dx = healthBoost->getX() - playerX;
-                float dy = healthBoost->getY() - playerY;
-                float distance = std::sqrt(dx * dx + dy * dy);
-                if (distance < 1000.0f && hasLineOfSight(state.maze.get(), playerX, playerY, healthBoost->getX(), healthBoost->getY())) {
-                    sprites.push_back({healthBoost->getX(), healthBoost->getY(), distance, 5, {255, 50, 50, 255}, nullptr, 0, 0});
-                }
-            }
-        }
-
-        // Add exit door
-        Vec2 exitPos = state.maze->getExitPos();
-        float exitDx = exitPos.x - playerX;
-        float exitDy = exitPos.y - playerY;
-        float exitDistance = std::sqrt(exitDx * exitDx + exitDy * exitDy);
-        if (exitDistance < 2000.0f && hasLineOfSight(state.maze.get(), playerX, playerY, exitPos.x, exitPos.y)) {
-            sprites.push_back({exitPos.x, exitPos.y, exitDistance, 4, {0, 255, 0, 255}, nullptr, 0, 0});
-        }
-
-        // Sort sprites by distance (back to front)
-        std::sort(sprites.begin(), sprites.end(), [](const Sprite& a, const Sprite& b) {
-            return a.distance > b.distance;
-        });
-
-        // Calculate elapsed time for highlighting (10+ mins for keys, 12+ mins for exit)
-        Uint32 currentTime = SDL_GetTicks();
-        float elapsedMinutes = (currentTime - state.gameStartTime) / 60000.0f;
-        bool highlightKeys = elapsedMinutes >= 10.0f;
-        bool highlightExit = elapsedMinutes >= 12.0f;
-
-        // Render sprites
-        for (const auto& sprite : sprites) {
-            // Calculate sprite position relative to player
-            float dx = sprite.x - playerX;
-            float dy = sprite.y - playerY;
-
-            // Transform to camera space
-            float invDet = 1.0f / (std::cos(playerAngle + M_PI/2) * std::sin(playerAngle) -
-                                   std::sin(playerAngle + M_PI/2) * std::cos(playerAngle));
-            float transformX = invDet * (std::sin(playerAngle) * dx - std::cos(playerAngle) * dy);
-            float transformY = invDet * (-std::sin(playerAngle + M_PI/2) * dx + std::cos(playerAngle + M_PI/2) * dy);
-
-            // Skip if behind player
-            if (transformY <= 0.1f) continue;
-
-            // Calculate screen position
-            int spriteScreenX = static_cast<int>((SCREEN_WIDTH / 2) * (1 + transformX / transformY / std::tan(FOV/2)));
-
-            // Calculate sprite size (zombies are ENORMOUS, keys are 10x normal)
-            float heightMultiplier, widthMultiplier;
-
-            // Hunters (dark entities) are TALL and THIN like Endermen
-            if (sprite.type == 0 && sprite.color.r < 50 && sprite.color.g < 50 && sprite.color.b < 50) {
-                heightMultiplier = 35.0f;  // VERY tall like Enderman
-                widthMultiplier = 8.0f;    // Thin/narrow
-            } else if (sprite.type == 0) {
-                heightMultiplier = 20.0f;  // Zombies normal size
-                widthMultiplier = 20.0f;
-            } else if (sprite.type == 1) {
-                heightMultiplier = 5.0f;  // Keys
-                widthMultiplier = 5.0f;
-            } else if (sprite.type == 2) {
-                heightMultiplier = 5.0f;  // Weapon pickups
-                widthMultiplier = 5.0f;
-            } else if (sprite.type == 4) {
-                heightMultiplier = 5.0f;  // Exit door
-                widthMultiplier = 5.0f;
-            } else if (sprite.type == 5) {
-                heightMultiplier = 5.0f;  // Health boosts
-                widthMultiplier = 5.0f;
-            } else {
-                heightMultiplier = 0.5f;  // Other sprites
-                widthMultiplier = 0.5f;
-            }
-            int spriteHeight = static_cast<int>(SCREEN_HEIGHT / transformY * heightMultiplier);
-            int spriteWidth = static_cast<int>(SCREEN_HEIGHT / transformY * widthMultiplier);
-
-            // Apply pitch offset for vertical look
-            int drawStartY = SCREEN_HEIGHT / 2 - spriteHeight / 2 + pitchOffset;
-            int drawEndY = SCREEN_HEIGHT / 2 + spriteHeight / 2 + pitchOffset;
-            int drawStartX = spriteScreenX - spriteWidth / 2;
-            int drawEndX = spriteScreenX + spriteWidth / 2;
-
-            // Clamp to screen
-            if (drawStartX < 0) drawStartX = 0;
-            if (drawEndX >= SCREEN_WIDTH) drawEndX = SCREEN_WIDTH - 1;
-            if (drawStartY < 0) drawStartY = 0;
-            if (drawEndY >= SCREEN_HEIGHT) drawEndY = SCREEN_HEIGHT - 1;
-
-            int width = drawEndX - drawStartX;
-            int height = drawEndY - drawStartY;
-
-            // === DISTANCE-BASED FOG ON SPRITES ===
-            // Calculate fog intensity based on distance
-            float spriteFogFactor = sprite.distance / 400.0f;  // 0 = close, 1+ = far
-            spriteFogFactor = std::min(1.0f, spriteFogFactor);
-            int fogOverlayAlpha = static_cast<int>(spriteFogFactor * spriteFogFactor * 180);  // Exponential
-
-            // Check if this is a hunter (dark entity)
-            bool isHunter = (sprite.type == 0 && sprite.color.r < 50 && sprite.color.g < 50 && sprite.color.b < 50);
-
-            if (isHunter) {
-                // === HUNTER - SHADOWY ENDERMAN ===
-                // Pure dark shadowy silhouette - no body parts, just darkness with eyes
-
-                // Main shadow body - very dark, slightly transparent for gloomy effect
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-                SDL_Rect hunterBody = {drawStartX, drawStartY, width, height};
-                SDL_SetRenderDrawColor(renderer, 15, 15, 20, 240);  // Very dark, slightly transparent
-                SDL_RenderFillRect(renderer, &hunterBody);
-
-                // Add darker gradient from top to bottom for depth
-                for (int i = 0; i < height / 3; i++) {
-                    int alpha = 240 - (i * 2);
-                    SDL_Rect gradientSlice = {drawStartX, drawStartY + i, width, 1};
-                    SDL_SetRenderDrawColor(renderer, 10, 10, 15, alpha);
-                    SDL_RenderFillRect(renderer, &gradientSlice);
-                }
-
-                // Shadowy aura around the hunter
-                SDL_Rect aura1 = {drawStartX - 4, drawStartY - 4, width + 8, height + 8};
-                SDL_SetRenderDrawColor(renderer, 5, 5, 10, 60);
-                SDL_RenderFillRect(renderer, &aura1);
-
-                SDL_Rect aura2 = {drawStartX - 2, drawStartY - 2, width + 4, height + 4};
-                SDL_SetRenderDrawColor(renderer, 8, 8, 12, 100);
-                SDL_RenderFillRect(renderer, &aura2);
-
-                // === GLOWING EYES - THE ONLY BRIGHT FEATURE ===
-                int eyeSize = std::max(5, width / 3);
-                int eyeY = drawStartY + height / 5;  // High on the head
-                int eyeSpacing = width / 5;
-
-                // Left eye - intense red/white glow (multiple layers)
-                SDL_Rect leftEyeGlow1 = {drawStartX + width/2 - eyeSpacing - eyeSize - 5, eyeY - 5, eyeSize + 10, eyeSize + 10};
-                SDL_SetRenderDrawColor(renderer, 255, 30, 30, 80);
-                SDL_RenderFillRect(renderer, &leftEyeGlow1);
-
-                SDL_Rect leftEyeGlow2 = {drawStartX + width/2 - eyeSpacing - eyeSize - 2, eyeY - 2, eyeSize + 4, eyeSize + 4};
-                SDL_SetRenderDrawColor(renderer, 255, 60, 60, 160);
-                SDL_RenderFillRect(renderer, &leftEyeGlow2);
-
-                SDL_Rect leftEye = {drawStartX + width/2 - eyeSpacing - eyeSize/2, eyeY, eyeSize, eyeSize};
-                SDL_SetRenderDrawColor(renderer, 255, 230, 230, 255);  // Bright white/red core
-                SDL_RenderFillRect(renderer, &leftEye);
-
-                // Right eye - intense red/white glow
-                SDL_Rect rightEyeGlow1 = {drawStartX + width/2 + eyeSpacing - 5, eyeY - 5, eyeSize + 10, eyeSize + 10};
-                SDL_SetRenderDrawColor(renderer, 255, 30, 30, 80);
-                SDL_RenderFillRect(renderer, &rightEyeGlow1);
-
-                SDL_Rect rightEyeGlow2 = {drawStartX + width/2 + eyeSpacing - 2, eyeY - 2, eyeSize + 4, eyeSize + 4};
-                SDL_SetRenderDrawColor(renderer, 255, 60, 60, 160);
-                SDL_RenderFillRect(renderer, &rightEyeGlow2);
-
-                SDL_Rect rightEye = {drawStartX + width/2 + eyeSpacing - eyeSize/2, eyeY, eyeSize, eyeSize};
-                SDL_SetRenderDrawColor(renderer, 255, 230, 230, 255);  // Bright white/red core
-                SDL_RenderFillRect(renderer, &rightEye);
-
-                // Floating red particles around hunter for supernatural effect
-                Uint32 particleTime = SDL_GetTicks();
-                for (int i = 0; i < 3; i++) {
-                    float particlePhase = (particleTime / 500.0f) + i * 2.0f;
-                    int particleX = drawStartX + width/2 + static_cast<int>(std::sin(particlePhase) * width);
-                    int particleY = drawStartY + height/3 + static_cast<int>(std::cos(particlePhase * 1.3f) * height/2);
-                    SDL_Rect particle = {particleX, particleY, 3, 3};
-                    SDL_SetRenderDrawColor(renderer, 255, 50, 50, 180);
-                    SDL_RenderFillRect(renderer, &particle);
-                }
-
-                // Reset blend mode
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-
-            } else if (sprite.type == 0) {
-                // === WALKING ANIMATION ===
-                // Create bobbing/swaying motion based on time and zombie position
-                Uint32 animTime = SDL_GetTicks();
-                float animPhase = (animTime / 300.0f) + (sprite.x + sprite.y) / 100.0f;  // Each zombie slightly offset
-                float bobAmount = std::sin(animPhase) * (height / 40.0f);  // Vertical bob
-                float swayAmount = std::cos(animPhase * 0.5f) * (width / 30.0f);  // Horizontal sway
-
-                // === DETERMINE ZOMBIE VIEW ANGLE ===
-                // Calculate angle from player to zombie
-                float angleToZombie = std::atan2(sprite.y - playerY, sprite.x - playerX);
-                // Get zombie's facing direction
-                float zombieFacing = sprite.zombie->getFacingAngle();
-                // Calculate relative angle (what angle player sees zombie from, relative to zombie's facing)
-                float relativeAngle = angleToZombie - zombieFacing;
-                // Normalize to -PI to PI range
-                while (relativeAngle > M_PI) relativeAngle -= 2.0f * M_PI;
-                while (relativeAngle < -M_PI) relativeAngle += 2.0f * M_PI;
-
-                // Determine view: 0=front, 1=left, 2=back, 3=right
-                int zombieView = 0;
-                float absAngle = std::abs(relativeAngle);
-                if (absAngle < M_PI / 4.0f) {
-                    zombieView = 0;  // Front view (facing player)
-                } else if (absAngle > 3.0f * M_PI / 4.0f) {
-                    zombieView = 2;  // Back view (facing away)
-                } else if (relativeAngle > 0) {
-                    zombieView = 1;  // Left side view
-                } else {
-                    zombieView = 3;  // Right side view
-                }
-
-                // === ZOMBIE HEAD - Humanoid with 3D shading ===
-                int headSize = height / 4;
-                int headX = drawStartX + width / 2 - headSize / 2 + static_cast<int>(swayAmount);
-                int headY = drawStartY + static_cast<int>(bobAmount);
-
-                // Head base (dark decayed color)
-                SDL_Rect head = {headX, headY, headSize, headSize};
-                SDL_SetRenderDrawColor(renderer, 45, 65, 45, 255);
-                SDL_RenderFillRect(renderer, &head);
-
-                // 3D shading - light from top-left
-                SDL_Rect headHighlight = {headX, headY, headSize*2/3, headSize/2};
-                SDL_SetRenderDrawColor(renderer, 60, 80, 60, 255);  // Lighter
-                SDL_RenderFillRect(renderer, &headHighlight);
-
-                SDL_Rect headShadow = {headX + headSize/2, headY + headSize/2, headSize/2, headSize/2};
-                SDL_SetRenderDrawColor(renderer, 30, 50, 30, 255);  // Darker
-                SDL_RenderFillRect(renderer, &headShadow);
-
-                // === ZOMBIE FACE ===
-                // EXPOSED BONE/SKULL patches (terrifying!)
-                SDL_Rect bone1 = {headX + headSize/6, headY + headSize/8, headSize/4, headSize/5};
-                SDL_Rect bone2 = {headX + 2*headSize/3, headY + headSize/3, headSize/5, headSize/4};
-                SDL_SetRenderDrawColor(renderer, 200, 200, 190, 255);  // Bone white
-                SDL_RenderFillRect(renderer, &bone1);
-                SDL_RenderFillRect(renderer, &bone2);
-
-                // === RENDER FEATURES BASED ON VIEW ===
-                if (zombieView == 0) {
-                    // FRONT VIEW - Show both eyes and mouth
-                    int eyeY = headY + headSize/3;
-                    int eyeSize = headSize/6;
-
-                    // Left eye - glowing red
-                    SDL_Rect leftEyeSocket = {headX + headSize/5, eyeY, eyeSize, eyeSize};
-                    SDL_SetRenderDrawColor(renderer, 10, 10, 10, 255);  // Dark socket
-                    SDL_RenderFillRect(renderer, &leftEyeSocket);
-
-                    SDL_Rect leftEyeGlow = {headX + headSize/5 + eyeSize/4, eyeY + eyeSize/4, eyeSize/2, eyeSize/2};
-                    SDL_SetRenderDrawColor(renderer, 255, 20, 20, 255);  // Bright red
-                    SDL_RenderFillRect(renderer, &leftEyeGlow);
-
-                    // Right eye - glowing red
-                    SDL_Rect rightEyeSocket = {headX + 3*headSize/5, eyeY, eyeSize, eyeSize};
-                    SDL_SetRenderDrawColor(renderer, 10, 10, 10, 255);  // Dark socket
-                    SDL_RenderFillRect(renderer, &rightEyeSocket);
-
-                    SDL_Rect rightEyeGlow = {headX + 3*headSize/5 + eyeSize/4, eyeY + eyeSize/4, eyeSize/2, eyeSize/2};
-                    SDL_SetRenderDrawColor(renderer, 255, 20, 20, 255);  // Bright red
-                    SDL_RenderFillRect(renderer, &rightEyeGlow);
-
-                    // Mouth
-                    SDL_Rect mouth = {headX + headSize/3, headY + 2*headSize/3, headSize/3, headSize/8};
-                    SDL_SetRenderDrawColor(renderer, 15, 5, 5, 255);  // Dark open mouth
-                    SDL_RenderFillRect(renderer, &mouth);
-
-                } else if (zombieView == 1) {
-                    // LEFT SIDE VIEW - Show one eye on left side
-                    int eyeY = headY + headSize/3;
-                    int eyeSize = headSize/6;
-
-                    SDL_Rect sideEyeSocket = {headX + headSize/8, eyeY, eyeSize, eyeSize};
-                    SDL_SetRenderDrawColor(renderer, 10, 10, 10, 255);
-                    SDL_RenderFillRect(renderer, &sideEyeSocket);
-
-                    SDL_Rect sideEyeGlow = {headX + headSize/8 + eyeSize/4, eyeY + eyeSize/4, eyeSize/2, eyeSize/2};
-                    SDL_SetRenderDrawColor(renderer, 255, 20, 20, 255);
-                    SDL_RenderFillRect(renderer, &sideEyeGlow);
-
-                    // Side mouth
-                    SDL_Rect sideMouth = {headX + headSize/8, headY + 2*headSize/3, headSize/4, headSize/8};
-                    SDL_SetRenderDrawColor(renderer, 15, 5, 5, 255);
-                    SDL_RenderFillRect(renderer, &sideMouth);
-
-                } else if (zombieView == 3) {
-                    // RIGHT SIDE VIEW - Show one eye on right side
-                    int eyeY = headY + headSize/3;
-                    int eyeSize = headSize/6;
-
-                    SDL_Rect sideEyeSocket = {headX + 5*headSize/8, eyeY, eyeSize, eyeSize};
-                    SDL_SetRenderDrawColor(renderer, 10, 10, 10, 255);
-                    SDL_RenderFillRect(renderer, &sideEyeSocket);
-
-                    SDL_Rect sideEyeGlow = {headX + 5*headSize/8 + eyeSize/4, eyeY + eyeSize/4, eyeSize/2, eyeSize/2};
-                    SDL_SetRenderDrawColor(renderer, 255, 20, 20, 255);
-                    SDL_RenderFillRect(renderer, &sideEyeGlow);
-
-                    // Side mouth
-                    SDL_Rect sideMouth = {headX + 5*headSize/8, headY + 2*headSize/3, headSize/4, headSize/8};
-                    SDL_SetRenderDrawColor(renderer, 15, 5, 5, 255);
-                    SDL_RenderFillRect(renderer, &sideMouth);
-
-                } else {
-                    // BACK VIEW (zombieView == 2) - No eyes or mouth visible, show back of head
-                    // Add some detail to back of head (maybe hair/damage)
-                    SDL_Rect backDetail1 = {headX + headSize/4, headY + headSize/4, headSize/2, headSize/6};
-                    SDL_SetRenderDrawColor(renderer, 30, 45, 30, 255);  // Darker detail
-                    SDL_RenderFillRect(renderer, &backDetail1);
-
-                    SDL_Rect backDetail2 = {headX + headSize/3, headY + headSize/2, headSize/3, headSize/6};
-                    SDL_SetRenderDrawColor(renderer, 35, 50, 35, 255);
-                    SDL_RenderFillRect(renderer, &backDetail2);
-                }
-
-                // === ZOMBIE BODY - Humanoid torso with 3D shading ===
-                int bodyWidth = width * 3 / 5;
-                int bodyHeight = height / 2;
-                int bodyX = drawStartX + width / 2 - bodyWidth / 2 + static_cast<int>(swayAmount * 0.7f);
-                int bodyY = drawStartY + headSize + static_cast<int>(bobAmount);
-
-                // Body base (dark decayed color)
-                SDL_Rect body = {bodyX, bodyY, bodyWidth, bodyHeight};
-                SDL_SetRenderDrawColor(renderer, 45, 65, 45, 255);
-                SDL_RenderFillRect(renderer, &body);
-
-                // 3D shading - light from top-left
-                SDL_Rect bodyHighlight = {bodyX, bodyY, bodyWidth*2/3, bodyHeight/2};
-                SDL_SetRenderDrawColor(renderer, 60, 80, 60, 255);  // Lighter
-                SDL_RenderFillRect(renderer, &bodyHighlight);
-
-                SDL_Rect bodyShadow = {bodyX + bodyWidth/3, bodyY + bodyHeight/2, bodyWidth*2/3, bodyHeight/2};
-                SDL_SetRenderDrawColor(renderer, 30, 50, 30, 255);  // Darker
-                SDL_RenderFillRect(renderer, &bodyShadow);
-
-                // Blood stains on body
-                SDL_Rect bloodStain1 = {bodyX + bodyWidth/4, bodyY + bodyHeight/4, bodyWidth/3, bodyHeight/3};
-                SDL_Rect bloodStain2 = {bodyX + bodyWidth/6, bodyY + bodyHeight/2, bodyWidth/3, bodyHeight/4};
-                SDL_SetRenderDrawColor(renderer, 100, 15, 15, 255);  // Dark blood
-                SDL_RenderFillRect(renderer, &bloodStain1);
-                SDL_RenderFillRect(renderer, &bloodStain2);
-
-                // === ZOMBIE ARMS - Simple with 3D shading ===
-                int armWidth = width / 6;
-                int armHeight = bodyHeight * 3 / 4;
-                float armSwing = std::sin(animPhase) * (width / 15.0f);  // Arm swing animation
-
-                // Left arm
-                int leftArmX = bodyX - armWidth + static_cast<int>(armSwing);
-                SDL_Rect leftArm = {leftArmX, bodyY + bodyHeight/6, armWidth, armHeight};
-                SDL_SetRenderDrawColor(renderer, 45, 65, 45, 255);
-                SDL_RenderFillRect(renderer, &leftArm);
-                // Left arm highlight (lighter on left side)
-                SDL_Rect leftArmHighlight = {leftArmX, bodyY + bodyHeight/6, armWidth/2, armHeight/2};
-                SDL_SetRenderDrawColor(renderer, 60, 80, 60, 255);
-                SDL_RenderFillRect(renderer, &leftArmHighlight);
-
-                // Right arm
-                int rightArmX = bodyX + bodyWidth - static_cast<int>(armSwing);
-                SDL_Rect rightArm = {rightArmX, bodyY + bodyHeight/6, armWidth, armHeight};
-                SDL_SetRenderDrawColor(renderer, 45, 65, 45, 255);
-                SDL_RenderFillRect(renderer, &rightArm);
-                // Right arm shadow (darker on right side)
-                SDL_Rect rightArmShadow = {rightArmX + armWidth/2, bodyY + bodyHeight/6 + armHeight/2, armWidth/2, armHeight/2};
-                SDL_SetRenderDrawColor(renderer, 30, 50, 30, 255);
-                SDL_RenderFillRect(renderer, &rightArmShadow);
-
-                // === ZOMBIE LEGS - Simple with 3D shading ===
-                int legWidth = bodyWidth / 3;
-                int legHeight = height / 3;
-                int legY = bodyY + bodyHeight;
-                float legOffset = std::sin(animPhase) * (width / 20.0f);  // Leg alternation
-
-                // Left leg
-                int leftLegX = bodyX + bodyWidth/6 + static_cast<int>(legOffset);
-                SDL_Rect leftLeg = {leftLegX, legY, legWidth, legHeight};
-                SDL_SetRenderDrawColor(renderer, 40, 60, 40, 255);
-                SDL_RenderFillRect(renderer, &leftLeg);
-                SDL_Rect leftLegHighlight = {leftLegX, legY, legWidth/2, legHeight/2};
-                SDL_SetRenderDrawColor(renderer, 55, 75, 55, 255);
-                SDL_RenderFillRect(renderer, &leftLegHighlight);
-
-                // Right leg
-                int rightLegX = bodyX + bodyWidth/2 - static_cast<int>(legOffset);
-                SDL_Rect rightLeg = {rightLegX, legY, legWidth, legHeight};
-                SDL_SetRenderDrawColor(renderer, 40, 60, 40, 255);
-                SDL_RenderFillRect(renderer, &rightLeg);
-                SDL_Rect rightLegShadow = {rightLegX + legWidth/2, legY + legHeight/2, legWidth/2, legHeight/2};
-                SDL_SetRenderDrawColor(renderer, 25, 45, 25, 255);
-                SDL_RenderFillRect(renderer, &rightLegShadow);
-
-                // === 3D DEPTH: LARGE SHADOW UNDER ZOMBIE ===
-                int shadowWidth = width + 10;
-                int shadowHeight = height / 8;
-                SDL_Rect zombieShadow = {drawStartX - 5, drawEndY - shadowHeight, shadowWidth, shadowHeight};
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-                SDL_SetRenderDrawColor(renderer, 0, 0, 0, 140);  // Dark shadow
-                SDL_RenderFillRect(renderer, &zombieShadow);
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-
-                // Zombies now rendered as humanoid with 3D perspective shading!
-
-                // === APPLY DISTANCE FOG TO ZOMBIE ===
-                if (fogOverlayAlpha > 0) {
-                    SDL_Rect zombieFog = {drawStartX, drawStartY, width, height};
-                    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-                    SDL_SetRenderDrawColor(renderer, 30, 30, 35, fogOverlayAlpha);
-                    SDL_RenderFillRect(renderer, &zombieFog);
-                    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-                }
-            } else if (sprite.type == 1) {
-                // Key - draw as big floating gold key
-                int keyHeadSize = width / 2;
-                int keyShaftWidth = width / 5;
-                int keyShaftHeight = height / 2;
-
-                int centerX = drawStartX + width / 2;
-                int centerY = drawStartY + height / 3;
-
-                // Add intense pulsing glow effect when highlighted (>10 min elapsed)
-                if (highlightKeys) {
-                    float pulseAmount = (std::sin(currentTime / 150.0f) + 1.0f) / 2.0f;  // Fast pulse 0-1
-                    int glowExpansion = static_cast<int>(pulseAmount * 30);
-
-                    // Outer glow layer (bright yellow/white)
-                    SDL_Rect outerGlow = {drawStartX - 20 - glowExpansion, drawStartY - 20 - glowExpansion,
-                                          width + 40 + glowExpansion * 2, height + 40 + glowExpansion * 2};
-                    SDL_SetRenderDrawColor(renderer, 255, 255, 100, static_cast<int>(60 + pulseAmount * 100));
-                    SDL_RenderFillRect(renderer, &outerGlow);
-
-                    // Middle glow layer
-                    SDL_Rect middleGlow = {drawStartX - 10 - glowExpansion/2, drawStartY - 10 - glowExpansion/2,
-                                           width + 20 + glowExpansion, height + 20 + glowExpansion};
-                    SDL_SetRenderDrawColor(renderer, 255, 255, 0, static_cast<int>(100 + pulseAmount * 120));
-                    SDL_RenderFillRect(renderer, &middleGlow);
-
-                    // Inner bright glow
-                    SDL_Rect innerGlow = {drawStartX - 5, drawStartY - 5, width + 10, height + 10};
-                    SDL_SetRenderDrawColor(renderer, 255, 255, 200, static_cast<int>(140 + pulseAmount * 115));
-                    SDL_RenderFillRect(renderer, &innerGlow);
-                }
-
-                // Key head (circular top)
-                SDL_Rect keyHead = {centerX - keyHeadSize/2, centerY - keyHeadSize/2, keyHeadSize, keyHeadSize};
-                SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255);  // Gold
-                SDL_RenderFillRect(renderer, &keyHead);
-
-                // Key head hole
-                int holeSize = keyHeadSize / 3;
-                SDL_Rect keyHole = {centerX - holeSize/2, centerY - holeSize/2, holeSize, holeSize};
-                SDL_SetRenderDrawColor(renderer, 40, 40, 50, 255);
-                SDL_RenderFillRect(renderer, &keyHole);
-
-                // Key shaft (vertical part)
-                SDL_Rect keyShaft = {centerX - keyShaftWidth/2, centerY + keyHeadSize/2, keyShaftWidth, keyShaftHeight};
-                SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255);  // Gold
-                SDL_RenderFillRect(renderer, &keyShaft);
-
-                // Key teeth (notches at bottom)
-                int toothWidth = keyShaftWidth * 2;
-                int toothHeight = height / 8;
-                SDL_Rect tooth1 = {centerX + keyShaftWidth/2, centerY + keyHeadSize/2 + keyShaftHeight/3, toothWidth, toothHeight};
-                SDL_Rect tooth2 = {centerX + keyShaftWidth/2, centerY + keyHeadSize/2 + 2*keyShaftHeight/3, toothWidth, toothHeight};
-                SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255);
-                SDL_RenderFillRect(renderer, &tooth1);
-                SDL_RenderFillRect(renderer, &tooth2);
-
-                // Gold highlights (shinier gold on edges)
-                SDL_Rect highlight1 = {centerX - keyHeadSize/4, centerY - keyHeadSize/4, keyHeadSize/3, keyHeadSize/3};
-                SDL_SetRenderDrawColor(renderer, 255, 245, 150, 255);
-                SDL_RenderFillRect(renderer, &highlight1);
-
-                // Dark outline
-                SDL_SetRenderDrawColor(renderer, 180, 150, 0, 255);
-                SDL_RenderDrawRect(renderer, &keyHead);
-                SDL_RenderDrawRect(renderer, &keyShaft);
-
-                // Normal glow effect around key (always visible)
-                SDL_Rect keyGlow = {drawStartX - 4, drawStartY - 4, width + 8, height + 8};
-                SDL_SetRenderDrawColor(renderer, 255, 255, 150, 100);
-                SDL_RenderDrawRect(renderer, &keyGlow);
-            } else if (sprite.type == 3) {
-                // Bullet - draw as bright projectile
-                int bulletSize = std::max(4, height / 4);
-                int bulletX = drawStartX + width / 2 - bulletSize / 2;
-                int bulletY = drawStartY + height / 2 - bulletSize / 2;
-
-                // Bright yellow bullet with glow
-                SDL_Rect bulletCore = {bulletX, bulletY, bulletSize, bulletSize};
-                SDL_SetRenderDrawColor(renderer, 255, 255, 150, 255);
-                SDL_RenderFillRect(renderer, &bulletCore);
-
-                // Glow effect
-                SDL_Rect bulletGlow = {bulletX - 2, bulletY - 2, bulletSize + 4, bulletSize + 4};
-                SDL_SetRenderDrawColor(renderer, 255, 200, 50, 180);
-                SDL_RenderDrawRect(renderer, &bulletGlow);
-            } else if (sprite.type == 4) {
-                // Exit door - draw as large glowing green door
-                int doorWidth = width;
-                int doorHeight = height;
-                int doorX = drawStartX;
-                int doorY = drawStartY;
-
-                // Add INTENSE pulsing glow effect when highlighted (>12 min elapsed)
-                if (highlightExit) {
-                    float pulseAmount = (std::sin(currentTime / 120.0f) + 1.0f) / 2.0f;  // Slower pulse 0-1
-                    int glowExpansion = static_cast<int>(pulseAmount * 40);
-
-                    // Outer glow layer (bright green/white beacon)
-                    SDL_Rect outerGlow = {doorX - 30 - glowExpansion, doorY - 30 - glowExpansion,
-                                          doorWidth + 60 + glowExpansion * 2, doorHeight + 60 + glowExpansion * 2};
-                    SDL_SetRenderDrawColor(renderer, 100, 255, 100, static_cast<int>(70 + pulseAmount * 120));
-                    SDL_RenderFillRect(renderer, &outerGlow);
-
-                    // Middle glow layer (intense green)
-                    SDL_Rect middleGlow = {doorX - 15 - glowExpansion/2, doorY - 15 - glowExpansion/2,
-                                           doorWidth + 30 + glowExpansion, doorHeight + 30 + glowExpansion};
-                    SDL_SetRenderDrawColor(renderer, 50, 255, 50, static_cast<int>(120 + pulseAmount * 135));
-                    SDL_RenderFillRect(renderer, &middleGlow);
-
-                    // Inner bright glow (nearly white)
-                    SDL_Rect innerGlow = {doorX - 8, doorY - 8, doorWidth + 16, doorHeight + 16};
-                    SDL_SetRenderDrawColor(renderer, 200, 255, 200, static_cast<int>(150 + pulseAmount * 105));
-                    SDL_RenderFillRect(renderer, &innerGlow);
-                }
-
-                // Door frame (dark green)
-                SDL_Rect doorFrame = {doorX, doorY, doorWidth, doorHeight};
-                SDL_SetRenderDrawColor(renderer, 0, 100, 0, 255);
-                SDL_RenderFillRect(renderer, &doorFrame);
-
-                // Door panels (brighter green)
-                int panelWidth = doorWidth / 2 - doorWidth / 10;
-                int panelHeight = doorHeight - doorHeight / 5;
-                SDL_Rect leftPanel = {doorX + doorWidth / 20, doorY + doorHeight / 10, panelWidth, panelHeight};
-                SDL_Rect rightPanel = {doorX + doorWidth / 2 + doorWidth / 20, doorY + doorHeight / 10, panelWidth, panelHeight};
-                SDL_SetRenderDrawColor(renderer, 50, 200, 50, 255);
-                SDL_RenderFillRect(renderer, &leftPanel);
-                SDL_RenderFillRect(renderer, &rightPanel);
-
-                // Door handles (gold)
-                int handleSize = doorWidth / 15;
-                SDL_Rect leftHandle = {doorX + doorWidth / 2 - handleSize - doorWidth / 10, doorY + doorHeight / 2 - handleSize, handleSize * 2, handleSize * 2};
-                SDL_Rect rightHandle = {doorX + doorWidth / 2 + doorWidth / 10 - handleSize, doorY + doorHeight / 2 - handleSize, handleSize * 2, handleSize * 2};
-                SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255);
-                SDL_RenderFillRect(renderer, &leftHandle);
-                SDL_RenderFillRect(renderer, &rightHandle);
-
-                // Glowing exit sign on top
-                int signWidth = doorWidth / 2;
-                int signHeight = doorHeight / 8;
-                SDL_Rect exitSign = {doorX + doorWidth / 4, doorY + doorHeight / 20, signWidth, signHeight};
-                SDL_SetRenderDrawColor(renderer, 100, 255, 100, 255);
-                SDL_RenderFillRect(renderer, &exitSign);
-
-                // Bright glow effect
-                SDL_Rect doorGlow1 = {doorX - 4, doorY - 4, doorWidth + 8, doorHeight + 8};
-                SDL_SetRenderDrawColor(renderer, 0, 255, 0, 150);
-                SDL_RenderDrawRect(renderer, &doorGlow1);
-                SDL_Rect doorGlow2 = {doorX - 8, doorY - 8, doorWidth + 16, doorHeight + 16};
-                SDL_SetRenderDrawColor(renderer, 0, 255, 0, 80);
-                SDL_RenderDrawRect(renderer, &doorGlow2);
-
-                // Dark outline for definition
-                SDL_SetRenderDrawColor(renderer, 0, 80, 0, 255);
-                SDL_RenderDrawRect(renderer, &doorFrame);
-            } else if (sprite.type == 5) {
-                // Health boost - draw as first aid kit with red cross
-                int boxWidth = width;
-                int boxHeight = height;
-                int boxX = drawStartX;
-                int boxY = drawStartY;
-
-                // White box background
-                SDL_Rect box = {boxX, boxY, boxWidth, boxHeight};
-                SDL_SetRenderDrawColor(renderer, 240, 240, 240, 255);
-                SDL_RenderFillRect(renderer, &box);
-
-                // Red cross - horizontal bar
-                int crossThickness = boxHeight / 5;
-                int crossLength = boxWidth * 3 / 4;
-                SDL_Rect horizBar = {boxX + (boxWidth - crossLength) / 2, boxY + boxHeight / 2 - crossThickness / 2, crossLength, crossThickness};
-                SDL_SetRenderDrawColor(renderer, 220, 20, 20, 255);
-                SDL_RenderFillRect(renderer, &horizBar);
-
-                // Red cross - vertical bar
-                SDL_Rect vertBar = {boxX + boxWidth / 2 - crossThickness / 2, boxY + (boxHeight - crossLength) / 2, crossThickness, crossLength};
-                SDL_SetRenderDrawColor(renderer, 220, 20, 20, 255);
-                SDL_RenderFillRect(renderer, &vertBar);
-
-                // Box border (dark red)
-                SDL_SetRenderDrawColor(renderer, 150, 20, 20, 255);
-                SDL_RenderDrawRect(renderer, &box);
-
-                // Add subtle glow effect
-                SDL_Rect glow = {boxX - 2, boxY - 2, boxWidth + 4, boxHeight + 4};
-                SDL_SetRenderDrawColor(renderer, 255, 100, 100, 120);
-                SDL_RenderDrawRect(renderer, &glow);
-            } else {
-                // Check if this is a hunter (tall, thin, dark Enderman-like entity)
-                bool isHunter = (sprite.type == 0 && sprite.color.r < 50 && sprite.color.g < 50 && sprite.color.b < 50);
-
-                if (isHunter) {
-                    // === HUNTER - ENDERMAN STYLE ===
-                    // Very dark, tall, thin body with subtle shading
-                    SDL_Rect hunterBody = {drawStartX, drawStartY, width, height};
-                    SDL_SetRenderDrawColor(renderer, 25, 25, 30, 255);  // Very dark gray/black
-                    SDL_RenderFillRect(renderer, &hunterBody);
-
-                    // Darker outline for depth
-                    SDL_SetRenderDrawColor(renderer, 10, 10, 15, 255);  // Nearly black outline
-                    SDL_RenderDrawRect(renderer, &hunterBody);
-
-                    // Subtle vertical highlights on edges (makes it look 3D)
-                    SDL_Rect leftEdge = {drawStartX + 1, drawStartY, 1, height};
-                    SDL_SetRenderDrawColor(renderer, 40, 40, 45, 255);
-                    SDL_RenderFillRect(renderer, &leftEdge);
-
-                    SDL_Rect rightEdge = {drawStartX + width - 2, drawStartY, 1, height};
-                    SDL_SetRenderDrawColor(renderer, 15, 15, 20, 255);
-                    SDL_RenderFillRect(renderer, &rightEdge);
-
-                    // === TERRIFYING GLOWING RED/WHITE EYES ===
-                    // Eyes positioned high on the body (like Enderman)
-                    int eyeSize = std::max(4, width / 3);  // Bigger eyes for thin face
-                    int eyeY = drawStartY + height / 6;  // High up on the head
-                    int eyeSpacing = width / 4;
-
-                    // Left eye - intense red glow
-                    SDL_Rect leftEyeGlow = {drawStartX + eyeSpacing - eyeSize - 3, eyeY - 3, eyeSize + 6, eyeSize + 6};
-                    SDL_SetRenderDrawColor(renderer, 255, 40, 40, 140);  // Strong red glow
-                    SDL_RenderFillRect(renderer, &leftEyeGlow);
-
-                    SDL_Rect leftEyeInner = {drawStartX + eyeSpacing - eyeSize - 1, eyeY - 1, eyeSize + 2, eyeSize + 2};
-                    SDL_SetRenderDrawColor(renderer, 255, 100, 100, 200);  // Medium glow
-                    SDL_RenderFillRect(renderer, &leftEyeInner);
-
-                    SDL_Rect leftEye = {drawStartX + eyeSpacing - eyeSize/2, eyeY, eyeSize, eyeSize};
-                    SDL_SetRenderDrawColor(renderer, 255, 220, 220, 255);  // Bright white/red core
-                    SDL_RenderFillRect(renderer, &leftEye);
-
-                    // Right eye - intense red glow
-                    SDL_Rect rightEyeGlow = {drawStartX + width - eyeSpacing - 3, eyeY - 3, eyeSize + 6, eyeSize + 6};
-                    SDL_SetRenderDrawColor(renderer, 255, 40, 40, 140);  // Strong red glow
-                    SDL_RenderFillRect(renderer, &rightEyeGlow);
-
-                    SDL_Rect rightEyeInner = {drawStartX + width - eyeSpacing - 1, eyeY - 1, eyeSize + 2, eyeSize + 2};
-                    SDL_SetRenderDrawColor(renderer, 255, 100, 100, 200);  // Medium glow
-                    SDL_RenderFillRect(renderer, &rightEyeInner);
-
-                    SDL_Rect rightEye = {drawStartX + width - eyeSpacing + eyeSize/2, eyeY, eyeSize, eyeSize};
-                    SDL_SetRenderDrawColor(renderer, 255, 220, 220, 255);  // Bright white/red core
-                    SDL_RenderFillRect(renderer, &rightEye);
-
-                    // Particle effect - small red dots floating around hunter
-                    if ((rand() % 3) == 0) {  // Random particles
-                        int particleX = drawStartX + (rand() % width);
-                        int particleY = drawStartY + (rand() % height);
-                        SDL_Rect particle = {particleX, particleY, 2, 2};
-                        SDL_SetRenderDrawColor(renderer, 255, 50, 50, 150);
-                        SDL_RenderFillRect(renderer, &particle);
-                    }
-                } else {
-                    // Weapons and other sprites - draw as colored rectangle
-                    SDL_Rect spriteRect = {drawStartX, drawStartY, width, height};
-                    SDL_SetRenderDrawColor(renderer, sprite.color.r, sprite.color.g, sprite.color.b, sprite.color.a);
-                    SDL_RenderFillRect(renderer, &spriteRect);
-
-                    // Draw darker outline
-                    SDL_SetRenderDrawColor(renderer, sprite.color.r/2, sprite.color.g/2, sprite.color.b/2, 255);
-                    SDL_RenderDrawRect(renderer, &spriteRect);
-                }
-            }
-
-            // Draw health bar above zombies
-            if (sprite.type == 0 && sprite.zombie != nullptr && sprite.maxHealth > 0) {
-                int barWidth = width;
-                int barHeight = 8;
-                int barX = drawStartX;
-                int barY = drawStartY - barHeight - 4;  // Position above zombie
-
-                // Background (dark red)
-                SDL_Rect barBg = {barX, barY, barWidth, barHeight};
-                SDL_SetRenderDrawColor(renderer, 60, 0, 0, 200);
-                SDL_RenderFillRect(renderer, &barBg);
-
-                // Health fill (red to green gradient based on health)
-                float healthPercent = static_cast<float>(sprite.health) / static_cast<float>(sprite.maxHealth);
-                int fillWidth = static_cast<int>(barWidth * healthPercent);
-                if (fillWidth > 0) {
-                    SDL_Rect barFill = {barX, barY, fillWidth, barHeight};
-                    // Color gradient: red (low health) to yellow (mid health) to green (full health)
-                    int r = healthPercent < 0.5f ? 255 : static_cast<int>(255 * (1.0f - (healthPercent - 0.5f) * 2.0f));
-                    int g = healthPercent < 0.5f ? static_cast<int>(255 * healthPercent * 2.0f) : 255;
-                    SDL_SetRenderDrawColor(renderer, r, g, 0, 220);
-                    SDL_RenderFillRect(renderer, &barFill);
-                }
-
-                // Border (white)
-                SDL_SetRenderDrawColor(renderer, 255, 255, 255, 200);
-                SDL_RenderDrawRect(renderer, &barBg);
-            }
-        }
-
-        // Render weapon in hands (Doom-style)
-        WeaponType currentWeapon = state.player->getCurrentWeapon();
-        int weaponWidth = 200;
-        int weaponHeight = 250;
-        int weaponX = (SCREEN_WIDTH - weaponWidth) / 2 + static_cast<int>(state.shakeOffsetX);
-        int weaponY = SCREEN_HEIGHT - weaponHeight + 50 + static_cast<int>(state.shakeOffsetY);
-
-        // Weapon recoil effect
-        if (state.screenShake > 0.1f) {
-            weaponY += static_cast<int>(state.screenShake * 30.0f);  // Kick weapon up when shooting
-        }
-
-        // Draw weapon based on type
-        if (currentWeapon == WeaponType::SHOTGUN) {
-            // Shotgun (M870 style pump-action)
-            // Stock
-            SDL_Rect stock = {weaponX + 20, weaponY + 140, 70, 50};
-            SDL_SetRenderDrawColor(renderer, 70, 50, 30, 255);
-            SDL_RenderFillRect(renderer, &stock);
-
-            // Receiver/body
-            SDL_Rect body = {weaponX + 80, weaponY + 125, 90, 50};
-            SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
-            SDL_RenderFillRect(renderer, &body);
-
-            // Long barrel
-            SDL_Rect barrel = {weaponX + 160, weaponY + 130, 40, 30};
-            SDL_SetRenderDrawColor(renderer, 60, 60, 60, 255);
-            SDL_RenderFillRect(renderer, &barrel);
-
-            // Barrel end
-            SDL_Rect barrelEnd = {weaponX + 190, weaponY + 135, 10, 20};
-            SDL_SetRenderDrawColor(renderer, 40, 40, 40, 255);
-            SDL_RenderFillRect(renderer, &barrelEnd);
-
-            // Pump/foregrip (wood)
-            SDL_Rect pump = {weaponX + 110, weaponY + 170, 50, 35};
-            SDL_SetRenderDrawColor(renderer, 80, 60, 40, 255);
-            SDL_RenderFillRect(renderer, &pump);
-
-            // Handle
-            SDL_Rect handle = {weaponX + 90, weaponY + 165, 30, 45};
-            SDL_SetRenderDrawColor(renderer, 60, 40, 20, 255);
-            SDL_RenderFillRect(renderer, &handle);
-
-            // Trigger guard
-            SDL_Rect trigger = {weaponX + 100, weaponY + 155, 20, 15};
-            SDL_SetRenderDrawColor(renderer, 45, 45, 45, 255);
-            SDL_RenderDrawRect(renderer, &trigger);
-
-            // Metal highlights
-            SDL_Rect highlight1 = {weaponX + 165, weaponY + 135, 20, 10};
-            SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
-            SDL_RenderFillRect(renderer, &highlight1);
-        } else if (currentWeapon == WeaponType::PISTOL) {
-            // Pistol
-            // Handle
-            SDL_Rect handle = {weaponX + 85, weaponY + 150, 30, 70};
-            SDL_SetRenderDrawColor(renderer, 60, 40, 20, 255);
-            SDL_RenderFillRect(renderer, &handle);
-
-            // Barrel
-            SDL_Rect barrel = {weaponX + 60, weaponY + 100, 80, 50};
-            SDL_SetRenderDrawColor(renderer, 80, 80, 80, 255);
-            SDL_RenderFillRect(renderer, &barrel);
-
-            // Barrel highlight
-            SDL_Rect barrelHighlight = {weaponX + 70, weaponY + 110, 50, 20};
-            SDL_SetRenderDrawColor(renderer, 120, 120, 120, 255);
-            SDL_RenderFillRect(renderer, &barrelHighlight);
-
-            // Trigger guard
-            SDL_Rect trigger = {weaponX + 90, weaponY + 140, 20, 15};
-            SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
-            SDL_RenderDrawRect(renderer, &trigger);
-        } else if (currentWeapon == WeaponType::ASSAULT_RIFLE) {
-            // Assault Rifle
-            // Stock
-            SDL_Rect stock = {weaponX + 20, weaponY + 130, 60, 40};
-            SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
-            SDL_RenderFillRect(renderer, &stock);
-
-            // Body
-            SDL_Rect body = {weaponX + 70, weaponY + 110, 100, 60};
-            SDL_SetRenderDrawColor(renderer, 60, 60, 60, 255);
-            SDL_RenderFillRect(renderer, &body);
-
-            // Barrel
-            SDL_Rect barrel = {weaponX + 150, weaponY + 120, 50, 30};
-            SDL_SetRenderDrawColor(renderer, 70, 70, 70, 255);
-            SDL_RenderFillRect(renderer, &barrel);
-
-            // Magazine
-            SDL_Rect mag = {weaponX + 110, weaponY + 170, 30, 50};
-            SDL_SetRenderDrawColor(renderer, 40, 40, 40, 255);
-            SDL_RenderFillRect(renderer, &mag);
-
-            // Handle
-            SDL_Rect handle = {weaponX + 90, weaponY + 150, 25, 40};
-            SDL_SetRenderDrawColor(renderer, 60, 40, 20, 255);
-            SDL_RenderFillRect(renderer, &handle);
-        } else if (currentWeapon == WeaponType::GRENADE_LAUNCHER) {
-            // Grenade Launcher
-            // Body
-            SDL_Rect body = {weaponX + 50, weaponY + 120, 120, 60};
-            SDL_SetRenderDrawColor(renderer, 70, 70, 50, 255);
-            SDL_RenderFillRect(renderer, &body);
-
-            // Large barrel tube
-            SDL_Rect barrel = {weaponX + 140, weaponY + 100, 60, 100};
-            SDL_SetRenderDrawColor(renderer, 80, 80, 60, 255);
-            SDL_RenderFillRect(renderer, &barrel);
-
-            // Barrel end (dark)
-            SDL_Rect barrelEnd = {weaponX + 180, weaponY + 110, 20, 80};
-            SDL_SetRenderDrawColor(renderer, 40, 40, 30, 255);
-            SDL_RenderFillRect(renderer, &barrelEnd);
-
-            // Handle
-            SDL_Rect handle = {weaponX + 80, weaponY + 160, 30, 50};
-            SDL_SetRenderDrawColor(renderer, 60, 40, 20, 255);
-            SDL_RenderFillRect(renderer, &handle);
-        } else if (currentWeapon == WeaponType::SMG) {
-            // SMG (Compact submachine gun)
-            // Stock (small and compact)
-            SDL_Rect stock = {weaponX + 30, weaponY + 135, 50, 35};
-            SDL_SetRenderDrawColor(renderer, 40, 40, 40, 255);
-            SDL_RenderFillRect(renderer, &stock);
-
-            // Body (compact)
-            SDL_Rect body = {weaponX + 70, weaponY + 115, 80, 55};
-            SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
-            SDL_RenderFillRect(renderer, &body);
-
-            // Short barrel
-            SDL_Rect barrel = {weaponX + 135, weaponY + 125, 45, 30};
-            SDL_SetRenderDrawColor(renderer, 60, 60, 60, 255);
-            SDL_RenderFillRect(renderer, &barrel);
-
-            // Large magazine (extended)
-            SDL_Rect mag = {weaponX + 100, weaponY + 170, 35, 60};
-            SDL_SetRenderDrawColor(renderer, 30, 30, 30, 255);
-            SDL_RenderFillRect(renderer, &mag);
-
-            // Handle
-            SDL_Rect handle = {weaponX + 90, weaponY + 155, 25, 40};
-            SDL_SetRenderDrawColor(renderer, 50, 40, 30, 255);
-            SDL_RenderFillRect(renderer, &handle);
-
-            // Highlight
-            SDL_Rect highlight = {weaponX + 140, weaponY + 130, 30, 10};
-            SDL_SetRenderDrawColor(renderer, 90, 90, 90, 255);
-            SDL_RenderFillRect(renderer, &highlight);
-        } else if (currentWeapon == WeaponType::SNIPER) {
-            // Sniper Rifle (Long and precise)
-            // Stock
-            SDL_Rect stock = {weaponX + 10, weaponY + 130, 70, 45};
-            SDL_SetRenderDrawColor(renderer, 60, 45, 30, 255);
-            SDL_RenderFillRect(renderer, &stock);
-
-            // Body/receiver
-            SDL_Rect body = {weaponX + 70, weaponY + 115, 90, 55};
-            SDL_SetRenderDrawColor(renderer, 55, 55, 55, 255);
-            SDL_RenderFillRect(renderer, &body);
-
-            // Very long barrel
-            SDL_Rect barrel = {weaponX + 145, weaponY + 125, 80, 28};
-            SDL_SetRenderDrawColor(renderer, 65, 65, 65, 255);
-            SDL_RenderFillRect(renderer, &barrel);
-
-            // Scope (large)
-            SDL_Rect scope = {weaponX + 90, weaponY + 85, 60, 30};
-            SDL_SetRenderDrawColor(renderer, 40, 40, 40, 255);
-            SDL_RenderFillRect(renderer, &scope);
-
-            // Scope lens
-            SDL_Rect scopeLens = {weaponX + 140, weaponY + 92, 10, 16};
-            SDL_SetRenderDrawColor(renderer, 100, 150, 200, 200);
-            SDL_RenderFillRect(renderer, &scopeLens);
-
-            // Barrel highlight
-            SDL_Rect barrelHighlight = {weaponX + 150, weaponY + 132, 60, 10};
-            SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
-            SDL_RenderFillRect(renderer, &barrelHighlight);
-
-            // Bipod
-            SDL_Rect bipod1 = {weaponX + 130, weaponY + 153, 3, 25};
-            SDL_Rect bipod2 = {weaponX + 145, weaponY + 153, 3, 25};
-            SDL_SetRenderDrawColor(renderer, 70, 70, 70, 255);
-            SDL_RenderFillRect(renderer, &bipod1);
-            SDL_RenderFillRect(renderer, &bipod2);
-        } else if (currentWeapon == WeaponType::FLAMETHROWER) {
-            // Flamethrower (Bulky and dangerous)
-            // Fuel tank (large red tank)
-            SDL_Rect tank = {weaponX + 30, weaponY + 90, 80, 100};
-            SDL_SetRenderDrawColor(renderer, 150, 50, 50, 255);
-            SDL_RenderFillRect(renderer, &tank);
-
-            // Tank highlight
-            SDL_Rect tankHighlight = {weaponX + 40, weaponY + 100, 30, 40};
-            SDL_SetRenderDrawColor(renderer, 180, 70, 70, 255);
-            SDL_RenderFillRect(renderer, &tankHighlight);
-
-            // Tank straps
-            SDL_Rect strap1 = {weaponX + 35, weaponY + 120, 70, 5};
-            SDL_Rect strap2 = {weaponX + 35, weaponY + 150, 70, 5};
-            SDL_SetRenderDrawColor(renderer, 80, 80, 60, 255);
-            SDL_RenderFillRect(renderer, &strap1);
-            SDL_RenderFillRect(renderer, &strap2);
-
-            // Nozzle body
-            SDL_Rect nozzleBody = {weaponX + 100, weaponY + 130, 70, 40};
-            SDL_SetRenderDrawColor(renderer, 70, 70, 70, 255);
-            SDL_RenderFillRect(renderer, &nozzleBody);
-
-            // Nozzle tip (brass/bronze)
-            SDL_Rect nozzleTip = {weaponX + 160, weaponY + 138, 40, 24};
-            SDL_SetRenderDrawColor(renderer, 150, 120, 60, 255);
-            SDL_RenderFillRect(renderer, &nozzleTip);
-
-            // Pilot light (small orange glow)
-            SDL_Rect pilotLight = {weaponX + 195, weaponY + 145, 5, 10};
-            SDL_SetRenderDrawColor(renderer, 255, 150, 0, 255);
-            SDL_RenderFillRect(renderer, &pilotLight);
-
-            // Handle
-            SDL_Rect handle = {weaponX + 110, weaponY + 160, 25, 45};
-            SDL_SetRenderDrawColor(renderer, 50, 40, 30, 255);
-            SDL_RenderFillRect(renderer, &handle);
-        }
-
-        // Draw crosshair in center of screen
-        int centerX = SCREEN_WIDTH / 2;
-        int centerY = SCREEN_HEIGHT / 2;
-        int crosshairSize = 15;
-        int crosshairThickness = 2;
-        int crosshairGap = 5;
-
-        // Crosshair with black outline for visibility
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        // Horizontal line (left)
-        SDL_Rect crosshairHL1 = {centerX - crosshairSize - 1, centerY - crosshairThickness/2 - 1,
-                                  crosshairSize - crosshairGap + 2, crosshairThickness + 2};
-        SDL_RenderFillRect(renderer, &crosshairHL1);
-        // Horizontal line (right)
-        SDL_Rect crosshairHL2 = {centerX + crosshairGap - 1, centerY - crosshairThickness/2 - 1,
-                                  crosshairSize - crosshairGap + 2, crosshairThickness + 2};
-        SDL_RenderFillRect(renderer, &crosshairHL2);
-        // Vertical line (top)
-        SDL_Rect crosshairVL1 = {centerX - crosshairThickness/2 - 1, centerY - crosshairSize - 1,
-                                  crosshairThickness + 2, crosshairSize - crosshairGap + 2};
-        SDL_RenderFillRect(renderer, &crosshairVL1);
-        // Vertical line (bottom)
-        SDL_Rect crosshairVL2 = {centerX - crosshairThickness/2 - 1, centerY + crosshairGap - 1,
-                                  crosshairThickness + 2, crosshairSize - crosshairGap + 2};
-        SDL_RenderFillRect(renderer, &crosshairVL2);
-
-        // White crosshair on top
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 200);
-        // Horizontal line (left)
-        SDL_Rect crosshairH1 = {centerX - crosshairSize, centerY - crosshairThickness/2,
-                                 crosshairSize - crosshairGap, crosshairThickness};
-        SDL_RenderFillRect(renderer, &crosshairH1);
-        // Horizontal line (right)
-        SDL_Rect crosshairH2 = {centerX + crosshairGap, centerY - crosshairThickness/2,
-                                 crosshairSize - crosshairGap, crosshairThickness};
-        SDL_RenderFillRect(renderer, &crosshairH2);
-        // Vertical line (top)
-        SDL_Rect crosshairV1 = {centerX - crosshairThickness/2, centerY - crosshairSize,
-                                 crosshairThickness, crosshairSize - crosshairGap};
-        SDL_RenderFillRect(renderer, &crosshairV1);
-        // Vertical line (bottom)
-        SDL_Rect crosshairV2 = {centerX - crosshairThickness/2, centerY + crosshairGap,
-                                 crosshairThickness, crosshairSize - crosshairGap};
-        SDL_RenderFillRect(renderer, &crosshairV2);
-
-        // Center dot
-        SDL_Rect crosshairDot = {centerX - 1, centerY - 1, 2, 2};
-        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 150);
-        SDL_RenderFillRect(renderer, &crosshairDot);
-
-        // === THICK ATMOSPHERIC FOG OVERLAY ===
-        // Add VERY DENSE creepy fog that obscures everything
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-
-        // Full screen heavy fog base layer
-        SDL_Rect fullFog = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
-        SDL_SetRenderDrawColor(renderer, 30, 30, 35, 120);  // MUCH thicker base fog
-        SDL_RenderFillRect(renderer, &fullFog);
-
-        // Add pulsing fog effect for atmosphere
-        Uint32 time = SDL_GetTicks();
-        float fogPulse = (std::sin(time / 500.0f) + 1.0f) / 2.0f;
-        int pulseAlpha = static_cast<int>(40 + fogPulse * 30);
-
-        SDL_SetRenderDrawColor(renderer, 25, 25, 30, pulseAlpha);
-        SDL_RenderFillRect(renderer, &fullFog);
-
-        // Extra thick fog at edges (vignette effect)
-        const int VIGNETTE_SIZE = 150;
-        for (int i = 0; i < VIGNETTE_SIZE; i++) {
-            float vignetteStrength = (float)i / VIGNETTE_SIZE;
-            int vignetteAlpha = static_cast<int>(vignetteStrength * 100);
-
-            SDL_SetRenderDrawColor(renderer, 10, 10, 15, vignetteAlpha);
-
-            // Top
-            SDL_RenderDrawLine(renderer, 0, i, SCREEN_WIDTH, i);
-            // Bottom
-            SDL_RenderDrawLine(renderer, 0, SCREEN_HEIGHT - i - 1, SCREEN_WIDTH, SCREEN_HEIGHT - i - 1);
-            // Left
-            SDL_RenderDrawLine(renderer, i, 0, i, SCREEN_HEIGHT);
-            // Right
-            SDL_RenderDrawLine(renderer, SCREEN_WIDTH - i - 1, 0, SCREEN_WIDTH - i - 1, SCREEN_HEIGHT);
-        }
-
-        // === ZOMBIE EYES GLOW THROUGH FOG (BUT NOT WALLS!) ===
-        // Render glowing red eyes ONLY for zombies with line of sight
-        for (const auto& zombie : state.zombies) {
-            if (!zombie->isDead()) {
-                float dx = zombie->getX() - playerX;
-                float dy = zombie->getY() - playerY;
-                float distance = std::sqrt(dx * dx + dy * dy);
-
-                // Show eyes ONLY if close AND have line of sight (NO WALL HACKS!)
-                if (distance < 1000.0f && hasLineOfSight(state.maze.get(), playerX, playerY, zombie->getX(), zombie->getY())) {
-                    // Transform zombie position to screen space
-                    float invDet = 1.0f / (std::cos(playerAngle + M_PI/2) * std::sin(playerAngle) -
-                                           std::sin(playerAngle + M_PI/2) * std::cos(playerAngle));
-                    float transformX = invDet * (std::sin(playerAngle) * dx - std::cos(playerAngle) * dy);
-                    float transformY = invDet * (-std::sin(playerAngle + M_PI/2) * dx + std::cos(playerAngle + M_PI/2) * dy);
-
-                    // Only render if in front of player
-                    if (transformY > 0.1f) {
-                        int screenX = static_cast<int>((SCREEN_WIDTH / 2) * (1 + transformX / transformY / std::tan(FOV/2)));
-
-                        // Calculate eye glow size (smaller when further away)
-                        int glowSize = static_cast<int>(800.0f / transformY);
-                        if (glowSize < 2) glowSize = 2;
-                        if (glowSize > 25) glowSize = 25;
-
-                        int screenY = SCREEN_HEIGHT / 2 - glowSize;
-
-                        // Pulsing glow effect
-                        Uint32 time = SDL_GetTicks();
-                        float pulse = (std::sin(time / 200.0f + distance / 100.0f) + 1.0f) / 2.0f;
-
-                        // Draw GLOWING RED EYES that pierce through fog!
-                        int eyeGlowAlpha = static_cast<int>(150 + pulse * 80);
-                        int eyeSeparation = glowSize / 2;
-
-                        // Left eye - outer glow (red halo)
-                        SDL_Rect leftEyeGlow = {screenX - eyeSeparation - glowSize, screenY - glowSize/2,
-                                                glowSize * 2, glowSize * 2};
-                        SDL_SetRenderDrawColor(renderer, 255, 50, 50, eyeGlowAlpha / 3);
-                        SDL_RenderFillRect(renderer, &leftEyeGlow);
-
-                        // Left eye - bright center
-                        SDL_Rect leftEye = {screenX - eyeSeparation - glowSize/2, screenY,
-                                           glowSize, glowSize};
-                        SDL_SetRenderDrawColor(renderer, 255, 20, 20, eyeGlowAlpha);
-                        SDL_RenderFillRect(renderer, &leftEye);
-
-                        // Right eye - outer glow
-                        SDL_Rect rightEyeGlow = {screenX + eyeSeparation - glowSize, screenY - glowSize/2,
-                                                 glowSize * 2, glowSize * 2};
-                        SDL_SetRenderDrawColor(renderer, 255, 50, 50, eyeGlowAlpha / 3);
-                        SDL_RenderFillRect(renderer, &rightEyeGlow);
-
-                        // Right eye - bright center
-                        SDL_Rect rightEye = {screenX + eyeSeparation - glowSize/2, screenY,
-                                            glowSize, glowSize};
-                        SDL_SetRenderDrawColor(renderer, 255, 20, 20, eyeGlowAlpha);
-                        SDL_RenderFillRect(renderer, &rightEye);
-                    }
-                }
-            }
-        }
-
-        // Reset blend mode
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-    }
-
     void renderZombieDirectionArrow(SDL_Renderer* renderer, const PlayState& state) {
         const int SCREEN_WIDTH = Game::SCREEN_WIDTH;
         const int SCREEN_HEIGHT = Game::SCREEN_HEIGHT;
@@ -2642,19 +1124,48 @@ namespace {
         SDL_SetRenderDrawColor(renderer, 20, 20, 20, 255);
         SDL_RenderFillRect(renderer, &minimap);
 
+        // The minimap shows at most MINIMAP_MAX_TILES per side, centred on the
+        // player and clamped to the maze, so big maps stay legible and cheap
+        const int MINIMAP_MAX_TILES = 64;
+        const Maze& maze = *state.maze;
+        float playerTileX = state.player->getX() / Maze::TILE_SIZE;
+        float playerTileY = state.player->getY() / Maze::TILE_SIZE;
+        int viewTilesX = std::min(maze.getWidth(), MINIMAP_MAX_TILES);
+        int viewTilesY = std::min(maze.getHeight(), MINIMAP_MAX_TILES);
+        int viewLeft = std::clamp(static_cast<int>(playerTileX) - viewTilesX / 2, 0, maze.getWidth() - viewTilesX);
+        int viewTop = std::clamp(static_cast<int>(playerTileY) - viewTilesY / 2, 0, maze.getHeight() - viewTilesY);
+        float viewOriginX = static_cast<float>(viewLeft * Maze::TILE_SIZE);
+        float viewOriginY = static_cast<float>(viewTop * Maze::TILE_SIZE);
+
         // Calculate scale
-        float scaleX = (float)MINIMAP_SIZE / (Maze::WIDTH * Maze::TILE_SIZE);
-        float scaleY = (float)MINIMAP_SIZE / (Maze::HEIGHT * Maze::TILE_SIZE);
+        float scaleX = (float)MINIMAP_SIZE / (viewTilesX * Maze::TILE_SIZE);
+        float scaleY = (float)MINIMAP_SIZE / (viewTilesY * Maze::TILE_SIZE);
+
+        // World position to minimap pixel; false if it falls outside the view
+        auto toMinimap = [&](float worldX, float worldY, int& mapX, int& mapY) {
+            mapX = MINIMAP_X + (int)((worldX - viewOriginX) * scaleX);
+            mapY = MINIMAP_Y + (int)((worldY - viewOriginY) * scaleY);
+            return mapX >= MINIMAP_X && mapX < MINIMAP_X + MINIMAP_SIZE &&
+                   mapY >= MINIMAP_Y && mapY < MINIMAP_Y + MINIMAP_SIZE;
+        };
 
         // Render maze walls
         // Outside testing mode: only show nearby walls (fog of war)
         bool isTestingMode = (state.difficulty == Difficulty::TESTING);
-        float playerTileX = state.player->getX() / Maze::TILE_SIZE;
-        float playerTileY = state.player->getY() / Maze::TILE_SIZE;
         float visibilityRadius = isTestingMode ? 9999.0f : 8.0f;  // Show 8 tiles around player in normal mode
 
-        for (int y = 0; y < Maze::HEIGHT; y++) {
-            for (int x = 0; x < Maze::WIDTH; x++) {
+        // Only walk the tiles that can be drawn
+        int minTileX = viewLeft, maxTileX = viewLeft + viewTilesX - 1;
+        int minTileY = viewTop, maxTileY = viewTop + viewTilesY - 1;
+        if (!isTestingMode) {
+            minTileX = std::max(minTileX, static_cast<int>(playerTileX - visibilityRadius));
+            maxTileX = std::min(maxTileX, static_cast<int>(playerTileX + visibilityRadius));
+            minTileY = std::max(minTileY, static_cast<int>(playerTileY - visibilityRadius));
+            maxTileY = std::min(maxTileY, static_cast<int>(playerTileY + visibilityRadius));
+        }
+
+        for (int y = minTileY; y <= maxTileY; y++) {
+            for (int x = minTileX; x <= maxTileX; x++) {
                 // Check distance to player (for fog of war outside testing mode)
                 float dx = x - playerTileX;
                 float dy = y - playerTileY;
@@ -2665,31 +1176,31 @@ namespace {
                     continue;  // Skip tiles that are too far in normal mode
                 }
 
-                if (state.maze->isSafeRoom(x, y)) {
+                if (maze.isSafeRoom(x, y)) {
                     // BLUE SAFE ROOM - render it blue!
                     SDL_Rect safeRoomRect = {
-                        MINIMAP_X + (int)(x * Maze::TILE_SIZE * scaleX),
-                        MINIMAP_Y + (int)(y * Maze::TILE_SIZE * scaleY),
+                        MINIMAP_X + (int)((x - viewLeft) * Maze::TILE_SIZE * scaleX),
+                        MINIMAP_Y + (int)((y - viewTop) * Maze::TILE_SIZE * scaleY),
                         std::max(2, (int)(Maze::TILE_SIZE * scaleX)),
                         std::max(2, (int)(Maze::TILE_SIZE * scaleY))
                     };
                     // Bright blue with glow effect
                     SDL_SetRenderDrawColor(renderer, 50, 150, 255, 255);
                     SDL_RenderFillRect(renderer, &safeRoomRect);
-                } else if (state.maze->isWall(x, y)) {
+                } else if (maze.isWall(x, y)) {
                     SDL_Rect wallRect = {
-                        MINIMAP_X + (int)(x * Maze::TILE_SIZE * scaleX),
-                        MINIMAP_Y + (int)(y * Maze::TILE_SIZE * scaleY),
+                        MINIMAP_X + (int)((x - viewLeft) * Maze::TILE_SIZE * scaleX),
+                        MINIMAP_Y + (int)((y - viewTop) * Maze::TILE_SIZE * scaleY),
                         std::max(2, (int)(Maze::TILE_SIZE * scaleX)),
                         std::max(2, (int)(Maze::TILE_SIZE * scaleY))
                     };
                     SDL_SetRenderDrawColor(renderer, 80, 80, 100, 255);
                     SDL_RenderFillRect(renderer, &wallRect);
-                } else if (state.maze->isExit(x, y) && isTestingMode) {
+                } else if (maze.isExit(x, y) && isTestingMode) {
                     // Only show exit in testing mode
                     SDL_Rect exitRect = {
-                        MINIMAP_X + (int)(x * Maze::TILE_SIZE * scaleX),
-                        MINIMAP_Y + (int)(y * Maze::TILE_SIZE * scaleY),
+                        MINIMAP_X + (int)((x - viewLeft) * Maze::TILE_SIZE * scaleX),
+                        MINIMAP_Y + (int)((y - viewTop) * Maze::TILE_SIZE * scaleY),
                         std::max(2, (int)(Maze::TILE_SIZE * scaleX)),
                         std::max(2, (int)(Maze::TILE_SIZE * scaleY))
                     };
@@ -2699,13 +1210,43 @@ namespace {
             }
         }
 
+        // Route hint along a precomputed distance field: to the safe room
+        // during a Blue Alert, otherwise the late-game hints (nearest key after
+        // 10 minutes, the exit after 12 once every key is collected)
+        float elapsedMinutes = (SDL_GetTicks() - state.gameStartTime) / 60000.0f;
+        const DistanceField* hintField = nullptr;
+        if (state.blueAlertActive && !state.inSafeRoom) {
+            hintField = &maze.getSafeRoomField();
+            SDL_SetRenderDrawColor(renderer, 100, 200, 255, 255);
+        } else if (elapsedMinutes >= 12.0f && state.player->getKeys() >= maze.getRequiredKeyCount(state.currentLevel)) {
+            hintField = &maze.getExitField();
+            SDL_SetRenderDrawColor(renderer, 0, 200, 100, 255);
+        } else if (elapsedMinutes >= 10.0f && !state.keyField.isEmpty()) {
+            hintField = &state.keyField;
+            SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
+        }
+        if (hintField) {
+            const int ROUTE_HINT_STEPS = 24;
+            int x = static_cast<int>(playerTileX);
+            int y = static_cast<int>(playerTileY);
+            int nextX, nextY;
+            for (int step = 0; step < ROUTE_HINT_STEPS && hintField->getNextStep(x, y, nextX, nextY); step++) {
+                x = nextX;
+                y = nextY;
+                int mapX, mapY;
+                if (!toMinimap((x + 0.5f) * Maze::TILE_SIZE, (y + 0.5f) * Maze::TILE_SIZE, mapX, mapY)) break;
+                SDL_Rect dot = {mapX - 1, mapY - 1, 3, 3};
+                SDL_RenderFillRect(renderer, &dot);
+            }
+        }
+
         // Only show entities in TESTING mode - normal mode shows only walls/player
         if (isTestingMode) {
             // Render keys
             for (const auto& key : state.keys) {
                 if (!key->isCollected()) {
-                    int mapX = MINIMAP_X + (int)(key->getX() * scaleX);
-                    int mapY = MINIMAP_Y + (int)(key->getY() * scaleY);
+                    int mapX, mapY;
+                    if (!toMinimap(key->getX(), key->getY(), mapX, mapY)) continue;
                     SDL_Rect keyRect = {mapX - 2, mapY - 2, 4, 4};
                     SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
                     SDL_RenderFillRect(renderer, &keyRect);
@@ -2715,8 +1256,8 @@ namespace {
             // Render weapon pickups
             for (const auto& weapon : state.weaponPickups) {
                 if (!weapon->isCollected()) {
-                    int mapX = MINIMAP_X + (int)(weapon->getX() * scaleX);
-                    int mapY = MINIMAP_Y + (int)(weapon->getY() * scaleY);
+                    int mapX, mapY;
+                    if (!toMinimap(weapon->getX(), weapon->getY(), mapX, mapY)) continue;
                     SDL_Rect weaponRect = {mapX - 2, mapY - 2, 4, 4};
                     if (weapon->getIsAmmo()) {
                         SDL_SetRenderDrawColor(renderer, 255, 180, 50, 255);  // Orange for ammo
@@ -2730,8 +1271,8 @@ namespace {
             // Render health boosts
             for (const auto& health : state.healthBoosts) {
                 if (!health->isCollected()) {
-                    int mapX = MINIMAP_X + (int)(health->getX() * scaleX);
-                    int mapY = MINIMAP_Y + (int)(health->getY() * scaleY);
+                    int mapX, mapY;
+                    if (!toMinimap(health->getX(), health->getY(), mapX, mapY)) continue;
                     SDL_Rect healthRect = {mapX - 2, mapY - 2, 4, 4};
                     SDL_SetRenderDrawColor(renderer, 50, 255, 50, 255);  // Green for health
                     SDL_RenderFillRect(renderer, &healthRect);
@@ -2741,8 +1282,8 @@ namespace {
             // Render zombies
             for (const auto& zombie : state.zombies) {
                 if (!zombie->isDead()) {
-                    int mapX = MINIMAP_X + (int)(zombie->getX() * scaleX);
-                    int mapY = MINIMAP_Y + (int)(zombie->getY() * scaleY);
+                    int mapX, mapY;
+                    if (!toMinimap(zombie->getX(), zombie->getY(), mapX, mapY)) continue;
                     SDL_Rect zombieRect = {mapX - 2, mapY - 2, 4, 4};
                     SDL_SetRenderDrawColor(renderer, 255, 50, 50, 255);
                     SDL_RenderFillRect(renderer, &zombieRect);
@@ -2752,8 +1293,8 @@ namespace {
             // Render hunters (dark purple entities)
             for (const auto& hunter : state.hunters) {
                 if (!hunter->isDead()) {
-                    int mapX = MINIMAP_X + (int)(hunter->getX() * scaleX);
-                    int mapY = MINIMAP_Y + (int)(hunter->getY() * scaleY);
+                    int mapX, mapY;
+                    if (!toMinimap(hunter->getX(), hunter->getY(), mapX, mapY)) continue;
                     SDL_Rect hunterRect = {mapX - 2, mapY - 2, 5, 5};  // Slightly bigger than zombies
                     SDL_SetRenderDrawColor(renderer, 150, 50, 200, 255);  // Dark purple
                     SDL_RenderFillRect(renderer, &hunterRect);
@@ -2777,8 +1318,8 @@ namespace {
             float spawnY = state.player->getY() + std::sin(angle) * adjustedRange;
 
             // Draw purple spawn indicator on minimap
-            int spawnMapX = MINIMAP_X + (int)(spawnX * scaleX);
-            int spawnMapY = MINIMAP_Y + (int)(spawnY * scaleY);
+            int spawnMapX, spawnMapY;
+            toMinimap(spawnX, spawnY, spawnMapX, spawnMapY);
 
             // Draw pulsing purple square
             float pulseAmount = 0.7f + 0.3f * std::sin(SDL_GetTicks() * 0.005f);
@@ -2793,8 +1334,8 @@ namespace {
         }
 
         // Render player
-        int playerMapX = MINIMAP_X + (int)(state.player->getX() * scaleX);
-        int playerMapY = MINIMAP_Y + (int)(state.player->getY() * scaleY);
+        int playerMapX, playerMapY;
+        toMinimap(state.player->getX(), state.player->getY(), playerMapX, playerMapY);
         SDL_Rect playerRect = {playerMapX - 3, playerMapY - 3, 6, 6};
         SDL_SetRenderDrawColor(renderer, 100, 150, 255, 255);
         SDL_RenderFillRect(renderer, &playerRect);
@@ -2832,6 +1373,106 @@ namespace {
         SDL_RenderDrawRect(renderer, &minimap);
     }
 
+    // Frame profiler (F3): mean and p99 per stage over the last
+    // FrameProfiler::HISTORY frames, a graph of whole-frame times, then heap
+    // allocations per frame and live bytes per tag (with --config=alloc)
+    void renderProfilerOverlay(SDL_Renderer* renderer, const FrameProfiler& profiler) {
+        const int PANEL_X = 10;
+        const int PANEL_Y = 70;
+        const int PANEL_WIDTH = FrameProfiler::HISTORY + 20;
+        const int LINE_HEIGHT = 11;
+        const int GRAPH_HEIGHT = 60;
+        const float GRAPH_MAX_MS = 1000.0f / 30.0f;  // Full graph height is a 30 FPS frame
+        const float TARGET_MS = 1000.0f / 60.0f;
+        const float MB = 1024.0f * 1024.0f;
+        const AllocationStats memory = getAllocationStats();
+        const int memoryLines = memory.enabled ? 2 + ALLOCATION_TAG_COUNT : 1;
+        const int PANEL_HEIGHT = 45 + (PROFILE_STAGE_COUNT + 2) * LINE_HEIGHT + GRAPH_HEIGHT + 15 +
+                                 memoryLines * LINE_HEIGHT + 8;
+
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        SDL_Rect panelBg = {PANEL_X, PANEL_Y, PANEL_WIDTH, PANEL_HEIGHT};
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
+        SDL_RenderFillRect(renderer, &panelBg);
+        SDL_SetRenderDrawColor(renderer, 100, 200, 255, 255);
+        SDL_RenderDrawRect(renderer, &panelBg);
+
+        int textX = PANEL_X + 10;
+        int y = PANEL_Y + 8;
+        renderText(renderer, "PROFILER", textX, y, 2);
+        y += 24;
+
+        char line[64];
+        SDL_SetRenderDrawColor(renderer, 150, 150, 150, 255);
+        snprintf(line, sizeof(line), "%-10s %7s %7s", "STAGE MS", "MEAN", "P99");
+        renderText(renderer, line, textX, y, 1);
+        y += LINE_HEIGHT + 2;
+
+        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+        for (int stage = 0; stage <= FrameProfiler::FRAME_ROW; stage++) {
+            FrameProfiler::Stats stats = profiler.getStats(stage);
+            const char* name = stage == FrameProfiler::FRAME_ROW ? "FRAME" : profileStageName(static_cast<ProfileStage>(stage));
+            if (stage == FrameProfiler::FRAME_ROW) {
+                SDL_SetRenderDrawColor(renderer, 255, 255, 100, 255);
+            }
+            snprintf(line, sizeof(line), "%-10s %7.2f %7.2f", name, stats.average, stats.p99);
+            renderText(renderer, line, textX, y, 1);
+            y += LINE_HEIGHT;
+        }
+
+        FrameProfiler::Stats frame = profiler.getStats(FrameProfiler::FRAME_ROW);
+        snprintf(line, sizeof(line), "FPS %.0f   WORST %.1f MS", frame.average > 0.0f ? 1000.0f / frame.average : 0.0f, frame.max);
+        renderText(renderer, line, textX, y, 1);
+        y += LINE_HEIGHT + 4;
+
+        // Oldest frame on the left; green within a 60 FPS budget, then yellow, then red
+        int graphBottom = y + GRAPH_HEIGHT;
+        for (int age = 0; age < profiler.getFrameCount(); age++) {
+            float ms = profiler.getMs(FrameProfiler::FRAME_ROW, age);
+            int height = std::max(1, static_cast<int>(std::min(ms / GRAPH_MAX_MS, 1.0f) * GRAPH_HEIGHT));
+            if (ms <= TARGET_MS) {
+                SDL_SetRenderDrawColor(renderer, 80, 220, 80, 255);
+            } else if (ms <= GRAPH_MAX_MS) {
+                SDL_SetRenderDrawColor(renderer, 240, 200, 60, 255);
+            } else {
+                SDL_SetRenderDrawColor(renderer, 240, 60, 60, 255);
+            }
+            int x = textX + FrameProfiler::HISTORY - 1 - age;
+            SDL_RenderDrawLine(renderer, x, graphBottom - height, x, graphBottom);
+        }
+        int targetY = graphBottom - static_cast<int>(TARGET_MS / GRAPH_MAX_MS * GRAPH_HEIGHT);
+        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 120);
+        SDL_RenderDrawLine(renderer, textX, targetY, textX + FrameProfiler::HISTORY, targetY);
+
+        // Heap: allocation churn, then what is live now by tag
+        y = graphBottom + 8;
+        SDL_SetRenderDrawColor(renderer, 150, 150, 150, 255);
+        if (!memory.enabled) {
+            renderText(renderer, "HEAP STATS OFF", textX, y, 1);
+            return;
+        }
+        std::uint64_t allocationTotal = 0;
+        std::uint32_t allocationMax = 0;
+        for (int age = 0; age < profiler.getFrameCount(); age++) {
+            allocationTotal += profiler.getAllocations(age);
+            allocationMax = std::max(allocationMax, profiler.getAllocations(age));
+        }
+        float allocationMean = profiler.getFrameCount() > 0 ? static_cast<float>(allocationTotal) / profiler.getFrameCount() : 0.0f;
+        snprintf(line, sizeof(line), "ALLOCS/FRAME %6.1f  MAX %u", allocationMean, allocationMax);
+        renderText(renderer, line, textX, y, 1);
+        y += LINE_HEIGHT;
+        snprintf(line, sizeof(line), "HEAP %.2f MB  MAX %.2f MB", memory.liveBytes / MB, memory.peakBytes / MB);
+        renderText(renderer, line, textX, y, 1);
+        y += LINE_HEIGHT;
+        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+        for (int tag = 0; tag < ALLOCATION_TAG_COUNT; tag++) {
+            snprintf(line, sizeof(line), "%-10s %7.2f MB %7lld", allocationTagName(static_cast<AllocationTag>(tag)),
+                     memory.liveBytesByTag[tag] / MB, static_cast<long long>(memory.liveBlocksByTag[tag]));
+            renderText(renderer, line, textX, y, 1);
+            y += LINE_HEIGHT;
+        }
+    }
+
     void renderTestingPanel(SDL_Renderer* renderer, PlayState& state) {
         const int PANEL_WIDTH = 300;
         const int PANEL_HEIGHT = 560;  // Increased for spawn mode toggle and hunter button
@@ -2975,151 +1616,135 @@ namespace {
         renderText(renderer, "F1 TO CLOSE PANEL", PANEL_X + 52, yOffset + 22, 1);
     }
 
-    void initializeGame(PlayState& state, Difficulty difficulty, MazeType mazeType = MazeType::STANDARD, bool isLevelProgression = false) {
-        // Store maze type for infinite mode
-        state.mazeType = mazeType;
+    // Decay the shake set by drainGameEvents and pick this frame's offset
+    void updateScreenShake(PlayState& state, float deltaTime) {
+        if (state.screenShake > 0.0f) {
+            state.screenShake -= deltaTime * 5.0f;  // Decay shake
+            if (state.screenShake < 0.0f) state.screenShake = 0.0f;
 
-        // If this is not a level progression, reset to level 1
-        if (!isLevelProgression) {
-            state.currentLevel = 1;
+            // Generate random shake offset
+            state.shakeOffsetX = ((float)rand() / RAND_MAX - 0.5f) * state.screenShake * 10.0f;
+            state.shakeOffsetY = ((float)rand() / RAND_MAX - 0.5f) * state.screenShake * 10.0f;
+        } else {
+            state.shakeOffsetX = 0.0f;
+            state.shakeOffsetY = 0.0f;
         }
+    }
 
-        // Apply difficulty settings
-        applyDifficulty(state, difficulty);
+    void playSound(Mix_Chunk* sound, int volume = -1) {
+        if (!sound) return;
+        if (volume >= 0) Mix_VolumeChunk(sound, volume);
+        Mix_PlayChannel(-1, sound, 0);
+    }
 
-        // Scale difficulty for infinite mode levels > 7
-        if (mazeType == MazeType::INFINITE && state.currentLevel > 7) {
-            // Add 3 more zombies per level after 7
-            int bonusZombies = (state.currentLevel - 7) * 3;
-            state.initialZombieCount += bonusZombies;
-            state.maxZombieCount += bonusZombies;
-        }
+    // Presentation side of the event queue: audio, console log, screen shake
+    // and high score saving (off for replays, which only re-enact a session).
+    // Runs once per frame after the simulation.
+    void drainGameEvents(PlayState& state, bool saveHighScores) {
+        GameEvent event;
+        while (state.events.pop(event)) {
+            switch (event.type) {
+                case GameEventType::SHOT_FIRED:
+                case GameEventType::FLAME_FIRED:
+                    playSound(shootSound);
+                    state.screenShake = 0.2f;  // Shake intensity
+                    break;
+
+                case GameEventType::MELEE_HIT:
+                    playSound(shootSound);  // Melee sound (using shoot sound for now)
+                    state.screenShake = 0.15f;
+                    break;
+
+                case GameEventType::ZOMBIE_KILLED:
+                    playSound(zombieDeathSound);
+                    break;
+
+                case GameEventType::HUNTER_KILLED:
+                    playSound(zombieDeathSound);
+                    std::cout << "Hunter eliminated! +500 points" << std::endl;
+                    break;
+
+                case GameEventType::EXPLOSION: {
+                    int zombiesKilled = event.amount;
+                    int huntersKilled = event.detail;
+                    if (zombiesKilled > 0 || huntersKilled > 0) {
+                        playSound(zombieDeathSound);
+                        if (zombiesKilled > 0 && huntersKilled > 0) {
+                            std::cout << "EXPLOSION! Killed " << zombiesKilled << " zombies and " << huntersKilled << " hunters!" << std::endl;
+                        } else if (zombiesKilled > 0) {
+                            std::cout << "EXPLOSION! Killed " << zombiesKilled << " zombies!" << std::endl;
+                        } else {
+                            std::cout << "EXPLOSION! Killed " << huntersKilled << " hunters!" << std::endl;
+                        }
+                    }
+                    state.screenShake = 0.5f;  // Add screen shake for explosion
+                    break;
+                }
 
-        // Create new maze (randomly generated with selected type)
-        state.maze = std::make_unique<Maze>(mazeType);
+                case GameEventType::PLAYER_DAMAGED:
+                    std::cout << (event.detail ? "HUNTER HIT! Health: " : "Hit! Health: ")
+                              << event.amount << "/" << state.player->getMaxHealth() << std::endl;
+                    break;
 
-        // Reset player at start position
-        Vec2 startPos = state.maze->getPlayerStart();
-        state.player = std::make_unique<Player>(startPos.x, startPos.y);
+                case GameEventType::PLAYER_DIED:
+                    playSound(playerDeathSound);
+                    std::cout << (event.detail ? "Killed by hunter! Score: " : "You died! Score: ")
+                              << event.amount << " | Total: " << event.totalScore << std::endl;
 
-        // SOLDIER MODE: Special initialization
-        if (mazeType == MazeType::SOLDIER) {
-            // Give player assault rifle with infinite ammo in slot 0
-            state.player->pickupWeapon(WeaponType::ASSAULT_RIFLE);
-            // Give infinite ammo (just a very large amount)
-            state.player->pickupAmmo(WeaponType::ASSAULT_RIFLE, 999999);
+                    // Save high score if applicable
+                    if (saveHighScores && isHighScore(event.totalScore)) {
+                        addHighScore(event.totalScore, event.level,
+                                   mazeTypeToString(static_cast<MazeType>(event.mazeType)),
+                                   difficultyToString(static_cast<Difficulty>(event.difficulty)));
+                        std::cout << "NEW HIGH SCORE!" << std::endl;
+                    }
 
-            // Initialize wave system
-            state.currentWave = 1;
-            state.waveActive = false;
-            state.waveDelayTimer = state.waveDelay;  // Start first wave after delay
+                    std::cout << "Respawning in 2 seconds..." << std::endl;
+                    break;
 
-            // Don't spawn any initial zombies (they spawn in waves)
-            state.zombies.clear();
-            state.totalZombiesSpawned = 0;
-            state.spawnTimer = 0.0f;
+                case GameEventType::KEY_COLLECTED:
+                    playSound(keySound);
+                    std::cout << "Key collected! (" << event.amount << "/" << event.detail << ") +250 points!" << std::endl;
+                    break;
 
-            // No keys needed in Soldier mode
-            state.keys.clear();
-        }
-        // TESTING MODE: Give player all weapons after creation
-        else if (difficulty == Difficulty::TESTING) {
-            // Give player ALL weapons - cycle through both slots
-            state.player->pickupWeapon(WeaponType::SHOTGUN);
-            state.player->switchWeapon();
-            state.player->pickupWeapon(WeaponType::ASSAULT_RIFLE);
-            state.player->switchWeapon();
-            state.player->pickupWeapon(WeaponType::SMG);
-            state.player->switchWeapon();
-            state.player->pickupWeapon(WeaponType::SNIPER);
-            state.player->switchWeapon();
-            state.player->pickupWeapon(WeaponType::GRENADE_LAUNCHER);
-            state.player->switchWeapon();
-            state.player->pickupWeapon(WeaponType::FLAMETHROWER);
-
-            // Standard zombie/key initialization for testing mode
-            state.zombies.clear();
-            auto zombiePositions = state.maze->getRandomZombiePositions(state.initialZombieCount, startPos);
-            for (const auto& pos : zombiePositions) {
-                ZombieType type = getRandomZombieType();
-                state.zombies.push_back(std::make_unique<Zombie>(pos.x, pos.y, state.zombieMaxHealth, type));
-            }
-            state.totalZombiesSpawned = state.initialZombieCount;
-            state.spawnTimer = 0.0f;
-
-            state.keys.clear();
-            int requiredKeys = state.maze->getRequiredKeyCount(state.currentLevel);
-            auto keyPositions = state.maze->getRandomKeyPositions(requiredKeys);
-            for (const auto& pos : keyPositions) {
-                state.keys.push_back(std::make_unique<Key>(pos.x, pos.y));
-            }
-        } else {
-            // NORMAL MODES: Standard initialization
-            // Clear and create zombies at random positions (far from player spawn)
-            state.zombies.clear();
-            auto zombiePositions = state.maze->getRandomZombiePositions(state.initialZombieCount, startPos);
-            for (const auto& pos : zombiePositions) {
-                ZombieType type = getRandomZombieType();
-                state.zombies.push_back(std::make_unique<Zombie>(pos.x, pos.y, state.zombieMaxHealth, type));
-            }
-            state.totalZombiesSpawned = state.initialZombieCount;
-            state.spawnTimer = 0.0f;
-
-            // Clear and create keys at random positions
-            state.keys.clear();
-            int requiredKeys = state.maze->getRequiredKeyCount(state.currentLevel);
-            auto keyPositions = state.maze->getRandomKeyPositions(requiredKeys);
-            for (const auto& pos : keyPositions) {
-                state.keys.push_back(std::make_unique<Key>(pos.x, pos.y));
-            }
-        }
+                case GameEventType::WEAPON_PICKED_UP: {
+                    WeaponStats stats = getWeaponStats(static_cast<WeaponType>(event.detail));
+                    std::cout << "Picked up: " << stats.name << " (" << event.amount << " rounds)" << std::endl;
+                    break;
+                }
 
-        // Clear and create weapon pickups (skip in Soldier mode)
-        state.weaponPickups.clear();
-        if (mazeType != MazeType::SOLDIER) {
-            int weaponCount = 3;
-            if (mazeType == MazeType::INFINITE && state.currentLevel > 7) {
-                // Reduce weapons as difficulty increases: level 8=2, level 9+=1
-                weaponCount = std::max(1, 10 - state.currentLevel);
-            }
-            auto weaponPositions = state.maze->getRandomKeyPositions(weaponCount);
-            // Spawn variety of weapons (cycle through all types)
-            WeaponType weaponTypes[] = {WeaponType::ASSAULT_RIFLE, WeaponType::GRENADE_LAUNCHER,
-                                         WeaponType::SMG, WeaponType::SNIPER, WeaponType::FLAMETHROWER};
-            for (size_t i = 0; i < weaponPositions.size() && i < static_cast<size_t>(weaponCount); i++) {
-                WeaponType weaponType = weaponTypes[i % 5];  // Cycle through all weapon types
-                state.weaponPickups.push_back(std::make_unique<WeaponPickup>(weaponPositions[i].x, weaponPositions[i].y, weaponType));
-            }
-        }
+                case GameEventType::AMMO_PICKED_UP: {
+                    WeaponStats stats = getWeaponStats(static_cast<WeaponType>(event.detail));
+                    std::cout << "Picked up ammo for: " << stats.name << " (+" << event.amount << ")" << std::endl;
+                    break;
+                }
 
-        // Clear and create health boosts (skip in Soldier mode - rely on natural regen)
-        state.healthBoosts.clear();
-        if (mazeType != MazeType::SOLDIER) {
-            int healthCount = 3;
-            if (mazeType == MazeType::INFINITE && state.currentLevel > 7) {
-                // Reduce health boosts: level 8=2, level 10+=1
-                healthCount = std::max(1, 11 - state.currentLevel);
-            }
-            auto healthPositions = state.maze->getRandomKeyPositions(healthCount);
-            for (size_t i = 0; i < healthPositions.size() && i < static_cast<size_t>(healthCount); i++) {
-                state.healthBoosts.push_back(std::make_unique<HealthBoost>(healthPositions[i].x, healthPositions[i].y));
-            }
-        }
+                case GameEventType::HEALTH_COLLECTED:
+                    playSound(keySound);
+                    if (event.detail) {
+                        std::cout << "Health boost collected! +1 HP (now " << event.amount << "/" << state.player->getMaxHealth() << ") + Full Ammo +50 points!" << std::endl;
+                    } else {
+                        std::cout << "Health boost collected! Full Ammo +50 points!" << std::endl;
+                    }
+                    break;
 
-        // Clear bullets
-        state.bullets.clear();
+                case GameEventType::ZOMBIE_GROAN:
+                    playSound(event.detail == 0 ? zombieGroanSound : zombieMoanSound, event.amount);
+                    break;
 
-        // Reset game state
-        state.deathTime = 0;
+                case GameEventType::HUNTER_BREATH:
+                    playSound(zombieGroanSound, event.amount);  // Groan sound, quieter, for hunters
+                    break;
 
-        // Reset current life score (keep totalScore)
-        state.score = 0;
-        state.zombiesKilled = 0;
-        state.gameStartTime = SDL_GetTicks();
+                case GameEventType::PROXIMITY_BEEP:
+                    playSound(proximityBeepSound, event.amount);
+                    break;
+            }
+        }
     }
 }
 
-void Game::run() {
+void Game::run(const GameOptions& options) {
     // Init SDL
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
         std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
@@ -3163,24 +1788,82 @@ void Game::run() {
         return;
     }
 
+    // Timeline capture (--trace); declared first so level and chunk workers
+    // owned by playState finish before it goes away
+    std::unique_ptr<TraceRecorder> trace;
+    if (!options.tracePath.empty()) {
+        trace = std::make_unique<TraceRecorder>(options.tracePath, options.traceFrames);
+        setActiveTrace(trace.get());
+        std::cout << "Tracing " << options.traceFrames << " frames to " << options.tracePath << std::endl;
+    }
+
     // Initialize game state
     MenuState menu;
     PlayState playState;
+    playState.mazeWidth = options.mazeWidth;
+    playState.mazeHeight = options.mazeHeight;
+    playState.endlessWorld = options.endlessWorld;
+    playState.mazeFile = options.mazeFile;
+    playState.saveMazePath = options.saveMazePath;
+
+    // Stage timings for the F3 overlay
+    FrameProfiler profiler;
+    playState.profiler = &profiler;
+
+    // Without --seed, pick one and print it so the run can be reproduced
+    playState.sessionSeed = options.hasSeed
+        ? options.seed
+        : (static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+    std::cout << "Session seed: " << playState.sessionSeed << " (replay with --seed " << playState.sessionSeed << ")" << std::endl;
+
+    // Input recording (--record) or playback (--replay). A replay brings its
+    // own seed and maze settings and goes straight into its first game.
+    InputRecorder recorder;
+    InputReplay replay;
+    bool replaying = false;
+    if (!options.replayPath.empty()) {
+        replaying = replay.load(options.replayPath) && replay.begin(playState);
+        if (replaying) {
+            menu.difficulty = playState.difficulty;
+            menu.currentState = GameState::PLAYING;
+        }
+    } else if (!options.recordPath.empty() && recorder.open(options.recordPath, playState)) {
+        std::cout << "Recording input to " << options.recordPath << std::endl;
+    }
+
+    // Every new game (menu, restart, respawn) starts here so recordings see
+    // it; starting one by hand also takes over from a replay
+    auto startGame = [&](Difficulty difficulty, MazeType mazeType = MazeType::STANDARD) {
+        if (replaying) {
+            std::cout << "Replay stopped after " << replay.getTicksPlayed() << " ticks" << std::endl;
+            replaying = false;
+        }
+        Uint32 now = SDL_GetTicks();
+        initializeGame(playState, now, difficulty, mazeType);
+        recorder.recordStart(playState, now);
+    };
 
     // Game loop variables
     bool running = true;
     Uint32 lastTime = SDL_GetTicks();
     bool mousePressed = false;
 
-    // Game loop
-    while (running) {
+    // Real time not yet simulated. Only banked while playing, so pauses and
+    // menus resume where they left off.
+    float tickAccumulator = 0.0f;
+    const float MAX_FRAME_TIME = 0.25f;  // Longer stalls are dropped, not caught up
+
+    // One frame: input, the ticks it owes, then draw and present. Natively a
+    // plain loop runs it back to back (the vsynced present paces it); in the
+    // browser requestAnimationFrame calls it, so the tab never blocks.
+    auto runFrame = [&]() {
+        profiler.beginFrame();
         Uint32 currentTime = SDL_GetTicks();
-        float deltaTime = (currentTime - lastTime) / 1000.0f;
+        float frameTime = std::min((currentTime - lastTime) / 1000.0f, MAX_FRAME_TIME);
         lastTime = currentTime;
 
-        if (deltaTime > 0.016f) deltaTime = 0.016f;  // Cap at ~60 FPS
-
         // Handle events
+        profiler.enterStage(ProfileStage::INPUT);
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
             if (event.type == SDL_QUIT) {
@@ -3195,7 +1878,7 @@ void Game::run() {
                     } else if (event.key.keysym.sym == SDLK_RETURN || event.key.keysym.sym == SDLK_SPACE) {
                         if (menu.menuSelection == 0) {
                             // Start game
-                            initializeGame(playState, menu.difficulty, menu.mazeType);
+                            startGame(menu.difficulty, menu.mazeType);
                             menu.currentState = GameState::PLAYING;
                             SDL_SetRelativeMouseMode(SDL_TRUE);  // Lock mouse
                         } else if (menu.menuSelection == 1) {
@@ -3248,7 +1931,7 @@ void Game::run() {
 
                             // If difficulty changed during gameplay, restart with new difficulty
                             if (playState.player != nullptr && oldDifficulty != menu.difficulty) {
-                                initializeGame(playState, menu.difficulty, playState.mazeType);
+                                startGame(menu.difficulty, playState.mazeType);
                                 menu.currentState = GameState::PLAYING;
                                 SDL_SetRelativeMouseMode(SDL_TRUE);  // Lock mouse
                             } else {
@@ -3301,16 +1984,18 @@ void Game::run() {
                         menu.currentState = GameState::PAUSED;
                         menu.pauseSelection = 0;
                         SDL_SetRelativeMouseMode(SDL_FALSE);  // Unlock mouse
-                    } else if (event.key.keysym.sym == SDLK_q) {
+                    } else if (event.key.keysym.sym == SDLK_q && !replaying) {
                         // Switch weapon (ranged only)
                         if (!playState.player->isUsingMelee()) {
                             playState.player->switchWeapon();
+                            recorder.recordAction(ReplayAction::SWITCH_WEAPON);
                             WeaponStats stats = getWeaponStats(playState.player->getCurrentWeapon());
                             std::cout << "Switched to: " << stats.name << std::endl;
                         }
-                    } else if (event.key.keysym.sym == SDLK_v) {
+                    } else if (event.key.keysym.sym == SDLK_v && !replaying) {
                         // Toggle between melee and ranged weapons
                         playState.player->setUsingMelee(!playState.player->isUsingMelee());
+                        recorder.recordAction(ReplayAction::TOGGLE_MELEE);
                         WeaponStats stats = getWeaponStats(playState.player->getCurrentWeapon());
                         std::cout << "Switched to: " << stats.name << (stats.isMelee ? " (MELEE)" : " (RANGED)") << std::endl;
                     } else if (event.key.keysym.sym == SDLK_h) {
@@ -3325,8 +2010,10 @@ void Game::run() {
                         playState.showMinimap = !playState.showMinimap;
                         std::cout << "Minimap: " << (playState.showMinimap ? "ON" : "OFF") << std::endl;
                     } else if (event.key.keysym.sym == SDLK_F1) {
-                        // Toggle testing panel (only in TESTING mode)
-                        if (playState.difficulty == Difficulty::TESTING) {
+                        // Toggle testing panel (only in TESTING mode). Its spawns
+                        // draw from the gameplay RNG without being recorded, so
+                        // it stays shut while a recording is made or played.
+                        if (playState.difficulty == Difficulty::TESTING && !replaying && !recorder.isOpen()) {
                             playState.showTestingPanel = !playState.showTestingPanel;
                             std::cout << "Testing Panel: " << (playState.showTestingPanel ? "ON" : "OFF") << std::endl;
 
@@ -3337,6 +2024,9 @@ void Game::run() {
                                 SDL_SetRelativeMouseMode(SDL_TRUE);  // Lock mouse for gameplay
                             }
                         }
+                    } else if (event.key.keysym.sym == SDLK_F3) {
+                        // Toggle frame profiler overlay
+                        playState.showProfiler = !playState.showProfiler;
                     }
                 } else if (menu.currentState == GameState::PAUSED) {
                     // Pause menu navigation
@@ -3351,7 +2041,7 @@ void Game::run() {
                             SDL_SetRelativeMouseMode(SDL_TRUE);  // Lock mouse
                         } else if (menu.pauseSelection == 1) {
                             // Restart with current difficulty
-                            initializeGame(playState, menu.difficulty);
+                            startGame(menu.difficulty);
                             menu.currentState = GameState::PLAYING;
                             SDL_SetRelativeMouseMode(SDL_TRUE);  // Lock mouse
                         } else if (menu.pauseSelection == 2) {
@@ -3374,7 +2064,7 @@ void Game::run() {
                 } else if (menu.currentState == GameState::GAME_WON || menu.currentState == GameState::GAME_LOST) {
                     // Win/lose screen
                     if (event.key.keysym.sym == SDLK_r) {
-                        initializeGame(playState, menu.difficulty);
+                        startGame(menu.difficulty);
                         menu.currentState = GameState::PLAYING;
                         SDL_SetRelativeMouseMode(SDL_TRUE);  // Lock mouse
                     } else if (event.key.keysym.sym == SDLK_ESCAPE) {
@@ -3479,7 +2169,8 @@ void Game::run() {
                                 spawnY = playState.player->getY() + std::sin(angle) * spawnDist;
                             }
 
-                            playState.zombies.push_back(std::make_unique<Zombie>(spawnX, spawnY, playState.zombieMaxHealth));
+                            playState.zombies.push_back(std::make_unique<Zombie>(spawnX, spawnY, playState.zombieMaxHealth,
+                                                                                 ZombieType::NORMAL, playState.rng.nextU64()));
                             std::cout << "Spawned zombie at " << (playState.spawnAtCrosshair ? "crosshair" : "player") << std::endl;
                         }
 
@@ -3510,7 +2201,7 @@ void Game::run() {
                             }
 
                             // Spawn hunter (dark, fast zombie-like entity with high health)
-                            playState.hunters.push_back(std::make_unique<Zombie>(spawnX, spawnY, 999));
+                            playState.hunters.push_back(std::make_unique<Zombie>(spawnX, spawnY, 999, ZombieType::NORMAL, playState.rng.nextU64()));
                             std::cout << "Spawned hunter at " << (playState.spawnAtCrosshair ? "crosshair" : "player") << std::endl;
                         }
 
@@ -3566,8 +2257,8 @@ void Game::run() {
             } else if (event.type == SDL_MOUSEBUTTONUP && event.button.button == SDL_BUTTON_LEFT) {
                 mousePressed = false;
             } else if (event.type == SDL_MOUSEMOTION) {
-                if (menu.currentState == GameState::PLAYING && !playState.showTestingPanel) {
-                    // Only rotate camera if testing panel is not open
+                if (menu.currentState == GameState::PLAYING && !playState.showTestingPanel && !replaying) {
+                    // Only rotate camera if testing panel is not open (or a replay is aiming)
                     float sensitivity = 0.003f;
 
                     // Horizontal rotation (left/right)
@@ -3585,973 +2276,96 @@ void Game::run() {
                 }
             }
         }
+        profiler.leaveStage();
 
         // Auto-respawn after 2 seconds of death
         if (menu.currentState == GameState::GAME_LOST && playState.deathTime > 0) {
             if (currentTime - playState.deathTime > 2000) {
                 std::cout << "Auto-respawning with new maze..." << std::endl;
-                initializeGame(playState, menu.difficulty);
+                startGame(menu.difficulty);
                 menu.currentState = GameState::PLAYING;
                 SDL_SetRelativeMouseMode(SDL_TRUE);  // Lock mouse
             }
         }
 
         if (menu.currentState == GameState::PLAYING) {
-            // Handle shooting/melee - use weapon's fire rate, not a hardcoded limit
-            if (mousePressed) {
-                float time = static_cast<float>(currentTime) / 1000.0f;
-                WeaponStats currentWeapon = getWeaponStats(playState.player->getCurrentWeapon());
-
-                if (currentWeapon.isMelee) {
-                    // MELEE ATTACK - check for zombies in range
-                    // Check if enough time has passed since last attack
-                    static float lastMeleeTime = 0.0f;
-                    if (time - lastMeleeTime >= currentWeapon.fireRate) {
-                        lastMeleeTime = time;
-
-                        float playerX = playState.player->getX();
-                        float playerY = playState.player->getY();
-                        float angle = playState.player->getAngle();
-
-                        // Check zombies in front of player within melee range
-                        for (auto& zombie : playState.zombies) {
-                            if (!zombie->isDead()) {
-                                float dx = zombie->getX() - playerX;
-                                float dy = zombie->getY() - playerY;
-                                float distance = std::sqrt(dx * dx + dy * dy);
-
-                                // Check if zombie is within melee range
-                                if (distance < currentWeapon.meleeRange) {
-                                    // Check if zombie is in front of player (within 60 degree cone)
-                                    float angleToZombie = std::atan2(dy, dx);
-                                    float angleDiff = angleToZombie - angle;
-                                    // Normalize angle diff
-                                    while (angleDiff > M_PI) angleDiff -= 2.0f * M_PI;
-                                    while (angleDiff < -M_PI) angleDiff += 2.0f * M_PI;
-
-                                    if (std::abs(angleDiff) < M_PI / 6.0f) {  // 60 degree cone
-                                        zombie->takeDamage(currentWeapon.damage);
-                                        // Play melee sound (using shoot sound for now)
-                                        Mix_PlayChannel(-1, shootSound, 0);
-                                        playState.screenShake = 0.15f;
-                                        break;  // Only hit one zombie per swing
-                                    }
-                                }
-                            }
-                        }
-                    }
-                } else {
-                    // RANGED ATTACK - shoot bullets
-                    float angle = playState.player->getAngle();
-                    float pitch = playState.player->getPitch();
-
-                    // Adjust bullet range based on pitch
-                    // Looking up = shoot further, looking down = shoot closer
-                    // This simulates aiming at where the crosshair intersects the ground
-                    float baseRange = 1000.0f;
-                    float pitchFactor = 1.0f + pitch;  // pitch is -PI/3 to PI/3, so factor is ~0.0 to 2.0
-                    pitchFactor = std::max(0.3f, std::min(3.0f, pitchFactor));  // Clamp to reasonable range
-                    float adjustedRange = baseRange * pitchFactor;
-
-                    float targetX = playState.player->getX() + std::cos(angle) * adjustedRange;
-                    float targetY = playState.player->getY() + std::sin(angle) * adjustedRange;
-
-                    bool shotFired = playState.player->shoot(targetX, targetY, playState.bullets, time);
-
-                    if (shotFired) {
-                        Mix_PlayChannel(-1, shootSound, 0);  // Play shoot sound
-                        // Add screen shake
-                        playState.screenShake = 0.2f;  // Shake intensity
-                    }
-                }
-            }
-
-            // Update player
-            const Uint8* keyState = SDL_GetKeyboardState(nullptr);
-            playState.player->handleInput(keyState);
-            playState.player->update(deltaTime, *playState.maze);
-
-            // Testing mode: infinite ammo for all weapons
-            if (playState.difficulty == Difficulty::TESTING) {
-                for (int i = 0; i < 2; i++) {
-                    WeaponStats stats = getWeaponStats(playState.player->getWeaponInSlot(i));
-                    if (stats.maxAmmo > 0) {
-                        playState.player->pickupAmmo(playState.player->getWeaponInSlot(i), stats.maxAmmo);
-                    }
-                }
-            }
-
-            // Soldier mode: infinite ammo for assault rifle
-            if (playState.mazeType == MazeType::SOLDIER) {
-                playState.player->pickupAmmo(WeaponType::ASSAULT_RIFLE, 999999);
-            }
-
-            // SOLDIER MODE: Wave-based spawning system
-            if (playState.mazeType == MazeType::SOLDIER) {
-                // Count alive zombies
-                int aliveZombies = 0;
-                for (const auto& zombie : playState.zombies) {
-                    if (!zombie->isDead()) {
-                        aliveZombies++;
-                    }
-                }
-
-                // If wave is complete (all zombies dead), start delay for next wave
-                if (playState.waveActive && aliveZombies == 0) {
-                    playState.waveActive = false;
-                    playState.waveDelayTimer = playState.waveDelay;
-                    playState.currentWave++;
-                    std::cout << "Wave " << (playState.currentWave - 1) << " complete! Next wave in " << playState.waveDelay << " seconds..." << std::endl;
-                }
-
-                // Update wave delay timer
-                if (!playState.waveActive) {
-                    playState.waveDelayTimer -= deltaTime;
-                    if (playState.waveDelayTimer <= 0.0f) {
-                        // Start new wave!
-                        playState.waveActive = true;
-                        playState.zombies.clear();  // Clear any dead zombies
-
-                        // Calculate zombies for this wave (increases each wave)
-                        int baseZombies = 5;  // Start with 5 zombies per spawn point
-                        int zombiesPerSpawn = baseZombies + (playState.currentWave - 1) * 2;  // +2 per wave
-
-                        // Spawn zombies in the 4 corner maze areas (not in walls!)
-                        int arenaLeft = Maze::WIDTH / 4;
-                        int arenaRight = 3 * Maze::WIDTH / 4;
-                        int arenaTop = Maze::HEIGHT / 4;
-                        int arenaBottom = 3 * Maze::HEIGHT / 4;
-
-                        // Define spawn areas in each corner maze (middle of each corner maze)
-                        std::vector<Vec2> spawnAreas;
-
-                        // Top-left corner maze center
-                        int tlX = (2 + arenaLeft - 1) / 2;
-                        int tlY = (2 + arenaTop - 1) / 2;
-                        spawnAreas.push_back({tlX * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f,
-                                             tlY * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f});
-
-                        // Top-right corner maze center
-                        int trX = (arenaRight + 2 + Maze::WIDTH - 2) / 2;
-                        int trY = (2 + arenaTop - 1) / 2;
-                        spawnAreas.push_back({trX * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f,
-                                             trY * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f});
-
-                        // Bottom-left corner maze center
-                        int blX = (2 + arenaLeft - 1) / 2;
-                        int blY = (arenaBottom + 2 + Maze::HEIGHT - 2) / 2;
-                        spawnAreas.push_back({blX * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f,
-                                             blY * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f});
-
-                        // Bottom-right corner maze center
-                        int brX = (arenaRight + 2 + Maze::WIDTH - 2) / 2;
-                        int brY = (arenaBottom + 2 + Maze::HEIGHT - 2) / 2;
-                        spawnAreas.push_back({brX * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f,
-                                             brY * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f});
-
-                        // Spawn zombies at each spawn area with wider spread
-                        for (const auto& spawnArea : spawnAreas) {
-                            for (int i = 0; i < zombiesPerSpawn; i++) {
-                                // Larger random offset within the spawn area (to spread out zombies)
-                                float offsetX = (rand() % 120 - 60);
-                                float offsetY = (rand() % 120 - 60);
-
-                                // Make sure spawn position is not in a wall
-                                float spawnX = spawnArea.x + offsetX;
-                                float spawnY = spawnArea.y + offsetY;
-                                int tileX = static_cast<int>(spawnX / Maze::TILE_SIZE);
-                                int tileY = static_cast<int>(spawnY / Maze::TILE_SIZE);
-
-                                // If spawning in wall, try center of spawn area instead
-                                if (playState.maze->isWall(tileX, tileY)) {
-                                    spawnX = spawnArea.x;
-                                    spawnY = spawnArea.y;
-                                }
-
-                                ZombieType type = getRandomZombieType();
-                                playState.zombies.push_back(
-                                    std::make_unique<Zombie>(spawnX, spawnY, playState.zombieMaxHealth, type)
-                                );
-                            }
-                        }
-
-                        int totalSpawned = spawnAreas.size() * zombiesPerSpawn;
-                        std::cout << "WAVE " << playState.currentWave << " STARTING! " << totalSpawned << " zombies incoming!" << std::endl;
-                    }
-                }
-            }
-
-            // Update screen shake
-            if (playState.screenShake > 0.0f) {
-                playState.screenShake -= deltaTime * 5.0f;  // Decay shake
-                if (playState.screenShake < 0.0f) playState.screenShake = 0.0f;
-
-                // Generate random shake offset
-                playState.shakeOffsetX = ((float)rand() / RAND_MAX - 0.5f) * playState.screenShake * 10.0f;
-                playState.shakeOffsetY = ((float)rand() / RAND_MAX - 0.5f) * playState.screenShake * 10.0f;
-            } else {
-                playState.shakeOffsetX = 0.0f;
-                playState.shakeOffsetY = 0.0f;
-            }
-
-            // === BLOOD MOON EVENT SYSTEM ===
-            playState.bloodMoonTimer += deltaTime;
-
-            // Check if Blood Moon should start
-            if (!playState.bloodMoonActive && playState.bloodMoonTimer >= playState.bloodMoonInterval) {
-                playState.bloodMoonActive = true;
-                playState.bloodMoonTimer = 0.0f;
-                std::cout << "\n=== BLOOD MOON RISING! ===\n" << std::endl;
-                std::cout << "The zombies grow restless..." << std::endl;
-            }
-
-            // Check if Blood Moon should end
-            if (playState.bloodMoonActive && playState.bloodMoonTimer >= playState.bloodMoonDuration) {
-                playState.bloodMoonActive = false;
-                playState.bloodMoonTimer = 0.0f;
-
-                // Kill half of all zombies when Blood Moon ends
-                int zombiesBeforeCull = 0;
-                int zombiesKilled = 0;
-
-                for (auto& zombie : playState.zombies) {
-                    if (!zombie->isDead()) {
-                        zombiesBeforeCull++;
-                        // 50% chance to kill each zombie
-                        if (rand() % 2 == 0) {
-                            zombie->takeDamage(999);  // Instant kill
-                            zombiesKilled++;
-                        }
-                    }
-                }
-
-                std::cout << "\n=== BLOOD MOON FADES ===\n" << std::endl;
-                std::cout << zombiesKilled << " / " << zombiesBeforeCull << " zombies succumb to exhaustion!" << std::endl;
-
-                if (zombiesKilled > 0) {
-                    Mix_PlayChannel(-1, zombieDeathSound, 0);
-                }
-            }
-
-            // === BLUE ALERT EVENT SYSTEM (Evacuation) ===
-            // Separate timer from blood moon
-            static float blueEventTimer = 0.0f;
-
-            if (!playState.blueAlertActive && !playState.hunterPhaseActive) {
-                blueEventTimer += deltaTime;
-
-                // Debug: show timer every 30 seconds
-                static float debugTimer = 0.0f;
-                debugTimer += deltaTime;
-                if (debugTimer >= 30.0f) {
-                    std::cout << "[DEBUG] Blue event timer: " << blueEventTimer << " / " << playState.blueAlertInterval << " seconds" << std::endl;
-                    debugTimer = 0.0f;
-                }
-
-                // Trigger blue alert every 3 minutes
-                if (blueEventTimer >= playState.blueAlertInterval) {
-                    playState.blueAlertActive = true;
-                    playState.blueAlertTimer = 0.0f;
-                    blueEventTimer = 0.0f;  // Reset for next cycle
-                    playState.safeRoomLocked = false;  // Unlock the room for evacuation
-
-                    // Store safe room coordinates
-                    Vec2 safePos = playState.maze->getSafeRoomPos();
-                    playState.blueRoomX = (int)(safePos.x / Maze::TILE_SIZE);
-                    playState.blueRoomY = (int)(safePos.y / Maze::TILE_SIZE);
-
-                    // KILL ALL ZOMBIES when blue alert starts
-                    int zombiesKilled = 0;
-                    for (auto& zombie : playState.zombies) {
-                        if (!zombie->isDead()) {
-                            while (!zombie->isDead()) {
-                                zombie->takeDamage();
-                            }
-                            zombiesKilled++;
-                        }
-                    }
-
-                    std::cout << "\n=== BLUE ALERT! EVACUATE TO SAFE ROOM! ===\n" << std::endl;
-                    std::cout << "All " << zombiesKilled << " zombies eliminated by evacuation protocol!" << std::endl;
-                    std::cout << "You have 45 seconds to reach the blue room!" << std::endl;
-                }
-            }
-
-            // During blue alert
-            if (playState.blueAlertActive) {
-                playState.blueAlertTimer += deltaTime;
-
-                // Check if player is in safe room
-                int playerTileX = (int)(playState.player->getX() / Maze::TILE_SIZE);
-                int playerTileY = (int)(playState.player->getY() / Maze::TILE_SIZE);
-                playState.inSafeRoom = playState.maze->isSafeRoom(playerTileX, playerTileY);
-
-                // Timer expired - check if player made it
-                if (playState.blueAlertTimer >= playState.blueAlertDuration) {
-                    // LOCK THE SAFE ROOM after timer expires
-                    playState.safeRoomLocked = true;
-                    std::cout << "\n=== SAFE ROOM SEALED! ===\n" << std::endl;
-
-                    if (!playState.inSafeRoom && playState.difficulty != Difficulty::TESTING && !playState.godMode) {
-                        // START HUNTER PHASE instead of instant death!
-                        playState.hunterPhaseActive = true;
-                        playState.hunterPhaseTimer = 0.0f;
-
-                        // Spawn 3-5 fast hunters around the player
-                        int numHunters = 3 + (rand() % 3);  // 3-5 hunters
-                        for (int i = 0; i < numHunters; i++) {
-                            float angle = (float)i * (M_PI * 2.0f / numHunters);
-                            float spawnDist = 200.0f + (rand() % 100);  // 200-300 units away
-                            float spawnX = playState.player->getX() + cos(angle) * spawnDist;
-                            float spawnY = playState.player->getY() + sin(angle) * spawnDist;
-
-                            // Make sure not spawning in wall
-                            int tileX = (int)(spawnX / Maze::TILE_SIZE);
-                            int tileY = (int)(spawnY / Maze::TILE_SIZE);
-                            if (!playState.maze->isWall(tileX, tileY)) {
-                                playState.hunters.push_back(std::make_unique<Zombie>(spawnX, spawnY, 999));
-                            }
-                        }
-
-                        std::cout << "=== FAILED TO EVACUATE! ===\n" << std::endl;
-                        std::cout << "=== HUNTER PHASE ACTIVATED! ===\n" << std::endl;
-                        std::cout << numHunters << " dark hunters have been unleashed!" << std::endl;
-                        std::cout << "Survive for 60 seconds!" << std::endl;
-                    } else if (playState.inSafeRoom) {
-                        std::cout << "=== EVACUATION SUCCESSFUL! ===\n" << std::endl;
-                        std::cout << "You survived the blue alert! The room is now sealed." << std::endl;
-                    }
-
-                    // End the alert
-                    playState.blueAlertActive = false;
-                    playState.blueAlertTimer = 0.0f;
-                }
-            }
-
-            // HUNTER PHASE - 60 seconds of terror!
-            if (playState.hunterPhaseActive) {
-                playState.hunterPhaseTimer += deltaTime;
-
-                // Check if hunter phase is over
-                if (playState.hunterPhaseTimer >= playState.hunterPhaseDuration) {
-                    // Kill all hunters
-                    for (auto& hunter : playState.hunters) {
-                        if (!hunter->isDead()) {
-                            while (!hunter->isDead()) {
-                                hunter->takeDamage();
-                            }
-                        }
-                    }
-                    playState.hunters.clear();
-
-                    playState.hunterPhaseActive = false;
-                    playState.hunterPhaseTimer = 0.0f;
-
-                    std::cout << "\n=== HUNTER PHASE ENDED! ===\n" << std::endl;
-                    std::cout << "You survived! The hunters have retreated." << std::endl;
-                }
-            }
-
-            // Zombie spawning system - spawn reinforcements when zombies are low (SKIP for Soldier mode)
-            if (playState.mazeType != MazeType::SOLDIER) {
-                playState.spawnTimer += deltaTime;
-                if (playState.spawnTimer >= SPAWN_CHECK_INTERVAL) {
-                    playState.spawnTimer = 0.0f;
-
-                    // Count alive zombies
-                int aliveZombies = 0;
-                for (const auto& zombie : playState.zombies) {
-                    if (!zombie->isDead()) {
-                        aliveZombies++;
-                    }
-                }
-
-                // Check if all zombies are dead - spawn new wave
-                if (aliveZombies == 0) {
-                    std::cout << "All zombies eliminated! Spawning new wave..." << std::endl;
-
-                    // Clear dead zombies from the list
-                    playState.zombies.clear();
-
-                    // Spawn a fresh wave (reset spawn counter)
-                    playState.totalZombiesSpawned = 0;
-                    int waveSize = playState.initialZombieCount;
-
-                    // Get spawn positions
-                    Vec2 playerPos = {playState.player->getX(), playState.player->getY()};
-                    auto zombiePositions = playState.maze->getRandomZombiePositions(waveSize, playerPos);
-
-                    for (const auto& pos : zombiePositions) {
-                        ZombieType type = getRandomZombieType();
-                        playState.zombies.push_back(std::make_unique<Zombie>(pos.x, pos.y, playState.zombieMaxHealth, type));
-                    }
-                    playState.totalZombiesSpawned = waveSize;
-
-                    std::cout << "New wave spawned! (" << waveSize << " zombies)" << std::endl;
-                }
-                // Spawn new zombies if below minimum and haven't hit max
-                else if (aliveZombies < playState.minZombieCount && playState.totalZombiesSpawned < playState.maxZombieCount) {
-                    int baseSpawn = 3;  // Base: Spawn 3 at a time
-
-                    // During Blood Moon, spawn 3x more!
-                    if (playState.bloodMoonActive) {
-                        baseSpawn = static_cast<int>(baseSpawn * playState.bloodMoonSpawnMultiplier);
-                    }
-
-                    int toSpawn = std::min(baseSpawn, playState.maxZombieCount - playState.totalZombiesSpawned);
-
-                    // Collect existing zombie positions
-                    std::vector<Vec2> existingPositions;
-                    for (const auto& zombie : playState.zombies) {
-                        if (!zombie->isDead()) {
-                            existingPositions.push_back({zombie->getX(), zombie->getY()});
-                        }
-                    }
-
-                    // Spawn new zombies in areas with fewer zombies
-                    for (int i = 0; i < toSpawn; i++) {
-                        Vec2 spawnPos = playState.maze->getSpawnPositionAwayFromZombies(
-                            existingPositions,
-                            {playState.player->getX(), playState.player->getY()}
-                        );
-                        ZombieType type = getRandomZombieType();
-                        playState.zombies.push_back(std::make_unique<Zombie>(spawnPos.x, spawnPos.y, playState.zombieMaxHealth, type));
-                        existingPositions.push_back(spawnPos);  // Add to list for next spawn
-                        playState.totalZombiesSpawned++;
-                    }
-
-                    std::cout << "Zombie reinforcements spawned! (" << toSpawn << " zombies)" << std::endl;
-                }
-            }
-            }  // End of non-Soldier spawning
-
-            // Update zombies
-            for (auto& zombie : playState.zombies) {
-                zombie->update(deltaTime, playState.player->getX(), playState.player->getY(), *playState.maze, &playState.zombies);
-
-                // FREQUENTLY play CREEPY zombie groans/moans (much more common now!)
-                if (!zombie->isDead() && (rand() % 150) == 0) {  // ~0.67% chance per frame = MUCH more frequent!
-                    // Calculate distance to player for volume adjustment
-                    float dx = zombie->getX() - playState.player->getX();
-                    float dy = zombie->getY() - playState.player->getY();
-                    float distance = std::sqrt(dx * dx + dy * dy);
-
-                    // Play if zombie is within hearing range (800 units = further!)
-                    if (distance < 800.0f) {
-                        // Choose random sound and adjust volume based on distance
-                        // Closer zombies are MUCH louder
-                        float volumeFactor = (1.0f - distance / 800.0f);
-                        int volume = static_cast<int>(MIX_MAX_VOLUME * volumeFactor * 1.2f);  // Louder!
-                        if (volume > MIX_MAX_VOLUME) volume = MIX_MAX_VOLUME;
-
-                        Mix_Chunk* sound = (rand() % 2 == 0) ? zombieGroanSound : zombieMoanSound;
-                        if (sound) {
-                            Mix_VolumeChunk(sound, volume);
-                            Mix_PlayChannel(-1, sound, 0);
-                        }
-                    }
-                }
-
-                // Check if zombie caught player
-                if (zombie->checkCollision(playState.player->getX(), playState.player->getY(), playState.player->getRadius())) {
-                    // In testing mode or with god mode, player is immortal
-                    if (playState.difficulty != Difficulty::TESTING && !playState.godMode) {
-                        if (playState.player->takeDamage()) {
-                            // Player took damage
-                            std::cout << "Hit! Health: " << playState.player->getHealth() << "/" << playState.player->getMaxHealth() << std::endl;
-
-                            // Check if player died
-                            if (playState.player->isDead()) {
-                                menu.currentState = GameState::GAME_LOST;
-                                playState.deathTime = currentTime;
-
-                            // Calculate survival time bonus
-                            int timeSurvived = (currentTime - playState.gameStartTime) / 1000;
-                            playState.score += timeSurvived;
-                            playState.totalScore += playState.score;
-
-                            Mix_PlayChannel(-1, playerDeathSound, 0);  // Play player death sound
-                            std::cout << "You died! Score: " << playState.score << " | Total: " << playState.totalScore << std::endl;
-
-                            // Save high score if applicable
-                            if (isHighScore(playState.totalScore)) {
-                                addHighScore(playState.totalScore, playState.currentLevel,
-                                           mazeTypeToString(playState.mazeType),
-                                           difficultyToString(menu.difficulty));
-                                std::cout << "NEW HIGH SCORE!" << std::endl;
-                            }
-
-                            std::cout << "Respawning in 2 seconds..." << std::endl;
-                        }
-                    }
-                    }
-                }
-            }
-
-            // Update hunters (fast, dark entities)
-            for (auto& hunter : playState.hunters) {
-                // Store previous position in case hunter tries to enter safe room
-                float prevX = hunter->getX();
-                float prevY = hunter->getY();
-
-                // Hunters move faster than zombies - pass the hunter vector instead of zombie vector
-                hunter->update(deltaTime, playState.player->getX(), playState.player->getY(), *playState.maze, &playState.hunters);
-
-                // PREVENT HUNTERS FROM ENTERING BLUE SAFE ROOM
-                int hunterTileX = (int)(hunter->getX() / Maze::TILE_SIZE);
-                int hunterTileY = (int)(hunter->getY() / Maze::TILE_SIZE);
-                if (playState.maze->isSafeRoom(hunterTileX, hunterTileY)) {
-                    // Hunter tried to enter safe room - push them back!
-                    hunter->setPosition(prevX, prevY);
-                }
-
-                // Hunters make scary breathing sounds (no groans)
-                if (!hunter->isDead() && (rand() % 200) == 0) {  // Less frequent than zombies
-                    float dx = hunter->getX() - playState.player->getX();
-                    float dy = hunter->getY() - playState.player->getY();
-                    float distance = std::sqrt(dx * dx + dy * dy);
-
-                    if (distance < 600.0f) {
-                        // Play scary sound (using zombie sound for now, but quieter/different)
-                        float volumeFactor = (1.0f - distance / 600.0f);
-                        int volume = static_cast<int>(MIX_MAX_VOLUME * volumeFactor * 0.5f);  // Quieter
-                        if (volume > MIX_MAX_VOLUME) volume = MIX_MAX_VOLUME;
-
-                        // Use groan sound pitched differently for hunters
-                        if (zombieGroanSound) {
-                            Mix_VolumeChunk(zombieGroanSound, volume);
-                            Mix_PlayChannel(-1, zombieGroanSound, 0);
-                        }
-                    }
-                }
-
-                // Check if hunter caught player
-                if (hunter->checkCollision(playState.player->getX(), playState.player->getY(), playState.player->getRadius())) {
-                    // Hunters damage player in same way as zombies
-                    if (playState.difficulty != Difficulty::TESTING && !playState.godMode) {
-                        if (playState.player->takeDamage()) {
-                            std::cout << "HUNTER HIT! Health: " << playState.player->getHealth() << "/" << playState.player->getMaxHealth() << std::endl;
-
-                            if (playState.player->isDead()) {
-                                menu.currentState = GameState::GAME_LOST;
-                                playState.deathTime = currentTime;
-
-                                int timeSurvived = (currentTime - playState.gameStartTime) / 1000;
-                                playState.score += timeSurvived;
-                                playState.totalScore += playState.score;
-
-                                Mix_PlayChannel(-1, playerDeathSound, 0);
-                                std::cout << "Killed by hunter! Score: " << playState.score << " | Total: " << playState.totalScore << std::endl;
-
-                                if (isHighScore(playState.totalScore)) {
-                                    addHighScore(playState.totalScore, playState.currentLevel,
-                                               mazeTypeToString(playState.mazeType),
-                                               difficultyToString(menu.difficulty));
-                                    std::cout << "NEW HIGH SCORE!" << std::endl;
-                                }
-
-                                std::cout << "Respawning in 2 seconds..." << std::endl;
-                            }
-                        }
-                    }
-                }
-            }
-
-            // Proximity beep system - beep faster as closest zombie gets nearer
-            playState.proximityBeepTimer += deltaTime;
-
-            // Find closest alive zombie
-            float closestDistance = 99999.0f;
-            for (const auto& zombie : playState.zombies) {
-                if (!zombie->isDead()) {
-                    float dx = zombie->getX() - playState.player->getX();
-                    float dy = zombie->getY() - playState.player->getY();
-                    float distance = std::sqrt(dx * dx + dy * dy);
-                    if (distance < closestDistance) {
-                        closestDistance = distance;
-                    }
-                }
-            }
-
-            // Calculate beep interval based on distance (closer = faster beeps)
-            // Very close (< 100): 0.2s, Close (< 200): 0.5s, Medium (< 400): 1.0s, Far (< 600): 2.0s, Very far: 3.0s
-            if (closestDistance < 100.0f) {
-                playState.proximityBeepInterval = 0.2f;
-            } else if (closestDistance < 200.0f) {
-                playState.proximityBeepInterval = 0.5f;
-            } else if (closestDistance < 400.0f) {
-                playState.proximityBeepInterval = 1.0f;
-            } else if (closestDistance < 600.0f) {
-                playState.proximityBeepInterval = 2.0f;
-            } else {
-                playState.proximityBeepInterval = 3.0f;
-            }
-
-            // Play beep if timer exceeds interval
-            if (playState.proximityBeepTimer >= playState.proximityBeepInterval && closestDistance < 600.0f) {
-                playState.proximityBeepTimer = 0.0f;
-                if (proximityBeepSound) {
-                    // Adjust volume based on distance (closer = louder)
-                    int volume = static_cast<int>(MIX_MAX_VOLUME * 0.3f * (1.0f - closestDistance / 600.0f));
-                    Mix_VolumeChunk(proximityBeepSound, volume);
-                    Mix_PlayChannel(-1, proximityBeepSound, 0);
-                }
-            }
-
-            // Update bullets
-            for (auto& bullet : playState.bullets) {
-                // Store old position for collision checking along the bullet's path
-                float oldX = bullet->getX();
-                float oldY = bullet->getY();
-
-                bullet->update(deltaTime, *playState.maze);
-
-                // Check bullet-zombie collision (check along the bullet's path to avoid missing fast-moving bullets)
-                if (bullet->isActive()) {
-                    float newX = bullet->getX();
-                    float newY = bullet->getY();
-
-                    // Calculate distance traveled this frame
-                    float dx = newX - oldX;
-                    float dy = newY - oldY;
-                    float distTraveled = std::sqrt(dx * dx + dy * dy);
-
-                    // Check more points for faster bullets to ensure no misses
-                    int numChecks = std::max(10, static_cast<int>(distTraveled / 5.0f));
-                    bool hitSomething = false;
-                    float explosionX = 0.0f;
-                    float explosionY = 0.0f;
-
-                    for (int i = 0; i <= numChecks && !hitSomething; i++) {
-                        float t = static_cast<float>(i) / numChecks;
-                        float checkX = oldX + (newX - oldX) * t;
-                        float checkY = oldY + (newY - oldY) * t;
-
-                        // For explosive bullets, also check if hit wall for explosion
-                        if (bullet->isExplosive()) {
-                            int tileX = static_cast<int>(checkX / Maze::TILE_SIZE);
-                            int tileY = static_cast<int>(checkY / Maze::TILE_SIZE);
-                            if (playState.maze->isWall(tileX, tileY)) {
-                                hitSomething = true;
-                                explosionX = checkX;
-                                explosionY = checkY;
-                                bullet->deactivate();
-                                break;
-                            }
-                        }
-
-                        for (auto& zombie : playState.zombies) {
-                            if (!zombie->isDead() &&
-                                zombie->checkCollision(checkX, checkY, bullet->getRadius())) {
-                                hitSomething = true;
-                                explosionX = checkX;
-                                explosionY = checkY;
-
-                                if (!bullet->isExplosive()) {
-                                    // Regular bullet: single target damage
-                                    zombie->takeDamage(bullet->getDamage());
-
-                                    // Award points and play sound only on death
-                                    if (zombie->isDead()) {
-                                        playState.zombiesKilled++;
-                                        playState.score += 100;  // 100 points per zombie kill
-                                        Mix_PlayChannel(-1, zombieDeathSound, 0);  // Play zombie death sound
-                                    }
-                                }
-
-                                bullet->deactivate();
-                                break;
-                            }
-                        }
-
-                        // Check hunters
-                        for (auto& hunter : playState.hunters) {
-                            if (!hunter->isDead() &&
-                                hunter->checkCollision(checkX, checkY, bullet->getRadius())) {
-                                hitSomething = true;
-                                explosionX = checkX;
-                                explosionY = checkY;
-
-                                if (!bullet->isExplosive()) {
-                                    // Regular bullet: single target damage
-                                    hunter->takeDamage(bullet->getDamage());
-
-                                    // Award MORE points for killing hunters (they're harder)
-                                    if (hunter->isDead()) {
-                                        playState.score += 500;  // 500 points per hunter kill
-                                        Mix_PlayChannel(-1, zombieDeathSound, 0);  // Play death sound
-                                        std::cout << "Hunter eliminated! +500 points" << std::endl;
-                                    }
-                                }
-
-                                bullet->deactivate();
-                                break;
-                            }
-                        }
-                    }
-
-                    // EXPLOSIVE DAMAGE: If this was an explosive bullet and it hit something
-                    if (hitSomething && bullet->isExplosive()) {
-                        float explosionRadius = bullet->getExplosionRadius();
-                        int zombiesKilledInExplosion = 0;
-
-                        // Damage ALL zombies within explosion radius
-                        for (auto& zombie : playState.zombies) {
-                            if (!zombie->isDead()) {
-                                float dx = zombie->getX() - explosionX;
-                                float dy = zombie->getY() - explosionY;
-                                float distance = std::sqrt(dx * dx + dy * dy);
-
-                                if (distance <= explosionRadius) {
-                                    // Damage falls off with distance (full damage at center, 50% at edge)
-                                    float damageMult = 1.0f - (distance / explosionRadius) * 0.5f;
-                                    int damage = static_cast<int>(bullet->getDamage() * damageMult);
-                                    zombie->takeDamage(damage);
-
-                                    // Award points for kills
-                                    if (zombie->isDead()) {
-                                        zombiesKilledInExplosion++;
-                                        playState.zombiesKilled++;
-                                        playState.score += 100;
-                                    }
-                                }
-                            }
-                        }
-
-                        // Damage ALL hunters within explosion radius
-                        int huntersKilledInExplosion = 0;
-                        for (auto& hunter : playState.hunters) {
-                            if (!hunter->isDead()) {
-                                float dx = hunter->getX() - explosionX;
-                                float dy = hunter->getY() - explosionY;
-                                float distance = std::sqrt(dx * dx + dy * dy);
-
-                                if (distance <= explosionRadius) {
-                                    float damageMult = 1.0f - (distance / explosionRadius) * 0.5f;
-                                    int damage = static_cast<int>(bullet->getDamage() * damageMult);
-                                    hunter->takeDamage(damage);
-
-                                    if (hunter->isDead()) {
-                                        huntersKilledInExplosion++;
-                                        playState.score += 500;  // 500 points per hunter
-                                    }
-                                }
-                            }
-                        }
-
-                        // Play explosion sound if zombies or hunters were killed
-                        if (zombiesKilledInExplosion > 0 || huntersKilledInExplosion > 0) {
-                            Mix_PlayChannel(-1, zombieDeathSound, 0);
-                            if (zombiesKilledInExplosion > 0 && huntersKilledInExplosion > 0) {
-                                std::cout << "EXPLOSION! Killed " << zombiesKilledInExplosion << " zombies and " << huntersKilledInExplosion << " hunters!" << std::endl;
-                            } else if (zombiesKilledInExplosion > 0) {
-                                std::cout << "EXPLOSION! Killed " << zombiesKilledInExplosion << " zombies!" << std::endl;
-                            } else {
-                                std::cout << "EXPLOSION! Killed " << huntersKilledInExplosion << " hunters!" << std::endl;
-                            }
-                        }
-
-                        // Add screen shake for explosion
-                        playState.screenShake = 0.5f;
-                    }
-                }
-            }
-
-            // Remove inactive bullets
-            playState.bullets.erase(
-                std::remove_if(playState.bullets.begin(), playState.bullets.end(),
-                    [](const auto& b) { return !b->isActive(); }),
-                playState.bullets.end()
-            );
-
-            // Check key collection
-            for (auto& key : playState.keys) {
-                if (key->checkCollision(playState.player->getX(), playState.player->getY(), playState.player->getRadius())) {
-                    if (!key->isCollected()) {
-                        key->collect();
-                        playState.player->addKey();
-                        playState.score += 250;  // 250 points per key
-                        Mix_PlayChannel(-1, keySound, 0);  // Play key collection sound
-                        std::cout << "Key collected! (" << playState.player->getKeys() << "/" << playState.maze->getRequiredKeyCount() << ") +250 points!" << std::endl;
-                    }
-                }
-            }
-
-            // Check weapon pickup (collect new weapons to spawn after loop to avoid iterator invalidation)
-            std::vector<std::unique_ptr<WeaponPickup>> newWeaponsToSpawn;
-            for (auto& weapon : playState.weaponPickups) {
-                if (weapon->checkCollision(playState.player->getX(), playState.player->getY(), playState.player->getRadius())) {
-                    if (!weapon->isCollected()) {
-                        WeaponType pickedWeapon = weapon->getType();
-                        WeaponStats stats = getWeaponStats(pickedWeapon);
-
-                        if (weapon->getIsAmmo()) {
-                            // This is an ammo pickup
-                            playState.player->pickupAmmo(pickedWeapon, stats.ammoPerPickup);
-                            weapon->collect();
-                            std::cout << "Picked up ammo for: " << stats.name << " (+" << stats.ammoPerPickup << ")" << std::endl;
-                        } else {
-                            // This is a weapon pickup
-                            playState.player->pickupWeapon(pickedWeapon);
-                            weapon->collect();
-                            std::cout << "Picked up: " << stats.name << " (" << stats.maxAmmo << " rounds)" << std::endl;
-                        }
-
-                        // Prepare a new random weapon pickup (spawn after loop to avoid iterator invalidation)
-                        auto newPos = playState.maze->getRandomKeyPositions(1);
-                        if (!newPos.empty()) {
-                            // Randomly choose a weapon type (exclude pistol which everyone starts with)
-                            WeaponType newWeaponType = static_cast<WeaponType>(rand() % 7);
-                            if (newWeaponType == WeaponType::PISTOL) {
-                                newWeaponType = WeaponType::SHOTGUN;  // Replace pistol with shotgun
-                            }
-                            newWeaponsToSpawn.push_back(
-                                std::make_unique<WeaponPickup>(newPos[0].x, newPos[0].y, newWeaponType, false)
-                            );
-                        }
+            updateScreenShake(playState, frameTime);
+
+            TickInput input;
+            input.keyState = SDL_GetKeyboardState(nullptr);
+            input.firing = mousePressed;
+
+            // As many fixed ticks as real time allows (none on some fast
+            // frames); each is stamped with the moment it stands for
+            tickAccumulator += frameTime;
+            TickOutcome outcome = TickOutcome::PLAYING;
+            while (tickAccumulator >= SIMULATION_STEP && outcome == TickOutcome::PLAYING) {
+                tickAccumulator -= SIMULATION_STEP;
+                if (replaying) {
+                    // Deaths and wins play straight on: the recording holds the restart
+                    TickOutcome replayed;
+                    if (!replay.step(playState, replayed)) {
+                        replay.report();
+                        replaying = false;
+                        running = false;
+                        break;
                     }
+                    continue;
+                }
+                Uint32 tickTime = currentTime - static_cast<Uint32>(tickAccumulator * 1000.0f);
+                recorder.recordTick(playState, input, tickTime);
+                outcome = stepSimulation(playState, input, SIMULATION_STEP, tickTime);
+            }
+            if (outcome != TickOutcome::PLAYING) {
+                tickAccumulator = 0.0f;  // The rest belonged to the life or level that just ended
+            }
+            playState.renderAlpha = outcome == TickOutcome::PLAYING ? tickAccumulator / SIMULATION_STEP : 1.0f;
+
+            // World state next to the frame spans, so spikes line up with their cause
+            if (trace && trace->isRecording()) {
+                trace->addCounter("world", TraceRecorder::Clock::now(),
+                                  {{"zombies", static_cast<int>(playState.zombies.size())},
+                                   {"hunters", static_cast<int>(playState.hunters.size())},
+                                   {"bullets", static_cast<int>(playState.bullets.size())}});
+                trace->addCounter("events", TraceRecorder::Clock::now(),
+                                  {{"bloodMoon", playState.bloodMoonActive ? 1 : 0},
+                                   {"blueAlert", playState.blueAlertActive ? 1 : 0},
+                                   {"hunterPhase", playState.hunterPhaseActive ? 1 : 0}});
+                AllocationStats memory = getAllocationStats();
+                if (memory.enabled) {
+                    auto kib = [&memory](AllocationTag tag) {
+                        return static_cast<int>(memory.liveBytesByTag[static_cast<int>(tag)] / 1024);
+                    };
+                    trace->addCounter("heap KiB", TraceRecorder::Clock::now(),
+                                      {{"total", static_cast<int>(memory.liveBytes / 1024)},
+                                       {"zombies", kib(AllocationTag::ZOMBIES)},
+                                       {"bullets", kib(AllocationTag::BULLETS)},
+                                       {"maze", kib(AllocationTag::MAZE)}});
                 }
             }
-            // Now safely add new weapons after iteration is complete
-            for (auto& newWeapon : newWeaponsToSpawn) {
-                playState.weaponPickups.push_back(std::move(newWeapon));
-            }
 
-            // Check health boost collection (always maintain 3 in world)
-            for (auto& healthBoost : playState.healthBoosts) {
-                if (healthBoost->checkCollision(playState.player->getX(), playState.player->getY(), playState.player->getRadius())) {
-                    if (!healthBoost->isCollected()) {
-                        bool healed = false;
-                        // Heal player if not at max health
-                        if (playState.player->getHealth() < playState.player->getMaxHealth()) {
-                            playState.player->heal(1);
-                            healed = true;
-                        }
-
-                        // ALWAYS refill ammo for both weapon slots
-                        for (int i = 0; i < 2; i++) {
-                            WeaponType weapon = playState.player->getWeaponInSlot(i);
-                            WeaponStats stats = getWeaponStats(weapon);
-                            if (stats.maxAmmo > 0) {
-                                playState.player->pickupAmmo(weapon, stats.maxAmmo);
-                            }
-                        }
+            if (outcome == TickOutcome::PLAYER_DIED) {
+                menu.currentState = GameState::GAME_LOST;
+            } else if (outcome == TickOutcome::LEVEL_WON) {
+                // Regular game modes - show win screen
+                menu.currentState = GameState::GAME_WON;
+                std::cout << "You win! Score: " << playState.score << " | Total: " << playState.totalScore << std::endl;
 
-                        healthBoost->collect();
-
-                        // Respawn at new random location
-                        auto newPos = playState.maze->getRandomKeyPositions(1);
-                        if (!newPos.empty()) {
-                            healthBoost->respawn(newPos[0].x, newPos[0].y);
-                        }
-
-                        playState.score += 50;  // 50 points for health boost
-                        Mix_PlayChannel(-1, keySound, 0);  // Play collection sound
-                        if (healed) {
-                            std::cout << "Health boost collected! +1 HP (now " << playState.player->getHealth() << "/" << playState.player->getMaxHealth() << ") + Full Ammo +50 points!" << std::endl;
-                        } else {
-                            std::cout << "Health boost collected! Full Ammo +50 points!" << std::endl;
-                        }
-                    }
-                }
-            }
-
-            // Check if current weapon is out of ammo - convert all matching pickups to ammo
-            if (playState.player->isOutOfAmmo()) {
-                WeaponType currentWeapon = playState.player->getCurrentWeapon();
-                bool converted = false;
-                for (auto& weapon : playState.weaponPickups) {
-                    if (!weapon->isCollected() && weapon->getType() == currentWeapon && !weapon->getIsAmmo()) {
-                        weapon->convertToAmmo();
-                        converted = true;
-                    }
-                }
-                if (converted) {
-                    WeaponStats stats = getWeaponStats(currentWeapon);
-                    std::cout << "Out of ammo! All " << stats.name << " pickups converted to ammo!" << std::endl;
+                // Save high score if applicable
+                if (!replaying && isHighScore(playState.totalScore)) {
+                    addHighScore(playState.totalScore, playState.currentLevel,
+                               mazeTypeToString(playState.mazeType),
+                               difficultyToString(menu.difficulty));
+                    std::cout << "NEW HIGH SCORE!" << std::endl;
                 }
-            }
 
-            // Check if player reached exit with all keys
-            int exitX = static_cast<int>(playState.player->getX() / Maze::TILE_SIZE);
-            int exitY = static_cast<int>(playState.player->getY() / Maze::TILE_SIZE);
-            int requiredKeys = playState.maze->getRequiredKeyCount(playState.currentLevel);
-
-            // ALWAYS require keys to exit - no exceptions for any difficulty!
-            bool hasAllKeys = (playState.player->getKeys() >= requiredKeys);
-            bool isOnExit = playState.maze->isExit(exitX, exitY);
-
-            // Warn player if they're at exit but don't have all keys
-            if (isOnExit && !hasAllKeys) {
-                static float lastWarningTime = 0.0f;
-                if (currentTime - lastWarningTime > 2000) {  // Show warning every 2 seconds
-                    int keysNeeded = requiredKeys - playState.player->getKeys();
-                    std::cout << "EXIT LOCKED! Need " << keysNeeded << " more key(s) to escape! ("
-                              << playState.player->getKeys() << "/" << requiredKeys << ")" << std::endl;
-                    lastWarningTime = currentTime;
-                }
-            }
-
-            if (isOnExit && hasAllKeys) {
-                // Bonus points for completing level
-                playState.score += 500;
-
-                // Time bonus (1 point per second)
-                int timeSurvived = (currentTime - playState.gameStartTime) / 1000;
-                playState.score += timeSurvived;
-
-                playState.totalScore += playState.score;
-
-                // Check if infinite mode - if so, regenerate and continue
-                if (playState.mazeType == MazeType::INFINITE) {
-                    playState.currentLevel++;
-                    std::cout << "Level " << (playState.currentLevel - 1) << " Complete! " << std::endl;
-                    std::cout << "Score: " << playState.score << " | Total: " << playState.totalScore << std::endl;
-                    std::cout << "Starting Level " << playState.currentLevel << "..." << std::endl;
-
-                    // Save player health and weapons before regenerating
-                    int playerHealth = playState.player->getHealth();
-                    WeaponType weapon0 = playState.player->getWeaponInSlot(0);
-                    WeaponType weapon1 = playState.player->getWeaponInSlot(1);
-                    int ammo0 = playState.player->getAmmoInSlot(0);
-                    int ammo1 = playState.player->getAmmoInSlot(1);
-                    int weaponSlot = playState.player->getCurrentWeaponSlot();
-
-                    // Regenerate the maze (passing true for isLevelProgression)
-                    initializeGame(playState, menu.difficulty, playState.mazeType, true);
-
-                    // Restore player state
-                    for (int i = 0; i < playerHealth; i++) {
-                        playState.player->heal(1);
-                    }
-                    // Restore weapons (this is a bit hacky but works)
-                    if (weapon0 != WeaponType::SHOTGUN || weapon1 != WeaponType::SHOTGUN) {
-                        playState.player->pickupWeapon(weapon0);
-                        playState.player->switchWeapon();
-                        playState.player->pickupWeapon(weapon1);
-                        if (weaponSlot == 0) {
-                            playState.player->switchWeapon();
-                        }
-                    }
-                    // Note: ammo restoration would require more complex logic, skipping for now
-                } else {
-                    // Regular game modes - show win screen
-                    menu.currentState = GameState::GAME_WON;
-                    std::cout << "You win! Score: " << playState.score << " | Total: " << playState.totalScore << std::endl;
-
-                    // Save high score if applicable
-                    if (isHighScore(playState.totalScore)) {
-                        addHighScore(playState.totalScore, playState.currentLevel,
-                                   mazeTypeToString(playState.mazeType),
-                                   difficultyToString(menu.difficulty));
-                        std::cout << "NEW HIGH SCORE!" << std::endl;
-                    }
-
-                    std::cout << "Press R to play again or ESC to quit." << std::endl;
-                }
+                std::cout << "Press R to play again or ESC to quit." << std::endl;
             }
         }
 
+        // Sounds, log lines, shake and high scores queued by the simulation
+        drainGameEvents(playState, !replaying);
+
         // Render
         SDL_SetRenderDrawColor(renderer, 20, 20, 20, 255);
         SDL_RenderClear(renderer);
@@ -4570,11 +2384,12 @@ void Game::run() {
                    menu.currentState == GameState::GAME_WON || menu.currentState == GameState::GAME_LOST) {
             // Render first-person view
             renderFirstPersonView(renderer, playState);
+            profiler.enterStage(ProfileStage::HUD);
 
             // Guard against null player before rendering UI
             if (!playState.player) {
                 SDL_RenderPresent(renderer);
-                continue;
+                return;
             }
 
             // Render UI - key count
@@ -4897,11 +2712,28 @@ void Game::run() {
                 std::string timeStr = std::to_string(remainingTime) + "s";
                 renderText(renderer, timeStr.c_str(), screenW/2 - 12, 108, 2);
 
-                // Arrow pointing to safe room (if not in it)
+                // Arrow pointing along the route to the safe room (if not in it)
                 if (!playState.inSafeRoom) {
-                    Vec2 safePos = playState.maze->getSafeRoomPos();
-                    float dx = safePos.x - playState.player->getX();
-                    float dy = safePos.y - playState.player->getY();
+                    // Aim a few tiles ahead on the precomputed route rather than
+                    // straight through the walls
+                    const int ROUTE_LOOKAHEAD = 3;
+                    const DistanceField& safeField = playState.maze->getSafeRoomField();
+                    int tileX = static_cast<int>(playState.player->getX() / Maze::TILE_SIZE);
+                    int tileY = static_cast<int>(playState.player->getY() / Maze::TILE_SIZE);
+                    int routeTiles = safeField.getDistance(tileX, tileY);
+                    Vec2 aim = playState.maze->getSafeRoomPos();
+                    if (routeTiles > 0) {
+                        int x = tileX, y = tileY, nextX, nextY;
+                        for (int step = 0; step < ROUTE_LOOKAHEAD && safeField.getNextStep(x, y, nextX, nextY); step++) {
+                            x = nextX;
+                            y = nextY;
+                        }
+                        aim = {(x + 0.5f) * Maze::TILE_SIZE, (y + 0.5f) * Maze::TILE_SIZE};
+                        std::string routeStr = std::to_string(routeTiles) + " TILES";
+                        renderText(renderer, routeStr.c_str(), screenW/2 + 40, 144, 2);
+                    }
+                    float dx = aim.x - playState.player->getX();
+                    float dy = aim.y - playState.player->getY();
                     float angleToRoom = std::atan2(dy, dx);
 
                     // Draw arrow at center top of screen
@@ -4977,19 +2809,50 @@ void Game::run() {
                 renderTestingPanel(renderer, playState);
             }
 
+            // Render frame profiler (F3 to toggle)
+            if (playState.showProfiler) {
+                renderProfilerOverlay(renderer, profiler);
+            }
+
             // Render pause menu overlay
             if (menu.currentState == GameState::PAUSED) {
                 renderPauseMenu(renderer, menu);
             }
         }
 
+        profiler.enterStage(ProfileStage::PRESENT);
         SDL_RenderPresent(renderer);
-    }
+        profiler.leaveStage();
+    };
+
+    auto shutdown = [&]() {
+        recorder.close(playState);
+        if (trace) {
+            trace->finish();  // Fewer frames than requested were played
+            setActiveTrace(nullptr);
+        }
+        cleanupSounds();
+        Mix_CloseAudio();
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+    };
 
-    // Cleanup
-    cleanupSounds();
-    Mix_CloseAudio();
-    SDL_DestroyRenderer(renderer);
-    SDL_DestroyWindow(window);
-    SDL_Quit();
+#ifdef __EMSCRIPTEN__
+    // fps 0 means requestAnimationFrame. simulate_infinite_loop = 1 doesn't
+    // return here, so the locals above stay alive for the callbacks.
+    auto webFrame = [&]() {
+        runFrame();
+        if (!running) {
+            emscripten_cancel_main_loop();
+            shutdown();
+        }
+    };
+    emscripten_set_main_loop_arg([](void* frame) { (*static_cast<decltype(webFrame)*>(frame))(); }, &webFrame, 0, 1);
+#else
+    while (running) {
+        runFrame();
+    }
+    shutdown();
+#endif
 }
@@ -2,6 +2,10 @@
 #define ZOMBIE_GAME_H
 
 #include <SDL.h>
+#include <cstdint>
+#include <string>
+#include "maze.h"
+#include "simulation.h"
 
 enum class GameState {
     MENU,
@@ -15,16 +19,24 @@ enum class GameState {
     GAME_LOST
 };
 
-enum class Difficulty {
-    EASY,
-    NORMAL,
-    HARD,
-    TESTING
+// Startup settings taken from the command line
+struct GameOptions {
+    int mazeWidth = Maze::DEFAULT_WIDTH;   // Tiles; Maze clamps to its supported range
+    int mazeHeight = Maze::DEFAULT_HEIGHT;
+    bool hasSeed = false;                  // Otherwise a random session seed is chosen
+    std::uint64_t seed = 0;
+    bool endlessWorld = false;             // Infinite mode streams one unbounded world
+    std::string mazeFile;                  // Play this saved maze instead of generating
+    std::string saveMazePath;              // Write the first generated maze here
+    std::string tracePath;                 // Chrome trace of the first traceFrames frames
+    int traceFrames = 600;
+    std::string recordPath;                // Record every tick's input here (see replay.h)
+    std::string replayPath;                // Play back a recording instead of live input
 };
 
 class Game {
 public:
-    static void run();
+    static void run(const GameOptions& options = GameOptions());
 
     static constexpr int SCREEN_WIDTH = 960;   // 32 tiles * 30 pixels
     static constexpr int SCREEN_HEIGHT = 720;  // 24 tiles * 30 pixels
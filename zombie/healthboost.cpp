@@ -1,5 +1,4 @@
 #include "healthboost.h"
-#include <cmath>
 
 HealthBoost::HealthBoost(float x, float y) : x(x), y(y), collected(false) {}
 
@@ -45,16 +44,6 @@ void HealthBoost::render(SDL_Renderer* renderer) const {
     SDL_RenderDrawRect(renderer, &glow);
 }
 
-bool HealthBoost::checkCollision(float px, float py, float radius) const {
-    if (collected) return false;
-
-    float dx = px - x;
-    float dy = py - y;
-    float dist = std::sqrt(dx*dx + dy*dy);
-
-    return dist < (radius + SIZE/2);
-}
-
 void HealthBoost::respawn(float newX, float newY) {
     x = newX;
     y = newY;
@@ -2,16 +2,18 @@
 #define ZOMBIE_HEALTHBOOST_H
 
 #include <SDL.h>
+#include "allocation.h"
 
-class HealthBoost {
+class HealthBoost : public TaggedAllocation<AllocationTag::ITEMS> {
 public:
     HealthBoost(float x, float y);
 
     void render(SDL_Renderer* renderer) const;
-    bool checkCollision(float px, float py, float radius) const;
 
     float getX() const { return x; }
     float getY() const { return y; }
+    void translate(float dx, float dy) { x += dx; y += dy; }
+    float getRadius() const { return SIZE / 2; }  // Pickup radius for the collision phase
     bool isCollected() const { return collected; }
     void collect() { collected = true; }
     void respawn(float newX, float newY);
@@ -66,13 +66,3 @@ void Key::render(SDL_Renderer* renderer, bool highlight) const {
     SDL_RenderDrawRect(renderer, &keyHead);
     SDL_RenderDrawRect(renderer, &keyShaft);
 }
-
-bool Key::checkCollision(float px, float py, float radius) const {
-    if (collected) return false;
-
-    float dx = px - x;
-    float dy = py - y;
-    float dist = std::sqrt(dx*dx + dy*dy);
-
-    return dist < (radius + SIZE/2);
-}
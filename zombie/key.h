@@ -2,16 +2,17 @@
 #define ZOMBIE_KEY_H
 
 #include <SDL.h>
+#include "allocation.h"
 
-class Key {
+class Key : public TaggedAllocation<AllocationTag::ITEMS> {
 public:
     Key(float x, float y);
 
     void render(SDL_Renderer* renderer, bool highlight = false) const;
-    bool checkCollision(float px, float py, float radius) const;
 
     float getX() const { return x; }
     float getY() const { return y; }
+    float getRadius() const { return SIZE / 2; }  // Pickup radius for the collision phase
     bool isCollected() const { return collected; }
     void collect() { collected = true; }
 
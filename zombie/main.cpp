@@ -1,7 +1,62 @@
 #include "game.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 int main(int argc, char* argv[]) {
+    GameOptions options;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--maze-size") == 0 && i + 1 < argc) {
+            // WIDTHxHEIGHT, or a single number for a square maze
+            int w = 0, h = 0;
+            int parsed = std::sscanf(argv[++i], "%dx%d", &w, &h);
+            if (parsed == 1) h = w;
+            if (parsed < 1 || w <= 0 || h <= 0) {
+                std::cerr << "Invalid --maze-size '" << argv[i] << "', expected WIDTHxHEIGHT" << std::endl;
+                return 1;
+            }
+            options.mazeWidth = w;
+            options.mazeHeight = h;
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            // Same seed, same mazes, spawns and enemy behaviour
+            char* end = nullptr;
+            errno = 0;
+            unsigned long long seed = std::strtoull(argv[++i], &end, 0);
+            if (errno != 0 || end == argv[i] || *end != '\0') {
+                std::cerr << "Invalid --seed '" << argv[i] << "', expected an unsigned integer" << std::endl;
+                return 1;
+            }
+            options.seed = seed;
+            options.hasSeed = true;
+        } else if (std::strcmp(argv[i], "--maze-file") == 0 && i + 1 < argc) {
+            options.mazeFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--save-maze") == 0 && i + 1 < argc) {
+            options.saveMazePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--endless") == 0) {
+            options.endlessWorld = true;
+        } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            options.tracePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--trace-frames") == 0 && i + 1 < argc) {
+            options.traceFrames = std::atoi(argv[++i]);
+            if (options.traceFrames <= 0) {
+                std::cerr << "Invalid --trace-frames '" << argv[i] << "', expected a positive count" << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            options.recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            options.replayPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            std::cerr << "Usage: " << argv[0] << " [--maze-size WIDTHxHEIGHT] [--seed N] [--endless]"
+                      << " [--maze-file PATH] [--save-maze PATH] [--trace PATH] [--trace-frames N]"
+                      << " [--record PATH] [--replay PATH]" << std::endl;
+            return 1;
+        }
+    }
+
     std::cout << "Zombie Maze Shooter" << std::endl;
     std::cout << "===================" << std::endl;
     std::cout << "Controls:" << std::endl;
@@ -20,9 +75,12 @@ int main(int argc, char* argv[]) {
     std::cout << "  - Randomly generated maze each life!" << std::endl;
     std::cout << "  - Auto-respawn after 2 seconds on death" << std::endl;
     std::cout << "  - Press R to respawn immediately" << std::endl;
+    std::cout << "  - Start with --maze-size WIDTHxHEIGHT for bigger mazes (up to "
+              << Maze::MAX_DIMENSION << "x" << Maze::MAX_DIMENSION << ")" << std::endl;
+    std::cout << "  - Start with --endless to make Infinite mode one endless world" << std::endl;
     std::cout << std::endl;
 
-    Game::run();
+    Game::run(options);
 
     return 0;
 }
@@ -1,46 +1,445 @@
 #include "maze.h"
-#include <random>
+#include "allocation.h"
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    struct MazeFileHeader {
+        char magic[4];            // "ZMAZ"
+        std::uint16_t version;
+        std::uint8_t mazeType;
+        std::uint8_t tileBits;    // Always 2
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint64_t seed;
+        float safeRoomX, safeRoomY;
+        std::uint32_t exitCount;
+        std::uint32_t reserved;
+    };
+    static_assert(sizeof(MazeFileHeader) == 40, "maze file header layout changed");
+
+    const char MAZE_FILE_MAGIC[4] = {'Z', 'M', 'A', 'Z'};
+
+    // Uniform sample of up to `capacity` tiles from a scan (reservoir
+    // sampling), so spawn queries need O(k) memory however big the maze is
+    class TileReservoir {
+    public:
+        explicit TileReservoir(int maxTiles) : capacity(std::max(maxTiles, 0)), seen(0) {
+            tiles.reserve(capacity);
+        }
+
+        void offer(int x, int y, Rng& rng) {
+            seen++;
+            if (static_cast<int>(tiles.size()) < capacity) {
+                tiles.push_back({x, y});
+                return;
+            }
+            int slot = rng.nextBelow(seen);
+            if (slot < capacity) {
+                tiles[slot] = {x, y};
+            }
+        }
+
+        const std::vector<std::pair<int, int>>& get() const { return tiles; }
+
+    private:
+        int capacity;
+        int seen;
+        std::vector<std::pair<int, int>> tiles;
+    };
+
+    // True if every tile in [minX, maxX] x [minY, maxY] is within the disk,
+    // i.e. no tile of that region can pass a "farther than" test
+    bool regionInsideDisk(int minX, int minY, int maxX, int maxY, int cx, int cy, int radiusSq) {
+        int dx = std::max(std::abs(minX - cx), std::abs(maxX - cx));
+        int dy = std::max(std::abs(minY - cy), std::abs(maxY - cy));
+        return dx * dx + dy * dy <= radiusSq;
+    }
+
+    Vec2 tileCenter(std::pair<int, int> tile) {
+        return {tile.first * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f, tile.second * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f};
+    }
+
+    bool anyRegion(int, int, int, int) { return true; }
+
+    // Horizontal run of open cells, a node of connectRegions' union-find
+    struct OpenRun {
+        int start, end;  // Padded cells [start, end) within one row
+        int parent;      // A root is its own parent
+    };
+
+    // Reused across mazes built on the same thread
+    thread_local std::vector<OpenRun> openRuns;
+
+    // Randomized depth-first backtracker over the odd cells of a width x
+    // height grid, from (cx, cy). isWall(x, y) reads a tile and open(x, y)
+    // carves one; shared by the maze and the standalone carvePassages.
+    template <typename IsWall, typename Open>
+    void carveBacktracker(int width, int height, int cx, int cy, Rng& rng, IsWall isWall, Open open) {
+        // Directions: N, S, E, W
+        static const int dx[] = {0, 0, 1, -1};
+        static const int dy[] = {-1, 1, 0, 0};
+
+        // Explicit stack of cells rather than recursion. Taking a uniformly
+        // random untried direction at each visit is the same distribution as
+        // shuffling all four up front, and needs no per-cell state. The stack
+        // never holds more than the carvable cells, so one reserve covers the
+        // whole run.
+        std::vector<int> stack;
+        stack.reserve(((width - 1) / 2) * ((height - 1) / 2) + 1);
+
+        open(cx, cy);
+        stack.push_back(cy * width + cx);
+
+        while (!stack.empty()) {
+            int x = stack.back() % width;
+            int y = stack.back() / width;
+
+            int untried[4];
+            int untriedCount = 0;
+            for (int dir = 0; dir < 4; dir++) {
+                int nx = x + dx[dir] * 2;
+                int ny = y + dy[dir] * 2;
+                if (nx > 0 && nx < width-1 && ny > 0 && ny < height-1 && isWall(nx, ny)) {
+                    untried[untriedCount++] = dir;
+                }
+            }
+
+            if (untriedCount == 0) {
+                stack.pop_back();  // Dead end, backtrack
+                continue;
+            }
+
+            int dir = untried[rng.nextBelow(untriedCount)];
+            int nx = x + dx[dir] * 2;
+            int ny = y + dy[dir] * 2;
 
-Maze::Maze(MazeType type) : tiles(HEIGHT, std::vector<TileType>(WIDTH, TileType::Wall)), mazeType(type) {
+            // Carve passage
+            open(x + dx[dir], y + dy[dir]);
+            open(nx, ny);
+            stack.push_back(ny * width + nx);
+        }
+    }
+}
+
+Maze::Maze(MazeType type, int mazeWidth, int mazeHeight, std::uint64_t mazeSeed)
+    : width(std::min(std::max(mazeWidth, MIN_DIMENSION), MAX_DIMENSION)),
+      height(std::min(std::max(mazeHeight, MIN_DIMENSION), MAX_DIMENSION)),
+      paddedWidth(width + 2), paddedHeight(height + 2),
+      cells(paddedWidth * paddedHeight, static_cast<std::uint8_t>(TileType::Wall)),
+      wallBits((paddedWidth * paddedHeight + 63) / 64, ~std::uint64_t(0)),
+      mazeType(type), seed(mazeSeed) {
+    Rng rng(seed);
     if (type == MazeType::CIRCULAR) {
-        generateCircularMaze();
+        generateCircularMaze(rng);
     } else if (type == MazeType::INFINITE) {
-        generateInfiniteMaze();
+        generateInfiniteMaze(rng);
     } else if (type == MazeType::SOLDIER) {
-        generateSoldierMaze();
+        generateSoldierMaze(rng);
     } else {
-        generateRandomMaze();
+        generateRandomMaze(rng);
+    }
+    connectRegions();
+    buildSpawnIndex();
+    buildDistanceFields();
+}
+
+Maze::Maze(MazeType type, int mazeWidth, int mazeHeight, const std::vector<std::uint8_t>& tiles, std::uint64_t mazeSeed)
+    : width(std::min(std::max(mazeWidth, MIN_DIMENSION), MAX_DIMENSION)),
+      height(std::min(std::max(mazeHeight, MIN_DIMENSION), MAX_DIMENSION)),
+      paddedWidth(width + 2), paddedHeight(height + 2),
+      cells(paddedWidth * paddedHeight, static_cast<std::uint8_t>(TileType::Wall)),
+      wallBits((paddedWidth * paddedHeight + 63) / 64, ~std::uint64_t(0)),
+      mazeType(type), seed(mazeSeed) {
+    safeRoomPos = {width / 2.0f * TILE_SIZE, height / 2.0f * TILE_SIZE};
+    bool foundSafeRoom = false;
+
+    // Anything missing from a short tile array stays Wall
+    const std::uint8_t lastType = static_cast<std::uint8_t>(TileType::SafeRoom);
+    for (int y = 0; y < std::min(height, mazeHeight); y++) {
+        std::uint8_t* row = &cells[cellIndex(0, y)];
+        for (int x = 0; x < std::min(width, mazeWidth); x++) {
+            size_t source = static_cast<size_t>(y) * mazeWidth + x;
+            if (source >= tiles.size() || tiles[source] > lastType) continue;
+            row[x] = tiles[source];
+
+            TileType tile = static_cast<TileType>(tiles[source]);
+            if (tile == TileType::Exit) {
+                exitPositions.push_back({x * TILE_SIZE + TILE_SIZE/2.0f, y * TILE_SIZE + TILE_SIZE/2.0f});
+            } else if (tile == TileType::SafeRoom && !foundSafeRoom) {
+                // First tile scanned is the top-left of the 3x3 room
+                safeRoomPos = {(x + 1.5f) * TILE_SIZE, (y + 1.5f) * TILE_SIZE};
+                foundSafeRoom = true;
+            }
+        }
+    }
+
+    // Rebuild the wall bitset from the grid, a word at a time
+    const std::uint8_t wall = static_cast<std::uint8_t>(TileType::Wall);
+    for (size_t word = 0; word < wallBits.size(); word++) {
+        std::uint64_t bits = 0;
+        size_t first = word * 64;
+        size_t count = std::min<size_t>(64, cells.size() - first);
+        for (size_t bit = 0; bit < count; bit++) {
+            bits |= static_cast<std::uint64_t>(cells[first + bit] == wall) << bit;
+        }
+        wallBits[word] = bits | (count < 64 ? ~std::uint64_t(0) << count : 0);
+    }
+    connectRegions();
+    buildSpawnIndex();
+    buildDistanceFields();
+}
+
+void Maze::buildSpawnIndex() {
+    regionColumns = (width + REGION_SIZE - 1) / REGION_SIZE;
+    regionRows = (height + REGION_SIZE - 1) / REGION_SIZE;
+    const std::uint8_t empty = static_cast<std::uint8_t>(TileType::Empty);
+
+    // Counting sort of the open tiles into their region buckets, one row at
+    // a time so the grid is read sequentially
+    regionOffsets.assign(regionColumns * regionRows + 1, 0);
+    for (int y = 2; y < height-2; y++) {
+        const std::uint8_t* row = &cells[cellIndex(0, y)];
+        int* counts = &regionOffsets[(y / REGION_SIZE) * regionColumns + 1];
+        for (int x = 2; x < width-2; x++) {
+            counts[x / REGION_SIZE] += row[x] == empty;
+        }
+    }
+    for (size_t r = 1; r < regionOffsets.size(); r++) {
+        regionOffsets[r] += regionOffsets[r - 1];
+    }
+
+    spawnTiles.resize(regionOffsets.back());
+    chosenStamps.assign(static_cast<size_t>(width) * height, 0);
+    chosenStamp = 0;
+    std::vector<int> next(regionOffsets.begin(), regionOffsets.end() - 1);
+    for (int y = 2; y < height-2; y++) {
+        const std::uint8_t* row = &cells[cellIndex(0, y)];
+        int* cursors = &next[(y / REGION_SIZE) * regionColumns];
+        for (int x = 2; x < width-2; x++) {
+            if (row[x] == empty) spawnTiles[cursors[x / REGION_SIZE]++] = y * width + x;
+        }
+    }
+}
+
+void Maze::connectRegions() {
+    // Works on padded cells like DistanceField: the Wall border means no
+    // bounds checks
+    const std::uint8_t wall = static_cast<std::uint8_t>(TileType::Wall);
+    const int cellCount = paddedWidth * paddedHeight;
+    const int offsets[] = {1, -1, paddedWidth, -paddedWidth};
+
+    // Union-find over horizontal runs of open cells: one pass down the rows,
+    // joining each run to the runs above that it touches
+    std::vector<OpenRun>& runs = openRuns;
+    runs.clear();
+    auto findRoot = [&runs](int run) {
+        while (runs[run].parent != run) {
+            runs[run].parent = runs[runs[run].parent].parent;  // Path halving
+            run = runs[run].parent;
+        }
+        return run;
+    };
+    int regionCount = 0;
+    int above = 0;
+    for (int py = 1; py < paddedHeight - 1; py++) {
+        const int aboveEnd = static_cast<int>(runs.size());
+        const std::uint8_t* row = &cells[py * paddedWidth];
+        for (int px = 1; px < paddedWidth - 1; px++) {
+            if (row[px] == wall) continue;
+            const int start = px;
+            while (row[px] != wall) px++;  // The border column ends every run
+            const int run = static_cast<int>(runs.size());
+            runs.push_back({py * paddedWidth + start, py * paddedWidth + px, run});
+            regionCount++;
+
+            // Runs above overlapping [start, px), compared one row up
+            const int rowAbove = (py - 1) * paddedWidth;
+            while (above < aboveEnd && runs[above].end - rowAbove <= start) above++;
+            for (int other = above; other < aboveEnd && runs[other].start - rowAbove < px; other++) {
+                int a = findRoot(run);
+                int b = findRoot(other);
+                if (a != b) {
+                    runs[std::max(a, b)].parent = std::min(a, b);
+                    regionCount--;
+                }
+            }
+        }
+        above = aboveEnd;
+    }
+    if (regionCount <= 1) return;  // Already one region, the usual case
+
+    // Label every open cell with its region
+    std::vector<int> region(cellCount, -1);
+    std::vector<int> regionSizes;
+    std::vector<int> rootLabels(runs.size(), -1);
+    for (int run = 0; run < static_cast<int>(runs.size()); run++) {
+        int root = findRoot(run);
+        if (rootLabels[root] < 0) {
+            rootLabels[root] = static_cast<int>(regionSizes.size());
+            regionSizes.push_back(0);
+        }
+        int label = rootLabels[root];
+        std::fill(region.begin() + runs[run].start, region.begin() + runs[run].end, label);
+        regionSizes[label] += runs[run].end - runs[run].start;
+    }
+
+    const int mainRegion = static_cast<int>(std::max_element(regionSizes.begin(), regionSizes.end()) - regionSizes.begin());
+    int unreached = static_cast<int>(regionSizes.size()) - 1;
+
+    // 0-1 BFS out of the main region, one carve count at a time: open cells
+    // are free, each wall costs one carve. The maze's own outer ring of
+    // tiles is never opened. The first cell reached in each other region is
+    // its cheapest link, and the search stops once all have one.
+    std::vector<int> parent(cellCount, -1);
+    std::vector<int> cheapest(regionSizes.size(), -1);
+    std::vector<std::uint8_t> visited(cellCount, 0);
+    std::vector<int> stack;
+    std::vector<int> nextLevel;
+    for (int index = 0; index < cellCount; index++) {
+        if (region[index] == mainRegion) {
+            visited[index] = 1;
+            stack.push_back(index);
+        }
+    }
+    auto carvable = [this](int index) {
+        int px = index % paddedWidth;
+        int py = index / paddedWidth;
+        return px >= 2 && px < paddedWidth - 2 && py >= 2 && py < paddedHeight - 2;
+    };
+    while (unreached > 0 && !stack.empty()) {
+        while (!stack.empty()) {
+            int index = stack.back();
+            stack.pop_back();
+            int label = region[index];
+            if (label >= 0 && cheapest[label] < 0 && label != mainRegion) {
+                cheapest[label] = index;
+                if (--unreached == 0) break;
+            }
+            for (int offset : offsets) {
+                int next = index + offset;
+                if (visited[next]) continue;
+                if (cells[next] != wall) {
+                    visited[next] = 1;
+                    parent[next] = index;
+                    stack.push_back(next);
+                } else if (carvable(next)) {
+                    visited[next] = 1;
+                    parent[next] = index;
+                    nextLevel.push_back(next);
+                }
+            }
+        }
+        stack.swap(nextLevel);
+        nextLevel.clear();
+    }
+
+    // Open each link's route back to the main region; routes that cross other
+    // pockets connect those on the way
+    for (int start : cheapest) {
+        for (int index = start; index >= 0; index = parent[index]) {
+            if (cells[index] != wall) continue;
+            setTile(index % paddedWidth - 1, index / paddedWidth - 1, TileType::Empty);
+            repairedTiles++;
+        }
     }
 }
 
-void Maze::generateRandomMaze() {
+void Maze::buildDistanceFields() {
+    std::vector<std::pair<int, int>> exits;
+    std::vector<std::pair<int, int>> safeRoom;
+    for (int y = 0; y < height; y++) {
+        const std::uint8_t* row = &cells[cellIndex(0, y)];
+        for (int x = 0; x < width; x++) {
+            if (row[x] == static_cast<std::uint8_t>(TileType::Exit)) exits.push_back({x, y});
+            if (row[x] == static_cast<std::uint8_t>(TileType::SafeRoom)) safeRoom.push_back({x, y});
+        }
+    }
+    exitField.build(*this, exits);
+    safeRoomField.build(*this, safeRoom);
+}
+
+template <typename Accept, typename RegionFilter>
+std::vector<std::pair<int, int>> Maze::sampleSpawnTiles(int count, Rng& rng, Accept accept, RegionFilter regionMayAccept) const {
+    std::vector<std::pair<int, int>> chosen;
+    if (count <= 0 || spawnTiles.empty()) return chosen;
+    chosen.reserve(count);
+
+    // New stamp for this query; on wraparound, clear the old ones once
+    if (++chosenStamp == 0) {
+        std::fill(chosenStamps.begin(), chosenStamps.end(), 0);
+        chosenStamp = 1;
+    }
+    auto isChosen = [this](int x, int y) { return chosenStamps[y * width + x] == chosenStamp; };
+
+    // Usually most open tiles qualify, so a few random draws finish the job
+    int tileCount = static_cast<int>(spawnTiles.size());
+    int attempts = MAX_SAMPLE_ATTEMPTS + 4 * count;
+    for (int attempt = 0; attempt < attempts && static_cast<int>(chosen.size()) < count; attempt++) {
+        int tile = spawnTiles[rng.nextBelow(tileCount)];
+        int x = tile % width;
+        int y = tile / width;
+        if (accept(x, y) && !isChosen(x, y)) {
+            chosen.push_back({x, y});
+            chosenStamps[tile] = chosenStamp;
+        }
+    }
+    if (static_cast<int>(chosen.size()) == count) return chosen;
+
+    // Few tiles qualify: scan the buckets that can still contribute
+    TileReservoir rest(count - static_cast<int>(chosen.size()));
+    for (int ry = 0; ry < regionRows; ry++) {
+        for (int rx = 0; rx < regionColumns; rx++) {
+            int minX = rx * REGION_SIZE;
+            int minY = ry * REGION_SIZE;
+            if (!regionMayAccept(minX, minY, std::min(minX + REGION_SIZE, width) - 1, std::min(minY + REGION_SIZE, height) - 1)) {
+                continue;
+            }
+            int region = ry * regionColumns + rx;
+            for (int i = regionOffsets[region]; i < regionOffsets[region + 1]; i++) {
+                int x = spawnTiles[i] % width;
+                int y = spawnTiles[i] / width;
+                if (accept(x, y) && !isChosen(x, y)) {
+                    rest.offer(x, y, rng);
+                }
+            }
+        }
+    }
+    chosen.insert(chosen.end(), rest.get().begin(), rest.get().end());
+    return chosen;
+}
+
+void Maze::generateRandomMaze(Rng& rng) {
     // Fill with walls
-    for (int y = 0; y < HEIGHT; y++) {
-        for (int x = 0; x < WIDTH; x++) {
-            tiles[y][x] = TileType::Wall;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            setTile(x, y, TileType::Wall);
         }
     }
 
     // Start carving from position (1, 1)
-    carvePassagesFrom(1, 1);
+    carvePassagesFrom(1, 1, rng);
 
-    // Randomly add 1-2 SMALL rooms (NOT in center!)
-    int numRooms = 1 + (rand() % 2);  // 1 or 2 rooms
-    int centerX = WIDTH / 2;
-    int centerY = HEIGHT / 2;
+    // Randomly add 1-2 SMALL rooms per default-sized area (NOT in center!)
+    int numRooms = (1 + rng.nextBelow(2)) * areaScale();
+    int centerX = width / 2;
+    int centerY = height / 2;
 
     for (int room = 0; room < numRooms; room++) {
         // SMALLER room size between 5x5 and 8x8
-        int roomWidth = 5 + (rand() % 4);
-        int roomHeight = 5 + (rand() % 4);
+        int roomWidth = 5 + rng.nextBelow(4);
+        int roomHeight = 5 + rng.nextBelow(4);
 
         // Try to find position FAR from center (avoid middle 50% of map)
         int roomX, roomY;
         bool validPosition = false;
         for (int attempt = 0; attempt < 50 && !validPosition; attempt++) {
-            roomX = 5 + (rand() % (WIDTH - roomWidth - 10));
-            roomY = 5 + (rand() % (HEIGHT - roomHeight - 10));
+            roomX = 5 + rng.nextBelow(width - roomWidth - 10);
+            roomY = 5 + rng.nextBelow(height - roomHeight - 10);
 
             // Check if room center is far enough from map center
             int roomCenterX = roomX + roomWidth / 2;
@@ -57,9 +456,9 @@ void Maze::generateRandomMaze() {
         if (!validPosition) continue;  // Skip this room if can't find good position
 
         // Carve out the SMALL room
-        for (int y = roomY; y < roomY + roomHeight && y < HEIGHT - 1; y++) {
-            for (int x = roomX; x < roomX + roomWidth && x < WIDTH - 1; x++) {
-                tiles[y][x] = TileType::Empty;
+        for (int y = roomY; y < roomY + roomHeight && y < height - 1; y++) {
+            for (int x = roomX; x < roomX + roomWidth && x < width - 1; x++) {
+                setTile(x, y, TileType::Empty);
             }
         }
     }
@@ -67,32 +466,32 @@ void Maze::generateRandomMaze() {
     // NO CENTER ROOM - completely removed per user request
 
     // Ensure borders are walls
-    for (int x = 0; x < WIDTH; x++) {
-        tiles[0][x] = TileType::Wall;
-        tiles[HEIGHT-1][x] = TileType::Wall;
+    for (int x = 0; x < width; x++) {
+        setTile(x, 0, TileType::Wall);
+        setTile(x, height-1, TileType::Wall);
     }
-    for (int y = 0; y < HEIGHT; y++) {
-        tiles[y][0] = TileType::Wall;
-        tiles[y][WIDTH-1] = TileType::Wall;
+    for (int y = 0; y < height; y++) {
+        setTile(0, y, TileType::Wall);
+        setTile(width-1, y, TileType::Wall);
     }
 
     // Set exit door (make sure it's not a wall)
-    tiles[HEIGHT-2][WIDTH-2] = TileType::Exit;
+    setTile(width-2, height-2, TileType::Exit);
 
     // Ensure area around exit is clear
-    tiles[HEIGHT-3][WIDTH-2] = TileType::Empty;
-    tiles[HEIGHT-2][WIDTH-3] = TileType::Empty;
+    setTile(width-2, height-3, TileType::Empty);
+    setTile(width-3, height-2, TileType::Empty);
 
     // Create safe room (3x3 blue room) in a random location away from start and exit
     int safeX, safeY;
     bool foundSafeSpot = false;
     for (int attempt = 0; attempt < 100 && !foundSafeSpot; attempt++) {
-        safeX = 5 + (rand() % (WIDTH - 12));
-        safeY = 5 + (rand() % (HEIGHT - 12));
+        safeX = 5 + rng.nextBelow(width - 12);
+        safeY = 5 + rng.nextBelow(height - 12);
 
-        // Check it's far from start (1,1) and exit (WIDTH-2, HEIGHT-2)
+        // Check it's far from start (1,1) and exit (width-2, height-2)
         int distFromStart = abs(safeX - 1) + abs(safeY - 1);
-        int distFromExit = abs(safeX - (WIDTH-2)) + abs(safeY - (HEIGHT-2));
+        int distFromExit = abs(safeX - (width-2)) + abs(safeY - (height-2));
 
         if (distFromStart > 15 && distFromExit > 10) {
             foundSafeSpot = true;
@@ -100,9 +499,9 @@ void Maze::generateRandomMaze() {
     }
 
     // Create 3x3 safe room
-    for (int y = safeY; y < safeY + 3 && y < HEIGHT-1; y++) {
-        for (int x = safeX; x < safeX + 3 && x < WIDTH-1; x++) {
-            tiles[y][x] = TileType::SafeRoom;
+    for (int y = safeY; y < safeY + 3 && y < height-1; y++) {
+        for (int x = safeX; x < safeX + 3 && x < width-1; x++) {
+            setTile(x, y, TileType::SafeRoom);
         }
     }
 
@@ -110,32 +509,29 @@ void Maze::generateRandomMaze() {
     safeRoomPos = {(safeX + 1.5f) * TILE_SIZE, (safeY + 1.5f) * TILE_SIZE};
 
     // Ensure start position is clear
-    tiles[1][1] = TileType::Empty;
-    tiles[1][2] = TileType::Empty;
-    tiles[2][1] = TileType::Empty;
+    setTile(1, 1, TileType::Empty);
+    setTile(2, 1, TileType::Empty);
+    setTile(1, 2, TileType::Empty);
 }
 
-void Maze::generateCircularMaze() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-
+void Maze::generateCircularMaze(Rng& rng) {
     // Fill with walls initially
-    for (int y = 0; y < HEIGHT; y++) {
-        for (int x = 0; x < WIDTH; x++) {
-            tiles[y][x] = TileType::Wall;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            setTile(x, y, TileType::Wall);
         }
     }
 
     // Center point
-    int centerX = WIDTH / 2;
-    int centerY = HEIGHT / 2;
+    int centerX = width / 2;
+    int centerY = height / 2;
 
     // Maximum radius - USE FULL SPACE (much larger)
-    int maxRadius = std::min(WIDTH, HEIGHT) / 2 - 1;  // Changed from -2 to -1 for more space
+    int maxRadius = std::min(width, height) / 2 - 1;  // Changed from -2 to -1 for more space
 
     // Create circular area with concentric ring maze
-    for (int y = 0; y < HEIGHT; y++) {
-        for (int x = 0; x < WIDTH; x++) {
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
             int dx = x - centerX;
             int dy = y - centerY;
             float distance = std::sqrt(dx * dx + dy * dy);
@@ -153,7 +549,7 @@ void Maze::generateCircularMaze() {
                 float passageWidth = 1.2f + (1.0f - normalizedDist) * 0.8f;  // 2.0 at center, 1.2 at edge
 
                 if (ringDist < passageWidth || distance < 8.0f) {  // Smaller center opening
-                    tiles[y][x] = TileType::Empty;
+                    setTile(x, y, TileType::Empty);
                 }
             }
         }
@@ -169,14 +565,14 @@ void Maze::generateCircularMaze() {
             int x = centerX + static_cast<int>(r * std::cos(angle));
             int y = centerY + static_cast<int>(r * std::sin(angle));
 
-            if (x >= 1 && x < WIDTH-1 && y >= 1 && y < HEIGHT-1) {
+            if (x >= 1 && x < width-1 && y >= 1 && y < height-1) {
                 // Make corridors MUCH WIDER (3x3 instead of 2x2)
                 for (int dy = -1; dy <= 1; dy++) {
                     for (int dx = -1; dx <= 1; dx++) {
                         int nx = x + dx;
                         int ny = y + dy;
-                        if (nx >= 1 && nx < WIDTH-1 && ny >= 1 && ny < HEIGHT-1) {
-                            tiles[ny][nx] = TileType::Empty;
+                        if (nx >= 1 && nx < width-1 && ny >= 1 && ny < height-1) {
+                            setTile(nx, ny, TileType::Empty);
                         }
                     }
                 }
@@ -185,11 +581,11 @@ void Maze::generateCircularMaze() {
     }
 
     // Add MANY MORE random openings to prevent isolated pockets (was 50, now 200)
-    std::uniform_int_distribution<> distX(2, WIDTH-3);
-    std::uniform_int_distribution<> distY(2, HEIGHT-3);
-    for (int i = 0; i < 200; i++) {
-        int x = distX(gen);
-        int y = distY(gen);
+    // Counts below are per default-sized area so density holds on big maps
+    int scale = areaScale();
+    for (int i = 0; i < 200 * scale; i++) {
+        int x = rng.nextInt(2, width-3);
+        int y = rng.nextInt(2, height-3);
         int dx = x - centerX;
         int dy = y - centerY;
         float distance = std::sqrt(dx * dx + dy * dy);
@@ -201,8 +597,8 @@ void Maze::generateCircularMaze() {
                 for (int ox = 0; ox <= 1; ox++) {
                     int nx = x + ox;
                     int ny = y + oy;
-                    if (nx >= 1 && nx < WIDTH-1 && ny >= 1 && ny < HEIGHT-1) {
-                        tiles[ny][nx] = TileType::Empty;
+                    if (nx >= 1 && nx < width-1 && ny >= 1 && ny < height-1) {
+                        setTile(nx, ny, TileType::Empty);
                     }
                 }
             }
@@ -210,22 +606,22 @@ void Maze::generateCircularMaze() {
     }
 
     // Add random connections between rings to prevent isolated pockets
-    for (int i = 0; i < 100; i++) {
-        int x = distX(gen);
-        int y = distY(gen);
+    for (int i = 0; i < 100 * scale; i++) {
+        int x = rng.nextInt(2, width-3);
+        int y = rng.nextInt(2, height-3);
         int dx = x - centerX;
         int dy = y - centerY;
         float distance = std::sqrt(dx * dx + dy * dy);
 
         if (distance < maxRadius - 1) {
             // Carve path in random direction
-            int dirX = (gen() % 3) - 1;  // -1, 0, or 1
-            int dirY = (gen() % 3) - 1;
+            int dirX = rng.nextBelow(3) - 1;  // -1, 0, or 1
+            int dirY = rng.nextBelow(3) - 1;
             for (int step = 0; step < 3; step++) {
                 int nx = x + dirX * step;
                 int ny = y + dirY * step;
-                if (nx >= 1 && nx < WIDTH-1 && ny >= 1 && ny < HEIGHT-1) {
-                    tiles[ny][nx] = TileType::Empty;
+                if (nx >= 1 && nx < width-1 && ny >= 1 && ny < height-1) {
+                    setTile(nx, ny, TileType::Empty);
                 }
             }
         }
@@ -233,36 +629,36 @@ void Maze::generateCircularMaze() {
 
     // Clear center room (moderate size for maze feel)
     int centerRoomRadius = 8;  // Moderate central room for more maze
-    for (int y = 0; y < HEIGHT; y++) {
-        for (int x = 0; x < WIDTH; x++) {
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
             int dx = x - centerX;
             int dy = y - centerY;
             float distance = std::sqrt(dx * dx + dy * dy);
 
             if (distance <= centerRoomRadius) {
-                tiles[y][x] = TileType::Empty;
+                setTile(x, y, TileType::Empty);
             }
         }
     }
 
     // Add dead ends and branching paths for maze complexity
-    for (int i = 0; i < 150; i++) {
-        int x = distX(gen);
-        int y = distY(gen);
+    for (int i = 0; i < 150 * scale; i++) {
+        int x = rng.nextInt(2, width-3);
+        int y = rng.nextInt(2, height-3);
         int dx = x - centerX;
         int dy = y - centerY;
         float distance = std::sqrt(dx * dx + dy * dy);
 
         if (distance < maxRadius - 3 && distance > centerRoomRadius + 2) {
             // Create small dead-end corridors
-            int dirX = (gen() % 3) - 1;
-            int dirY = (gen() % 3) - 1;
+            int dirX = rng.nextBelow(3) - 1;
+            int dirY = rng.nextBelow(3) - 1;
             if (dirX != 0 || dirY != 0) {  // Ensure we have a direction
                 for (int step = 0; step < 4; step++) {
                     int nx = x + dirX * step;
                     int ny = y + dirY * step;
-                    if (nx >= 1 && nx < WIDTH-1 && ny >= 1 && ny < HEIGHT-1) {
-                        tiles[ny][nx] = TileType::Empty;
+                    if (nx >= 1 && nx < width-1 && ny >= 1 && ny < height-1) {
+                        setTile(nx, ny, TileType::Empty);
                     }
                 }
             }
@@ -270,147 +666,105 @@ void Maze::generateCircularMaze() {
     }
 
     // Place exit in the center and ensure area around it is clear
-    tiles[centerY][centerX] = TileType::Exit;
+    setTile(centerX, centerY, TileType::Exit);
 
     // Clear 5x5 area around exit to make it visible
     for (int dy = -2; dy <= 2; dy++) {
         for (int dx = -2; dx <= 2; dx++) {
             int nx = centerX + dx;
             int ny = centerY + dy;
-            if (nx >= 0 && nx < WIDTH && ny >= 0 && ny < HEIGHT) {
+            if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
                 if (dx == 0 && dy == 0) {
-                    tiles[ny][nx] = TileType::Exit;  // Keep center as exit
+                    setTile(nx, ny, TileType::Exit);  // Keep center as exit
                 } else {
-                    tiles[ny][nx] = TileType::Empty;  // Clear surrounding area
+                    setTile(nx, ny, TileType::Empty);  // Clear surrounding area
                 }
             }
         }
     }
 
     // Ensure borders are walls
-    for (int x = 0; x < WIDTH; x++) {
-        tiles[0][x] = TileType::Wall;
-        tiles[HEIGHT-1][x] = TileType::Wall;
+    for (int x = 0; x < width; x++) {
+        setTile(x, 0, TileType::Wall);
+        setTile(x, height-1, TileType::Wall);
     }
-    for (int y = 0; y < HEIGHT; y++) {
-        tiles[y][0] = TileType::Wall;
-        tiles[y][WIDTH-1] = TileType::Wall;
+    for (int y = 0; y < height; y++) {
+        setTile(0, y, TileType::Wall);
+        setTile(width-1, y, TileType::Wall);
     }
 
     // Ensure LARGER start area on outer edge is clear (was 2x2, now 4x4)
     for (int y = 1; y <= 4; y++) {
         for (int x = 1; x <= 4; x++) {
-            tiles[y][x] = TileType::Empty;
+            setTile(x, y, TileType::Empty);
         }
     }
 }
 
-void Maze::carvePassagesFrom(int cx, int cy) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-
-    // Directions: N, S, E, W
-    int dx[] = {0, 0, 1, -1};
-    int dy[] = {-1, 1, 0, 0};
-
-    // Shuffle directions for randomness
-    std::vector<int> directions = {0, 1, 2, 3};
-    std::shuffle(directions.begin(), directions.end(), gen);
-
-    tiles[cy][cx] = TileType::Empty;
-
-    for (int dir : directions) {
-        int nx = cx + dx[dir] * 2;
-        int ny = cy + dy[dir] * 2;
+void Maze::carvePassagesFrom(int cx, int cy, Rng& rng) {
+    carveBacktracker(width, height, cx, cy, rng,
+                     [this](int x, int y) { return getTile(x, y) == TileType::Wall; },
+                     [this](int x, int y) { setTile(x, y, TileType::Empty); });
+}
 
-        if (nx > 0 && nx < WIDTH-1 && ny > 0 && ny < HEIGHT-1 && tiles[ny][nx] == TileType::Wall) {
-            // Carve passage
-            tiles[cy + dy[dir]][cx + dx[dir]] = TileType::Empty;
-            carvePassagesFrom(nx, ny);
-        }
-    }
+std::vector<std::uint8_t> Maze::carvePassages(int width, int height, std::uint64_t seed) {
+    std::vector<std::uint8_t> tiles(static_cast<size_t>(width) * height, static_cast<std::uint8_t>(TileType::Wall));
+    Rng rng(seed);
+    carveBacktracker(width, height, 1, 1, rng,
+                     [&](int x, int y) { return tiles[static_cast<size_t>(y) * width + x] == static_cast<std::uint8_t>(TileType::Wall); },
+                     [&](int x, int y) { tiles[static_cast<size_t>(y) * width + x] = static_cast<std::uint8_t>(TileType::Empty); });
+    return tiles;
 }
 
 bool Maze::isValidPosition(int x, int y) const {
-    return x > 0 && x < WIDTH-1 && y > 0 && y < HEIGHT-1 &&
-           tiles[y][x] == TileType::Empty;
+    return x > 0 && x < width-1 && y > 0 && y < height-1 &&
+           getTile(x, y) == TileType::Empty;
 }
 
-std::vector<Vec2> Maze::getRandomKeyPositions(int count) const {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+std::vector<Vec2> Maze::getRandomKeyPositions(int count, Rng& rng) const {
+    // Valid (empty) tiles that are not near start or exit
+    auto accept = [this](int x, int y) {
+        if (x < 3 || x >= width-3 || y < 3 || y >= height-3) return false;
+        // Not too close to start (1,1) or exit (width-2, height-2)
+        return (x > 5 || y > 5) && (x < width-5 || y < height-5);
+    };
 
     std::vector<Vec2> positions;
-    std::vector<std::pair<int, int>> validTiles;
-
-    // Collect all valid (empty) tiles that are not near start or exit
-    for (int y = 3; y < HEIGHT-3; y++) {
-        for (int x = 3; x < WIDTH-3; x++) {
-            if (tiles[y][x] == TileType::Empty) {
-                // Not too close to start (1,1) or exit (WIDTH-2, HEIGHT-2)
-                if ((x > 5 || y > 5) && (x < WIDTH-5 || y < HEIGHT-5)) {
-                    validTiles.push_back({x, y});
-                }
-            }
-        }
-    }
-
-    // Shuffle and pick random positions
-    std::shuffle(validTiles.begin(), validTiles.end(), gen);
-
-    for (int i = 0; i < count && i < static_cast<int>(validTiles.size()); i++) {
-        auto [x, y] = validTiles[i];
-        positions.push_back({x * TILE_SIZE + TILE_SIZE/2.0f, y * TILE_SIZE + TILE_SIZE/2.0f});
+    for (auto tile : sampleSpawnTiles(count, rng, accept, anyRegion)) {
+        positions.push_back(tileCenter(tile));
     }
-
     return positions;
 }
 
-std::vector<Vec2> Maze::getRandomZombiePositions(int count, Vec2 playerPos) const {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-
-    std::vector<Vec2> positions;
-    std::vector<std::pair<int, int>> validTiles;
-
+std::vector<Vec2> Maze::getRandomZombiePositions(int count, Vec2 playerPos, Rng& rng) const {
     // Convert player position to tile coordinates
     int playerTileX = static_cast<int>(playerPos.x / TILE_SIZE);
     int playerTileY = static_cast<int>(playerPos.y / TILE_SIZE);
 
-    // Collect all valid (empty) tiles that are far from player spawn
-    for (int y = 2; y < HEIGHT-2; y++) {
-        for (int x = 2; x < WIDTH-2; x++) {
-            if (tiles[y][x] == TileType::Empty) {
-                // Calculate distance from player spawn
-                int dx = x - playerTileX;
-                int dy = y - playerTileY;
-                int distSq = dx * dx + dy * dy;
-
-                // Spawn zombies at least 8 tiles away from player (much safer starting distance)
-                if (distSq > 64) {  // sqrt(64) = 8 tiles minimum
-                    validTiles.push_back({x, y});
-                }
-            }
-        }
-    }
-
-    // Shuffle and pick random positions
-    std::shuffle(validTiles.begin(), validTiles.end(), gen);
+    // Spawn zombies at least 8 tiles away from player (much safer starting distance)
+    const int MIN_PLAYER_DIST_SQ = 64;
+    auto accept = [&](int x, int y) {
+        int dx = x - playerTileX;
+        int dy = y - playerTileY;
+        return dx * dx + dy * dy > MIN_PLAYER_DIST_SQ;
+    };
+    auto regionMayAccept = [&](int minX, int minY, int maxX, int maxY) {
+        return !regionInsideDisk(minX, minY, maxX, maxY, playerTileX, playerTileY, MIN_PLAYER_DIST_SQ);
+    };
 
-    for (int i = 0; i < count && i < static_cast<int>(validTiles.size()); i++) {
-        auto [x, y] = validTiles[i];
-        positions.push_back({x * TILE_SIZE + TILE_SIZE/2.0f, y * TILE_SIZE + TILE_SIZE/2.0f});
+    std::vector<Vec2> positions;
+    for (auto tile : sampleSpawnTiles(count, rng, accept, regionMayAccept)) {
+        positions.push_back(tileCenter(tile));
     }
-
     return positions;
 }
 
 void Maze::render(SDL_Renderer* renderer) const {
-    for (int y = 0; y < HEIGHT; y++) {
-        for (int x = 0; x < WIDTH; x++) {
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
             SDL_Rect rect = {x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE};
 
-            switch (tiles[y][x]) {
+            switch (getTile(x, y)) {
                 case TileType::Wall: {
                     // Shadow layer (offset bottom-right for depth)
                     SDL_Rect shadow = {rect.x + 4, rect.y + 4, rect.w, rect.h};
@@ -538,186 +892,150 @@ void Maze::render(SDL_Renderer* renderer) const {
     }
 }
 
-bool Maze::isWall(int x, int y) const {
-    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return true;
-    return tiles[y][x] == TileType::Wall;
-}
-
-bool Maze::isExit(int x, int y) const {
-    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return false;
-    return tiles[y][x] == TileType::Exit;
-}
-
-bool Maze::isSafeRoom(int x, int y) const {
-    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return false;
-    return tiles[y][x] == TileType::SafeRoom;
-}
-
-TileType Maze::getTile(int x, int y) const {
-    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return TileType::Wall;
-    return tiles[y][x];
+void Maze::setTile(int x, int y, TileType type) {
+    if (x < 0 || x >= width || y < 0 || y >= height) return;  // Border stays Wall
+    int i = cellIndex(x, y);
+    cells[i] = static_cast<std::uint8_t>(type);
+    std::uint64_t bit = std::uint64_t(1) << (i & 63);
+    if (type == TileType::Wall) {
+        wallBits[i >> 6] |= bit;
+    } else {
+        wallBits[i >> 6] &= ~bit;
+    }
 }
 
 Vec2 Maze::getExitPos() const {
-    return {(WIDTH-2) * TILE_SIZE + TILE_SIZE/2.0f, (HEIGHT-2) * TILE_SIZE + TILE_SIZE/2.0f};
+    return {(width-2) * TILE_SIZE + TILE_SIZE/2.0f, (height-2) * TILE_SIZE + TILE_SIZE/2.0f};
 }
 
 Vec2 Maze::getSafeRoomPos() const {
     return safeRoomPos;
 }
 
-Vec2 Maze::getSpawnPositionAwayFromZombies(const std::vector<Vec2>& existingZombies, Vec2 playerPos) const {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-
-    std::vector<std::pair<int, int>> validTiles;
-
+Vec2 Maze::getSpawnPositionAwayFromZombies(const std::vector<Vec2>& existingZombies, Vec2 playerPos, Rng& rng) const {
     // Convert player position to tile coordinates
     int playerTileX = static_cast<int>(playerPos.x / TILE_SIZE);
     int playerTileY = static_cast<int>(playerPos.y / TILE_SIZE);
 
-    // Collect all valid (empty) tiles
-    for (int y = 2; y < HEIGHT-2; y++) {
-        for (int x = 2; x < WIDTH-2; x++) {
-            if (tiles[y][x] == TileType::Empty) {
-                // Must be far from player
-                int dx = x - playerTileX;
-                int dy = y - playerTileY;
-                int distToPlayerSq = dx * dx + dy * dy;
-
-                if (distToPlayerSq > 100) {  // At least 10 tiles from player
-                    // Check distance to all existing zombies
-                    float minZombieDist = 999999.0f;
-                    for (const auto& zombiePos : existingZombies) {
-                        int zx = static_cast<int>(zombiePos.x / TILE_SIZE);
-                        int zy = static_cast<int>(zombiePos.y / TILE_SIZE);
-                        int zdx = x - zx;
-                        int zdy = y - zy;
-                        float zombieDist = std::sqrt(static_cast<float>(zdx * zdx + zdy * zdy));
-                        if (zombieDist < minZombieDist) {
-                            minZombieDist = zombieDist;
-                        }
-                    }
+    std::vector<std::pair<int, int>> zombieTiles;
+    zombieTiles.reserve(existingZombies.size());
+    for (const auto& zombiePos : existingZombies) {
+        zombieTiles.push_back({static_cast<int>(zombiePos.x / TILE_SIZE), static_cast<int>(zombiePos.y / TILE_SIZE)});
+    }
 
-                    // Prefer locations far from other zombies
-                    if (minZombieDist > 8.0f) {  // At least 8 tiles from nearest zombie
-                        validTiles.push_back({x, y});
-                    }
-                }
-            }
+    const int IDEAL_PLAYER_DIST_SQ = 100;  // At least 10 tiles from player
+    const int MIN_PLAYER_DIST_SQ = 64;     // Relaxed: at least 8 tiles
+    const int MIN_ZOMBIE_DIST_SQ = 64;     // At least 8 tiles from the nearest zombie
+
+    auto farFromPlayer = [&](int x, int y, int minDistSq) {
+        int dx = x - playerTileX;
+        int dy = y - playerTileY;
+        return dx * dx + dy * dy > minDistSq;
+    };
+
+    // Prefer locations far from the player and from other zombies
+    auto ideal = [&](int x, int y) {
+        if (!farFromPlayer(x, y, IDEAL_PLAYER_DIST_SQ)) return false;
+        for (auto [zx, zy] : zombieTiles) {
+            int zdx = x - zx;
+            int zdy = y - zy;
+            if (zdx * zdx + zdy * zdy <= MIN_ZOMBIE_DIST_SQ) return false;
         }
-    }
+        return true;
+    };
+    auto idealRegion = [&](int minX, int minY, int maxX, int maxY) {
+        if (regionInsideDisk(minX, minY, maxX, maxY, playerTileX, playerTileY, IDEAL_PLAYER_DIST_SQ)) return false;
+        for (auto [zx, zy] : zombieTiles) {
+            if (regionInsideDisk(minX, minY, maxX, maxY, zx, zy, MIN_ZOMBIE_DIST_SQ)) return false;
+        }
+        return true;
+    };
+    auto picked = sampleSpawnTiles(1, rng, ideal, idealRegion);
 
     // If no ideal spots, lower the requirements
-    if (validTiles.empty()) {
-        for (int y = 2; y < HEIGHT-2; y++) {
-            for (int x = 2; x < WIDTH-2; x++) {
-                if (tiles[y][x] == TileType::Empty) {
-                    int dx = x - playerTileX;
-                    int dy = y - playerTileY;
-                    int distToPlayerSq = dx * dx + dy * dy;
-                    if (distToPlayerSq > 64) {  // At least 8 tiles from player
-                        validTiles.push_back({x, y});
-                    }
-                }
-            }
-        }
+    if (picked.empty()) {
+        auto relaxed = [&](int x, int y) { return farFromPlayer(x, y, MIN_PLAYER_DIST_SQ); };
+        auto relaxedRegion = [&](int minX, int minY, int maxX, int maxY) {
+            return !regionInsideDisk(minX, minY, maxX, maxY, playerTileX, playerTileY, MIN_PLAYER_DIST_SQ);
+        };
+        picked = sampleSpawnTiles(1, rng, relaxed, relaxedRegion);
     }
 
-    // Pick random position
-    if (!validTiles.empty()) {
-        std::uniform_int_distribution<> dis(0, validTiles.size() - 1);
-        auto [x, y] = validTiles[dis(gen)];
-        return {x * TILE_SIZE + TILE_SIZE/2.0f, y * TILE_SIZE + TILE_SIZE/2.0f};
+    if (!picked.empty()) {
+        return tileCenter(picked.front());
     }
 
     // Fallback
     return {5 * TILE_SIZE + TILE_SIZE/2.0f, 5 * TILE_SIZE + TILE_SIZE/2.0f};
 }
 
-Vec2 Maze::getPlayerStart() const {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-
-    std::vector<std::pair<int, int>> validTiles;
-
-    int centerX = WIDTH / 2;
-    int centerY = HEIGHT / 2;
+Vec2 Maze::getPlayerStart(Rng& rng) const {
+    int centerX = width / 2;
+    int centerY = height / 2;
     int centerRoomRadius = 5;  // Stay away from 5+ tiles around center (for standard mode)
 
-    // Collect all valid (empty) tiles that are not near the exit or center room
-    for (int y = 2; y < HEIGHT-3; y++) {
-        for (int x = 2; x < WIDTH-3; x++) {
-            if (tiles[y][x] == TileType::Empty) {
-                // Not too close to exit
-                int distToExit = std::abs(x - (WIDTH-2)) + std::abs(y - (HEIGHT-2));
-
-                // For STANDARD mode only: also avoid center room
-                bool tooCloseToCenter = false;
-                if (mazeType == MazeType::STANDARD) {
-                    int distToCenter = std::max(std::abs(x - centerX), std::abs(y - centerY));
-                    tooCloseToCenter = (distToCenter <= centerRoomRadius);
-                }
+    // Valid (empty) tiles that are not near the exit or center room
+    auto accept = [&](int x, int y) {
+        if (x >= width-3 || y >= height-3) return false;
 
-                if (distToExit > 5 && !tooCloseToCenter) {
-                    validTiles.push_back({x, y});
-                }
-            }
+        // Not too close to exit
+        int distToExit = std::abs(x - (width-2)) + std::abs(y - (height-2));
+
+        // For STANDARD mode only: also avoid center room
+        bool tooCloseToCenter = false;
+        if (mazeType == MazeType::STANDARD) {
+            int distToCenter = std::max(std::abs(x - centerX), std::abs(y - centerY));
+            tooCloseToCenter = (distToCenter <= centerRoomRadius);
         }
-    }
 
-    if (validTiles.empty()) {
+        return distToExit > 5 && !tooCloseToCenter;
+    };
+
+    auto picked = sampleSpawnTiles(1, rng, accept, anyRegion);
+    if (picked.empty()) {
         // Fallback to corner if no valid tiles found
         return {2 * TILE_SIZE + TILE_SIZE/2.0f, 2 * TILE_SIZE + TILE_SIZE/2.0f};
     }
-
-    // Pick a random tile
-    std::uniform_int_distribution<> dis(0, validTiles.size() - 1);
-    auto [x, y] = validTiles[dis(gen)];
-
-    return {x * TILE_SIZE + TILE_SIZE/2.0f, y * TILE_SIZE + TILE_SIZE/2.0f};
+    return tileCenter(picked.front());
 }
 
-void Maze::generateInfiniteMaze() {
+void Maze::generateInfiniteMaze(Rng& rng) {
     // Infinite mode uses standard maze generation
     // The "infinite" aspect is handled by regenerating the maze when player completes it
-    generateRandomMaze();
+    generateRandomMaze(rng);
 }
 
-void Maze::generateSoldierMaze() {
+void Maze::generateSoldierMaze(Rng& rng) {
     // SOLDIER MODE: Large open arena in center with 4 corner rooms connected by wide hallways
     // Fill with walls first
-    for (int y = 0; y < HEIGHT; y++) {
-        for (int x = 0; x < WIDTH; x++) {
-            tiles[y][x] = TileType::Wall;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            setTile(x, y, TileType::Wall);
         }
     }
 
     // Define arena boundaries (large open center area - 50% of map)
-    int arenaLeft = WIDTH / 4;
-    int arenaRight = 3 * WIDTH / 4;
-    int arenaTop = HEIGHT / 4;
-    int arenaBottom = 3 * HEIGHT / 4;
+    int arenaLeft = width / 4;
+    int arenaRight = 3 * width / 4;
+    int arenaTop = height / 4;
+    int arenaBottom = 3 * height / 4;
 
     // Create large open arena in center
     for (int y = arenaTop; y <= arenaBottom; y++) {
         for (int x = arenaLeft; x <= arenaRight; x++) {
-            tiles[y][x] = TileType::Empty;
+            setTile(x, y, TileType::Empty);
         }
     }
 
     // Add some cover/obstacles in the arena (scattered walls for tactical gameplay)
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> distObstacles(0, 100);
     for (int y = arenaTop + 3; y < arenaBottom - 3; y += 4) {
         for (int x = arenaLeft + 3; x < arenaRight - 3; x += 4) {
-            if (distObstacles(gen) < 25) {  // 25% chance for cover
+            if (rng.nextInt(0, 100) < 25) {  // 25% chance for cover
                 // Create small 2x2 cover
-                tiles[y][x] = TileType::Wall;
-                tiles[y][x+1] = TileType::Wall;
-                tiles[y+1][x] = TileType::Wall;
-                tiles[y+1][x+1] = TileType::Wall;
+                setTile(x, y, TileType::Wall);
+                setTile(x+1, y, TileType::Wall);
+                setTile(x, y+1, TileType::Wall);
+                setTile(x+1, y+1, TileType::Wall);
             }
         }
     }
@@ -726,28 +1044,28 @@ void Maze::generateSoldierMaze() {
     // Top-left corner room
     for (int y = 3; y < arenaTop - 2; y++) {
         for (int x = 3; x < arenaLeft - 2; x++) {
-            tiles[y][x] = TileType::Empty;
+            setTile(x, y, TileType::Empty);
         }
     }
 
     // Top-right corner room
     for (int y = 3; y < arenaTop - 2; y++) {
-        for (int x = arenaRight + 3; x < WIDTH - 3; x++) {
-            tiles[y][x] = TileType::Empty;
+        for (int x = arenaRight + 3; x < width - 3; x++) {
+            setTile(x, y, TileType::Empty);
         }
     }
 
     // Bottom-left corner room
-    for (int y = arenaBottom + 3; y < HEIGHT - 3; y++) {
+    for (int y = arenaBottom + 3; y < height - 3; y++) {
         for (int x = 3; x < arenaLeft - 2; x++) {
-            tiles[y][x] = TileType::Empty;
+            setTile(x, y, TileType::Empty);
         }
     }
 
     // Bottom-right corner room
-    for (int y = arenaBottom + 3; y < HEIGHT - 3; y++) {
-        for (int x = arenaRight + 3; x < WIDTH - 3; x++) {
-            tiles[y][x] = TileType::Empty;
+    for (int y = arenaBottom + 3; y < height - 3; y++) {
+        for (int x = arenaRight + 3; x < width - 3; x++) {
+            setTile(x, y, TileType::Empty);
         }
     }
 
@@ -759,41 +1077,41 @@ void Maze::generateSoldierMaze() {
     for (int x = 3; x <= arenaLeft; x++) {
         for (int dy = -4; dy <= 4; dy++) {
             int y = tlHallY + dy;
-            if (y >= 1 && y < HEIGHT - 1) {
-                tiles[y][x] = TileType::Empty;
+            if (y >= 1 && y < height - 1) {
+                setTile(x, y, TileType::Empty);
             }
         }
     }
 
     // Top-right: Horizontal hallway
     int trHallY = (3 + arenaTop - 2) / 2;
-    for (int x = arenaRight; x < WIDTH - 3; x++) {
+    for (int x = arenaRight; x < width - 3; x++) {
         for (int dy = -4; dy <= 4; dy++) {
             int y = trHallY + dy;
-            if (y >= 1 && y < HEIGHT - 1) {
-                tiles[y][x] = TileType::Empty;
+            if (y >= 1 && y < height - 1) {
+                setTile(x, y, TileType::Empty);
             }
         }
     }
 
     // Bottom-left: Horizontal hallway
-    int blHallY = (arenaBottom + 3 + HEIGHT - 3) / 2;
+    int blHallY = (arenaBottom + 3 + height - 3) / 2;
     for (int x = 3; x <= arenaLeft; x++) {
         for (int dy = -4; dy <= 4; dy++) {
             int y = blHallY + dy;
-            if (y >= 1 && y < HEIGHT - 1) {
-                tiles[y][x] = TileType::Empty;
+            if (y >= 1 && y < height - 1) {
+                setTile(x, y, TileType::Empty);
             }
         }
     }
 
     // Bottom-right: Horizontal hallway
-    int brHallY = (arenaBottom + 3 + HEIGHT - 3) / 2;
-    for (int x = arenaRight; x < WIDTH - 3; x++) {
+    int brHallY = (arenaBottom + 3 + height - 3) / 2;
+    for (int x = arenaRight; x < width - 3; x++) {
         for (int dy = -4; dy <= 4; dy++) {
             int y = brHallY + dy;
-            if (y >= 1 && y < HEIGHT - 1) {
-                tiles[y][x] = TileType::Empty;
+            if (y >= 1 && y < height - 1) {
+                setTile(x, y, TileType::Empty);
             }
         }
     }
@@ -801,44 +1119,44 @@ void Maze::generateSoldierMaze() {
     // Add 2-block-wide hallways connecting all corner rooms
     // Top horizontal hallway (connecting top-left to top-right)
     int topHallY = (3 + arenaTop - 2) / 2;
-    for (int x = 3; x < WIDTH - 3; x++) {
+    for (int x = 3; x < width - 3; x++) {
         for (int dy = 0; dy <= 1; dy++) {
             int y = topHallY + dy;
-            if (y >= 1 && y < HEIGHT - 1) {
-                tiles[y][x] = TileType::Empty;
+            if (y >= 1 && y < height - 1) {
+                setTile(x, y, TileType::Empty);
             }
         }
     }
 
     // Bottom horizontal hallway (connecting bottom-left to bottom-right)
-    int bottomHallY = (arenaBottom + 3 + HEIGHT - 3) / 2;
-    for (int x = 3; x < WIDTH - 3; x++) {
+    int bottomHallY = (arenaBottom + 3 + height - 3) / 2;
+    for (int x = 3; x < width - 3; x++) {
         for (int dy = 0; dy <= 1; dy++) {
             int y = bottomHallY + dy;
-            if (y >= 1 && y < HEIGHT - 1) {
-                tiles[y][x] = TileType::Empty;
+            if (y >= 1 && y < height - 1) {
+                setTile(x, y, TileType::Empty);
             }
         }
     }
 
     // Left vertical hallway (connecting top-left to bottom-left)
     int leftHallX = (3 + arenaLeft - 2) / 2;
-    for (int y = 3; y < HEIGHT - 3; y++) {
+    for (int y = 3; y < height - 3; y++) {
         for (int dx = 0; dx <= 1; dx++) {
             int x = leftHallX + dx;
-            if (x >= 1 && x < WIDTH - 1) {
-                tiles[y][x] = TileType::Empty;
+            if (x >= 1 && x < width - 1) {
+                setTile(x, y, TileType::Empty);
             }
         }
     }
 
     // Right vertical hallway (connecting top-right to bottom-right)
-    int rightHallX = (arenaRight + 3 + WIDTH - 3) / 2;
-    for (int y = 3; y < HEIGHT - 3; y++) {
+    int rightHallX = (arenaRight + 3 + width - 3) / 2;
+    for (int y = 3; y < height - 3; y++) {
         for (int dx = 0; dx <= 1; dx++) {
             int x = rightHallX + dx;
-            if (x >= 1 && x < WIDTH - 1) {
-                tiles[y][x] = TileType::Empty;
+            if (x >= 1 && x < width - 1) {
+                setTile(x, y, TileType::Empty);
             }
         }
     }
@@ -857,10 +1175,10 @@ std::vector<Vec2> Maze::getAllExitPositions() const {
 
     if (mazeType == MazeType::CIRCULAR) {
         // Center exit for circular
-        positions.push_back({(WIDTH/2) * TILE_SIZE + TILE_SIZE/2.0f, (HEIGHT/2) * TILE_SIZE + TILE_SIZE/2.0f});
+        positions.push_back({(width/2) * TILE_SIZE + TILE_SIZE/2.0f, (height/2) * TILE_SIZE + TILE_SIZE/2.0f});
     } else {
         // Corner exit for standard
-        positions.push_back({(WIDTH-2) * TILE_SIZE + TILE_SIZE/2.0f, (HEIGHT-2) * TILE_SIZE + TILE_SIZE/2.0f});
+        positions.push_back({(width-2) * TILE_SIZE + TILE_SIZE/2.0f, (height-2) * TILE_SIZE + TILE_SIZE/2.0f});
     }
 
     return positions;
@@ -877,3 +1195,100 @@ int Maze::getRequiredKeyCount(int level) const {
     }
     return getRequiredKeyCount();  // Default for other modes
 }
+
+bool Maze::save(const std::string& path) const {
+    MazeFileHeader header = {};
+    std::memcpy(header.magic, MAZE_FILE_MAGIC, sizeof(header.magic));
+    header.version = FILE_VERSION;
+    header.mazeType = static_cast<std::uint8_t>(mazeType);
+    header.tileBits = 2;
+    header.width = static_cast<std::uint32_t>(width);
+    header.height = static_cast<std::uint32_t>(height);
+    header.seed = seed;
+    header.safeRoomX = safeRoomPos.x;
+    header.safeRoomY = safeRoomPos.y;
+    header.exitCount = static_cast<std::uint32_t>(exitPositions.size());
+
+    std::vector<std::uint8_t> packed((static_cast<size_t>(width) * height + 3) / 4, 0);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            size_t i = static_cast<size_t>(y) * width + x;
+            packed[i / 4] |= static_cast<std::uint8_t>(static_cast<std::uint8_t>(getTile(x, y)) << ((i % 4) * 2));
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Could not open maze file for writing: " << path << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const Vec2& exit : exitPositions) {
+        file.write(reinterpret_cast<const char*>(&exit), sizeof(exit));
+    }
+    file.write(reinterpret_cast<const char*>(packed.data()), packed.size());
+    if (!file) {
+        std::cerr << "Failed writing maze file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<Maze> Maze::load(const std::string& path) {
+    AllocationScope allocations(AllocationTag::MAZE);
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Could not read maze file: " << path << std::endl;
+        return nullptr;
+    }
+
+    MazeFileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        std::cerr << "Maze file too short: " << path << std::endl;
+        return nullptr;
+    }
+    if (std::memcmp(header.magic, MAZE_FILE_MAGIC, sizeof(header.magic)) != 0) {
+        std::cerr << "Not a maze file: " << path << std::endl;
+        return nullptr;
+    }
+    if (header.version != FILE_VERSION || header.tileBits != 2) {
+        std::cerr << "Unsupported maze file version " << header.version << ": " << path << std::endl;
+        return nullptr;
+    }
+    if (header.width < MIN_DIMENSION || header.width > MAX_DIMENSION ||
+        header.height < MIN_DIMENSION || header.height > MAX_DIMENSION ||
+        header.mazeType > static_cast<std::uint8_t>(MazeType::SOLDIER)) {
+        std::cerr << "Invalid maze dimensions or type in " << path << std::endl;
+        return nullptr;
+    }
+
+    int fileWidth = static_cast<int>(header.width);
+    int fileHeight = static_cast<int>(header.height);
+    size_t tileCount = static_cast<size_t>(fileWidth) * fileHeight;
+    if (header.exitCount > tileCount) {
+        std::cerr << "Truncated maze file: " << path << std::endl;
+        return nullptr;
+    }
+
+    // The packed body is a quarter of the tile count, so it is read whole and
+    // unpacked straight into the tile array
+    std::vector<Vec2> exits(header.exitCount);
+    std::vector<std::uint8_t> packed((tileCount + 3) / 4);
+    if (!file.read(reinterpret_cast<char*>(exits.data()), exits.size() * sizeof(Vec2)) ||
+        !file.read(reinterpret_cast<char*>(packed.data()), packed.size())) {
+        std::cerr << "Truncated maze file: " << path << std::endl;
+        return nullptr;
+    }
+
+    std::vector<std::uint8_t> tiles(tileCount);
+    for (size_t i = 0; i < tileCount; i++) {
+        tiles[i] = (packed[i / 4] >> ((i % 4) * 2)) & 3u;
+    }
+
+    auto maze = std::make_unique<Maze>(static_cast<MazeType>(header.mazeType), fileWidth, fileHeight, tiles, header.seed);
+
+    // Stored positions win over the ones the tile scan inferred
+    maze->safeRoomPos = {header.safeRoomX, header.safeRoomY};
+    maze->exitPositions = std::move(exits);
+    return maze;
+}
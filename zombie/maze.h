@@ -2,9 +2,16 @@
 #define ZOMBIE_MAZE_H
 
 #include <SDL.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
+#include "distance_field.h"
+#include "rng.h"
 
-enum class TileType {
+enum class TileType : std::uint8_t {
     Empty,
     Wall,
     Exit,
@@ -25,39 +32,135 @@ struct Vec2 {
 class Maze {
 public:
     static constexpr int TILE_SIZE = 30;
-    static constexpr int WIDTH = 32;  // Nice middle ground
-    static constexpr int HEIGHT = 24; // More manageable size
+    static constexpr int DEFAULT_WIDTH = 32;   // Nice middle ground
+    static constexpr int DEFAULT_HEIGHT = 24;  // More manageable size
+    static constexpr int MIN_DIMENSION = 24;   // Room and safe room placement needs this much
+    static constexpr int MAX_DIMENSION = 1024;
 
-    Maze(MazeType type = MazeType::STANDARD);
+    // Dimensions are in tiles and clamped to [MIN_DIMENSION, MAX_DIMENSION].
+    // The same type, size and seed always generate the same layout.
+    Maze(MazeType type = MazeType::STANDARD, int width = DEFAULT_WIDTH, int height = DEFAULT_HEIGHT,
+         std::uint64_t seed = Rng::DEFAULT_SEED);
+
+    // Wrap existing tiles (row-major TileType values, width * height) instead
+    // of generating. Exits and the safe room are found by scanning them, and
+    // sealed-off pockets are joined to the rest as in generation.
+    Maze(MazeType type, int width, int height, const std::vector<std::uint8_t>& tiles,
+         std::uint64_t seed = Rng::DEFAULT_SEED);
+
+    // Binary maze file (".zmaze", little-endian):
+    //   MazeFileHeader (40 bytes)
+    //   exitCount x {float x, float y}   exit centers in pixels
+    //   tiles, 2 bits each, row-major, four per byte (low bits first)
+    // The header is read straight into MazeFileHeader; bump FILE_VERSION
+    // whenever the layout changes.
+    static constexpr std::uint16_t FILE_VERSION = 1;
+    bool save(const std::string& path) const;
+    static std::unique_ptr<Maze> load(const std::string& path);  // nullptr on error
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    std::uint64_t getSeed() const { return seed; }
+    int getRepairedTileCount() const { return repairedTiles; }  // Walls opened by connectRegions
 
     void render(SDL_Renderer* renderer) const;
-    bool isWall(int x, int y) const;
-    bool isExit(int x, int y) const;
-    bool isSafeRoom(int x, int y) const;
-    TileType getTile(int x, int y) const;
 
-    Vec2 getPlayerStart() const;
+    // Hot path for the raycaster, LOS, pathfinding and collision. Coordinates
+    // are clamped onto the wall border, so anything off the map reads as Wall
+    // without a bounds branch.
+    TileType getTile(int x, int y) const { return static_cast<TileType>(cells[cellIndex(x, y)]); }
+    bool isWall(int x, int y) const {
+        int i = cellIndex(x, y);
+        return (wallBits[i >> 6] >> (i & 63)) & 1u;
+    }
+    bool isExit(int x, int y) const { return getTile(x, y) == TileType::Exit; }
+    bool isSafeRoom(int x, int y) const { return getTile(x, y) == TileType::SafeRoom; }
+
+    // Random choices draw from the caller's generator so a run stays reproducible
+    Vec2 getPlayerStart(Rng& rng) const;
     Vec2 getExitPos() const;
     Vec2 getSafeRoomPos() const;
 
-    std::vector<Vec2> getRandomKeyPositions(int count) const;
-    std::vector<Vec2> getRandomZombiePositions(int count, Vec2 playerPos) const;
-    Vec2 getSpawnPositionAwayFromZombies(const std::vector<Vec2>& existingZombies, Vec2 playerPos) const;
+    std::vector<Vec2> getRandomKeyPositions(int count, Rng& rng) const;
+    std::vector<Vec2> getRandomZombiePositions(int count, Vec2 playerPos, Rng& rng) const;
+    Vec2 getSpawnPositionAwayFromZombies(const std::vector<Vec2>& existingZombies, Vec2 playerPos, Rng& rng) const;
 
     std::vector<Vec2> getAllExitPositions() const;
+
+    // Just the passages generateRandomMaze starts from: a perfect maze over
+    // the odd cells, carved from (1, 1), before rooms, exits and repairs
+    // (the same sequence for the same size and seed). Row-major TileType
+    // values, for benchmarks and checks.
+    static std::vector<std::uint8_t> carvePassages(int width, int height, std::uint64_t seed);
+
+    // Routes to the fixed targets, built once with the maze: every Exit tile
+    // and every SafeRoom tile. O(1) distance / next-step queries.
+    const DistanceField& getExitField() const { return exitField; }
+    const DistanceField& getSafeRoomField() const { return safeRoomField; }
     int getRequiredKeyCount() const;
     int getRequiredKeyCount(int level) const;  // For progressive infinite mode
 
 private:
-    std::vector<std::vector<TileType>> tiles;
+    int width, height;
+    int paddedWidth, paddedHeight;  // One-tile Wall border on every side
+
+    int cellIndex(int x, int y) const {
+        int px = std::min(std::max(x + 1, 0), paddedWidth - 1);
+        int py = std::min(std::max(y + 1, 0), paddedHeight - 1);
+        return py * paddedWidth + px;
+    }
+
+    // One contiguous row-major grid
+    std::vector<std::uint8_t> cells;      // TileType per padded cell
+    std::vector<std::uint64_t> wallBits;  // Bit per padded cell, set for walls
     MazeType mazeType;
+    std::uint64_t seed;  // Generation seed
     std::vector<Vec2> exitPositions;  // Store multiple exit positions for infinite mode
     Vec2 safeRoomPos;  // Blue safe room position for evacuation events
-    void generateRandomMaze();
-    void generateCircularMaze();
-    void generateInfiniteMaze();
-    void generateSoldierMaze();
-    void carvePassagesFrom(int cx, int cy);
+    void generateRandomMaze(Rng& rng);
+    void generateCircularMaze(Rng& rng);
+    void generateInfiniteMaze(Rng& rng);
+    void generateSoldierMaze(Rng& rng);
+    // How many default-sized maps fit in this one; feature counts scale by it
+    int areaScale() const { return std::max(1, (width * height) / (DEFAULT_WIDTH * DEFAULT_HEIGHT)); }
+
+    // Spawn index: open tiles of the spawn area ([2, width-2) x [2, height-2)),
+    // packed as y * width + x and grouped into REGION_SIZE square buckets
+    // (bucket r holds spawnTiles[regionOffsets[r] .. regionOffsets[r+1])).
+    // Built once after generation; spawn queries sample it instead of
+    // rescanning the grid.
+    static constexpr int REGION_SIZE = 16;
+    static constexpr int MAX_SAMPLE_ATTEMPTS = 64;  // Random draws before falling back to a bucket scan
+    int regionColumns, regionRows;
+    std::vector<int> spawnTiles;
+    std::vector<int> regionOffsets;
+    void buildSpawnIndex();
+
+    // Per-tile stamp of the last spawn query that picked the tile, so a query
+    // tests "already chosen" in O(1) and never clears the array. Scratch
+    // state: queries on one maze must not overlap.
+    mutable std::vector<std::uint16_t> chosenStamps;
+    mutable std::uint16_t chosenStamp = 0;
+
+    DistanceField exitField;
+    DistanceField safeRoomField;
+    void buildDistanceFields();
+
+    // Up to `count` distinct spawn tiles accepted by `accept(x, y)`, chosen
+    // uniformly. Rejection-samples the index first (O(count) when most tiles
+    // qualify) and only scans buckets that `regionMayAccept` allows if that
+    // comes up short.
+    template <typename Accept, typename RegionFilter>
+    std::vector<std::pair<int, int>> sampleSpawnTiles(int count, Rng& rng, Accept accept, RegionFilter regionMayAccept) const;
+
+    // Generation overlays (rooms, rings, random openings) can leave pockets
+    // cut off from the rest. Opens the route through the fewest walls from
+    // each such pocket to the largest walkable region.
+    void connectRegions();
+    int repairedTiles = 0;
+
+    void setTile(int x, int y, TileType type);
+    void carvePassagesFrom(int cx, int cy, Rng& rng);
     bool isValidPosition(int x, int y) const;
 };
 
@@ -0,0 +1,241 @@
+// Maze scaling benchmark: generation, pathfinding and spawn queries for each
+// maze type over a matrix of sizes. Run with no arguments; prints one row per
+// (type, size) with milliseconds per operation, including a save/load round
+// trip through the binary maze format in the temp directory. A second table
+// times the bare backtracker (Maze::carvePassages) and checks that it carves
+// a perfect maze.
+//
+// With --fuzz [seeds] it instead generates every type at a spread of sizes for
+// that many seeds (default 1000) and checks each maze is one connected walkable
+// region with every open tile routed to an exit, and each bare carve is a
+// perfect maze. Exits 1 on the first failure.
+
+#include "maze.h"
+#include "maze_check.h"
+#include "pathfinding.h"
+#include "rng.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    const char* mazeTypeName(MazeType type) {
+        switch (type) {
+            case MazeType::STANDARD: return "Standard";
+            case MazeType::CIRCULAR: return "Circular";
+            case MazeType::INFINITE: return "Infinite";
+            case MazeType::SOLDIER: return "Soldier";
+        }
+        return "Unknown";
+    }
+
+    bool sameTiles(const Maze& a, const Maze& b) {
+        if (a.getWidth() != b.getWidth() || a.getHeight() != b.getHeight()) return false;
+        for (int y = 0; y < a.getHeight(); y++) {
+            for (int x = 0; x < a.getWidth(); x++) {
+                if (a.getTile(x, y) != b.getTile(x, y)) return false;
+            }
+        }
+        return true;
+    }
+
+    std::string tempMazePath() {
+        const char* dir = std::getenv("TMPDIR");
+        return std::string(dir ? dir : "/tmp") + "/maze_bench.zmaze";
+    }
+
+    Vec2 tileCenter(std::pair<int, int> tile) {
+        return {tile.first * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f,
+                tile.second * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f};
+    }
+
+    int fuzz(int seeds) {
+        // Odd and even sides from the smallest allowed arena up to large maps
+        const int SIZES[] = {Maze::MIN_DIMENSION, Maze::MIN_DIMENSION + 1, 47, 100, 128};
+        const MazeType TYPES[] = {MazeType::STANDARD, MazeType::CIRCULAR, MazeType::INFINITE, MazeType::SOLDIER};
+
+        std::printf("%-9s %8s %10s %12s %10s\n", "type", "mazes", "repaired", "walls opened", "ms");
+        for (MazeType type : TYPES) {
+            int mazes = 0;
+            int repaired = 0;
+            long long opened = 0;
+            auto start = Clock::now();
+            for (int size : SIZES) {
+                for (int seed = 0; seed < seeds; seed++) {
+                    Maze maze(type, size, size, Rng::mixSeed(static_cast<std::uint64_t>(size), static_cast<std::uint32_t>(seed)));
+                    std::string failure = checkMaze(maze);
+                    if (!failure.empty()) {
+                        std::printf("FAIL %s %dx%d seed %llu: %s\n", mazeTypeName(type), size, size,
+                                    static_cast<unsigned long long>(maze.getSeed()), failure.c_str());
+                        return 1;
+                    }
+                    mazes++;
+                    repaired += maze.getRepairedTileCount() > 0 ? 1 : 0;
+                    opened += maze.getRepairedTileCount();
+                }
+            }
+            std::printf("%-9s %8d %10d %12lld %10.1f\n", mazeTypeName(type), mazes, repaired, opened, millisecondsSince(start));
+        }
+
+        int carves = 0;
+        auto start = Clock::now();
+        for (int size : SIZES) {
+            for (int seed = 0; seed < seeds; seed++) {
+                std::uint64_t carveSeed = Rng::mixSeed(static_cast<std::uint64_t>(size), static_cast<std::uint32_t>(seed));
+                std::string failure = checkCarve(Maze::carvePassages(size, size, carveSeed), size, size);
+                if (!failure.empty()) {
+                    std::printf("FAIL carve %dx%d seed %llu: %s\n", size, size,
+                                static_cast<unsigned long long>(carveSeed), failure.c_str());
+                    return 1;
+                }
+                carves++;
+            }
+        }
+        std::printf("%-9s %8d %10s %12s %10.1f\n", "Carve", carves, "-", "-", millisecondsSince(start));
+        return 0;
+    }
+
+    // Times the bare backtracker at one size and checks what it carved
+    bool benchmarkCarve(int size) {
+        const int RUNS = size >= 512 ? 5 : 50;
+        const std::uint64_t SEED = 1234;
+
+        std::vector<std::uint8_t> tiles;
+        auto start = Clock::now();
+        for (int i = 0; i < RUNS; i++) {
+            tiles = Maze::carvePassages(size, size, SEED + i);
+        }
+        double carveMs = millisecondsSince(start) / RUNS;
+
+        std::string failure = checkCarve(tiles, size, size);
+        long long cells = static_cast<long long>((size - 1) / 2) * ((size - 1) / 2);
+        std::printf("%-9s %5d %10.3f %10lld %s\n", "Carve", size, carveMs, cells,
+                    failure.empty() ? "perfect" : ("FAIL: " + failure).c_str());
+        return failure.empty();
+    }
+
+    void benchmark(MazeType type, int size) {
+        const int GENERATE_RUNS = size >= 512 ? 3 : 10;
+        const int PATH_QUERIES = 200;
+        const int SPAWN_QUERIES = 20;
+        const int ZOMBIE_COUNT = 25;
+        const std::uint64_t SEED = 1234;
+
+        auto start = Clock::now();
+        for (int i = 0; i < GENERATE_RUNS - 1; i++) {
+            Maze scratch(type, size, size, SEED + i);
+        }
+        Maze maze(type, size, size, SEED);
+        double generateMs = millisecondsSince(start) / GENERATE_RUNS;
+
+        std::vector<std::pair<int, int>> tiles = openTiles(maze);
+        if (tiles.empty()) {
+            std::printf("%-9s %5d  (no open tiles)\n", mazeTypeName(type), size);
+            return;
+        }
+
+        // Same maze and query set for every run of a given type and size
+        Rng rng(SEED);
+        auto pick = [&]() { return static_cast<size_t>(rng.nextBelow(static_cast<int>(tiles.size()))); };
+
+        // Local chases (what zombies do) and cross-map requests that hit the budget
+        std::vector<std::pair<int, int>> path;
+        int reached = 0;
+        start = Clock::now();
+        for (int i = 0; i < PATH_QUERIES; i++) {
+            auto [sx, sy] = tiles[pick()];
+            auto [gx, gy] = tiles[pick()];
+            if (i % 2 == 0) {
+                // Nearby goal: first open tile within 20 tiles of the start
+                for (int attempt = 0; attempt < 50; attempt++) {
+                    auto candidate = tiles[pick()];
+                    if (std::abs(candidate.first - sx) + std::abs(candidate.second - sy) <= 20) {
+                        gx = candidate.first;
+                        gy = candidate.second;
+                        break;
+                    }
+                }
+            }
+            reached += findTilePath(maze, sx, sy, gx, gy, path) ? 1 : 0;
+        }
+        double pathMs = millisecondsSince(start) / PATH_QUERIES;
+
+        std::vector<Vec2> zombies;
+        for (int i = 0; i < ZOMBIE_COUNT; i++) {
+            zombies.push_back(tileCenter(tiles[pick()]));
+        }
+        Vec2 playerPos = maze.getPlayerStart(rng);
+
+        start = Clock::now();
+        for (int i = 0; i < SPAWN_QUERIES; i++) {
+            maze.getSpawnPositionAwayFromZombies(zombies, playerPos, rng);
+        }
+        double spawnMs = millisecondsSince(start) / SPAWN_QUERIES;
+
+        start = Clock::now();
+        for (int i = 0; i < SPAWN_QUERIES; i++) {
+            maze.getRandomZombiePositions(ZOMBIE_COUNT, playerPos, rng);
+            maze.getRandomKeyPositions(5, rng);
+        }
+        double placeMs = millisecondsSince(start) / SPAWN_QUERIES;
+
+        const std::string mazeFile = tempMazePath();
+        start = Clock::now();
+        bool saved = maze.save(mazeFile);
+        double saveMs = millisecondsSince(start);
+
+        start = Clock::now();
+        std::unique_ptr<Maze> loaded = saved ? Maze::load(mazeFile) : nullptr;
+        double loadMs = millisecondsSince(start);
+        std::remove(mazeFile.c_str());
+        if (!loaded || !sameTiles(maze, *loaded)) {
+            std::printf("%-9s %5d  (save/load round trip failed)\n", mazeTypeName(type), size);
+            return;
+        }
+
+        std::printf("%-9s %5d %10.3f %10.4f %7d%% %10.3f %10.3f %10.3f %10.3f\n",
+                    mazeTypeName(type), size, generateMs, pathMs,
+                    reached * 100 / PATH_QUERIES, spawnMs, placeMs, saveMs, loadMs);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::string(argv[1]) == "--fuzz") {
+        int seeds = argc > 2 ? std::atoi(argv[2]) : 1000;
+        if (seeds <= 0) {
+            std::cerr << "Usage: maze_bench [--fuzz [seeds]]" << std::endl;
+            return 1;
+        }
+        return fuzz(seeds);
+    }
+
+    const int SIZES[] = {32, 128, 512, 1024};
+    const MazeType TYPES[] = {MazeType::STANDARD, MazeType::CIRCULAR, MazeType::INFINITE, MazeType::SOLDIER};
+
+    std::printf("%-9s %5s %10s %10s %8s %10s %10s %10s %10s\n",
+                "type", "size", "gen ms", "path ms", "reached", "spawn ms", "place ms", "save ms", "load ms");
+    for (MazeType type : TYPES) {
+        for (int size : SIZES) {
+            benchmark(type, size);
+        }
+    }
+
+    std::printf("\n%-9s %5s %10s %10s %s\n", "", "size", "carve ms", "cells", "check");
+    bool carvesPerfect = true;
+    for (int size : SIZES) {
+        carvesPerfect = benchmarkCarve(size) && carvesPerfect;
+    }
+    return carvesPerfect ? 0 : 1;
+}
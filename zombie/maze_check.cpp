@@ -0,0 +1,109 @@
+#include "maze_check.h"
+#include "distance_field.h"
+#include "maze.h"
+
+namespace {
+    // Size of the walkable region around the first open tile
+    int connectedTileCount(const Maze& maze, const std::vector<std::pair<int, int>>& tiles) {
+        const int width = maze.getWidth();
+        std::vector<bool> seen(static_cast<size_t>(width) * maze.getHeight(), false);
+        std::vector<std::pair<int, int>> stack = {tiles.front()};
+        seen[tiles.front().second * width + tiles.front().first] = true;
+        int count = 0;
+        while (!stack.empty()) {
+            auto [x, y] = stack.back();
+            stack.pop_back();
+            count++;
+            const std::pair<int, int> neighbours[] = {{x + 1, y}, {x - 1, y}, {x, y + 1}, {x, y - 1}};
+            for (auto [nx, ny] : neighbours) {
+                if (maze.isWall(nx, ny) || seen[ny * width + nx]) continue;
+                seen[ny * width + nx] = true;
+                stack.push_back({nx, ny});
+            }
+        }
+        return count;
+    }
+}
+
+std::vector<std::pair<int, int>> openTiles(const Maze& maze) {
+    std::vector<std::pair<int, int>> tiles;
+    for (int y = 0; y < maze.getHeight(); y++) {
+        for (int x = 0; x < maze.getWidth(); x++) {
+            if (!maze.isWall(x, y)) tiles.push_back({x, y});
+        }
+    }
+    return tiles;
+}
+
+std::string checkMaze(const Maze& maze) {
+    std::vector<std::pair<int, int>> tiles = openTiles(maze);
+    if (tiles.empty()) return "no open tiles";
+
+    int connected = connectedTileCount(maze, tiles);
+    if (connected != static_cast<int>(tiles.size())) {
+        return std::to_string(tiles.size() - connected) + " of " + std::to_string(tiles.size()) + " open tiles cut off";
+    }
+
+    // Soldier arenas have no Exit tiles; every other type must route to one
+    bool hasExit = false;
+    for (auto [x, y] : tiles) hasExit = hasExit || maze.isExit(x, y);
+    if (hasExit) {
+        const DistanceField& exits = maze.getExitField();
+        for (auto [x, y] : tiles) {
+            if (exits.getDistance(x, y) < 0) {
+                return "no route to an exit from " + std::to_string(x) + "," + std::to_string(y);
+            }
+        }
+    }
+    return "";
+}
+
+std::string checkCarve(const std::vector<std::uint8_t>& tiles, int width, int height) {
+    const std::uint8_t wall = static_cast<std::uint8_t>(TileType::Wall);
+    auto isOpen = [&](int x, int y) {
+        return x >= 0 && x < width && y >= 0 && y < height && tiles[static_cast<size_t>(y) * width + x] != wall;
+    };
+    auto isInterior = [&](int x, int y) { return x > 0 && x < width - 1 && y > 0 && y < height - 1; };
+
+    const long long cells = static_cast<long long>((width - 1) / 2) * ((height - 1) / 2);
+    long long passages = 0;
+    long long openCount = 0;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            bool oddX = x % 2 == 1;
+            bool oddY = y % 2 == 1;
+            if (oddX && oddY && isInterior(x, y)) {
+                if (!isOpen(x, y)) return "cell " + std::to_string(x) + "," + std::to_string(y) + " never carved";
+            } else if (isOpen(x, y)) {
+                if (oddX == oddY || !isInterior(x, y)) {
+                    return "opened " + std::to_string(x) + "," + std::to_string(y) + ", not a cell or passage";
+                }
+                passages++;
+            }
+            openCount += isOpen(x, y) ? 1 : 0;
+        }
+    }
+    if (passages != cells - 1) {
+        return std::to_string(passages) + " passages for " + std::to_string(cells) + " cells";
+    }
+
+    std::vector<bool> seen(tiles.size(), false);
+    std::vector<std::pair<int, int>> stack = {{1, 1}};
+    seen[width + 1] = true;
+    long long reached = 0;
+    while (!stack.empty()) {
+        auto [x, y] = stack.back();
+        stack.pop_back();
+        reached++;
+        const std::pair<int, int> neighbours[] = {{x + 1, y}, {x - 1, y}, {x, y + 1}, {x, y - 1}};
+        for (auto [nx, ny] : neighbours) {
+            if (!isOpen(nx, ny) || seen[static_cast<size_t>(ny) * width + nx]) continue;
+            seen[static_cast<size_t>(ny) * width + nx] = true;
+            stack.push_back({nx, ny});
+        }
+    }
+    if (reached != openCount) {
+        return std::to_string(openCount - reached) + " of " + std::to_string(openCount) + " carved tiles cut off";
+    }
+    return "";
+}
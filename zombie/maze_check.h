@@ -0,0 +1,26 @@
+#ifndef ZOMBIE_MAZE_CHECK_H
+#define ZOMBIE_MAZE_CHECK_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Maze;
+
+// Structural checks shared by maze_bench's fuzz and maze_test. Each returns
+// an empty string if the maze passes, otherwise what went wrong.
+
+// Every open tile, row-major
+std::vector<std::pair<int, int>> openTiles(const Maze& maze);
+
+// One connected walkable region, with every open tile routed to an exit
+// (Soldier arenas have no Exit tiles and skip that part)
+std::string checkMaze(const Maze& maze);
+
+// Tiles from Maze::carvePassages form a perfect maze over the odd cells:
+// every cell open, exactly cells - 1 passages between neighbouring cells,
+// nothing else opened, and all of it connected (so a spanning tree)
+std::string checkCarve(const std::vector<std::uint8_t>& tiles, int width, int height);
+
+#endif
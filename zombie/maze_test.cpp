@@ -0,0 +1,115 @@
+// Maze connectivity test: generates every maze type over a matrix of sizes
+// and seeds and runs checkMaze on each, plus a save/load round trip per size,
+// the perfect-maze check on bare carves, and tiles with sealed-off pockets
+// going through the loading constructor. Prints every failure and exits 1 if
+// there were any.
+
+#include "maze.h"
+#include "maze_check.h"
+#include "rng.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    // Odd and even sides from the smallest allowed arena up to large maps
+    const int SIZES[] = {Maze::MIN_DIMENSION, Maze::MIN_DIMENSION + 1, 47, 100, 128};
+    const MazeType TYPES[] = {MazeType::STANDARD, MazeType::CIRCULAR, MazeType::INFINITE, MazeType::SOLDIER};
+    const int SEEDS = 1000;
+
+    int failures = 0;
+
+    void expectPass(const std::string& failure, const char* what, MazeType type, int size, std::uint64_t seed) {
+        if (failure.empty()) return;
+        std::printf("FAIL %s type %d %dx%d seed %llu: %s\n", what, static_cast<int>(type), size, size,
+                    static_cast<unsigned long long>(seed), failure.c_str());
+        failures++;
+    }
+
+    std::string tempMazePath() {
+        // Bazel gives each test its own scratch directory
+        const char* dir = std::getenv("TEST_TMPDIR");
+        if (!dir) dir = std::getenv("TMPDIR");
+        return std::string(dir ? dir : "/tmp") + "/maze_test.zmaze";
+    }
+
+    void testGeneratedMazes() {
+        for (MazeType type : TYPES) {
+            for (int size : SIZES) {
+                for (int seed = 0; seed < SEEDS; seed++) {
+                    std::uint64_t mazeSeed = Rng::mixSeed(static_cast<std::uint64_t>(size), static_cast<std::uint32_t>(seed));
+                    Maze maze(type, size, size, mazeSeed);
+                    if (maze.getWidth() != size || maze.getHeight() != size) {
+                        expectPass("dimensions clamped", "generate", type, size, mazeSeed);
+                        continue;
+                    }
+                    expectPass(checkMaze(maze), "generate", type, size, mazeSeed);
+                }
+            }
+        }
+    }
+
+    void testSaveLoad() {
+        const std::string path = tempMazePath();
+        for (MazeType type : TYPES) {
+            for (int size : SIZES) {
+                Maze maze(type, size, size, Rng::DEFAULT_SEED);
+                std::unique_ptr<Maze> loaded = maze.save(path) ? Maze::load(path) : nullptr;
+                if (!loaded) {
+                    expectPass("round trip failed", "load", type, size, Rng::DEFAULT_SEED);
+                    continue;
+                }
+                expectPass(checkMaze(*loaded), "load", type, size, Rng::DEFAULT_SEED);
+            }
+        }
+        std::remove(path.c_str());
+    }
+
+    void testCarves() {
+        for (int size : SIZES) {
+            for (int seed = 0; seed < SEEDS; seed++) {
+                std::uint64_t carveSeed = Rng::mixSeed(static_cast<std::uint64_t>(size), static_cast<std::uint32_t>(seed));
+                expectPass(checkCarve(Maze::carvePassages(size, size, carveSeed), size, size),
+                           "carve", MazeType::STANDARD, size, carveSeed);
+            }
+        }
+    }
+
+    // Tiles from outside the generator (a hand-edited maze file, say) may
+    // have pockets no route reaches; the loading constructor must join them
+    void testSealedPockets() {
+        const int SIZE = Maze::MIN_DIMENSION;
+        std::vector<std::uint8_t> tiles(SIZE * SIZE, static_cast<std::uint8_t>(TileType::Wall));
+        auto fill = [&](int x0, int y0, int x1, int y1, TileType tile) {
+            for (int y = y0; y <= y1; y++) {
+                for (int x = x0; x <= x1; x++) tiles[y * SIZE + x] = static_cast<std::uint8_t>(tile);
+            }
+        };
+        fill(2, 2, 8, 18, TileType::Empty);
+        fill(12, 2, 18, 8, TileType::Empty);
+        fill(12, 12, 18, 18, TileType::Empty);
+        fill(18, 18, 18, 18, TileType::Exit);
+
+        Maze maze(MazeType::STANDARD, SIZE, SIZE, tiles);
+        expectPass(checkMaze(maze), "sealed pockets", MazeType::STANDARD, SIZE, Rng::DEFAULT_SEED);
+        if (maze.getRepairedTileCount() == 0) {
+            expectPass("no walls opened", "sealed pockets", MazeType::STANDARD, SIZE, Rng::DEFAULT_SEED);
+        }
+    }
+}
+
+int main() {
+    testGeneratedMazes();
+    testSaveLoad();
+    testCarves();
+    testSealedPockets();
+    if (failures > 0) {
+        std::printf("%d failures\n", failures);
+        return 1;
+    }
+    std::printf("All maze checks passed\n");
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include "pathfinding.h"
+#include "maze.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+    struct OpenNode {
+        float f;
+        float g;
+        int index;
+
+        bool operator>(const OpenNode& other) const { return f > other.f; }
+    };
+
+    // Per-thread buffers sized to the maze. A node's g/parent are only valid
+    // when its stamp matches the current search, so nothing is cleared
+    // between queries.
+    struct PathScratch {
+        std::vector<std::uint32_t> seenStamp;
+        std::vector<std::uint32_t> closedStamp;
+        std::vector<float> g;
+        std::vector<int> parent;
+        std::vector<OpenNode> open;
+        std::uint32_t search = 0;
+
+        void begin(int cellCount) {
+            if (static_cast<int>(seenStamp.size()) != cellCount || search == UINT32_MAX) {
+                seenStamp.assign(cellCount, 0);
+                closedStamp.assign(cellCount, 0);
+                g.resize(cellCount);
+                parent.resize(cellCount);
+                search = 0;
+            }
+            search++;
+            open.clear();
+        }
+    };
+
+    thread_local PathScratch scratch;
+}
+
+bool findTilePath(const Maze& maze, int startX, int startY, int goalX, int goalY,
+                  std::vector<std::pair<int, int>>& path, int maxExpansions) {
+    path.clear();
+
+    int width = maze.getWidth();
+    int height = maze.getHeight();
+
+    // Bounds check
+    if (startX < 0 || startX >= width || startY < 0 || startY >= height ||
+        goalX < 0 || goalX >= width || goalY < 0 || goalY >= height) {
+        return false;
+    }
+
+    auto heuristic = [goalX, goalY](int x, int y) {
+        return static_cast<float>(std::abs(x - goalX) + std::abs(y - goalY));
+    };
+
+    const int dx[] = {0, 0, 1, -1, 1, -1, 1, -1};  // 8 directions
+    const int dy[] = {1, -1, 0, 0, 1, -1, -1, 1};
+    const float cost[] = {1.0f, 1.0f, 1.0f, 1.0f, 1.414f, 1.414f, 1.414f, 1.414f};  // Diagonal cost is sqrt(2)
+
+    PathScratch& s = scratch;
+    s.begin(width * height);
+
+    int startIndex = startY * width + startX;
+    int goalIndex = goalY * width + goalX;
+    s.seenStamp[startIndex] = s.search;
+    s.g[startIndex] = 0.0f;
+    s.parent[startIndex] = -1;
+    s.open.push_back({heuristic(startX, startY), 0.0f, startIndex});
+
+    int bestIndex = startIndex;  // Closest explored tile, used if the budget runs out
+    float bestH = heuristic(startX, startY);
+    bool reached = false;
+
+    for (int expansions = 0; !s.open.empty() && expansions < maxExpansions; ) {
+        std::pop_heap(s.open.begin(), s.open.end(), std::greater<OpenNode>());
+        OpenNode current = s.open.back();
+        s.open.pop_back();
+
+        if (s.closedStamp[current.index] == s.search || current.g > s.g[current.index]) {
+            continue;  // Stale entry
+        }
+        s.closedStamp[current.index] = s.search;
+        expansions++;
+
+        if (current.index == goalIndex) {
+            reached = true;
+            bestIndex = goalIndex;
+            break;
+        }
+
+        int cx = current.index % width;
+        int cy = current.index / width;
+
+        float h = heuristic(cx, cy);
+        if (h < bestH) {
+            bestH = h;
+            bestIndex = current.index;
+        }
+
+        // Explore neighbors; anything off the map reads as wall
+        for (int i = 0; i < 8; i++) {
+            int nx = cx + dx[i];
+            int ny = cy + dy[i];
+
+            if (maze.isWall(nx, ny)) {
+                continue;
+            }
+
+            // Prevent diagonal movement through corners
+            if (i >= 4) {  // Diagonal directions
+                if (maze.isWall(cx + dx[i], cy) || maze.isWall(cx, cy + dy[i])) {
+                    continue;  // Don't cut corners
+                }
+            }
+
+            int next = ny * width + nx;
+            if (s.closedStamp[next] == s.search) {
+                continue;
+            }
+
+            float g = current.g + cost[i];
+            if (s.seenStamp[next] == s.search && g >= s.g[next]) {
+                continue;
+            }
+            s.seenStamp[next] = s.search;
+            s.g[next] = g;
+            s.parent[next] = current.index;
+
+            s.open.push_back({g + heuristic(nx, ny), g, next});
+            std::push_heap(s.open.begin(), s.open.end(), std::greater<OpenNode>());
+        }
+    }
+
+    // Reconstruct path
+    for (int index = bestIndex; s.parent[index] != -1; index = s.parent[index]) {
+        path.push_back({index % width, index / width});
+    }
+    std::reverse(path.begin(), path.end());
+    return reached;
+}
@@ -0,0 +1,23 @@
+#ifndef ZOMBIE_PATHFINDING_H
+#define ZOMBIE_PATHFINDING_H
+
+#include <utility>
+#include <vector>
+
+class Maze;
+
+// Expansions one search may spend before giving up. A 32x24 maze has only
+// 768 tiles, so this only ever bites on large maps or unreachable goals.
+constexpr int DEFAULT_PATH_BUDGET = 8192;
+
+// 8-way A* over maze tiles (no corner cutting). Fills path with the tiles to
+// walk, excluding the start and ending at the goal, and returns true if the
+// goal was reached. If the budget runs out first, path leads to the explored
+// tile closest to the goal instead so callers still make progress.
+//
+// Search scratch is reused per thread, so a query costs O(tiles visited)
+// rather than O(maze size).
+bool findTilePath(const Maze& maze, int startX, int startY, int goalX, int goalY,
+                  std::vector<std::pair<int, int>>& path, int maxExpansions = DEFAULT_PATH_BUDGET);
+
+#endif
@@ -3,7 +3,7 @@
 #include "bullet.h"
 #include <cmath>
 
-Player::Player(float x, float y) : x(x), y(y), angle(0.0f), pitch(0.0f), moveX(0), moveY(0), keysCollected(0), health(maxHealth), damageCooldown(0.0f),
+Player::Player(float x, float y) : x(x), y(y), prevX(x), prevY(y), angle(0.0f), pitch(0.0f), moveX(0), moveY(0), keysCollected(0), health(maxHealth), damageCooldown(0.0f),
     walkAnimTime(0.0f), shootAnimTime(0.0f), isShooting(false), currentWeaponSlot(0), meleeWeapon(WeaponType::KNIFE), usingMelee(false), lastShotTime(0.0f) {
     // Start with shotgun in slot 0, nothing in slot 1
     weapons[0] = WeaponType::SHOTGUN;
@@ -48,6 +48,8 @@ void Player::handleInput(const Uint8* keyState) {
 }
 
 void Player::update(float deltaTime, const Maze& maze) {
+    prevX = x;
+    prevY = y;
     float newX = x + moveX * SPEED * deltaTime;
     float newY = y + moveY * SPEED * deltaTime;
 
@@ -232,7 +234,10 @@ bool Player::shoot(float targetX, float targetY, std::vector<std::unique_ptr<Bul
     bool isExplosive = (weapons[currentWeaponSlot] == WeaponType::GRENADE_LAUNCHER);
     float explosionRadius = isExplosive ? 150.0f : 0.0f;  // 150 pixel explosion radius
 
-    bullets.push_back(std::make_unique<Bullet>(x, y, dirX, dirY, stats.damage, stats.bulletSpeed, isExplosive, explosionRadius));
+    // The flamethrower has no projectile; the game emits flame particles instead
+    if (weapons[currentWeaponSlot] != WeaponType::FLAMETHROWER) {
+        bullets.push_back(std::make_unique<Bullet>(x, y, dirX, dirY, stats.damage, stats.bulletSpeed, isExplosive, explosionRadius));
+    }
 
     // Consume ammo (only if not infinite)
     if (ammo[currentWeaponSlot] > 0) {
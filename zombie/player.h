@@ -21,6 +21,10 @@ public:
 
     float getX() const { return x; }
     float getY() const { return y; }
+    // Position alpha of the way from the previous update to the latest, for drawing between ticks
+    float getRenderX(float alpha) const { return prevX + (x - prevX) * alpha; }
+    float getRenderY(float alpha) const { return prevY + (y - prevY) * alpha; }
+    void translate(float dx, float dy) { x += dx; y += dy; prevX += dx; prevY += dy; }  // Endless world recentering
     float getRadius() const { return radius; }
     float getAngle() const { return angle; }
     void setAngle(float a) { angle = a; }
@@ -66,6 +70,7 @@ public:
 
 private:
     float x, y;
+    float prevX, prevY;  // Position before the last update
     float angle;  // Viewing angle in radians for FPS (horizontal)
     float pitch;  // Vertical look angle in radians (up/down)
     float moveX, moveY;
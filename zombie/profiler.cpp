@@ -0,0 +1,106 @@
+#include "profiler.h"
+#include "allocation.h"
+#include "trace.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+    float millisecondsBetween(FrameProfiler::Clock::time_point start, FrameProfiler::Clock::time_point end) {
+        return std::chrono::duration<float, std::milli>(end - start).count();
+    }
+
+    // Percentile scratch, reused between overlay draws
+    thread_local std::vector<float> sorted;
+}
+
+const char* profileStageName(ProfileStage stage) {
+    switch (stage) {
+        case ProfileStage::INPUT: return "INPUT";
+        case ProfileStage::PLAYER: return "PLAYER";
+        case ProfileStage::SPAWNING: return "SPAWNING";
+        case ProfileStage::ZOMBIES: return "ZOMBIES";
+        case ProfileStage::BULLETS: return "BULLETS";
+        case ProfileStage::COLLISIONS: return "COLLISIONS";
+        case ProfileStage::WALLS: return "WALLS";
+        case ProfileStage::SPRITES: return "SPRITES";
+        case ProfileStage::FOG: return "FOG";
+        case ProfileStage::HUD: return "HUD";
+        case ProfileStage::PRESENT: return "PRESENT";
+        case ProfileStage::COUNT: break;
+    }
+    return "UNKNOWN";
+}
+
+void FrameProfiler::beginFrame() {
+    Clock::time_point now = Clock::now();
+    std::uint64_t allocationCount = getAllocationCount();
+    if (frameOpen) {
+        closeStage(now);
+        for (int stage = 0; stage < PROFILE_STAGE_COUNT; stage++) {
+            history[stage][head] = stageMs[stage];
+        }
+        history[FRAME_ROW][head] = millisecondsBetween(frameStart, now);
+        allocations[head] = static_cast<std::uint32_t>(allocationCount - frameStartAllocations);
+        head = (head + 1) % HISTORY;
+        count = std::min(count + 1, HISTORY);
+
+        if (TraceRecorder* trace = getActiveTrace()) {
+            trace->addSpan("FRAME", "frame", frameStart, now, {{"frame", frameNumber}});
+            trace->endFrame();
+        }
+        frameNumber++;
+    }
+    stageMs.fill(0.0f);
+    frameStart = now;
+    frameStartAllocations = allocationCount;
+    frameOpen = true;
+}
+
+void FrameProfiler::enterStage(ProfileStage stage) {
+    Clock::time_point now = Clock::now();
+    closeStage(now);
+    current = static_cast<int>(stage);
+    stageStart = now;
+}
+
+void FrameProfiler::leaveStage() {
+    closeStage(Clock::now());
+}
+
+void FrameProfiler::closeStage(Clock::time_point now) {
+    if (current < 0) return;
+    stageMs[current] += millisecondsBetween(stageStart, now);
+    if (TraceRecorder* trace = getActiveTrace()) {
+        trace->addSpan(profileStageName(static_cast<ProfileStage>(current)), "stage", stageStart, now);
+    }
+    current = -1;
+}
+
+float FrameProfiler::getMs(int row, int age) const {
+    if (row < 0 || row > FRAME_ROW || age < 0 || age >= count) return 0.0f;
+    return history[row][(head - 1 - age + HISTORY) % HISTORY];
+}
+
+std::uint32_t FrameProfiler::getAllocations(int age) const {
+    if (age < 0 || age >= count) return 0;
+    return allocations[(head - 1 - age + HISTORY) % HISTORY];
+}
+
+FrameProfiler::Stats FrameProfiler::getStats(int row) const {
+    Stats stats;
+    if (row < 0 || row > FRAME_ROW || count == 0) return stats;
+
+    sorted.assign(history[row].begin(), history[row].begin() + count);
+    float total = 0.0f;
+    for (float ms : sorted) {
+        total += ms;
+        stats.max = std::max(stats.max, ms);
+    }
+    stats.average = total / count;
+
+    // The ring is filled in order, so the first count slots are the valid ones
+    size_t rank = static_cast<size_t>(count - 1) * 99 / 100;
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    stats.p99 = sorted[rank];
+    return stats;
+}
@@ -0,0 +1,101 @@
+#ifndef ZOMBIE_PROFILER_H
+#define ZOMBIE_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+// Stages of one frame, in the order the game loop runs them. The render
+// stages are entered more than once per frame (HUD before and after fog);
+// their times add up.
+enum class ProfileStage : std::uint8_t {
+    INPUT,       // SDL event handling
+    PLAYER,      // Firing and player movement
+    SPAWNING,    // Waves, world events and reinforcements
+    ZOMBIES,     // Zombie and hunter AI
+    BULLETS,     // Projectile and flame movement
+    COLLISIONS,  // Hits, explosions, enemy contact and pickups
+    WALLS,       // Ceiling, floor and raycast wall columns
+    SPRITES,     // Sprite sort and draw, flame particles
+    FOG,         // Fog layers, vignette and glowing eyes
+    HUD,         // Weapon, crosshair, HUD and overlays
+    PRESENT,     // SDL_RenderPresent, including any vsync wait
+    COUNT
+};
+
+constexpr int PROFILE_STAGE_COUNT = static_cast<int>(ProfileStage::COUNT);
+
+const char* profileStageName(ProfileStage stage);
+
+// Lap timer for the game loop. One stage runs at a time: entering a stage
+// closes the running one, so consecutive sections need no nesting. Each
+// frame's per-stage totals go into a ring of recent frames for the overlay.
+// A few clock reads per frame; nothing is allocated after construction.
+// With allocation tracking compiled in (allocation.h) it also keeps each
+// frame's heap allocation count. While a trace is active (see trace.h),
+// every stage and frame is also recorded as a span on the timeline.
+class FrameProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int HISTORY = 240;                   // Frames kept (4 s at 60 FPS)
+    static constexpr int FRAME_ROW = PROFILE_STAGE_COUNT; // Row index for whole-frame times
+
+    struct Stats {
+        float average = 0.0f;  // Milliseconds
+        float p99 = 0.0f;
+        float max = 0.0f;
+    };
+
+    // Ends the previous frame (closing any running stage) and starts a new one
+    void beginFrame();
+    void enterStage(ProfileStage stage);
+    void leaveStage();
+
+    int getFrameCount() const { return count; }  // Completed frames in the history
+    // Milliseconds for a row (a stage, or FRAME_ROW) `age` frames ago; 0 is the latest
+    float getMs(int row, int age) const;
+    Stats getStats(int row) const;
+    // Heap allocations made during the frame `age` frames ago, on any thread
+    std::uint32_t getAllocations(int age) const;
+
+private:
+    void closeStage(Clock::time_point now);
+
+    Clock::time_point frameStart;
+    Clock::time_point stageStart;
+    bool frameOpen = false;
+    int current = -1;  // Running stage, or -1
+
+    std::array<float, PROFILE_STAGE_COUNT> stageMs{};  // Totals for the open frame
+    std::array<std::array<float, HISTORY>, PROFILE_STAGE_COUNT + 1> history{};
+    std::array<std::uint32_t, HISTORY> allocations{};
+    std::uint64_t frameStartAllocations = 0;
+    int head = 0;   // Next slot to write
+    int count = 0;
+    int frameNumber = 0;  // Frames completed since construction
+};
+
+// Times a stage until it goes out of scope. next() moves on to the following
+// stage, so a long function can be split into sections without extra braces.
+// A null profiler makes every call a no-op.
+class ProfileScope {
+public:
+    ProfileScope(FrameProfiler* profiler, ProfileStage stage) : profiler(profiler) {
+        if (profiler) profiler->enterStage(stage);
+    }
+    ~ProfileScope() {
+        if (profiler) profiler->leaveStage();
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    void next(ProfileStage stage) {
+        if (profiler) profiler->enterStage(stage);
+    }
+
+private:
+    FrameProfiler* profiler;
+};
+
+#endif
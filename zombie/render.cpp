@@ -0,0 +1,1476 @@
+#include "render.h"
+#include "allocation.h"
+#include "game.h"
+#include "maze.h"
+#include <SDL.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// Check if there's a clear line of sight between two points (no walls in between)
+bool hasLineOfSight(const Maze* maze, float x1, float y1, float x2, float y2) {
+    float dx = x2 - x1;
+    float dy = y2 - y1;
+    float distance = std::sqrt(dx * dx + dy * dy);
+
+    // Normalize direction
+    dx /= distance;
+    dy /= distance;
+
+    // Step along the ray and check for walls
+    float step = 5.0f;  // Check every 5 units
+    for (float t = 0; t < distance; t += step) {
+        float checkX = x1 + dx * t;
+        float checkY = y1 + dy * t;
+
+        int tileX = static_cast<int>(checkX / Maze::TILE_SIZE);
+        int tileY = static_cast<int>(checkY / Maze::TILE_SIZE);
+
+        if (maze->isWall(tileX, tileY)) {
+            return false;  // Wall found, no line of sight
+        }
+    }
+
+    return true;  // No walls found, clear line of sight
+}
+
+void renderFirstPersonView(SDL_Renderer* renderer, const PlayState& state) {
+    AllocationScope allocations(AllocationTag::RENDER);
+    // Guard against null player (game not initialized yet)
+    if (!state.player) {
+        // Render black screen if player not initialized
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+        return;
+    }
+
+    ProfileScope profile(state.profiler, ProfileStage::WALLS);
+
+    const int SCREEN_WIDTH = Game::SCREEN_WIDTH;
+    const int SCREEN_HEIGHT = Game::SCREEN_HEIGHT;
+    const float FOV = 75.0f * M_PI / 180.0f;  // 75 degree field of view - wider for better visibility
+    const int NUM_RAYS = SCREEN_WIDTH;
+
+    // Moving entities are drawn between their last two simulation ticks
+    const float alpha = state.renderAlpha;
+    float playerX = state.player->getRenderX(alpha);
+    float playerY = state.player->getRenderY(alpha);
+    float playerAngle = state.player->getAngle();
+    float playerPitch = state.player->getPitch();
+
+    // Apply screen shake to camera angle
+    float shakeAngle = state.screenShake * ((float)rand() / RAND_MAX - 0.5f) * 0.1f;
+    playerAngle += shakeAngle;
+
+    // Calculate pitch offset for vertical look
+    int pitchOffset = static_cast<int>(playerPitch * SCREEN_HEIGHT * 1.5f);
+
+    // Render ceiling with dark, oppressive gradient (very dark)
+    // Ceiling extends from top of screen to horizon (adjusted by pitch)
+    int horizonLine = SCREEN_HEIGHT / 2 + pitchOffset;
+    for (int y = 0; y < horizonLine && y < SCREEN_HEIGHT; y++) {
+        float gradient = (float)y / (horizonLine > 0 ? horizonLine : 1);
+        int r = 5 + (int)(5 * gradient);
+        int g = 5 + (int)(5 * gradient);
+        int b = 10 + (int)(5 * gradient);
+        SDL_SetRenderDrawColor(renderer, r, g, b, 255);
+        SDL_RenderDrawLine(renderer, 0, y, SCREEN_WIDTH, y);
+    }
+
+    // Render floor with very dark gradient (almost black)
+    // Floor extends from horizon to bottom of screen
+    // Note: Blue safe room visible via blue walls only (floor raycasting was too slow)
+    for (int y = horizonLine; y < SCREEN_HEIGHT; y++) {
+        if (y < 0) continue;
+        float gradient = (float)(y - horizonLine) / ((SCREEN_HEIGHT - horizonLine) > 0 ? (SCREEN_HEIGHT - horizonLine) : 1);
+        int baseColor = 3 + (int)(8 * gradient);
+        SDL_SetRenderDrawColor(renderer, baseColor, baseColor, baseColor - 2, 255);
+        SDL_RenderDrawLine(renderer, 0, y, SCREEN_WIDTH, y);
+    }
+
+    // Cast rays for each column of the screen
+    for (int x = 0; x < NUM_RAYS; x++) {
+        // Calculate ray angle
+        float rayAngle = playerAngle - (FOV / 2.0f) + (static_cast<float>(x) / NUM_RAYS) * FOV;
+
+        float rayDirX = std::cos(rayAngle);
+        float rayDirY = std::sin(rayAngle);
+
+        // DDA raycasting
+        float rayX = playerX;
+        float rayY = playerY;
+        float deltaX = std::abs(1.0f / rayDirX);
+        float deltaY = std::abs(1.0f / rayDirY);
+
+        int mapX = static_cast<int>(rayX / Maze::TILE_SIZE);
+        int mapY = static_cast<int>(rayY / Maze::TILE_SIZE);
+
+        int stepX = (rayDirX > 0) ? 1 : -1;
+        int stepY = (rayDirY > 0) ? 1 : -1;
+
+        float sideDistX = (rayDirX > 0) ? ((mapX + 1) * Maze::TILE_SIZE - rayX) / Maze::TILE_SIZE * deltaX
+                                         : (rayX - mapX * Maze::TILE_SIZE) / Maze::TILE_SIZE * deltaX;
+        float sideDistY = (rayDirY > 0) ? ((mapY + 1) * Maze::TILE_SIZE - rayY) / Maze::TILE_SIZE * deltaY
+                                         : (rayY - mapY * Maze::TILE_SIZE) / Maze::TILE_SIZE * deltaY;
+
+        bool hit = false;
+        int side = 0;  // 0 = vertical wall, 1 = horizontal wall
+        float perpWallDist = 0.0f;
+        bool isSafeRoomWall = false;  // Track if we hit a safe room wall
+
+        // DDA algorithm
+        while (!hit && perpWallDist < 2000.0f) {
+            if (sideDistX < sideDistY) {
+                sideDistX += deltaX;
+                mapX += stepX;
+                side = 0;
+            } else {
+                sideDistY += deltaY;
+                mapY += stepY;
+                side = 1;
+            }
+
+            if (state.maze->isWall(mapX, mapY)) {
+                hit = true;
+                // Check if this is a safe room wall (but locked safe rooms act as walls)
+                isSafeRoomWall = state.maze->isSafeRoom(mapX, mapY) && !state.safeRoomLocked;
+            }
+        }
+
+        // Calculate perpendicular wall distance
+        if (side == 0) {
+            perpWallDist = (mapX * Maze::TILE_SIZE - rayX + (1 - stepX) * Maze::TILE_SIZE / 2) / rayDirX;
+        } else {
+            perpWallDist = (mapY * Maze::TILE_SIZE - rayY + (1 - stepY) * Maze::TILE_SIZE / 2) / rayDirY;
+        }
+
+        // Calculate wall height on screen
+        int wallHeight = (int)(SCREEN_HEIGHT / (perpWallDist + 0.1f) * Maze::TILE_SIZE);
+
+        // Apply pitch offset for vertical look
+        int drawStart = SCREEN_HEIGHT / 2 - wallHeight / 2 + pitchOffset;
+        int drawEnd = SCREEN_HEIGHT / 2 + wallHeight / 2 + pitchOffset;
+
+        if (drawStart < 0) drawStart = 0;
+        if (drawEnd >= SCREEN_HEIGHT) drawEnd = SCREEN_HEIGHT - 1;
+
+        // Color based on wall type, side, and distance
+        int baseColor, colorR, colorG, colorB;
+        float distanceFade = std::max(0.0f, 1.0f - perpWallDist / 400.0f);  // Fog falloff
+        distanceFade = distanceFade * distanceFade;  // Square it for exponential falloff
+
+        if (isSafeRoomWall) {
+            // BLUE SAFE ROOM WALLS - bright and glowing
+            int blueBase = side == 0 ? 180 : 150;  // Brighter blue for safe room
+            colorR = static_cast<int>(50 * distanceFade);   // Low red
+            colorG = static_cast<int>(120 * distanceFade);  // Medium green
+            colorB = static_cast<int>(blueBase * distanceFade);  // High blue
+
+            // Add pulsing glow effect to safe room
+            float pulseAmount = 0.5f + 0.5f * std::sin(SDL_GetTicks() * 0.003f);
+            colorB = std::min(255, static_cast<int>(colorB * (1.0f + 0.3f * pulseAmount)));
+        } else {
+            // Normal walls - dark and creepy
+            baseColor = side == 0 ? 35 : 25;  // Very dark gray/brown walls
+            int color = static_cast<int>(baseColor * distanceFade);
+
+            // Add subtle texture variation based on wall position (blood stains, decay)
+            int colorVariation = ((mapX * 7 + mapY * 13) % 8) - 4;
+            color = std::max(0, std::min(255, color + colorVariation));
+
+            // Add eerie red tint to some walls (blood stained)
+            int redTint = ((mapX * 11 + mapY * 17) % 20) > 15 ? 10 : 0;
+
+            colorR = color + redTint;
+            colorG = color * 0.8f;
+            colorB = color * 0.8f;
+        }
+
+        // Calculate texture coordinate for brick pattern
+        float wallX;
+        if (side == 0) {
+            wallX = rayY + perpWallDist * rayDirY;
+        } else {
+            wallX = rayX + perpWallDist * rayDirX;
+        }
+        wallX -= std::floor(wallX);
+
+        // Draw main wall column
+        SDL_SetRenderDrawColor(renderer, colorR, colorG, colorB, 255);
+        SDL_RenderDrawLine(renderer, x, drawStart, x, drawEnd);
+
+        int wallHeightPx = drawEnd - drawStart;
+
+        if (isSafeRoomWall) {
+            // Safe room gets glowing highlights instead of bricks
+            // Add bright vertical highlights to make it glow
+            if (((int)(wallX * 8) % 2) == 0) {  // Vertical glow lines
+                for (int y = drawStart; y < drawEnd; y += 2) {
+                    SDL_SetRenderDrawColor(renderer,
+                        std::min(255, colorR + 30),
+                        std::min(255, colorG + 50),
+                        std::min(255, colorB + 60),
+                        255);
+                    SDL_RenderDrawPoint(renderer, x, y);
+                }
+            }
+        } else {
+            // Normal walls get brick pattern and blood
+            // Draw optimized brick pattern (horizontal mortar lines) - darker mortar
+            int brickRows = 6;
+            for (int i = 1; i < brickRows; i++) {
+                int mortarY = drawStart + (wallHeightPx * i) / brickRows;
+                if (mortarY >= drawStart && mortarY < drawEnd) {
+                    SDL_SetRenderDrawColor(renderer, colorR * 0.3f, colorG * 0.3f, colorB * 0.3f, 255);
+                    SDL_RenderDrawPoint(renderer, x, mortarY);
+                }
+            }
+
+            // Draw vertical mortar lines based on texture coordinate - darker
+            int brickCol = (int)(wallX * 4);  // 4 bricks horizontally
+            if ((wallX * 4.0f - brickCol) < 0.1f) {  // Vertical mortar
+                for (int y = drawStart; y < drawEnd; y += 3) {  // Every 3rd pixel for performance
+                    SDL_SetRenderDrawColor(renderer, colorR * 0.3f, colorG * 0.3f, colorB * 0.3f, 255);
+                    SDL_RenderDrawPoint(renderer, x, y);
+                }
+            }
+
+            // Add creepy blood drips on some walls
+            int redTint = ((mapX * 11 + mapY * 17) % 20) > 15 ? 10 : 0;
+            if (redTint > 0 && wallHeightPx > 30) {
+                int dripY = drawStart + wallHeightPx / 3;
+                SDL_SetRenderDrawColor(renderer, 60, 10, 10, static_cast<int>(200 * distanceFade));
+                SDL_RenderDrawPoint(renderer, x, dripY);
+                SDL_RenderDrawPoint(renderer, x, dripY + 1);
+            }
+        }
+    }
+
+    profile.next(ProfileStage::SPRITES);
+
+    // Render sprites (zombies, keys, weapons, bullets) in 3D
+    // Collect all visible sprites with distance
+    struct Sprite {
+        float x, y;
+        float distance;
+        int type;  // 0=zombie, 1=key, 2=weapon, 3=bullet, 4=exit
+        SDL_Color color;
+        const Zombie* zombie;  // Pointer to zombie for health bar rendering
+        int health;
+        int maxHealth;
+    };
+    std::vector<Sprite> sprites;
+
+    // Add zombies
+    for (const auto& zombie : state.zombies) {
+        if (!zombie->isDead()) {
+            float zombieX = zombie->getRenderX(alpha);
+            float zombieY = zombie->getRenderY(alpha);
+            float dx = zombieX - playerX;
+            float dy = zombieY - playerY;
+            float distance = std::sqrt(dx * dx + dy * dy);
+
+            // Check line-of-sight for all zombies (no wall-hacking)
+            if (distance < 2000.0f && hasLineOfSight(state.maze.get(), playerX, playerY, zombieX, zombieY)) {
+                sprites.push_back({zombieX, zombieY, distance, 0, {100, 255, 100, 255},
+                                 zombie.get(), zombie->getHealth(), zombie->getMaxHealth()});  // Store zombie pointer and health
+            }
+        }
+    }
+
+    // Add hunters (scary dark entities with red eyes)
+    for (const auto& hunter : state.hunters) {
+        if (!hunter->isDead()) {
+            float hunterX = hunter->getRenderX(alpha);
+            float hunterY = hunter->getRenderY(alpha);
+            float dx = hunterX - playerX;
+            float dy = hunterY - playerY;
+            float distance = std::sqrt(dx * dx + dy * dy);
+
+            // Hunters need line-of-sight (can't see through walls)
+            if (distance < 2000.0f && hasLineOfSight(state.maze.get(), playerX, playerY, hunterX, hunterY)) {
+                sprites.push_back({hunterX, hunterY, distance, 0, {30, 30, 35, 255},  // Very dark gray/black
+                                 hunter.get(), hunter->getHealth(), hunter->getMaxHealth()});
+            }
+        }
+    }
+
+    // Add bullets
+    for (const auto& bullet : state.bullets) {
+        if (bullet->isActive()) {
+            float bulletX = bullet->getRenderX(alpha);
+            float bulletY = bullet->getRenderY(alpha);
+            float dx = bulletX - playerX;
+            float dy = bulletY - playerY;
+            float distance = std::sqrt(dx * dx + dy * dy);
+            if (distance < 1000.0f) {
+                sprites.push_back({bulletX, bulletY, distance, 3, {255, 255, 100, 255}, nullptr, 0, 0});
+            }
+        }
+    }
+
+    // Add keys
+    for (const auto& key : state.keys) {
+        if (!key->isCollected()) {
+            float dx = key->getX() - playerX;
+            float dy = key->getY() - playerY;
+            float distance = std::sqrt(dx * dx + dy * dy);
+            if (distance < 1000.0f && hasLineOfSight(state.maze.get(), playerX, playerY, key->getX(), key->getY())) {
+                sprites.push_back({key->getX(), key->getY(), distance, 1, {255, 255, 0, 255}, nullptr, 0, 0});
+            }
+        }
+    }
+
+    // Add weapon pickups
+    for (const auto& weapon : state.weaponPickups) {
+        if (!weapon->isCollected()) {
+            float dx = weapon->getX() - playerX;
+            float dy = weapon->getY() - playerY;
+            float distance = std::sqrt(dx * dx + dy * dy);
+            if (distance < 1000.0f && hasLineOfSight(state.maze.get(), playerX, playerY, weapon->getX(), weapon->getY())) {
+                sprites.push_back({weapon->getX(), weapon->getY(), distance, 2,
+                    weapon->getIsAmmo() ? SDL_Color{255, 200, 50, 255} : SDL_Color{100, 200, 255, 255}, nullptr, 0, 0});
+            }
+        }
+    }
+
+    // Add health boosts
+    for (const auto& healthBoost : state.healthBoosts) {
+        if (!healthBoost->isCollected()) {
+            float dx = healthBoost->getX() - playerX;
+            float dy = healthBoost->getY() - playerY;
+            float distance = std::sqrt(dx * dx + dy * dy);
+            if (distance < 1000.0f && hasLineOfSight(state.maze.get(), playerX, playerY, healthBoost->getX(), healthBoost->getY())) {
+                sprites.push_back({healthBoost->getX(), healthBoost->getY(), distance, 5, {255, 50, 50, 255}, nullptr, 0, 0});
+            }
+        }
+    }
+
+    // Add exit door (the endless world has none)
+    Vec2 exitPos = state.maze->getExitPos();
+    float exitDx = exitPos.x - playerX;
+    float exitDy = exitPos.y - playerY;
+    float exitDistance = std::sqrt(exitDx * exitDx + exitDy * exitDy);
+    if (!state.world && exitDistance < 2000.0f && hasLineOfSight(state.maze.get(), playerX, playerY, exitPos.x, exitPos.y)) {
+        sprites.push_back({exitPos.x, exitPos.y, exitDistance, 4, {0, 255, 0, 255}, nullptr, 0, 0});
+    }
+
+    // Sort sprites by distance (back to front)
+    std::sort(sprites.begin(), sprites.end(), [](const Sprite& a, const Sprite& b) {
+        return a.distance > b.distance;
+    });
+
+    // Calculate elapsed time for highlighting (10+ mins for keys, 12+ mins for exit)
+    Uint32 currentTime = SDL_GetTicks();
+    float elapsedMinutes = (currentTime - state.gameStartTime) / 60000.0f;
+    bool highlightKeys = elapsedMinutes >= 10.0f;
+    bool highlightExit = elapsedMinutes >= 12.0f;
+
+    // Render sprites
+    for (const auto& sprite : sprites) {
+        // Calculate sprite position relative to player
+        float dx = sprite.x - playerX;
+        float dy = sprite.y - playerY;
+
+        // Transform to camera space
+        float invDet = 1.0f / (std::cos(playerAngle + M_PI/2) * std::sin(playerAngle) -
+                               std::sin(playerAngle + M_PI/2) * std::cos(playerAngle));
+        float transformX = invDet * (std::sin(playerAngle) * dx - std::cos(playerAngle) * dy);
+        float transformY = invDet * (-std::sin(playerAngle + M_PI/2) * dx + std::cos(playerAngle + M_PI/2) * dy);
+
+        // Skip if behind player
+        if (transformY <= 0.1f) continue;
+
+        // Calculate screen position
+        int spriteScreenX = static_cast<int>((SCREEN_WIDTH / 2) * (1 + transformX / transformY / std::tan(FOV/2)));
+
+        // Calculate sprite size (zombies are ENORMOUS, keys are 10x normal)
+        float heightMultiplier, widthMultiplier;
+
+        // Hunters (dark entities) are TALL and THIN like Endermen
+        if (sprite.type == 0 && sprite.color.r < 50 && sprite.color.g < 50 && sprite.color.b < 50) {
+            heightMultiplier = 35.0f;  // VERY tall like Enderman
+            widthMultiplier = 8.0f;    // Thin/narrow
+        } else if (sprite.type == 0) {
+            heightMultiplier = 20.0f;  // Zombies normal size
+            widthMultiplier = 20.0f;
+        } else if (sprite.type == 1) {
+            heightMultiplier = 5.0f;  // Keys
+            widthMultiplier = 5.0f;
+        } else if (sprite.type == 2) {
+            heightMultiplier = 5.0f;  // Weapon pickups
+            widthMultiplier = 5.0f;
+        } else if (sprite.type == 4) {
+            heightMultiplier = 5.0f;  // Exit door
+            widthMultiplier = 5.0f;
+        } else if (sprite.type == 5) {
+            heightMultiplier = 5.0f;  // Health boosts
+            widthMultiplier = 5.0f;
+        } else {
+            heightMultiplier = 0.5f;  // Other sprites
+            widthMultiplier = 0.5f;
+        }
+        int spriteHeight = static_cast<int>(SCREEN_HEIGHT / transformY * heightMultiplier);
+        int spriteWidth = static_cast<int>(SCREEN_HEIGHT / transformY * widthMultiplier);
+
+        // Apply pitch offset for vertical look
+        int drawStartY = SCREEN_HEIGHT / 2 - spriteHeight / 2 + pitchOffset;
+        int drawEndY = SCREEN_HEIGHT / 2 + spriteHeight / 2 + pitchOffset;
+        int drawStartX = spriteScreenX - spriteWidth / 2;
+        int drawEndX = spriteScreenX + spriteWidth / 2;
+
+        // Clamp to screen
+        if (drawStartX < 0) drawStartX = 0;
+        if (drawEndX >= SCREEN_WIDTH) drawEndX = SCREEN_WIDTH - 1;
+        if (drawStartY < 0) drawStartY = 0;
+        if (drawEndY >= SCREEN_HEIGHT) drawEndY = SCREEN_HEIGHT - 1;
+
+        int width = drawEndX - drawStartX;
+        int height = drawEndY - drawStartY;
+
+        // === DISTANCE-BASED FOG ON SPRITES ===
+        // Calculate fog intensity based on distance
+        float spriteFogFactor = sprite.distance / 400.0f;  // 0 = close, 1+ = far
+        spriteFogFactor = std::min(1.0f, spriteFogFactor);
+        int fogOverlayAlpha = static_cast<int>(spriteFogFactor * spriteFogFactor * 180);  // Exponential
+
+        // Check if this is a hunter (dark entity)
+        bool isHunter = (sprite.type == 0 && sprite.color.r < 50 && sprite.color.g < 50 && sprite.color.b < 50);
+
+        if (isHunter) {
+            // === HUNTER - SHADOWY ENDERMAN ===
+            // Pure dark shadowy silhouette - no body parts, just darkness with eyes
+
+            // Main shadow body - very dark, slightly transparent for gloomy effect
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+            SDL_Rect hunterBody = {drawStartX, drawStartY, width, height};
+            SDL_SetRenderDrawColor(renderer, 15, 15, 20, 240);  // Very dark, slightly transparent
+            SDL_RenderFillRect(renderer, &hunterBody);
+
+            // Add darker gradient from top to bottom for depth
+            for (int i = 0; i < height / 3; i++) {
+                int alpha = 240 - (i * 2);
+                SDL_Rect gradientSlice = {drawStartX, drawStartY + i, width, 1};
+                SDL_SetRenderDrawColor(renderer, 10, 10, 15, alpha);
+                SDL_RenderFillRect(renderer, &gradientSlice);
+            }
+
+            // Shadowy aura around the hunter
+            SDL_Rect aura1 = {drawStartX - 4, drawStartY - 4, width + 8, height + 8};
+            SDL_SetRenderDrawColor(renderer, 5, 5, 10, 60);
+            SDL_RenderFillRect(renderer, &aura1);
+
+            SDL_Rect aura2 = {drawStartX - 2, drawStartY - 2, width + 4, height + 4};
+            SDL_SetRenderDrawColor(renderer, 8, 8, 12, 100);
+            SDL_RenderFillRect(renderer, &aura2);
+
+            // === GLOWING EYES - THE ONLY BRIGHT FEATURE ===
+            int eyeSize = std::max(5, width / 3);
+            int eyeY = drawStartY + height / 5;  // High on the head
+            int eyeSpacing = width / 5;
+
+            // Left eye - intense red/white glow (multiple layers)
+            SDL_Rect leftEyeGlow1 = {drawStartX + width/2 - eyeSpacing - eyeSize - 5, eyeY - 5, eyeSize + 10, eyeSize + 10};
+            SDL_SetRenderDrawColor(renderer, 255, 30, 30, 80);
+            SDL_RenderFillRect(renderer, &leftEyeGlow1);
+
+            SDL_Rect leftEyeGlow2 = {drawStartX + width/2 - eyeSpacing - eyeSize - 2, eyeY - 2, eyeSize + 4, eyeSize + 4};
+            SDL_SetRenderDrawColor(renderer, 255, 60, 60, 160);
+            SDL_RenderFillRect(renderer, &leftEyeGlow2);
+
+            SDL_Rect leftEye = {drawStartX + width/2 - eyeSpacing - eyeSize/2, eyeY, eyeSize, eyeSize};
+            SDL_SetRenderDrawColor(renderer, 255, 230, 230, 255);  // Bright white/red core
+            SDL_RenderFillRect(renderer, &leftEye);
+
+            // Right eye - intense red/white glow
+            SDL_Rect rightEyeGlow1 = {drawStartX + width/2 + eyeSpacing - 5, eyeY - 5, eyeSize + 10, eyeSize + 10};
+            SDL_SetRenderDrawColor(renderer, 255, 30, 30, 80);
+            SDL_RenderFillRect(renderer, &rightEyeGlow1);
+
+            SDL_Rect rightEyeGlow2 = {drawStartX + width/2 + eyeSpacing - 2, eyeY - 2, eyeSize + 4, eyeSize + 4};
+            SDL_SetRenderDrawColor(renderer, 255, 60, 60, 160);
+            SDL_RenderFillRect(renderer, &rightEyeGlow2);
+
+            SDL_Rect rightEye = {drawStartX + width/2 + eyeSpacing - eyeSize/2, eyeY, eyeSize, eyeSize};
+            SDL_SetRenderDrawColor(renderer, 255, 230, 230, 255);  // Bright white/red core
+            SDL_RenderFillRect(renderer, &rightEye);
+
+            // Floating red particles around hunter for supernatural effect
+            Uint32 particleTime = SDL_GetTicks();
+            for (int i = 0; i < 3; i++) {
+                float particlePhase = (particleTime / 500.0f) + i * 2.0f;
+                int particleX = drawStartX + width/2 + static_cast<int>(std::sin(particlePhase) * width);
+                int particleY = drawStartY + height/3 + static_cast<int>(std::cos(particlePhase * 1.3f) * height/2);
+                SDL_Rect particle = {particleX, particleY, 3, 3};
+                SDL_SetRenderDrawColor(renderer, 255, 50, 50, 180);
+                SDL_RenderFillRect(renderer, &particle);
+            }
+
+            // Reset blend mode
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+        } else if (sprite.type == 0) {
+            // === WALKING ANIMATION ===
+            // Create bobbing/swaying motion based on time and zombie position
+            Uint32 animTime = SDL_GetTicks();
+            float animPhase = (animTime / 300.0f) + (sprite.x + sprite.y) / 100.0f;  // Each zombie slightly offset
+            float bobAmount = std::sin(animPhase) * (height / 40.0f);  // Vertical bob
+            float swayAmount = std::cos(animPhase * 0.5f) * (width / 30.0f);  // Horizontal sway
+
+            // === DETERMINE ZOMBIE VIEW ANGLE ===
+            // Calculate angle from player to zombie
+            float angleToZombie = std::atan2(sprite.y - playerY, sprite.x - playerX);
+            // Get zombie's facing direction
+            float zombieFacing = sprite.zombie->getFacingAngle();
+            // Calculate relative angle (what angle player sees zombie from, relative to zombie's facing)
+            float relativeAngle = angleToZombie - zombieFacing;
+            // Normalize to -PI to PI range
+            while (relativeAngle > M_PI) relativeAngle -= 2.0f * M_PI;
+            while (relativeAngle < -M_PI) relativeAngle += 2.0f * M_PI;
+
+            // Determine view: 0=front, 1=left, 2=back, 3=right
+            int zombieView = 0;
+            float absAngle = std::abs(relativeAngle);
+            if (absAngle < M_PI / 4.0f) {
+                zombieView = 0;  // Front view (facing player)
+            } else if (absAngle > 3.0f * M_PI / 4.0f) {
+                zombieView = 2;  // Back view (facing away)
+            } else if (relativeAngle > 0) {
+                zombieView = 1;  // Left side view
+            } else {
+                zombieView = 3;  // Right side view
+            }
+
+            // === ZOMBIE HEAD - Humanoid with 3D shading ===
+            int headSize = height / 4;
+            int headX = drawStartX + width / 2 - headSize / 2 + static_cast<int>(swayAmount);
+            int headY = drawStartY + static_cast<int>(bobAmount);
+
+            // Head base (dark decayed color)
+            SDL_Rect head = {headX, headY, headSize, headSize};
+            SDL_SetRenderDrawColor(renderer, 45, 65, 45, 255);
+            SDL_RenderFillRect(renderer, &head);
+
+            // 3D shading - light from top-left
+            SDL_Rect headHighlight = {headX, headY, headSize*2/3, headSize/2};
+            SDL_SetRenderDrawColor(renderer, 60, 80, 60, 255);  // Lighter
+            SDL_RenderFillRect(renderer, &headHighlight);
+
+            SDL_Rect headShadow = {headX + headSize/2, headY + headSize/2, headSize/2, headSize/2};
+            SDL_SetRenderDrawColor(renderer, 30, 50, 30, 255);  // Darker
+            SDL_RenderFillRect(renderer, &headShadow);
+
+            // === ZOMBIE FACE ===
+            // EXPOSED BONE/SKULL patches (terrifying!)
+            SDL_Rect bone1 = {headX + headSize/6, headY + headSize/8, headSize/4, headSize/5};
+            SDL_Rect bone2 = {headX + 2*headSize/3, headY + headSize/3, headSize/5, headSize/4};
+            SDL_SetRenderDrawColor(renderer, 200, 200, 190, 255);  // Bone white
+            SDL_RenderFillRect(renderer, &bone1);
+            SDL_RenderFillRect(renderer, &bone2);
+
+            // === RENDER FEATURES BASED ON VIEW ===
+            if (zombieView == 0) {
+                // FRONT VIEW - Show both eyes and mouth
+                int eyeY = headY + headSize/3;
+                int eyeSize = headSize/6;
+
+                // Left eye - glowing red
+                SDL_Rect leftEyeSocket = {headX + headSize/5, eyeY, eyeSize, eyeSize};
+                SDL_SetRenderDrawColor(renderer, 10, 10, 10, 255);  // Dark socket
+                SDL_RenderFillRect(renderer, &leftEyeSocket);
+
+                SDL_Rect leftEyeGlow = {headX + headSize/5 + eyeSize/4, eyeY + eyeSize/4, eyeSize/2, eyeSize/2};
+                SDL_SetRenderDrawColor(renderer, 255, 20, 20, 255);  // Bright red
+                SDL_RenderFillRect(renderer, &leftEyeGlow);
+
+                // Right eye - glowing red
+                SDL_Rect rightEyeSocket = {headX + 3*headSize/5, eyeY, eyeSize, eyeSize};
+                SDL_SetRenderDrawColor(renderer, 10, 10, 10, 255);  // Dark socket
+                SDL_RenderFillRect(renderer, &rightEyeSocket);
+
+                SDL_Rect rightEyeGlow = {headX + 3*headSize/5 + eyeSize/4, eyeY + eyeSize/4, eyeSize/2, eyeSize/2};
+                SDL_SetRenderDrawColor(renderer, 255, 20, 20, 255);  // Bright red
+                SDL_RenderFillRect(renderer, &rightEyeGlow);
+
+                // Mouth
+                SDL_Rect mouth = {headX + headSize/3, headY + 2*headSize/3, headSize/3, headSize/8};
+                SDL_SetRenderDrawColor(renderer, 15, 5, 5, 255);  // Dark open mouth
+                SDL_RenderFillRect(renderer, &mouth);
+
+            } else if (zombieView == 1) {
+                // LEFT SIDE VIEW - Show one eye on left side
+                int eyeY = headY + headSize/3;
+                int eyeSize = headSize/6;
+
+                SDL_Rect sideEyeSocket = {headX + headSize/8, eyeY, eyeSize, eyeSize};
+                SDL_SetRenderDrawColor(renderer, 10, 10, 10, 255);
+                SDL_RenderFillRect(renderer, &sideEyeSocket);
+
+                SDL_Rect sideEyeGlow = {headX + headSize/8 + eyeSize/4, eyeY + eyeSize/4, eyeSize/2, eyeSize/2};
+                SDL_SetRenderDrawColor(renderer, 255, 20, 20, 255);
+                SDL_RenderFillRect(renderer, &sideEyeGlow);
+
+                // Side mouth
+                SDL_Rect sideMouth = {headX + headSize/8, headY + 2*headSize/3, headSize/4, headSize/8};
+                SDL_SetRenderDrawColor(renderer, 15, 5, 5, 255);
+                SDL_RenderFillRect(renderer, &sideMouth);
+
+            } else if (zombieView == 3) {
+                // RIGHT SIDE VIEW - Show one eye on right side
+                int eyeY = headY + headSize/3;
+                int eyeSize = headSize/6;
+
+                SDL_Rect sideEyeSocket = {headX + 5*headSize/8, eyeY, eyeSize, eyeSize};
+                SDL_SetRenderDrawColor(renderer, 10, 10, 10, 255);
+                SDL_RenderFillRect(renderer, &sideEyeSocket);
+
+                SDL_Rect sideEyeGlow = {headX + 5*headSize/8 + eyeSize/4, eyeY + eyeSize/4, eyeSize/2, eyeSize/2};
+                SDL_SetRenderDrawColor(renderer, 255, 20, 20, 255);
+                SDL_RenderFillRect(renderer, &sideEyeGlow);
+
+                // Side mouth
+                SDL_Rect sideMouth = {headX + 5*headSize/8, headY + 2*headSize/3, headSize/4, headSize/8};
+                SDL_SetRenderDrawColor(renderer, 15, 5, 5, 255);
+                SDL_RenderFillRect(renderer, &sideMouth);
+
+            } else {
+                // BACK VIEW (zombieView == 2) - No eyes or mouth visible, show back of head
+                // Add some detail to back of head (maybe hair/damage)
+                SDL_Rect backDetail1 = {headX + headSize/4, headY + headSize/4, headSize/2, headSize/6};
+                SDL_SetRenderDrawColor(renderer, 30, 45, 30, 255);  // Darker detail
+                SDL_RenderFillRect(renderer, &backDetail1);
+
+                SDL_Rect backDetail2 = {headX + headSize/3, headY + headSize/2, headSize/3, headSize/6};
+                SDL_SetRenderDrawColor(renderer, 35, 50, 35, 255);
+                SDL_RenderFillRect(renderer, &backDetail2);
+            }
+
+            // === ZOMBIE BODY - Humanoid torso with 3D shading ===
+            int bodyWidth = width * 3 / 5;
+            int bodyHeight = height / 2;
+            int bodyX = drawStartX + width / 2 - bodyWidth / 2 + static_cast<int>(swayAmount * 0.7f);
+            int bodyY = drawStartY + headSize + static_cast<int>(bobAmount);
+
+            // Body base (dark decayed color)
+            SDL_Rect body = {bodyX, bodyY, bodyWidth, bodyHeight};
+            SDL_SetRenderDrawColor(renderer, 45, 65, 45, 255);
+            SDL_RenderFillRect(renderer, &body);
+
+            // 3D shading - light from top-left
+            SDL_Rect bodyHighlight = {bodyX, bodyY, bodyWidth*2/3, bodyHeight/2};
+            SDL_SetRenderDrawColor(renderer, 60, 80, 60, 255);  // Lighter
+            SDL_RenderFillRect(renderer, &bodyHighlight);
+
+            SDL_Rect bodyShadow = {bodyX + bodyWidth/3, bodyY + bodyHeight/2, bodyWidth*2/3, bodyHeight/2};
+            SDL_SetRenderDrawColor(renderer, 30, 50, 30, 255);  // Darker
+            SDL_RenderFillRect(renderer, &bodyShadow);
+
+            // Blood stains on body
+            SDL_Rect bloodStain1 = {bodyX + bodyWidth/4, bodyY + bodyHeight/4, bodyWidth/3, bodyHeight/3};
+            SDL_Rect bloodStain2 = {bodyX + bodyWidth/6, bodyY + bodyHeight/2, bodyWidth/3, bodyHeight/4};
+            SDL_SetRenderDrawColor(renderer, 100, 15, 15, 255);  // Dark blood
+            SDL_RenderFillRect(renderer, &bloodStain1);
+            SDL_RenderFillRect(renderer, &bloodStain2);
+
+            // === ZOMBIE ARMS - Simple with 3D shading ===
+            int armWidth = width / 6;
+            int armHeight = bodyHeight * 3 / 4;
+            float armSwing = std::sin(animPhase) * (width / 15.0f);  // Arm swing animation
+
+            // Left arm
+            int leftArmX = bodyX - armWidth + static_cast<int>(armSwing);
+            SDL_Rect leftArm = {leftArmX, bodyY + bodyHeight/6, armWidth, armHeight};
+            SDL_SetRenderDrawColor(renderer, 45, 65, 45, 255);
+            SDL_RenderFillRect(renderer, &leftArm);
+            // Left arm highlight (lighter on left side)
+            SDL_Rect leftArmHighlight = {leftArmX, bodyY + bodyHeight/6, armWidth/2, armHeight/2};
+            SDL_SetRenderDrawColor(renderer, 60, 80, 60, 255);
+            SDL_RenderFillRect(renderer, &leftArmHighlight);
+
+            // Right arm
+            int rightArmX = bodyX + bodyWidth - static_cast<int>(armSwing);
+            SDL_Rect rightArm = {rightArmX, bodyY + bodyHeight/6, armWidth, armHeight};
+            SDL_SetRenderDrawColor(renderer, 45, 65, 45, 255);
+            SDL_RenderFillRect(renderer, &rightArm);
+            // Right arm shadow (darker on right side)
+            SDL_Rect rightArmShadow = {rightArmX + armWidth/2, bodyY + bodyHeight/6 + armHeight/2, armWidth/2, armHeight/2};
+            SDL_SetRenderDrawColor(renderer, 30, 50, 30, 255);
+            SDL_RenderFillRect(renderer, &rightArmShadow);
+
+            // === ZOMBIE LEGS - Simple with 3D shading ===
+            int legWidth = bodyWidth / 3;
+            int legHeight = height / 3;
+            int legY = bodyY + bodyHeight;
+            float legOffset = std::sin(animPhase) * (width / 20.0f);  // Leg alternation
+
+            // Left leg
+            int leftLegX = bodyX + bodyWidth/6 + static_cast<int>(legOffset);
+            SDL_Rect leftLeg = {leftLegX, legY, legWidth, legHeight};
+            SDL_SetRenderDrawColor(renderer, 40, 60, 40, 255);
+            SDL_RenderFillRect(renderer, &leftLeg);
+            SDL_Rect leftLegHighlight = {leftLegX, legY, legWidth/2, legHeight/2};
+            SDL_SetRenderDrawColor(renderer, 55, 75, 55, 255);
+            SDL_RenderFillRect(renderer, &leftLegHighlight);
+
+            // Right leg
+            int rightLegX = bodyX + bodyWidth/2 - static_cast<int>(legOffset);
+            SDL_Rect rightLeg = {rightLegX, legY, legWidth, legHeight};
+            SDL_SetRenderDrawColor(renderer, 40, 60, 40, 255);
+            SDL_RenderFillRect(renderer, &rightLeg);
+            SDL_Rect rightLegShadow = {rightLegX + legWidth/2, legY + legHeight/2, legWidth/2, legHeight/2};
+            SDL_SetRenderDrawColor(renderer, 25, 45, 25, 255);
+            SDL_RenderFillRect(renderer, &rightLegShadow);
+
+            // === 3D DEPTH: LARGE SHADOW UNDER ZOMBIE ===
+            int shadowWidth = width + 10;
+            int shadowHeight = height / 8;
+            SDL_Rect zombieShadow = {drawStartX - 5, drawEndY - shadowHeight, shadowWidth, shadowHeight};
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 140);  // Dark shadow
+            SDL_RenderFillRect(renderer, &zombieShadow);
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+            // Zombies now rendered as humanoid with 3D perspective shading!
+
+            // === APPLY DISTANCE FOG TO ZOMBIE ===
+            if (fogOverlayAlpha > 0) {
+                SDL_Rect zombieFog = {drawStartX, drawStartY, width, height};
+                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+                SDL_SetRenderDrawColor(renderer, 30, 30, 35, fogOverlayAlpha);
+                SDL_RenderFillRect(renderer, &zombieFog);
+                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+            }
+        } else if (sprite.type == 1) {
+            // Key - draw as big floating gold key
+            int keyHeadSize = width / 2;
+            int keyShaftWidth = width / 5;
+            int keyShaftHeight = height / 2;
+
+            int centerX = drawStartX + width / 2;
+            int centerY = drawStartY + height / 3;
+
+            // Add intense pulsing glow effect when highlighted (>10 min elapsed)
+            if (highlightKeys) {
+                float pulseAmount = (std::sin(currentTime / 150.0f) + 1.0f) / 2.0f;  // Fast pulse 0-1
+                int glowExpansion = static_cast<int>(pulseAmount * 30);
+
+                // Outer glow layer (bright yellow/white)
+                SDL_Rect outerGlow = {drawStartX - 20 - glowExpansion, drawStartY - 20 - glowExpansion,
+                                      width + 40 + glowExpansion * 2, height + 40 + glowExpansion * 2};
+                SDL_SetRenderDrawColor(renderer, 255, 255, 100, static_cast<int>(60 + pulseAmount * 100));
+                SDL_RenderFillRect(renderer, &outerGlow);
+
+                // Middle glow layer
+                SDL_Rect middleGlow = {drawStartX - 10 - glowExpansion/2, drawStartY - 10 - glowExpansion/2,
+                                       width + 20 + glowExpansion, height + 20 + glowExpansion};
+                SDL_SetRenderDrawColor(renderer, 255, 255, 0, static_cast<int>(100 + pulseAmount * 120));
+                SDL_RenderFillRect(renderer, &middleGlow);
+
+                // Inner bright glow
+                SDL_Rect innerGlow = {drawStartX - 5, drawStartY - 5, width + 10, height + 10};
+                SDL_SetRenderDrawColor(renderer, 255, 255, 200, static_cast<int>(140 + pulseAmount * 115));
+                SDL_RenderFillRect(renderer, &innerGlow);
+            }
+
+            // Key head (circular top)
+            SDL_Rect keyHead = {centerX - keyHeadSize/2, centerY - keyHeadSize/2, keyHeadSize, keyHeadSize};
+            SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255);  // Gold
+            SDL_RenderFillRect(renderer, &keyHead);
+
+            // Key head hole
+            int holeSize = keyHeadSize / 3;
+            SDL_Rect keyHole = {centerX - holeSize/2, centerY - holeSize/2, holeSize, holeSize};
+            SDL_SetRenderDrawColor(renderer, 40, 40, 50, 255);
+            SDL_RenderFillRect(renderer, &keyHole);
+
+            // Key shaft (vertical part)
+            SDL_Rect keyShaft = {centerX - keyShaftWidth/2, centerY + keyHeadSize/2, keyShaftWidth, keyShaftHeight};
+            SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255);  // Gold
+            SDL_RenderFillRect(renderer, &keyShaft);
+
+            // Key teeth (notches at bottom)
+            int toothWidth = keyShaftWidth * 2;
+            int toothHeight = height / 8;
+            SDL_Rect tooth1 = {centerX + keyShaftWidth/2, centerY + keyHeadSize/2 + keyShaftHeight/3, toothWidth, toothHeight};
+            SDL_Rect tooth2 = {centerX + keyShaftWidth/2, centerY + keyHeadSize/2 + 2*keyShaftHeight/3, toothWidth, toothHeight};
+            SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255);
+            SDL_RenderFillRect(renderer, &tooth1);
+            SDL_RenderFillRect(renderer, &tooth2);
+
+            // Gold highlights (shinier gold on edges)
+            SDL_Rect highlight1 = {centerX - keyHeadSize/4, centerY - keyHeadSize/4, keyHeadSize/3, keyHeadSize/3};
+            SDL_SetRenderDrawColor(renderer, 255, 245, 150, 255);
+            SDL_RenderFillRect(renderer, &highlight1);
+
+            // Dark outline
+            SDL_SetRenderDrawColor(renderer, 180, 150, 0, 255);
+            SDL_RenderDrawRect(renderer, &keyHead);
+            SDL_RenderDrawRect(renderer, &keyShaft);
+
+            // Normal glow effect around key (always visible)
+            SDL_Rect keyGlow = {drawStartX - 4, drawStartY - 4, width + 8, height + 8};
+            SDL_SetRenderDrawColor(renderer, 255, 255, 150, 100);
+            SDL_RenderDrawRect(renderer, &keyGlow);
+        } else if (sprite.type == 3) {
+            // Bullet - draw as bright projectile
+            int bulletSize = std::max(4, height / 4);
+            int bulletX = drawStartX + width / 2 - bulletSize / 2;
+            int bulletY = drawStartY + height / 2 - bulletSize / 2;
+
+            // Bright yellow bullet with glow
+            SDL_Rect bulletCore = {bulletX, bulletY, bulletSize, bulletSize};
+            SDL_SetRenderDrawColor(renderer, 255, 255, 150, 255);
+            SDL_RenderFillRect(renderer, &bulletCore);
+
+            // Glow effect
+            SDL_Rect bulletGlow = {bulletX - 2, bulletY - 2, bulletSize + 4, bulletSize + 4};
+            SDL_SetRenderDrawColor(renderer, 255, 200, 50, 180);
+            SDL_RenderDrawRect(renderer, &bulletGlow);
+        } else if (sprite.type == 4) {
+            // Exit door - draw as large glowing green door
+            int doorWidth = width;
+            int doorHeight = height;
+            int doorX = drawStartX;
+            int doorY = drawStartY;
+
+            // Add INTENSE pulsing glow effect when highlighted (>12 min elapsed)
+            if (highlightExit) {
+                float pulseAmount = (std::sin(currentTime / 120.0f) + 1.0f) / 2.0f;  // Slower pulse 0-1
+                int glowExpansion = static_cast<int>(pulseAmount * 40);
+
+                // Outer glow layer (bright green/white beacon)
+                SDL_Rect outerGlow = {doorX - 30 - glowExpansion, doorY - 30 - glowExpansion,
+                                      doorWidth + 60 + glowExpansion * 2, doorHeight + 60 + glowExpansion * 2};
+                SDL_SetRenderDrawColor(renderer, 100, 255, 100, static_cast<int>(70 + pulseAmount * 120));
+                SDL_RenderFillRect(renderer, &outerGlow);
+
+                // Middle glow layer (intense green)
+                SDL_Rect middleGlow = {doorX - 15 - glowExpansion/2, doorY - 15 - glowExpansion/2,
+                                       doorWidth + 30 + glowExpansion, doorHeight + 30 + glowExpansion};
+                SDL_SetRenderDrawColor(renderer, 50, 255, 50, static_cast<int>(120 + pulseAmount * 135));
+                SDL_RenderFillRect(renderer, &middleGlow);
+
+                // Inner bright glow (nearly white)
+                SDL_Rect innerGlow = {doorX - 8, doorY - 8, doorWidth + 16, doorHeight + 16};
+                SDL_SetRenderDrawColor(renderer, 200, 255, 200, static_cast<int>(150 + pulseAmount * 105));
+                SDL_RenderFillRect(renderer, &innerGlow);
+            }
+
+            // Door frame (dark green)
+            SDL_Rect doorFrame = {doorX, doorY, doorWidth, doorHeight};
+            SDL_SetRenderDrawColor(renderer, 0, 100, 0, 255);
+            SDL_RenderFillRect(renderer, &doorFrame);
+
+            // Door panels (brighter green)
+            int panelWidth = doorWidth / 2 - doorWidth / 10;
+            int panelHeight = doorHeight - doorHeight / 5;
+            SDL_Rect leftPanel = {doorX + doorWidth / 20, doorY + doorHeight / 10, panelWidth, panelHeight};
+            SDL_Rect rightPanel = {doorX + doorWidth / 2 + doorWidth / 20, doorY + doorHeight / 10, panelWidth, panelHeight};
+            SDL_SetRenderDrawColor(renderer, 50, 200, 50, 255);
+            SDL_RenderFillRect(renderer, &leftPanel);
+            SDL_RenderFillRect(renderer, &rightPanel);
+
+            // Door handles (gold)
+            int handleSize = doorWidth / 15;
+            SDL_Rect leftHandle = {doorX + doorWidth / 2 - handleSize - doorWidth / 10, doorY + doorHeight / 2 - handleSize, handleSize * 2, handleSize * 2};
+            SDL_Rect rightHandle = {doorX + doorWidth / 2 + doorWidth / 10 - handleSize, doorY + doorHeight / 2 - handleSize, handleSize * 2, handleSize * 2};
+            SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255);
+            SDL_RenderFillRect(renderer, &leftHandle);
+            SDL_RenderFillRect(renderer, &rightHandle);
+
+            // Glowing exit sign on top
+            int signWidth = doorWidth / 2;
+            int signHeight = doorHeight / 8;
+            SDL_Rect exitSign = {doorX + doorWidth / 4, doorY + doorHeight / 20, signWidth, signHeight};
+            SDL_SetRenderDrawColor(renderer, 100, 255, 100, 255);
+            SDL_RenderFillRect(renderer, &exitSign);
+
+            // Bright glow effect
+            SDL_Rect doorGlow1 = {doorX - 4, doorY - 4, doorWidth + 8, doorHeight + 8};
+            SDL_SetRenderDrawColor(renderer, 0, 255, 0, 150);
+            SDL_RenderDrawRect(renderer, &doorGlow1);
+            SDL_Rect doorGlow2 = {doorX - 8, doorY - 8, doorWidth + 16, doorHeight + 16};
+            SDL_SetRenderDrawColor(renderer, 0, 255, 0, 80);
+            SDL_RenderDrawRect(renderer, &doorGlow2);
+
+            // Dark outline for definition
+            SDL_SetRenderDrawColor(renderer, 0, 80, 0, 255);
+            SDL_RenderDrawRect(renderer, &doorFrame);
+        } else if (sprite.type == 5) {
+            // Health boost - draw as first aid kit with red cross
+            int boxWidth = width;
+            int boxHeight = height;
+            int boxX = drawStartX;
+            int boxY = drawStartY;
+
+            // White box background
+            SDL_Rect box = {boxX, boxY, boxWidth, boxHeight};
+            SDL_SetRenderDrawColor(renderer, 240, 240, 240, 255);
+            SDL_RenderFillRect(renderer, &box);
+
+            // Red cross - horizontal bar
+            int crossThickness = boxHeight / 5;
+            int crossLength = boxWidth * 3 / 4;
+            SDL_Rect horizBar = {boxX + (boxWidth - crossLength) / 2, boxY + boxHeight / 2 - crossThickness / 2, crossLength, crossThickness};
+            SDL_SetRenderDrawColor(renderer, 220, 20, 20, 255);
+            SDL_RenderFillRect(renderer, &horizBar);
+
+            // Red cross - vertical bar
+            SDL_Rect vertBar = {boxX + boxWidth / 2 - crossThickness / 2, boxY + (boxHeight - crossLength) / 2, crossThickness, crossLength};
+            SDL_SetRenderDrawColor(renderer, 220, 20, 20, 255);
+            SDL_RenderFillRect(renderer, &vertBar);
+
+            // Box border (dark red)
+            SDL_SetRenderDrawColor(renderer, 150, 20, 20, 255);
+            SDL_RenderDrawRect(renderer, &box);
+
+            // Add subtle glow effect
+            SDL_Rect glow = {boxX - 2, boxY - 2, boxWidth + 4, boxHeight + 4};
+            SDL_SetRenderDrawColor(renderer, 255, 100, 100, 120);
+            SDL_RenderDrawRect(renderer, &glow);
+        } else {
+            // Check if this is a hunter (tall, thin, dark Enderman-like entity)
+            bool isHunter = (sprite.type == 0 && sprite.color.r < 50 && sprite.color.g < 50 && sprite.color.b < 50);
+
+            if (isHunter) {
+                // === HUNTER - ENDERMAN STYLE ===
+                // Very dark, tall, thin body with subtle shading
+                SDL_Rect hunterBody = {drawStartX, drawStartY, width, height};
+                SDL_SetRenderDrawColor(renderer, 25, 25, 30, 255);  // Very dark gray/black
+                SDL_RenderFillRect(renderer, &hunterBody);
+
+                // Darker outline for depth
+                SDL_SetRenderDrawColor(renderer, 10, 10, 15, 255);  // Nearly black outline
+                SDL_RenderDrawRect(renderer, &hunterBody);
+
+                // Subtle vertical highlights on edges (makes it look 3D)
+                SDL_Rect leftEdge = {drawStartX + 1, drawStartY, 1, height};
+                SDL_SetRenderDrawColor(renderer, 40, 40, 45, 255);
+                SDL_RenderFillRect(renderer, &leftEdge);
+
+                SDL_Rect rightEdge = {drawStartX + width - 2, drawStartY, 1, height};
+                SDL_SetRenderDrawColor(renderer, 15, 15, 20, 255);
+                SDL_RenderFillRect(renderer, &rightEdge);
+
+                // === TERRIFYING GLOWING RED/WHITE EYES ===
+                // Eyes positioned high on the body (like Enderman)
+                int eyeSize = std::max(4, width / 3);  // Bigger eyes for thin face
+                int eyeY = drawStartY + height / 6;  // High up on the head
+                int eyeSpacing = width / 4;
+
+                // Left eye - intense red glow
+                SDL_Rect leftEyeGlow = {drawStartX + eyeSpacing - eyeSize - 3, eyeY - 3, eyeSize + 6, eyeSize + 6};
+                SDL_SetRenderDrawColor(renderer, 255, 40, 40, 140);  // Strong red glow
+                SDL_RenderFillRect(renderer, &leftEyeGlow);
+
+                SDL_Rect leftEyeInner = {drawStartX + eyeSpacing - eyeSize - 1, eyeY - 1, eyeSize + 2, eyeSize + 2};
+                SDL_SetRenderDrawColor(renderer, 255, 100, 100, 200);  // Medium glow
+                SDL_RenderFillRect(renderer, &leftEyeInner);
+
+                SDL_Rect leftEye = {drawStartX + eyeSpacing - eyeSize/2, eyeY, eyeSize, eyeSize};
+                SDL_SetRenderDrawColor(renderer, 255, 220, 220, 255);  // Bright white/red core
+                SDL_RenderFillRect(renderer, &leftEye);
+
+                // Right eye - intense red glow
+                SDL_Rect rightEyeGlow = {drawStartX + width - eyeSpacing - 3, eyeY - 3, eyeSize + 6, eyeSize + 6};
+                SDL_SetRenderDrawColor(renderer, 255, 40, 40, 140);  // Strong red glow
+                SDL_RenderFillRect(renderer, &rightEyeGlow);
+
+                SDL_Rect rightEyeInner = {drawStartX + width - eyeSpacing - 1, eyeY - 1, eyeSize + 2, eyeSize + 2};
+                SDL_SetRenderDrawColor(renderer, 255, 100, 100, 200);  // Medium glow
+                SDL_RenderFillRect(renderer, &rightEyeInner);
+
+                SDL_Rect rightEye = {drawStartX + width - eyeSpacing + eyeSize/2, eyeY, eyeSize, eyeSize};
+                SDL_SetRenderDrawColor(renderer, 255, 220, 220, 255);  // Bright white/red core
+                SDL_RenderFillRect(renderer, &rightEye);
+
+                // Particle effect - small red dots floating around hunter
+                if ((rand() % 3) == 0) {  // Random particles
+                    int particleX = drawStartX + (rand() % width);
+                    int particleY = drawStartY + (rand() % height);
+                    SDL_Rect particle = {particleX, particleY, 2, 2};
+                    SDL_SetRenderDrawColor(renderer, 255, 50, 50, 150);
+                    SDL_RenderFillRect(renderer, &particle);
+                }
+            } else {
+                // Weapons and other sprites - draw as colored rectangle
+                SDL_Rect spriteRect = {drawStartX, drawStartY, width, height};
+                SDL_SetRenderDrawColor(renderer, sprite.color.r, sprite.color.g, sprite.color.b, sprite.color.a);
+                SDL_RenderFillRect(renderer, &spriteRect);
+
+                // Draw darker outline
+                SDL_SetRenderDrawColor(renderer, sprite.color.r/2, sprite.color.g/2, sprite.color.b/2, 255);
+                SDL_RenderDrawRect(renderer, &spriteRect);
+            }
+        }
+
+        // Draw health bar above zombies
+        if (sprite.type == 0 && sprite.zombie != nullptr && sprite.maxHealth > 0) {
+            int barWidth = width;
+            int barHeight = 8;
+            int barX = drawStartX;
+            int barY = drawStartY - barHeight - 4;  // Position above zombie
+
+            // Background (dark red)
+            SDL_Rect barBg = {barX, barY, barWidth, barHeight};
+            SDL_SetRenderDrawColor(renderer, 60, 0, 0, 200);
+            SDL_RenderFillRect(renderer, &barBg);
+
+            // Health fill (red to green gradient based on health)
+            float healthPercent = static_cast<float>(sprite.health) / static_cast<float>(sprite.maxHealth);
+            int fillWidth = static_cast<int>(barWidth * healthPercent);
+            if (fillWidth > 0) {
+                SDL_Rect barFill = {barX, barY, fillWidth, barHeight};
+                // Color gradient: red (low health) to yellow (mid health) to green (full health)
+                int r = healthPercent < 0.5f ? 255 : static_cast<int>(255 * (1.0f - (healthPercent - 0.5f) * 2.0f));
+                int g = healthPercent < 0.5f ? static_cast<int>(255 * healthPercent * 2.0f) : 255;
+                SDL_SetRenderDrawColor(renderer, r, g, 0, 220);
+                SDL_RenderFillRect(renderer, &barFill);
+            }
+
+            // Border (white)
+            SDL_SetRenderDrawColor(renderer, 255, 255, 255, 200);
+            SDL_RenderDrawRect(renderer, &barBg);
+        }
+    }
+
+    // Flamethrower particles: project every live particle and submit them
+    // as a single geometry batch instead of one draw call per puff
+    if (state.flames.getCount() > 0) {
+        static std::vector<SDL_Vertex> flameVertices;  // Reused between frames
+        static std::vector<int> flameIndices;
+        flameVertices.clear();
+        flameIndices.clear();
+
+        float forwardX = std::cos(playerAngle);
+        float forwardY = std::sin(playerAngle);
+        float projScale = (SCREEN_WIDTH / 2) / std::tan(FOV / 2);
+
+        for (int i = 0; i < state.flames.getCount(); i++) {
+            const FlameParticle& p = state.flames.getParticle(i);
+            if (!p.alive) continue;
+
+            float dx = p.x - playerX;
+            float dy = p.y - playerY;
+            float depth = forwardX * dx + forwardY * dy;
+            if (depth < 8.0f) continue;  // Behind or inside the camera
+            float side = -forwardY * dx + forwardX * dy;
+
+            float life = std::min(1.0f, p.age / FlameSystem::LIFETIME);
+            float scale = SCREEN_HEIGHT / depth;
+            float halfSize = scale * (1.5f + 5.0f * life);  // Puffs swell as they cool
+            float screenX = SCREEN_WIDTH / 2 + side / depth * projScale;
+            float screenY = SCREEN_HEIGHT / 2 + pitchOffset + scale * 4.0f;  // Just below eye level
+
+            // White-yellow core fading to dark red smoke
+            SDL_Color color = {
+                255,
+                static_cast<Uint8>(40 + 200 * (1.0f - life)),
+                static_cast<Uint8>(80 * (1.0f - life) * (1.0f - life)),
+                static_cast<Uint8>(220 * (1.0f - life))
+            };
+
+            int base = static_cast<int>(flameVertices.size());
+            flameVertices.push_back({{screenX - halfSize, screenY - halfSize}, color, {0, 0}});
+            flameVertices.push_back({{screenX + halfSize, screenY - halfSize}, color, {0, 0}});
+            flameVertices.push_back({{screenX + halfSize, screenY + halfSize}, color, {0, 0}});
+            flameVertices.push_back({{screenX - halfSize, screenY + halfSize}, color, {0, 0}});
+            flameIndices.insert(flameIndices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+        }
+
+        if (!flameVertices.empty()) {
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+            SDL_RenderGeometry(renderer, nullptr, flameVertices.data(), static_cast<int>(flameVertices.size()),
+                               flameIndices.data(), static_cast<int>(flameIndices.size()));
+        }
+    }
+
+    profile.next(ProfileStage::HUD);
+
+    // Render weapon in hands (Doom-style)
+    WeaponType currentWeapon = state.player->getCurrentWeapon();
+    int weaponWidth = 200;
+    int weaponHeight = 250;
+    int weaponX = (SCREEN_WIDTH - weaponWidth) / 2 + static_cast<int>(state.shakeOffsetX);
+    int weaponY = SCREEN_HEIGHT - weaponHeight + 50 + static_cast<int>(state.shakeOffsetY);
+
+    // Weapon recoil effect
+    if (state.screenShake > 0.1f) {
+        weaponY += static_cast<int>(state.screenShake * 30.0f);  // Kick weapon up when shooting
+    }
+
+    // Draw weapon based on type
+    if (currentWeapon == WeaponType::SHOTGUN) {
+        // Shotgun (M870 style pump-action)
+        // Stock
+        SDL_Rect stock = {weaponX + 20, weaponY + 140, 70, 50};
+        SDL_SetRenderDrawColor(renderer, 70, 50, 30, 255);
+        SDL_RenderFillRect(renderer, &stock);
+
+        // Receiver/body
+        SDL_Rect body = {weaponX + 80, weaponY + 125, 90, 50};
+        SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
+        SDL_RenderFillRect(renderer, &body);
+
+        // Long barrel
+        SDL_Rect barrel = {weaponX + 160, weaponY + 130, 40, 30};
+        SDL_SetRenderDrawColor(renderer, 60, 60, 60, 255);
+        SDL_RenderFillRect(renderer, &barrel);
+
+        // Barrel end
+        SDL_Rect barrelEnd = {weaponX + 190, weaponY + 135, 10, 20};
+        SDL_SetRenderDrawColor(renderer, 40, 40, 40, 255);
+        SDL_RenderFillRect(renderer, &barrelEnd);
+
+        // Pump/foregrip (wood)
+        SDL_Rect pump = {weaponX + 110, weaponY + 170, 50, 35};
+        SDL_SetRenderDrawColor(renderer, 80, 60, 40, 255);
+        SDL_RenderFillRect(renderer, &pump);
+
+        // Handle
+        SDL_Rect handle = {weaponX + 90, weaponY + 165, 30, 45};
+        SDL_SetRenderDrawColor(renderer, 60, 40, 20, 255);
+        SDL_RenderFillRect(renderer, &handle);
+
+        // Trigger guard
+        SDL_Rect trigger = {weaponX + 100, weaponY + 155, 20, 15};
+        SDL_SetRenderDrawColor(renderer, 45, 45, 45, 255);
+        SDL_RenderDrawRect(renderer, &trigger);
+
+        // Metal highlights
+        SDL_Rect highlight1 = {weaponX + 165, weaponY + 135, 20, 10};
+        SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
+        SDL_RenderFillRect(renderer, &highlight1);
+    } else if (currentWeapon == WeaponType::PISTOL) {
+        // Pistol
+        // Handle
+        SDL_Rect handle = {weaponX + 85, weaponY + 150, 30, 70};
+        SDL_SetRenderDrawColor(renderer, 60, 40, 20, 255);
+        SDL_RenderFillRect(renderer, &handle);
+
+        // Barrel
+        SDL_Rect barrel = {weaponX + 60, weaponY + 100, 80, 50};
+        SDL_SetRenderDrawColor(renderer, 80, 80, 80, 255);
+        SDL_RenderFillRect(renderer, &barrel);
+
+        // Barrel highlight
+        SDL_Rect barrelHighlight = {weaponX + 70, weaponY + 110, 50, 20};
+        SDL_SetRenderDrawColor(renderer, 120, 120, 120, 255);
+        SDL_RenderFillRect(renderer, &barrelHighlight);
+
+        // Trigger guard
+        SDL_Rect trigger = {weaponX + 90, weaponY + 140, 20, 15};
+        SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
+        SDL_RenderDrawRect(renderer, &trigger);
+    } else if (currentWeapon == WeaponType::ASSAULT_RIFLE) {
+        // Assault Rifle
+        // Stock
+        SDL_Rect stock = {weaponX + 20, weaponY + 130, 60, 40};
+        SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
+        SDL_RenderFillRect(renderer, &stock);
+
+        // Body
+        SDL_Rect body = {weaponX + 70, weaponY + 110, 100, 60};
+        SDL_SetRenderDrawColor(renderer, 60, 60, 60, 255);
+        SDL_RenderFillRect(renderer, &body);
+
+        // Barrel
+        SDL_Rect barrel = {weaponX + 150, weaponY + 120, 50, 30};
+        SDL_SetRenderDrawColor(renderer, 70, 70, 70, 255);
+        SDL_RenderFillRect(renderer, &barrel);
+
+        // Magazine
+        SDL_Rect mag = {weaponX + 110, weaponY + 170, 30, 50};
+        SDL_SetRenderDrawColor(renderer, 40, 40, 40, 255);
+        SDL_RenderFillRect(renderer, &mag);
+
+        // Handle
+        SDL_Rect handle = {weaponX + 90, weaponY + 150, 25, 40};
+        SDL_SetRenderDrawColor(renderer, 60, 40, 20, 255);
+        SDL_RenderFillRect(renderer, &handle);
+    } else if (currentWeapon == WeaponType::GRENADE_LAUNCHER) {
+        // Grenade Launcher
+        // Body
+        SDL_Rect body = {weaponX + 50, weaponY + 120, 120, 60};
+        SDL_SetRenderDrawColor(renderer, 70, 70, 50, 255);
+        SDL_RenderFillRect(renderer, &body);
+
+        // Large barrel tube
+        SDL_Rect barrel = {weaponX + 140, weaponY + 100, 60, 100};
+        SDL_SetRenderDrawColor(renderer, 80, 80, 60, 255);
+        SDL_RenderFillRect(renderer, &barrel);
+
+        // Barrel end (dark)
+        SDL_Rect barrelEnd = {weaponX + 180, weaponY + 110, 20, 80};
+        SDL_SetRenderDrawColor(renderer, 40, 40, 30, 255);
+        SDL_RenderFillRect(renderer, &barrelEnd);
+
+        // Handle
+        SDL_Rect handle = {weaponX + 80, weaponY + 160, 30, 50};
+        SDL_SetRenderDrawColor(renderer, 60, 40, 20, 255);
+        SDL_RenderFillRect(renderer, &handle);
+    } else if (currentWeapon == WeaponType::SMG) {
+        // SMG (Compact submachine gun)
+        // Stock (small and compact)
+        SDL_Rect stock = {weaponX + 30, weaponY + 135, 50, 35};
+        SDL_SetRenderDrawColor(renderer, 40, 40, 40, 255);
+        SDL_RenderFillRect(renderer, &stock);
+
+        // Body (compact)
+        SDL_Rect body = {weaponX + 70, weaponY + 115, 80, 55};
+        SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
+        SDL_RenderFillRect(renderer, &body);
+
+        // Short barrel
+        SDL_Rect barrel = {weaponX + 135, weaponY + 125, 45, 30};
+        SDL_SetRenderDrawColor(renderer, 60, 60, 60, 255);
+        SDL_RenderFillRect(renderer, &barrel);
+
+        // Large magazine (extended)
+        SDL_Rect mag = {weaponX + 100, weaponY + 170, 35, 60};
+        SDL_SetRenderDrawColor(renderer, 30, 30, 30, 255);
+        SDL_RenderFillRect(renderer, &mag);
+
+        // Handle
+        SDL_Rect handle = {weaponX + 90, weaponY + 155, 25, 40};
+        SDL_SetRenderDrawColor(renderer, 50, 40, 30, 255);
+        SDL_RenderFillRect(renderer, &handle);
+
+        // Highlight
+        SDL_Rect highlight = {weaponX + 140, weaponY + 130, 30, 10};
+        SDL_SetRenderDrawColor(renderer, 90, 90, 90, 255);
+        SDL_RenderFillRect(renderer, &highlight);
+    } else if (currentWeapon == WeaponType::SNIPER) {
+        // Sniper Rifle (Long and precise)
+        // Stock
+        SDL_Rect stock = {weaponX + 10, weaponY + 130, 70, 45};
+        SDL_SetRenderDrawColor(renderer, 60, 45, 30, 255);
+        SDL_RenderFillRect(renderer, &stock);
+
+        // Body/receiver
+        SDL_Rect body = {weaponX + 70, weaponY + 115, 90, 55};
+        SDL_SetRenderDrawColor(renderer, 55, 55, 55, 255);
+        SDL_RenderFillRect(renderer, &body);
+
+        // Very long barrel
+        SDL_Rect barrel = {weaponX + 145, weaponY + 125, 80, 28};
+        SDL_SetRenderDrawColor(renderer, 65, 65, 65, 255);
+        SDL_RenderFillRect(renderer, &barrel);
+
+        // Scope (large)
+        SDL_Rect scope = {weaponX + 90, weaponY + 85, 60, 30};
+        SDL_SetRenderDrawColor(renderer, 40, 40, 40, 255);
+        SDL_RenderFillRect(renderer, &scope);
+
+        // Scope lens
+        SDL_Rect scopeLens = {weaponX + 140, weaponY + 92, 10, 16};
+        SDL_SetRenderDrawColor(renderer, 100, 150, 200, 200);
+        SDL_RenderFillRect(renderer, &scopeLens);
+
+        // Barrel highlight
+        SDL_Rect barrelHighlight = {weaponX + 150, weaponY + 132, 60, 10};
+        SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
+        SDL_RenderFillRect(renderer, &barrelHighlight);
+
+        // Bipod
+        SDL_Rect bipod1 = {weaponX + 130, weaponY + 153, 3, 25};
+        SDL_Rect bipod2 = {weaponX + 145, weaponY + 153, 3, 25};
+        SDL_SetRenderDrawColor(renderer, 70, 70, 70, 255);
+        SDL_RenderFillRect(renderer, &bipod1);
+        SDL_RenderFillRect(renderer, &bipod2);
+    } else if (currentWeapon == WeaponType::FLAMETHROWER) {
+        // Flamethrower (Bulky and dangerous)
+        // Fuel tank (large red tank)
+        SDL_Rect tank = {weaponX + 30, weaponY + 90, 80, 100};
+        SDL_SetRenderDrawColor(renderer, 150, 50, 50, 255);
+        SDL_RenderFillRect(renderer, &tank);
+
+        // Tank highlight
+        SDL_Rect tankHighlight = {weaponX + 40, weaponY + 100, 30, 40};
+        SDL_SetRenderDrawColor(renderer, 180, 70, 70, 255);
+        SDL_RenderFillRect(renderer, &tankHighlight);
+
+        // Tank straps
+        SDL_Rect strap1 = {weaponX + 35, weaponY + 120, 70, 5};
+        SDL_Rect strap2 = {weaponX + 35, weaponY + 150, 70, 5};
+        SDL_SetRenderDrawColor(renderer, 80, 80, 60, 255);
+        SDL_RenderFillRect(renderer, &strap1);
+        SDL_RenderFillRect(renderer, &strap2);
+
+        // Nozzle body
+        SDL_Rect nozzleBody = {weaponX + 100, weaponY + 130, 70, 40};
+        SDL_SetRenderDrawColor(renderer, 70, 70, 70, 255);
+        SDL_RenderFillRect(renderer, &nozzleBody);
+
+        // Nozzle tip (brass/bronze)
+        SDL_Rect nozzleTip = {weaponX + 160, weaponY + 138, 40, 24};
+        SDL_SetRenderDrawColor(renderer, 150, 120, 60, 255);
+        SDL_RenderFillRect(renderer, &nozzleTip);
+
+        // Pilot light (small orange glow)
+        SDL_Rect pilotLight = {weaponX + 195, weaponY + 145, 5, 10};
+        SDL_SetRenderDrawColor(renderer, 255, 150, 0, 255);
+        SDL_RenderFillRect(renderer, &pilotLight);
+
+        // Handle
+        SDL_Rect handle = {weaponX + 110, weaponY + 160, 25, 45};
+        SDL_SetRenderDrawColor(renderer, 50, 40, 30, 255);
+        SDL_RenderFillRect(renderer, &handle);
+    }
+
+    // Draw crosshair in center of screen
+    int centerX = SCREEN_WIDTH / 2;
+    int centerY = SCREEN_HEIGHT / 2;
+    int crosshairSize = 15;
+    int crosshairThickness = 2;
+    int crosshairGap = 5;
+
+    // Crosshair with black outline for visibility
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    // Horizontal line (left)
+    SDL_Rect crosshairHL1 = {centerX - crosshairSize - 1, centerY - crosshairThickness/2 - 1,
+                              crosshairSize - crosshairGap + 2, crosshairThickness + 2};
+    SDL_RenderFillRect(renderer, &crosshairHL1);
+    // Horizontal line (right)
+    SDL_Rect crosshairHL2 = {centerX + crosshairGap - 1, centerY - crosshairThickness/2 - 1,
+                              crosshairSize - crosshairGap + 2, crosshairThickness + 2};
+    SDL_RenderFillRect(renderer, &crosshairHL2);
+    // Vertical line (top)
+    SDL_Rect crosshairVL1 = {centerX - crosshairThickness/2 - 1, centerY - crosshairSize - 1,
+                              crosshairThickness + 2, crosshairSize - crosshairGap + 2};
+    SDL_RenderFillRect(renderer, &crosshairVL1);
+    // Vertical line (bottom)
+    SDL_Rect crosshairVL2 = {centerX - crosshairThickness/2 - 1, centerY + crosshairGap - 1,
+                              crosshairThickness + 2, crosshairSize - crosshairGap + 2};
+    SDL_RenderFillRect(renderer, &crosshairVL2);
+
+    // White crosshair on top
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 200);
+    // Horizontal line (left)
+    SDL_Rect crosshairH1 = {centerX - crosshairSize, centerY - crosshairThickness/2,
+                             crosshairSize - crosshairGap, crosshairThickness};
+    SDL_RenderFillRect(renderer, &crosshairH1);
+    // Horizontal line (right)
+    SDL_Rect crosshairH2 = {centerX + crosshairGap, centerY - crosshairThickness/2,
+                             crosshairSize - crosshairGap, crosshairThickness};
+    SDL_RenderFillRect(renderer, &crosshairH2);
+    // Vertical line (top)
+    SDL_Rect crosshairV1 = {centerX - crosshairThickness/2, centerY - crosshairSize,
+                             crosshairThickness, crosshairSize - crosshairGap};
+    SDL_RenderFillRect(renderer, &crosshairV1);
+    // Vertical line (bottom)
+    SDL_Rect crosshairV2 = {centerX - crosshairThickness/2, centerY + crosshairGap,
+                             crosshairThickness, crosshairSize - crosshairGap};
+    SDL_RenderFillRect(renderer, &crosshairV2);
+
+    // Center dot
+    SDL_Rect crosshairDot = {centerX - 1, centerY - 1, 2, 2};
+    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 150);
+    SDL_RenderFillRect(renderer, &crosshairDot);
+
+    profile.next(ProfileStage::FOG);
+
+    // === THICK ATMOSPHERIC FOG OVERLAY ===
+    // Add VERY DENSE creepy fog that obscures everything
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+    // Full screen heavy fog base layer
+    SDL_Rect fullFog = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
+    SDL_SetRenderDrawColor(renderer, 30, 30, 35, 120);  // MUCH thicker base fog
+    SDL_RenderFillRect(renderer, &fullFog);
+
+    // Add pulsing fog effect for atmosphere
+    Uint32 time = SDL_GetTicks();
+    float fogPulse = (std::sin(time / 500.0f) + 1.0f) / 2.0f;
+    int pulseAlpha = static_cast<int>(40 + fogPulse * 30);
+
+    SDL_SetRenderDrawColor(renderer, 25, 25, 30, pulseAlpha);
+    SDL_RenderFillRect(renderer, &fullFog);
+
+    // Extra thick fog at edges (vignette effect)
+    const int VIGNETTE_SIZE = 150;
+    for (int i = 0; i < VIGNETTE_SIZE; i++) {
+        float vignetteStrength = (float)i / VIGNETTE_SIZE;
+        int vignetteAlpha = static_cast<int>(vignetteStrength * 100);
+
+        SDL_SetRenderDrawColor(renderer, 10, 10, 15, vignetteAlpha);
+
+        // Top
+        SDL_RenderDrawLine(renderer, 0, i, SCREEN_WIDTH, i);
+        // Bottom
+        SDL_RenderDrawLine(renderer, 0, SCREEN_HEIGHT - i - 1, SCREEN_WIDTH, SCREEN_HEIGHT - i - 1);
+        // Left
+        SDL_RenderDrawLine(renderer, i, 0, i, SCREEN_HEIGHT);
+        // Right
+        SDL_RenderDrawLine(renderer, SCREEN_WIDTH - i - 1, 0, SCREEN_WIDTH - i - 1, SCREEN_HEIGHT);
+    }
+
+    // === ZOMBIE EYES GLOW THROUGH FOG (BUT NOT WALLS!) ===
+    // Render glowing red eyes ONLY for zombies with line of sight
+    for (const auto& zombie : state.zombies) {
+        if (!zombie->isDead()) {
+            float zombieX = zombie->getRenderX(alpha);
+            float zombieY = zombie->getRenderY(alpha);
+            float dx = zombieX - playerX;
+            float dy = zombieY - playerY;
+            float distance = std::sqrt(dx * dx + dy * dy);
+
+            // Show eyes ONLY if close AND have line of sight (NO WALL HACKS!)
+            if (distance < 1000.0f && hasLineOfSight(state.maze.get(), playerX, playerY, zombieX, zombieY)) {
+                // Transform zombie position to screen space
+                float invDet = 1.0f / (std::cos(playerAngle + M_PI/2) * std::sin(playerAngle) -
+                                       std::sin(playerAngle + M_PI/2) * std::cos(playerAngle));
+                float transformX = invDet * (std::sin(playerAngle) * dx - std::cos(playerAngle) * dy);
+                float transformY = invDet * (-std::sin(playerAngle + M_PI/2) * dx + std::cos(playerAngle + M_PI/2) * dy);
+
+                // Only render if in front of player
+                if (transformY > 0.1f) {
+                    int screenX = static_cast<int>((SCREEN_WIDTH / 2) * (1 + transformX / transformY / std::tan(FOV/2)));
+
+                    // Calculate eye glow size (smaller when further away)
+                    int glowSize = static_cast<int>(800.0f / transformY);
+                    if (glowSize < 2) glowSize = 2;
+                    if (glowSize > 25) glowSize = 25;
+
+                    int screenY = SCREEN_HEIGHT / 2 - glowSize;
+
+                    // Pulsing glow effect
+                    Uint32 time = SDL_GetTicks();
+                    float pulse = (std::sin(time / 200.0f + distance / 100.0f) + 1.0f) / 2.0f;
+
+                    // Draw GLOWING RED EYES that pierce through fog!
+                    int eyeGlowAlpha = static_cast<int>(150 + pulse * 80);
+                    int eyeSeparation = glowSize / 2;
+
+                    // Left eye - outer glow (red halo)
+                    SDL_Rect leftEyeGlow = {screenX - eyeSeparation - glowSize, screenY - glowSize/2,
+                                            glowSize * 2, glowSize * 2};
+                    SDL_SetRenderDrawColor(renderer, 255, 50, 50, eyeGlowAlpha / 3);
+                    SDL_RenderFillRect(renderer, &leftEyeGlow);
+
+                    // Left eye - bright center
+                    SDL_Rect leftEye = {screenX - eyeSeparation - glowSize/2, screenY,
+                                       glowSize, glowSize};
+                    SDL_SetRenderDrawColor(renderer, 255, 20, 20, eyeGlowAlpha);
+                    SDL_RenderFillRect(renderer, &leftEye);
+
+                    // Right eye - outer glow
+                    SDL_Rect rightEyeGlow = {screenX + eyeSeparation - glowSize, screenY - glowSize/2,
+                                             glowSize * 2, glowSize * 2};
+                    SDL_SetRenderDrawColor(renderer, 255, 50, 50, eyeGlowAlpha / 3);
+                    SDL_RenderFillRect(renderer, &rightEyeGlow);
+
+                    // Right eye - bright center
+                    SDL_Rect rightEye = {screenX + eyeSeparation - glowSize/2, screenY,
+                                        glowSize, glowSize};
+                    SDL_SetRenderDrawColor(renderer, 255, 20, 20, eyeGlowAlpha);
+                    SDL_RenderFillRect(renderer, &rightEye);
+                }
+            }
+        }
+    }
+
+    // Reset blend mode
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
@@ -0,0 +1,17 @@
+#ifndef ZOMBIE_RENDER_H
+#define ZOMBIE_RENDER_H
+
+#include <SDL.h>
+#include "simulation.h"
+
+class Maze;
+
+// True if no wall tile lies on the segment between two pixel positions
+bool hasLineOfSight(const Maze* maze, float x1, float y1, float x2, float y2);
+
+// Raycast 3D view of the play state: walls, sprites, weapon, fog and glow.
+// Draws a Game::SCREEN_WIDTH x SCREEN_HEIGHT frame to whatever the renderer
+// targets, so a software renderer on a surface works as well as a window.
+void renderFirstPersonView(SDL_Renderer* renderer, const PlayState& state);
+
+#endif
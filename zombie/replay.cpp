@@ -0,0 +1,344 @@
+#include "replay.h"
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+namespace {
+    struct ReplayFileHeader {
+        char magic[4];                  // "ZRPL"
+        std::uint16_t version;
+        std::uint8_t endlessWorld;
+        std::uint8_t reserved;
+        std::uint32_t mazeWidth;
+        std::uint32_t mazeHeight;
+        std::uint64_t sessionSeed;
+        std::uint32_t mazeFileLength;   // Bytes of the --maze-file path after the header
+        std::uint32_t reserved2;
+    };
+    static_assert(sizeof(ReplayFileHeader) == 32, "replay file header layout changed");
+
+    const char REPLAY_FILE_MAGIC[4] = {'Z', 'R', 'P', 'L'};
+    const std::uint16_t REPLAY_FILE_VERSION = 1;
+
+    enum RecordTag : std::uint8_t {
+        TAG_START = 1,
+        TAG_AIM,
+        TAG_ACTION,
+        TAG_TICK,
+        TAG_END
+    };
+
+    // TICK buttons: the four movement directions and the trigger
+    enum Button : std::uint8_t {
+        BUTTON_FORWARD = 1 << 0,
+        BUTTON_BACK = 1 << 1,
+        BUTTON_LEFT = 1 << 2,
+        BUTTON_RIGHT = 1 << 3,
+        BUTTON_FIRE = 1 << 4
+    };
+
+    void hashBytes(std::uint64_t& hash, const void* bytes, size_t count) {
+        const std::uint8_t* p = static_cast<const std::uint8_t*>(bytes);
+        for (size_t i = 0; i < count; i++) {
+            hash = (hash ^ p[i]) * 0x100000001b3ULL;  // FNV-1a
+        }
+    }
+
+    template <typename T>
+    void hashValue(std::uint64_t& hash, T value) {
+        hashBytes(hash, &value, sizeof(value));
+    }
+
+    bool sameBits(float a, float b) {
+        return std::memcmp(&a, &b, sizeof(float)) == 0;
+    }
+}
+
+std::uint64_t stateChecksum(const PlayState& state) {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    hashValue(hash, state.score);
+    hashValue(hash, state.totalScore);
+    hashValue(hash, state.zombiesKilled);
+    hashValue(hash, state.currentLevel);
+    hashValue(hash, state.mazesGenerated);
+    if (state.player) {
+        hashValue(hash, state.player->getX());
+        hashValue(hash, state.player->getY());
+        hashValue(hash, state.player->getAngle());
+        hashValue(hash, state.player->getHealth());
+        hashValue(hash, state.player->getCurrentAmmo());
+    }
+    for (const auto* group : {&state.zombies, &state.hunters}) {
+        hashValue(hash, group->size());
+        for (const auto& zombie : *group) {
+            hashValue(hash, zombie->getX());
+            hashValue(hash, zombie->getY());
+            hashValue(hash, zombie->getHealth());
+        }
+    }
+    hashValue(hash, state.bullets.size());
+    Rng rng = state.rng;  // Where the gameplay stream has got to
+    hashValue(hash, rng.nextU32());
+    return hash;
+}
+
+bool InputRecorder::open(const std::string& path, const PlayState& state) {
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Could not open recording for writing: " << path << std::endl;
+        return false;
+    }
+    this->path = path;
+
+    ReplayFileHeader header = {};
+    std::memcpy(header.magic, REPLAY_FILE_MAGIC, sizeof(header.magic));
+    header.version = REPLAY_FILE_VERSION;
+    header.endlessWorld = state.endlessWorld ? 1 : 0;
+    header.mazeWidth = static_cast<std::uint32_t>(state.mazeWidth);
+    header.mazeHeight = static_cast<std::uint32_t>(state.mazeHeight);
+    header.sessionSeed = state.sessionSeed;
+    header.mazeFileLength = static_cast<std::uint32_t>(state.mazeFile.size());
+    writeBytes(&header, sizeof(header));
+    writeBytes(state.mazeFile.data(), state.mazeFile.size());
+    return true;
+}
+
+void InputRecorder::writeBytes(const void* bytes, size_t count) {
+    file.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(count));
+}
+
+void InputRecorder::recordStart(const PlayState& state, Uint32 now) {
+    if (!isOpen()) return;
+    writeByte(TAG_START);
+    writeByte(static_cast<std::uint8_t>(state.difficulty));
+    writeByte(static_cast<std::uint8_t>(state.mazeType));
+    writeBytes(&now, sizeof(now));
+    lastNow = now;
+
+    // A new player starts with the default aim, which the replay matches
+    lastAngle = state.player->getAngle();
+    lastPitch = state.player->getPitch();
+}
+
+void InputRecorder::recordAction(ReplayAction action) {
+    if (!isOpen()) return;
+    writeByte(TAG_ACTION);
+    writeByte(static_cast<std::uint8_t>(action));
+}
+
+void InputRecorder::recordTick(const PlayState& state, const TickInput& input, Uint32 now) {
+    if (!isOpen()) return;
+
+    // Mouse look is kept as the resulting aim rather than raw deltas, so the
+    // replay doesn't depend on sensitivity or clamping
+    float angle = state.player->getAngle();
+    float pitch = state.player->getPitch();
+    if (!sameBits(angle, lastAngle) || !sameBits(pitch, lastPitch)) {
+        writeByte(TAG_AIM);
+        writeBytes(&angle, sizeof(angle));
+        writeBytes(&pitch, sizeof(pitch));
+        lastAngle = angle;
+        lastPitch = pitch;
+    }
+
+    const Uint8* keys = input.keyState;
+    std::uint8_t buttons = 0;
+    if (keys[SDL_SCANCODE_W] || keys[SDL_SCANCODE_UP]) buttons |= BUTTON_FORWARD;
+    if (keys[SDL_SCANCODE_S] || keys[SDL_SCANCODE_DOWN]) buttons |= BUTTON_BACK;
+    if (keys[SDL_SCANCODE_A] || keys[SDL_SCANCODE_LEFT]) buttons |= BUTTON_LEFT;
+    if (keys[SDL_SCANCODE_D] || keys[SDL_SCANCODE_RIGHT]) buttons |= BUTTON_RIGHT;
+    if (input.firing) buttons |= BUTTON_FIRE;
+    writeByte(TAG_TICK);
+    writeByte(buttons);
+
+    // Clock step as a zigzag varint: one byte for a normal 16-17 ms tick
+    std::int32_t step = static_cast<std::int32_t>(now - lastNow);
+    std::uint32_t zigzag = (static_cast<std::uint32_t>(step) << 1) ^ static_cast<std::uint32_t>(step >> 31);
+    while (zigzag >= 0x80) {
+        writeByte(static_cast<std::uint8_t>(zigzag | 0x80));
+        zigzag >>= 7;
+    }
+    writeByte(static_cast<std::uint8_t>(zigzag));
+    lastNow = now;
+    ticks++;
+}
+
+bool InputRecorder::close(const PlayState& state) {
+    if (!isOpen()) return true;
+    writeByte(TAG_END);
+    std::uint64_t checksum = stateChecksum(state);
+    writeBytes(&checksum, sizeof(checksum));
+
+    bool ok = static_cast<bool>(file);
+    file.close();
+    if (!ok) {
+        std::cerr << "Failed writing recording: " << path << std::endl;
+        return false;
+    }
+    std::cout << "Recorded " << ticks << " ticks to " << path << std::endl;
+    return true;
+}
+
+bool InputReplay::load(const std::string& path) {
+    this->path = path;
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Could not read recording: " << path << std::endl;
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    ReplayFileHeader header;
+    if (data.size() < sizeof(header)) {
+        std::cerr << "Recording too short: " << path << std::endl;
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, REPLAY_FILE_MAGIC, sizeof(header.magic)) != 0) {
+        std::cerr << "Not a recording: " << path << std::endl;
+        return false;
+    }
+    if (header.version != REPLAY_FILE_VERSION) {
+        std::cerr << "Unsupported recording version " << header.version << ": " << path << std::endl;
+        return false;
+    }
+    if (data.size() < sizeof(header) + header.mazeFileLength) {
+        std::cerr << "Truncated recording: " << path << std::endl;
+        return false;
+    }
+    sessionSeed = header.sessionSeed;
+    mazeWidth = static_cast<int>(header.mazeWidth);
+    mazeHeight = static_cast<int>(header.mazeHeight);
+    endlessWorld = header.endlessWorld != 0;
+    mazeFile.assign(reinterpret_cast<const char*>(data.data()) + sizeof(header), header.mazeFileLength);
+    recordsStart = sizeof(header) + header.mazeFileLength;
+
+    // Check every record up front. A game that crashed or was killed leaves
+    // a partial last record; everything before it still replays.
+    pos = recordsStart;
+    tickCount = 0;
+    Record record;
+    Uint32 clock = 0;
+    while (pos < data.size()) {
+        size_t recordStart = pos;
+        if (!readRecord(record, clock)) {
+            std::cerr << "Recording ends in a bad record at byte " << recordStart << ", replaying up to it: " << path << std::endl;
+            data.resize(recordStart);
+            break;
+        }
+        if (record.tag == TAG_START || record.tag == TAG_TICK) clock = record.now;
+        if (record.tag == TAG_TICK) tickCount++;
+    }
+    pos = recordsStart;
+    return true;
+}
+
+bool InputReplay::readBytes(void* out, size_t count) {
+    if (data.size() - pos < count) return false;
+    std::memcpy(out, data.data() + pos, count);
+    pos += count;
+    return true;
+}
+
+bool InputReplay::readRecord(Record& record, Uint32 clock) {
+    if (!readBytes(&record.tag, 1)) return false;
+    switch (record.tag) {
+        case TAG_START:
+            return readBytes(&record.a, 1) && readBytes(&record.b, 1) && readBytes(&record.now, sizeof(record.now)) &&
+                   record.a <= static_cast<std::uint8_t>(Difficulty::TESTING) &&
+                   record.b <= static_cast<std::uint8_t>(MazeType::SOLDIER);
+        case TAG_AIM:
+            return readBytes(&record.angle, sizeof(float)) && readBytes(&record.pitch, sizeof(float));
+        case TAG_ACTION:
+            return readBytes(&record.a, 1) && record.a <= static_cast<std::uint8_t>(ReplayAction::TOGGLE_MELEE);
+        case TAG_TICK: {
+            if (!readBytes(&record.a, 1)) return false;
+            std::uint32_t zigzag = 0;
+            for (int shift = 0;; shift += 7) {
+                std::uint8_t byte;
+                if (shift > 28 || !readBytes(&byte, 1)) return false;
+                zigzag |= static_cast<std::uint32_t>(byte & 0x7f) << shift;
+                if (!(byte & 0x80)) break;
+            }
+            std::int32_t step = static_cast<std::int32_t>(zigzag >> 1) ^ -static_cast<std::int32_t>(zigzag & 1);
+            record.now = clock + static_cast<Uint32>(step);
+            return true;
+        }
+        case TAG_END:
+            return readBytes(&record.checksum, sizeof(record.checksum));
+        default:
+            return false;
+    }
+}
+
+bool InputReplay::begin(PlayState& state) {
+    state.sessionSeed = sessionSeed;
+    state.mazeWidth = mazeWidth;
+    state.mazeHeight = mazeHeight;
+    state.endlessWorld = endlessWorld;
+    state.mazeFile = mazeFile;
+    std::cout << "Replaying " << path << ": " << tickCount << " ticks, seed " << sessionSeed << std::endl;
+
+    // Recordings always open with a START; run it so the caller has a level
+    pos = recordsStart;
+    Record record;
+    if (!readRecord(record, now) || record.tag != TAG_START) {
+        std::cerr << "Recording does not start with a game: " << path << std::endl;
+        return false;
+    }
+    now = record.now;
+    initializeGame(state, now, static_cast<Difficulty>(record.a), static_cast<MazeType>(record.b));
+    return true;
+}
+
+void InputReplay::report() const {
+    std::cout << "Replayed " << ticksPlayed << " of " << tickCount << " ticks from " << path << ": ";
+    if (!checksumRecorded) {
+        std::cout << "no final checksum (recording was cut short)" << std::endl;
+    } else if (inSync) {
+        std::cout << "final state matches the recording" << std::endl;
+    } else {
+        std::cout << "final state DIFFERS from the recording" << std::endl;
+    }
+}
+
+bool InputReplay::step(PlayState& state, TickOutcome& outcome) {
+    Record record;
+    while (readRecord(record, now)) {
+        switch (record.tag) {
+            case TAG_START:
+                now = record.now;
+                initializeGame(state, now, static_cast<Difficulty>(record.a), static_cast<MazeType>(record.b));
+                break;
+            case TAG_AIM:
+                state.player->setAngle(record.angle);
+                state.player->setPitch(record.pitch);
+                break;
+            case TAG_ACTION:
+                if (static_cast<ReplayAction>(record.a) == ReplayAction::SWITCH_WEAPON) {
+                    state.player->switchWeapon();
+                } else {
+                    state.player->setUsingMelee(!state.player->isUsingMelee());
+                }
+                break;
+            case TAG_TICK: {
+                now = record.now;
+                keys[SDL_SCANCODE_W] = (record.a & BUTTON_FORWARD) ? 1 : 0;
+                keys[SDL_SCANCODE_S] = (record.a & BUTTON_BACK) ? 1 : 0;
+                keys[SDL_SCANCODE_A] = (record.a & BUTTON_LEFT) ? 1 : 0;
+                keys[SDL_SCANCODE_D] = (record.a & BUTTON_RIGHT) ? 1 : 0;
+                TickInput input;
+                input.keyState = keys.data();
+                input.firing = (record.a & BUTTON_FIRE) != 0;
+                outcome = stepSimulation(state, input, SIMULATION_STEP, now);
+                ticksPlayed++;
+                return true;
+            }
+            case TAG_END:
+                checksumRecorded = true;
+                inSync = record.checksum == stateChecksum(state);
+                break;
+        }
+    }
+    return false;
+}
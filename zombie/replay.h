@@ -0,0 +1,116 @@
+#ifndef ZOMBIE_REPLAY_H
+#define ZOMBIE_REPLAY_H
+
+#include <SDL.h>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "simulation.h"
+
+// Input recordings (--record / --replay). Everything that reaches the
+// simulation from outside is written per tick; the rest (mazes, spawns, AI)
+// follows from the session seed, so a replay re-runs the session bit for
+// bit. The file is a small header with the session settings followed by
+// tagged records:
+//
+//   START   difficulty, maze type, clock   initializeGame (new game, restart, respawn)
+//   AIM     angle, pitch                   mouse look, only when it changed
+//   ACTION  switch weapon / toggle melee   in the order they were pressed
+//   TICK    held buttons, clock step       one stepSimulation call
+//   END     state checksum                 on close, to check a replay stayed in sync
+//
+// Testing panel actions (spawns, god mode) are not recorded, so the panel
+// cannot be opened while recording or replaying.
+
+enum class ReplayAction : std::uint8_t {
+    SWITCH_WEAPON,
+    TOGGLE_MELEE
+};
+
+// Hash of the gameplay state (player, enemies, bullets, score, RNG); equal
+// checksums mean a replay reproduced the recorded session
+std::uint64_t stateChecksum(const PlayState& state);
+
+// Every call but open() does nothing while no file is open, so the game loop
+// can report unconditionally
+class InputRecorder {
+public:
+    // Writes the header from state's session settings (seed, maze options)
+    bool open(const std::string& path, const PlayState& state);
+    bool isOpen() const { return file.is_open(); }
+
+    void recordStart(const PlayState& state, Uint32 now);  // Right after initializeGame
+    void recordAction(ReplayAction action);                 // After the action is applied
+    void recordTick(const PlayState& state, const TickInput& input, Uint32 now);  // Before stepSimulation
+
+    // Writes END with state's checksum and closes the file. False on I/O error.
+    bool close(const PlayState& state);
+
+private:
+    void writeBytes(const void* bytes, size_t count);
+    void writeByte(std::uint8_t value) { writeBytes(&value, 1); }
+
+    std::ofstream file;
+    std::string path;
+    Uint32 lastNow = 0;
+    float lastAngle = 0.0f;
+    float lastPitch = 0.0f;
+    long long ticks = 0;
+};
+
+class InputReplay {
+public:
+    // Reads the whole recording; false (with a message) if it isn't one
+    bool load(const std::string& path);
+
+    // Applies the recorded session settings to state and starts its first game
+    bool begin(PlayState& state);
+
+    // Applies records up to the next tick and runs it. False once the
+    // recording is used up (or corrupt); outcome is set otherwise.
+    bool step(PlayState& state, TickOutcome& outcome);
+
+    long long getTickCount() const { return tickCount; }    // Ticks in the recording
+    long long getTicksPlayed() const { return ticksPlayed; }
+    Uint32 getNow() const { return now; }                    // Clock of the last record applied
+
+    // Once step() has returned false: whether the END checksum matched
+    bool hasChecksum() const { return checksumRecorded; }
+    bool isInSync() const { return inSync; }
+    void report() const;  // Prints ticks played and the checksum result
+
+private:
+    struct Record {
+        std::uint8_t tag = 0;
+        std::uint8_t a = 0, b = 0;         // START: difficulty, maze type; ACTION: action; TICK: buttons
+        Uint32 now = 0;                    // START, TICK: clock after the record
+        float angle = 0.0f, pitch = 0.0f;  // AIM
+        std::uint64_t checksum = 0;        // END
+    };
+
+    // Decodes the record at pos and advances; false at the end or on a bad record
+    bool readRecord(Record& record, Uint32 clock);
+    bool readBytes(void* out, size_t count);
+
+    std::string path;
+    std::vector<std::uint8_t> data;
+    size_t recordsStart = 0;
+    size_t pos = 0;
+
+    std::uint64_t sessionSeed = 0;
+    int mazeWidth = 0;
+    int mazeHeight = 0;
+    bool endlessWorld = false;
+    std::string mazeFile;
+
+    Uint32 now = 0;
+    long long tickCount = 0;
+    long long ticksPlayed = 0;
+    bool checksumRecorded = false;
+    bool inSync = false;
+    std::array<Uint8, SDL_NUM_SCANCODES> keys{};  // Synthetic keyboard for Player::handleInput
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef ZOMBIE_RNG_H
+#define ZOMBIE_RNG_H
+
+#include <cstdint>
+
+// Small, fast, seedable generator (PCG32, XSH-RR). Every gameplay random
+// choice goes through one of these so a seed reproduces a run. Bounded
+// draws are computed here instead of with <random> distributions, whose
+// output differs between standard libraries (native vs. emscripten).
+class Rng {
+public:
+    explicit Rng(std::uint64_t seed = DEFAULT_SEED) { reseed(seed); }
+
+    void reseed(std::uint64_t seed) {
+        state = 0;
+        increment = (mixSeed(seed, 0x5851f42d4c957f2dULL) << 1) | 1u;  // Stream picked by the seed too
+        nextU32();
+        state += seed;
+        nextU32();
+    }
+
+    std::uint32_t nextU32() {
+        std::uint64_t old = state;
+        state = old * 6364136223846793005ULL + increment;
+        std::uint32_t xorShifted = static_cast<std::uint32_t>(((old >> 18u) ^ old) >> 27u);
+        std::uint32_t rot = static_cast<std::uint32_t>(old >> 59u);
+        return (xorShifted >> rot) | (xorShifted << ((32u - rot) & 31u));
+    }
+
+    std::uint64_t nextU64() {
+        std::uint64_t high = nextU32();
+        return (high << 32) | nextU32();
+    }
+
+    // Uniform in [0, bound); bound must be positive. Unbiased (Lemire).
+    int nextBelow(int bound) {
+        std::uint32_t range = static_cast<std::uint32_t>(bound);
+        std::uint64_t product = static_cast<std::uint64_t>(nextU32()) * range;
+        std::uint32_t low = static_cast<std::uint32_t>(product);
+        if (low < range) {
+            std::uint32_t threshold = (0u - range) % range;
+            while (low < threshold) {
+                product = static_cast<std::uint64_t>(nextU32()) * range;
+                low = static_cast<std::uint32_t>(product);
+            }
+        }
+        return static_cast<int>(product >> 32);
+    }
+
+    // Uniform in [lo, hi], inclusive
+    int nextInt(int lo, int hi) { return lo + nextBelow(hi - lo + 1); }
+
+    // Uniform in [0, 1)
+    float nextFloat() { return (nextU32() >> 8) * (1.0f / 16777216.0f); }
+    float nextFloat(float lo, float hi) { return lo + (hi - lo) * nextFloat(); }
+
+    // SplitMix64 finaliser: derive well-spread child seeds (per level, per
+    // zombie, ...) from one session seed
+    static constexpr std::uint64_t mixSeed(std::uint64_t seed, std::uint64_t salt) {
+        std::uint64_t z = seed + 0x9e3779b97f4a7c15ULL * (salt + 1);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    static constexpr std::uint64_t DEFAULT_SEED = 0x853c49e6748fea9bULL;
+
+private:
+    std::uint64_t state;
+    std::uint64_t increment;
+};
+
+#endif
@@ -0,0 +1,494 @@
+// Headless soak run: the full simulation (AI, spawning, bullets, events)
+// with no window or audio, stepped as fast as the CPU allows. By default the
+// player holds fire while slowly turning on the spot; with --autopilot a
+// scripted bot plays properly (keys, exits, pickups, fights). Deaths and
+// wins restart the level, as the game would. Prints throughput and a
+// summary at the end; --sweep repeats the run for every maze type and
+// difficulty and prints one row each.
+// With --replay it plays back a recorded session (from the game or from
+// --record here) instead, and checks it ends in the recorded state.
+// --horde holds the world at a fixed number of zombies, hunters and bullets
+// (the player is immortal) and adds per-stage times to the summary;
+// --scaling runs each of those alone at 100, 1,000 and 10,000 and reports
+// how every stage's cost grows with the count. Built with --config=alloc,
+// the summary also counts heap allocations per tick and live bytes by tag.
+
+#include "allocation.h"
+#include "autopilot.h"
+#include "replay.h"
+#include "simulation.h"
+#include "stress.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#define ZOMBIE_HAVE_RUSAGE 1
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    const float TURN_PER_TICK = 0.02f;  // Radians; sweeps the aim around the player
+    const long long SCALING_TICKS = 600;  // Default ticks per --scaling point
+    const int SCALING_COUNTS[] = {100, 1000, 10000};
+
+    // The stages stepSimulation reports to a profiler
+    const ProfileStage SIMULATION_STAGES[] = {ProfileStage::PLAYER, ProfileStage::SPAWNING, ProfileStage::ZOMBIES,
+                                              ProfileStage::BULLETS, ProfileStage::COLLISIONS};
+
+    const std::pair<const char*, MazeType> MAZE_TYPE_NAMES[] = {
+        {"standard", MazeType::STANDARD}, {"circular", MazeType::CIRCULAR},
+        {"infinite", MazeType::INFINITE}, {"soldier", MazeType::SOLDIER}};
+    const std::pair<const char*, Difficulty> DIFFICULTY_NAMES[] = {
+        {"easy", Difficulty::EASY}, {"normal", Difficulty::NORMAL},
+        {"hard", Difficulty::HARD}, {"testing", Difficulty::TESTING}};
+
+    bool parseMazeType(const char* name, MazeType& type) {
+        for (const auto& [text, value] : MAZE_TYPE_NAMES) {
+            if (std::strcmp(name, text) == 0) {
+                type = value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool parseDifficulty(const char* name, Difficulty& difficulty) {
+        for (const auto& [text, value] : DIFFICULTY_NAMES) {
+            if (std::strcmp(name, text) == 0) {
+                difficulty = value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " [--ticks N] [--seed N] [--maze-size WIDTHxHEIGHT]"
+                  << " [--maze-type standard|circular|infinite|soldier]"
+                  << " [--difficulty easy|normal|hard|testing] [--endless] [--quiet]"
+                  << " [--autopilot] [--sweep] [--record PATH] [--replay PATH]"
+                  << " [--horde ZOMBIES[,HUNTERS[,BULLETS]]] [--scaling]" << std::endl;
+    }
+
+    // Peak resident set size of the process so far in KiB, or -1 where unknown
+    long peakResidentKb() {
+#ifdef ZOMBIE_HAVE_RUSAGE
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#ifdef __APPLE__
+        return static_cast<long>(usage.ru_maxrss / 1024);  // Bytes on macOS
+#else
+        return static_cast<long>(usage.ru_maxrss);
+#endif
+#else
+        return -1;
+#endif
+    }
+
+    // Session settings shared by every run of a sweep
+    struct SessionOptions {
+        std::uint64_t seed = Rng::DEFAULT_SEED;
+        int mazeWidth = Maze::DEFAULT_WIDTH;
+        int mazeHeight = Maze::DEFAULT_HEIGHT;
+        bool endlessWorld = false;
+    };
+
+    struct RunStats {
+        long long ticks = 0;
+        double elapsedMs = 0.0;
+        std::vector<float> tickMs;  // Every tick's wall time, for percentiles
+        int deaths = 0;
+        int wins = 0;
+        int kills = 0;
+        int keys = 0;
+        int topLevel = 1;
+        int peakZombies = 0;
+        int peakBullets = 0;
+        long long events = 0;
+        int alive = 0;
+        int unsticks = 0;
+        std::uint64_t allocations = 0;  // Made by the simulation (allocation tracking builds only)
+        std::uint64_t mostAllocations = 0;  // In one tick
+        // With a horde held: per-stage totals over the second half of the
+        // run, once the horde has closed in on the player
+        std::array<double, PROFILE_STAGE_COUNT> stageMs{};
+        long long stageTicks = 0;
+
+        float stageAverageMs(ProfileStage stage) const {
+            return stageTicks > 0 ? static_cast<float>(stageMs[static_cast<int>(stage)] / stageTicks) : 0.0f;
+        }
+        float steadyTickMs() const {  // Whole ticks over the same stretch
+            if (stageTicks <= 0 || tickMs.size() < static_cast<size_t>(stageTicks)) return 0.0f;
+            return std::accumulate(tickMs.end() - stageTicks, tickMs.end(), 0.0f) / stageTicks;
+        }
+
+        float percentileMs(int percent) {
+            if (tickMs.empty()) return 0.0f;
+            size_t rank = (tickMs.size() - 1) * percent / 100;
+            std::nth_element(tickMs.begin(), tickMs.begin() + rank, tickMs.end());
+            return tickMs[rank];
+        }
+        float slowestMs() const {
+            return tickMs.empty() ? 0.0f : *std::max_element(tickMs.begin(), tickMs.end());
+        }
+    };
+
+    // Steps state for up to ticks ticks (or through the whole replay), driven
+    // by the turning gunner, the autopilot or the recording. A horde is
+    // topped up before every tick, outside the timed part.
+    RunStats runSession(PlayState& state, long long ticks, Difficulty difficulty, MazeType mazeType,
+                        bool autopilot, const HordeSize& hordeSize, InputRecorder& recorder, InputReplay* replay) {
+        RunStats stats;
+        stats.tickMs.reserve(static_cast<size_t>(ticks));
+
+        // Only stress runs pay for the stage clock reads
+        FrameProfiler profiler;
+        bool stressed = !hordeSize.isEmpty();
+        Horde horde(hordeSize, Rng::mixSeed(state.sessionSeed, 0x4d0e));
+        if (stressed) {
+            state.profiler = &profiler;
+            state.godMode = true;  // Measure the load, not the respawns
+        }
+        auto addStageTimes = [&stats, &profiler, ticks](long long frameTick) {
+            if (frameTick < ticks / 2) return;
+            stats.stageTicks++;
+            for (ProfileStage stage : SIMULATION_STAGES) {
+                stats.stageMs[static_cast<int>(stage)] += profiler.getMs(static_cast<int>(stage), 0);
+            }
+        };
+
+        std::array<Uint8, SDL_NUM_SCANCODES> noKeys{};
+        TickInput spinInput;
+        spinInput.keyState = noKeys.data();
+        spinInput.firing = true;
+        Autopilot bot(Rng::mixSeed(state.sessionSeed, 0xb07));
+
+        Uint32 now = 0;  // Tick clock, SIMULATION_HZ ticks per simulated second
+        if (replay) {
+            if (!replay->begin(state)) return stats;
+        } else {
+            initializeGame(state, now, difficulty, mazeType);
+            recorder.recordStart(state, now);
+        }
+
+        auto start = Clock::now();
+        for (long long tick = 0; tick < ticks; tick++) {
+            auto tickStart = Clock::now();
+            std::uint64_t allocationsBefore = getAllocationCount();
+            TickOutcome outcome;
+            if (replay) {
+                if (!replay->step(state, outcome)) break;
+            } else {
+                now = static_cast<Uint32>((tick + 1) * 1000 / SIMULATION_HZ);
+                TickInput input = spinInput;
+                if (autopilot) {
+                    input = bot.update(state);
+                    for (ReplayAction action : bot.getActions()) recorder.recordAction(action);
+                } else {
+                    state.player->setAngle(state.player->getAngle() + TURN_PER_TICK);
+                }
+                recorder.recordTick(state, input, now);
+                if (stressed) {
+                    horde.topUp(state);
+                    profiler.beginFrame();
+                    if (tick > 0) addStageTimes(tick - 1);  // The frame beginFrame just closed
+                }
+                tickStart = Clock::now();  // Time the simulation, not the bot or the horde
+                allocationsBefore = getAllocationCount();
+                outcome = stepSimulation(state, input, SIMULATION_STEP, now);
+            }
+            stats.tickMs.push_back(std::chrono::duration<float, std::milli>(Clock::now() - tickStart).count());
+            std::uint64_t tickAllocations = getAllocationCount() - allocationsBefore;
+            stats.allocations += tickAllocations;
+            stats.mostAllocations = std::max(stats.mostAllocations, tickAllocations);
+            stats.ticks++;
+
+            // Nothing presents the events; drain them so the queue never fills
+            GameEvent event;
+            while (state.events.pop(event)) {
+                stats.events++;
+                if (event.type == GameEventType::KEY_COLLECTED) stats.keys++;
+            }
+            stats.topLevel = std::max(stats.topLevel, state.currentLevel);
+            stats.peakZombies = std::max(stats.peakZombies, static_cast<int>(state.zombies.size() + state.hunters.size()));
+            stats.peakBullets = std::max(stats.peakBullets, static_cast<int>(state.bullets.size()));
+
+            if (outcome != TickOutcome::PLAYING) {
+                if (outcome == TickOutcome::PLAYER_DIED) {
+                    stats.deaths++;
+                } else {
+                    stats.wins++;
+                }
+                stats.kills += state.zombiesKilled;  // Per-life count, reset with the level
+                if (!replay) {  // A replay restarts where its recording did
+                    initializeGame(state, now, difficulty, mazeType);
+                    recorder.recordStart(state, now);
+                }
+            }
+        }
+        stats.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (stressed) {
+            profiler.beginFrame();
+            addStageTimes(stats.ticks - 1);
+            state.profiler = nullptr;
+        }
+        if (replay) {
+            TickOutcome outcome;
+            while (replay->step(state, outcome)) {}  // Reads the closing checksum
+        }
+
+        stats.kills += state.zombiesKilled;
+        stats.alive = static_cast<int>(std::count_if(state.zombies.begin(), state.zombies.end(),
+                                                     [](const auto& z) { return !z->isDead(); }));
+        stats.unsticks = bot.getUnstickCount();
+        return stats;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    long long ticks = 36000;  // Ten minutes of game time
+    SessionOptions session;
+    MazeType mazeType = MazeType::STANDARD;
+    Difficulty difficulty = Difficulty::NORMAL;
+    bool quiet = false;
+    bool autopilot = false;
+    bool sweep = false;
+    bool scaling = false;
+    bool ticksGiven = false;
+    HordeSize hordeSize;
+    std::string recordPath;
+    std::string replayPath;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            ticks = std::atoll(argv[++i]);
+            if (ticks <= 0) {
+                std::cerr << "Invalid --ticks '" << argv[i] << "', expected a positive count" << std::endl;
+                return 1;
+            }
+            ticksGiven = true;
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            char* end = nullptr;
+            errno = 0;
+            unsigned long long seed = std::strtoull(argv[++i], &end, 0);
+            if (errno != 0 || end == argv[i] || *end != '\0') {
+                std::cerr << "Invalid --seed '" << argv[i] << "', expected an unsigned integer" << std::endl;
+                return 1;
+            }
+            session.seed = seed;
+        } else if (std::strcmp(argv[i], "--maze-size") == 0 && i + 1 < argc) {
+            int w = 0, h = 0;
+            int parsed = std::sscanf(argv[++i], "%dx%d", &w, &h);
+            if (parsed == 1) h = w;
+            if (parsed < 1 || w <= 0 || h <= 0) {
+                std::cerr << "Invalid --maze-size '" << argv[i] << "', expected WIDTHxHEIGHT" << std::endl;
+                return 1;
+            }
+            session.mazeWidth = w;
+            session.mazeHeight = h;
+        } else if (std::strcmp(argv[i], "--maze-type") == 0 && i + 1 < argc) {
+            if (!parseMazeType(argv[++i], mazeType)) {
+                std::cerr << "Unknown --maze-type '" << argv[i] << "'" << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--difficulty") == 0 && i + 1 < argc) {
+            if (!parseDifficulty(argv[++i], difficulty)) {
+                std::cerr << "Unknown --difficulty '" << argv[i] << "'" << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--endless") == 0) {
+            session.endlessWorld = true;
+        } else if (std::strcmp(argv[i], "--quiet") == 0) {
+            quiet = true;
+        } else if (std::strcmp(argv[i], "--autopilot") == 0) {
+            autopilot = true;
+        } else if (std::strcmp(argv[i], "--sweep") == 0) {
+            sweep = true;
+        } else if (std::strcmp(argv[i], "--horde") == 0 && i + 1 < argc) {
+            int parsed = std::sscanf(argv[++i], "%d,%d,%d", &hordeSize.zombies, &hordeSize.hunters, &hordeSize.bullets);
+            if (parsed < 1 || hordeSize.zombies < 0 || hordeSize.hunters < 0 || hordeSize.bullets < 0 ||
+                hordeSize.isEmpty()) {
+                std::cerr << "Invalid --horde '" << argv[i] << "', expected ZOMBIES[,HUNTERS[,BULLETS]]" << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--scaling") == 0) {
+            scaling = true;
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (sweep && (!recordPath.empty() || !replayPath.empty())) {
+        std::cerr << "--sweep cannot be combined with --record or --replay" << std::endl;
+        return 1;
+    }
+    // The horde's spawns aren't input, so a recording couldn't reproduce them
+    if ((scaling || !hordeSize.isEmpty()) && (!recordPath.empty() || !replayPath.empty())) {
+        std::cerr << "--horde and --scaling cannot be combined with --record or --replay" << std::endl;
+        return 1;
+    }
+
+    auto makeState = [&session](PlayState& state) {
+        state.sessionSeed = session.seed;
+        state.mazeWidth = session.mazeWidth;
+        state.mazeHeight = session.mazeHeight;
+        state.endlessWorld = session.endlessWorld;
+    };
+
+    // Zombies, hunters and bullets alone at each count: per-stage cost, and
+    // the exponent k in cost ~ n^k from the last two counts
+    if (scaling) {
+        if (!ticksGiven) ticks = SCALING_TICKS;
+        std::cout << "Scaling: " << ticks << " ticks per point, " << session.mazeWidth << "x" << session.mazeHeight
+                  << " maze, seed " << session.seed << std::endl;
+        std::printf("%-8s %6s", "load", "count");
+        for (ProfileStage stage : SIMULATION_STAGES) std::printf(" %10s", profileStageName(stage));
+        std::printf(" %10s\n", "tick ms");
+
+        const char* loadNames[] = {"zombies", "hunters", "bullets"};
+        for (int load = 0; load < 3; load++) {
+            std::array<std::array<float, PROFILE_STAGE_COUNT + 1>, std::size(SCALING_COUNTS)> times{};
+            for (size_t point = 0; point < std::size(SCALING_COUNTS); point++) {
+                int count = SCALING_COUNTS[point];
+                HordeSize pointSize;
+                (load == 0 ? pointSize.zombies : load == 1 ? pointSize.hunters : pointSize.bullets) = count;
+
+                PlayState state;
+                makeState(state);
+                InputRecorder noRecorder;
+                if (quiet) std::cout.setstate(std::ios::failbit);
+                RunStats stats = runSession(state, ticks, difficulty, mazeType, autopilot, pointSize, noRecorder, nullptr);
+                std::cout.clear();
+
+                std::printf("%-8s %6d", loadNames[load], count);
+                for (ProfileStage stage : SIMULATION_STAGES) {
+                    times[point][static_cast<int>(stage)] = stats.stageAverageMs(stage);
+                    std::printf(" %10.3f", stats.stageAverageMs(stage));
+                }
+                times[point][PROFILE_STAGE_COUNT] = stats.steadyTickMs();
+                std::printf(" %10.3f\n", times[point][PROFILE_STAGE_COUNT]);
+                std::fflush(stdout);
+            }
+
+            // Stages too cheap to time reliably at the top count have no exponent
+            const auto& low = times[std::size(SCALING_COUNTS) - 2];
+            const auto& high = times[std::size(SCALING_COUNTS) - 1];
+            double countRatio = std::log(static_cast<double>(SCALING_COUNTS[std::size(SCALING_COUNTS) - 1]) /
+                                         SCALING_COUNTS[std::size(SCALING_COUNTS) - 2]);
+            std::printf("%-8s %6s", "", "n^k");
+            for (ProfileStage stage : SIMULATION_STAGES) {
+                int row = static_cast<int>(stage);
+                if (high[row] < 0.01f || low[row] <= 0.0f) {
+                    std::printf(" %10s", "-");
+                } else {
+                    std::printf(" %10.2f", std::log(high[row] / low[row]) / countRatio);
+                }
+            }
+            std::printf(" %10.2f\n", std::log(high[PROFILE_STAGE_COUNT] / low[PROFILE_STAGE_COUNT]) / countRatio);
+        }
+        std::printf("peak RSS %ld KiB\n", peakResidentKb());
+        return 0;
+    }
+
+    // Every maze type at every real difficulty (TESTING is a debug loadout), one row each
+    if (sweep) {
+        std::cout << "Sweep: " << ticks << " ticks per run, seed " << session.seed
+                  << (autopilot ? ", autopilot" : "") << std::endl;
+        std::printf("%-9s %-7s %9s %7s %7s %7s %6s %5s %5s %5s %6s %8s %8s\n", "maze", "diff", "ticks/s",
+                    "avg ms", "p99 ms", "max ms", "deaths", "wins", "level", "keys", "kills", "peak enm", "peak blt");
+        InputRecorder noRecorder;
+        for (const auto& [mazeName, sweepMaze] : MAZE_TYPE_NAMES) {
+            for (const auto& [difficultyName, sweepDifficulty] : DIFFICULTY_NAMES) {
+                if (sweepDifficulty == Difficulty::TESTING) continue;
+                PlayState state;
+                makeState(state);
+                if (quiet) std::cout.setstate(std::ios::failbit);
+                RunStats stats = runSession(state, ticks, sweepDifficulty, sweepMaze, autopilot, hordeSize, noRecorder, nullptr);
+                std::cout.clear();
+                std::printf("%-9s %-7s %9.0f %7.3f %7.3f %7.3f %6d %5d %5d %5d %6d %8d %8d\n", mazeName, difficultyName,
+                            stats.ticks * 1000.0 / stats.elapsedMs, stats.elapsedMs / stats.ticks, stats.percentileMs(99),
+                            stats.slowestMs(), stats.deaths, stats.wins, stats.topLevel, stats.keys, stats.kills,
+                            stats.peakZombies, stats.peakBullets);
+                std::fflush(stdout);
+            }
+        }
+        std::printf("peak RSS %ld KiB\n", peakResidentKb());
+        return 0;
+    }
+
+    // A replay sets its own seed, maze options and length
+    InputReplay replay;
+    bool replaying = !replayPath.empty();
+    if (replaying) {
+        if (!replay.load(replayPath)) return 1;
+        ticks = replay.getTickCount();
+    }
+    PlayState state;
+    makeState(state);
+    InputRecorder recorder;
+    if (!recordPath.empty() && !replaying && !recorder.open(recordPath, state)) return 1;
+
+    if (!replaying) std::cout << "Headless run: " << ticks << " ticks, seed " << state.sessionSeed << std::endl;
+    if (quiet) std::cout.setstate(std::ios::failbit);  // Drop the simulation's log lines
+
+    RunStats stats = runSession(state, ticks, difficulty, mazeType, autopilot, hordeSize, recorder,
+                                replaying ? &replay : nullptr);
+    std::cout.clear();
+    if (replaying && stats.ticks == 0 && replay.getTickCount() > 0) return 1;  // begin() failed
+
+    std::printf("simulated %.1f s in %.1f ms: %.0f ticks/s, %.3f ms/tick avg, %.3f ms p99, %.3f ms slowest\n",
+                static_cast<double>(stats.ticks) / SIMULATION_HZ, stats.elapsedMs, stats.ticks * 1000.0 / stats.elapsedMs,
+                stats.elapsedMs / stats.ticks, stats.percentileMs(99), stats.slowestMs());
+    std::printf("deaths %d, wins %d, level %d, zombie kills %d, zombies alive %d, events %lld\n",
+                stats.deaths, stats.wins, state.currentLevel, stats.kills, stats.alive, stats.events);
+    std::printf("keys %d, top level %d, peak enemies %d, peak bullets %d, peak RSS %ld KiB",
+                stats.keys, stats.topLevel, stats.peakZombies, stats.peakBullets, peakResidentKb());
+    if (autopilot) std::printf(", autopilot unstuck %d times", stats.unsticks);
+    std::printf("\n");
+    AllocationStats memory = getAllocationStats();
+    if (memory.enabled) {
+        const double KIB = 1024.0;
+        std::printf("allocations %.2f/tick avg, %llu max; heap live %.1f KiB, peak %.1f KiB\n",
+                    stats.ticks > 0 ? static_cast<double>(stats.allocations) / stats.ticks : 0.0,
+                    static_cast<unsigned long long>(stats.mostAllocations), memory.liveBytes / KIB,
+                    memory.peakBytes / KIB);
+        std::printf("live KiB (blocks) by tag:");
+        for (int tag = 0; tag < ALLOCATION_TAG_COUNT; tag++) {
+            std::printf(" %s %.1f (%lld)", allocationTagName(static_cast<AllocationTag>(tag)),
+                        memory.liveBytesByTag[tag] / KIB, static_cast<long long>(memory.liveBlocksByTag[tag]));
+        }
+        std::printf("\n");
+    }
+    if (!hordeSize.isEmpty()) {
+        std::printf("horde of %d zombies, %d hunters, %d bullets; ms/tick by stage:", hordeSize.zombies,
+                    hordeSize.hunters, hordeSize.bullets);
+        for (ProfileStage stage : SIMULATION_STAGES) {
+            std::printf(" %s %.3f", profileStageName(stage), stats.stageAverageMs(stage));
+        }
+        std::printf("\n");
+    }
+
+    if (!recorder.close(state)) return 1;
+    if (replaying) {
+        replay.report();
+        if (replay.hasChecksum() && !replay.isInSync()) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,1323 @@
+#include "simulation.h"
+#include "allocation.h"
+#include "trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+    constexpr int INITIAL_ZOMBIE_COUNT = 15;  // Start with more zombies for bigger maze
+    constexpr int MIN_ZOMBIE_COUNT = 8;  // Spawn more when below this
+    constexpr int MAX_ZOMBIE_COUNT = 25;  // Don't spawn more than this
+    constexpr float SPAWN_CHECK_INTERVAL = 5.0f;  // Check every 5 seconds
+
+    // Per-difficulty spawn settings (see applyDifficulty)
+    struct DifficultySettings {
+        int initialZombieCount;
+        int minZombieCount;
+        int maxZombieCount;
+        int zombieMaxHealth;
+    };
+
+    // Helper function to randomly select a zombie type
+    ZombieType getRandomZombieType(Rng& rng) {
+        int roll = rng.nextBelow(100);  // 0-99
+
+        // Distribution:
+        // 50% NORMAL (0-49)
+        // 25% FAST (50-74)
+        // 15% TANK (75-89)
+        // 10% RUNNER (90-99)
+
+        if (roll < 50) {
+            return ZombieType::NORMAL;
+        } else if (roll < 75) {
+            return ZombieType::FAST;
+        } else if (roll < 90) {
+            return ZombieType::TANK;
+        } else {
+            return ZombieType::RUNNER;
+        }
+    }
+
+    DifficultySettings difficultySettings(Difficulty difficulty) {
+        switch (difficulty) {
+            case Difficulty::EASY:
+                return {10, 5, 15, 2};  // Easy: 2 hits to kill
+            case Difficulty::HARD:
+                return {20, 12, 35, 5};  // Hard: 5 hits to kill
+            case Difficulty::TESTING:
+                // Weapon setup happens AFTER player is created (see initializeGame)
+                return {2, 0, 5, 1};  // Testing: 1 hit to kill
+            case Difficulty::NORMAL:
+            default:
+                return {15, 8, 25, 3};  // Normal: 3 hits to kill
+        }
+    }
+
+    void applyDifficulty(PlayState& state, Difficulty difficulty) {
+        state.difficulty = difficulty;  // Store difficulty in PlayState
+
+        DifficultySettings settings = difficultySettings(difficulty);
+        state.initialZombieCount = settings.initialZombieCount;
+        state.minZombieCount = settings.minZombieCount;
+        state.maxZombieCount = settings.maxZombieCount;
+        state.zombieMaxHealth = settings.zombieMaxHealth;
+    }
+
+    // Plan for the level after the current one; seedIndex picks its maze seed
+    LevelPlan makeLevelPlan(const PlayState& state, Difficulty difficulty, MazeType mazeType, int level, std::uint64_t seedIndex) {
+        DifficultySettings settings = difficultySettings(difficulty);
+
+        LevelPlan plan;
+        plan.mazeType = mazeType;
+        plan.level = level;
+        plan.mazeWidth = state.mazeWidth;
+        plan.mazeHeight = state.mazeHeight;
+        plan.mazeSeed = Rng::mixSeed(state.sessionSeed, seedIndex);
+        plan.initialZombieCount = settings.initialZombieCount;
+        plan.zombieMaxHealth = settings.zombieMaxHealth;
+        plan.bakedMaze = state.bakedMaze;
+
+        // Scale difficulty for infinite mode levels > 7: 3 more zombies per level
+        if (mazeType == MazeType::INFINITE && level > 7) {
+            plan.initialZombieCount += (level - 7) * 3;
+        }
+        return plan;
+    }
+
+    void rebuildKeyField(PlayState& state) {
+        std::vector<std::pair<int, int>> targets;
+        for (const auto& key : state.keys) {
+            if (!key->isCollected()) {
+                targets.push_back({static_cast<int>(key->getX() / Maze::TILE_SIZE),
+                                   static_cast<int>(key->getY() / Maze::TILE_SIZE)});
+            }
+        }
+        if (targets.empty()) {
+            state.keyField.clear();
+        } else {
+            state.keyField.build(*state.maze, targets);
+        }
+    }
+
+    // Place the start, zombies, keys and pickups in level.maze, drawing from
+    // level.rng. The endless world has no exits and so places no keys.
+    void populateLevel(PreparedLevel& level, bool withKeys) {
+        const LevelPlan& plan = level.plan;
+        level.startPos = level.maze->getPlayerStart(level.rng);
+
+        // Soldier mode spawns zombies in waves and needs no keys
+        if (plan.mazeType != MazeType::SOLDIER) {
+            // Create zombies at random positions (far from player spawn)
+            auto zombiePositions = level.maze->getRandomZombiePositions(plan.initialZombieCount, level.startPos, level.rng);
+            for (const auto& pos : zombiePositions) {
+                ZombieType type = getRandomZombieType(level.rng);
+                level.zombies.push_back(std::make_unique<Zombie>(pos.x, pos.y, plan.zombieMaxHealth, type, level.rng.nextU64()));
+            }
+
+            // Create keys at random positions
+            if (withKeys) {
+                int requiredKeys = level.maze->getRequiredKeyCount(plan.level);
+                auto keyPositions = level.maze->getRandomKeyPositions(requiredKeys, level.rng);
+                for (const auto& pos : keyPositions) {
+                    level.keys.push_back(std::make_unique<Key>(pos.x, pos.y));
+                }
+            }
+
+            // Create weapon pickups
+            int weaponCount = 3;
+            if (plan.mazeType == MazeType::INFINITE && plan.level > 7) {
+                // Reduce weapons as difficulty increases: level 8=2, level 9+=1
+                weaponCount = std::max(1, 10 - plan.level);
+            }
+            auto weaponPositions = level.maze->getRandomKeyPositions(weaponCount, level.rng);
+            // Spawn variety of weapons (cycle through all types)
+            WeaponType weaponTypes[] = {WeaponType::ASSAULT_RIFLE, WeaponType::GRENADE_LAUNCHER,
+                                         WeaponType::SMG, WeaponType::SNIPER, WeaponType::FLAMETHROWER};
+            for (size_t i = 0; i < weaponPositions.size() && i < static_cast<size_t>(weaponCount); i++) {
+                WeaponType weaponType = weaponTypes[i % 5];  // Cycle through all weapon types
+                level.weaponPickups.push_back(std::make_unique<WeaponPickup>(weaponPositions[i].x, weaponPositions[i].y, weaponType));
+            }
+
+            // Create health boosts (Soldier mode relies on natural regen)
+            int healthCount = 3;
+            if (plan.mazeType == MazeType::INFINITE && plan.level > 7) {
+                // Reduce health boosts: level 8=2, level 10+=1
+                healthCount = std::max(1, 11 - plan.level);
+            }
+            auto healthPositions = level.maze->getRandomKeyPositions(healthCount, level.rng);
+            for (size_t i = 0; i < healthPositions.size() && i < static_cast<size_t>(healthCount); i++) {
+                level.healthBoosts.push_back(std::make_unique<HealthBoost>(healthPositions[i].x, healthPositions[i].y));
+            }
+        }
+    }
+
+    // Generate the maze and place everything in it. Pure function of the
+    // plan: touches neither PlayState nor SDL, so it is safe on a worker.
+    PreparedLevel buildLevel(const LevelPlan& plan) {
+        TraceSpan span("buildLevel", "worker");
+        PreparedLevel level;
+        level.plan = plan;
+
+        // Create new maze (randomly generated with selected type); the
+        // gameplay RNG restarts from its seed
+        {
+            AllocationScope allocations(AllocationTag::MAZE);
+            if (plan.bakedMaze) {
+                // Fixed layout: only the spawns change with the seed
+                level.maze = std::make_unique<Maze>(*plan.bakedMaze);
+            } else {
+                level.maze = std::make_unique<Maze>(plan.mazeType, plan.mazeWidth, plan.mazeHeight, plan.mazeSeed);
+            }
+        }
+        level.rng.reseed(Rng::mixSeed(plan.mazeSeed, 1));
+        populateLevel(level, true);
+        return level;
+    }
+
+    // Drop stale prefetches whose worker has finished; never waits
+    void reapRetiredLevels(PlayState& state) {
+        auto finished = [](const std::future<PreparedLevel>& level) {
+            // A deferred (single-threaded web) build never started, so it is free to drop
+            return level.wait_for(std::chrono::seconds(0)) != std::future_status::timeout;
+        };
+        auto& retired = state.retiredLevels;
+        retired.erase(std::remove_if(retired.begin(), retired.end(), finished), retired.end());
+    }
+
+    // Start building the level after state.currentLevel in the background.
+    // It uses the maze seed the next initializeGame would take, so swapping
+    // it in is indistinguishable from generating it on the spot.
+    void prefetchNextLevel(PlayState& state, Difficulty difficulty) {
+        state.nextLevelPlan = makeLevelPlan(state, difficulty, state.mazeType, state.currentLevel + 1, state.mazesGenerated);
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+        // No threads in the single-threaded web build; build it at the exit instead
+        state.nextLevel = std::async(std::launch::deferred, buildLevel, state.nextLevelPlan);
+#else
+        state.nextLevel = std::async(std::launch::async, buildLevel, state.nextLevelPlan);
+#endif
+    }
+
+    // Endless world: once the player walks out of the window's middle chunk,
+    // move the window along and shift everything in play to match
+    void updateWorldStream(PlayState& state) {
+        int stepX, stepY;
+        if (!state.world->needsRecenter(state.player->getX(), state.player->getY(), stepX, stepY)) return;
+
+        Vec2 shift = state.world->recenter(stepX, stepY, state.zombies, state.zombieMaxHealth,
+                                           state.maxZombieCount, state.rng);
+        state.maze = state.world->buildWindow();
+        state.player->translate(shift.x, shift.y);
+
+        for (auto& bullet : state.bullets) {
+            bullet->translate(shift.x, shift.y);
+        }
+        state.flames.translate(shift.x, shift.y);
+
+        // Hunters chase the player, so any left outside the window are dropped
+        for (auto& hunter : state.hunters) {
+            hunter->translate(shift.x, shift.y);
+        }
+        state.hunters.erase(
+            std::remove_if(state.hunters.begin(), state.hunters.end(),
+                [](const auto& h) { return !WorldStream::inWindow(h->getX(), h->getY()); }),
+            state.hunters.end());
+
+        // Pickups left behind are dropped again somewhere in the new window
+        auto follow = [&state, shift](auto& pickup) {
+            float x = pickup->getX() + shift.x;
+            float y = pickup->getY() + shift.y;
+            if (!WorldStream::inWindow(x, y)) {
+                auto positions = state.maze->getRandomKeyPositions(1, state.rng);
+                if (!positions.empty()) {
+                    x = positions[0].x;
+                    y = positions[0].y;
+                }
+            }
+            pickup->translate(x - pickup->getX(), y - pickup->getY());
+        };
+        std::for_each(state.weaponPickups.begin(), state.weaponPickups.end(), follow);
+        std::for_each(state.healthBoosts.begin(), state.healthBoosts.end(), follow);
+
+        if (state.blueRoomX >= 0) {
+            state.blueRoomX -= stepX * WorldStream::CHUNK_SIZE;
+            state.blueRoomY -= stepY * WorldStream::CHUNK_SIZE;
+        }
+    }
+
+    void postEvent(PlayState& state, GameEventType type, float x = 0.0f, float y = 0.0f, int amount = 0, int detail = 0) {
+        state.events.push({type, x, y, amount, detail});
+    }
+
+    // Player was touched by a zombie or hunter this tick
+    void handlePlayerHit(PlayState& state, Uint32 now, bool byHunter) {
+        // In testing mode or with god mode, player is immortal
+        if (state.difficulty == Difficulty::TESTING || state.godMode) return;
+        if (!state.player->takeDamage()) return;
+
+        float px = state.player->getX();
+        float py = state.player->getY();
+        postEvent(state, GameEventType::PLAYER_DAMAGED, px, py, state.player->getHealth(), byHunter ? 1 : 0);
+
+        // Check if player died
+        if (state.player->isDead()) {
+            state.deathTime = now;
+
+            // Calculate survival time bonus
+            int timeSurvived = (now - state.gameStartTime) / 1000;
+            state.score += timeSurvived;
+            state.totalScore += state.score;
+
+            GameEvent died = {GameEventType::PLAYER_DIED, px, py, state.score, byHunter ? 1 : 0};
+            died.totalScore = state.totalScore;
+            died.level = state.currentLevel;
+            died.mazeType = static_cast<std::uint8_t>(state.mazeType);
+            died.difficulty = static_cast<std::uint8_t>(state.difficulty);
+            state.events.push(died);
+        }
+    }
+
+    // Score for a zombie or hunter that just died
+    void creditKill(PlayState& state, bool isHunter) {
+        if (isHunter) {
+            state.score += 500;  // Award MORE points for killing hunters (they're harder)
+        } else {
+            state.zombiesKilled++;
+            state.score += 100;  // 100 points per zombie kill
+        }
+    }
+
+    // Grenade blast: damage every zombie and hunter whose centre is inside the radius
+    void explode(PlayState& state, float explosionX, float explosionY, float explosionRadius, int baseDamage) {
+        int zombiesKilledInExplosion = 0;
+        int huntersKilledInExplosion = 0;
+
+        state.collisions.queryCircle(explosionX, explosionY, explosionRadius,
+            categoryBit(ColliderCategory::ZOMBIE) | categoryBit(ColliderCategory::HUNTER),
+            [&](ColliderCategory category, int index, float distanceSq) {
+                bool isHunter = (category == ColliderCategory::HUNTER);
+                Zombie& target = isHunter ? *state.hunters[index] : *state.zombies[index];
+                if (target.isDead()) return;
+
+                // Damage falls off with distance (full damage at center, 50% at edge)
+                float distance = std::sqrt(distanceSq);
+                float damageMult = 1.0f - (distance / explosionRadius) * 0.5f;
+                target.takeDamage(static_cast<int>(baseDamage * damageMult));
+
+                // Award points for kills
+                if (target.isDead()) {
+                    creditKill(state, isHunter);
+                    if (isHunter) {
+                        huntersKilledInExplosion++;
+                    } else {
+                        zombiesKilledInExplosion++;
+                    }
+                }
+            });
+
+        postEvent(state, GameEventType::EXPLOSION, explosionX, explosionY, zombiesKilledInExplosion, huntersKilledInExplosion);
+    }
+
+    // First live zombie or hunter along a bullet's sweep
+    void handleBulletContact(PlayState& state, const Contact& contact) {
+        Bullet& bullet = *state.bullets[contact.probeIndex];
+        if (!bullet.isActive()) return;  // Already spent on an earlier contact
+
+        bool isHunter = (contact.bodyCategory == ColliderCategory::HUNTER);
+        Zombie& target = isHunter ? *state.hunters[contact.bodyIndex] : *state.zombies[contact.bodyIndex];
+        if (target.isDead()) return;
+
+        bullet.deactivate();
+
+        if (bullet.isExplosive()) {
+            float explosionX = bullet.getPrevX() + (bullet.getX() - bullet.getPrevX()) * contact.t;
+            float explosionY = bullet.getPrevY() + (bullet.getY() - bullet.getPrevY()) * contact.t;
+            explode(state, explosionX, explosionY, bullet.getExplosionRadius(), bullet.getDamage());
+            return;
+        }
+
+        // Regular bullet: single target damage
+        target.takeDamage(bullet.getDamage());
+
+        // Award points only on death
+        if (target.isDead()) {
+            creditKill(state, isHunter);
+            postEvent(state, isHunter ? GameEventType::HUNTER_KILLED : GameEventType::ZOMBIE_KILLED, target.getX(), target.getY());
+        }
+    }
+
+    // Flamethrower: one cone query per damage tick instead of a bullet per puff.
+    // Uses the broadphase built by the collision phase.
+    void applyFlameDamage(PlayState& state) {
+        FlameSystem& flames = state.flames;
+        if (!flames.takeDamageTick()) return;
+
+        int damage = getWeaponStats(WeaponType::FLAMETHROWER).damage;
+        float originX = flames.getConeX();
+        float originY = flames.getConeY();
+        float dirX = std::cos(flames.getConeAngle());
+        float dirY = std::sin(flames.getConeAngle());
+        float cosHalfSq = std::cos(FlameSystem::CONE_HALF_ANGLE) * std::cos(FlameSystem::CONE_HALF_ANGLE);
+        auto isWall = [&state](int tileX, int tileY) { return state.maze->isWall(tileX, tileY); };
+
+        state.collisions.queryCircle(originX, originY, FlameSystem::RANGE,
+            categoryBit(ColliderCategory::ZOMBIE) | categoryBit(ColliderCategory::HUNTER),
+            [&](ColliderCategory category, int index, float distanceSq) {
+                bool isHunter = (category == ColliderCategory::HUNTER);
+                Zombie& target = isHunter ? *state.hunters[index] : *state.zombies[index];
+                if (target.isDead()) return;
+
+                // Inside the cone: angle to target within the half angle (no sqrt)
+                float dot = (target.getX() - originX) * dirX + (target.getY() - originY) * dirY;
+                if (dot <= 0.0f || dot * dot < distanceSq * cosHalfSq) return;
+
+                // Flames don't go through walls
+                if (traceGridSegment(originX, originY, target.getX(), target.getY(),
+                                     static_cast<float>(Maze::TILE_SIZE), isWall) >= 0.0f) return;
+
+                target.takeDamage(damage);
+                if (target.isDead()) {
+                    creditKill(state, isHunter);
+                    postEvent(state, isHunter ? GameEventType::HUNTER_KILLED : GameEventType::ZOMBIE_KILLED, target.getX(), target.getY());
+                }
+            });
+    }
+
+    // Player overlapping an enemy or a pickup
+    void handlePlayerContact(PlayState& state, const Contact& contact, Uint32 now,
+                             std::vector<std::unique_ptr<WeaponPickup>>& newWeaponsToSpawn) {
+        switch (contact.bodyCategory) {
+            case ColliderCategory::ZOMBIE:
+                if (!state.zombies[contact.bodyIndex]->isDead()) {
+                    handlePlayerHit(state, now, false);
+                }
+                break;
+
+            case ColliderCategory::HUNTER:
+                if (!state.hunters[contact.bodyIndex]->isDead()) {
+                    handlePlayerHit(state, now, true);
+                }
+                break;
+
+            case ColliderCategory::KEY: {
+                Key& key = *state.keys[contact.bodyIndex];
+                if (key.isCollected()) break;
+                key.collect();
+                rebuildKeyField(state);
+                state.player->addKey();
+                state.score += 250;  // 250 points per key
+                postEvent(state, GameEventType::KEY_COLLECTED, key.getX(), key.getY(),
+                          state.player->getKeys(), state.maze->getRequiredKeyCount());
+                break;
+            }
+
+            case ColliderCategory::WEAPON: {
+                WeaponPickup& weapon = *state.weaponPickups[contact.bodyIndex];
+                if (weapon.isCollected()) break;
+
+                WeaponType pickedWeapon = weapon.getType();
+                WeaponStats stats = getWeaponStats(pickedWeapon);
+
+                if (weapon.getIsAmmo()) {
+                    // This is an ammo pickup
+                    state.player->pickupAmmo(pickedWeapon, stats.ammoPerPickup);
+                    weapon.collect();
+                    postEvent(state, GameEventType::AMMO_PICKED_UP, weapon.getX(), weapon.getY(),
+                              stats.ammoPerPickup, static_cast<int>(pickedWeapon));
+                } else {
+                    // This is a weapon pickup
+                    state.player->pickupWeapon(pickedWeapon);
+                    weapon.collect();
+                    postEvent(state, GameEventType::WEAPON_PICKED_UP, weapon.getX(), weapon.getY(),
+                              stats.maxAmmo, static_cast<int>(pickedWeapon));
+                }
+
+                // Prepare a new random weapon pickup (spawned once dispatch is finished)
+                auto newPos = state.maze->getRandomKeyPositions(1, state.rng);
+                if (!newPos.empty()) {
+                    // Randomly choose a weapon type (exclude pistol which everyone starts with)
+                    WeaponType newWeaponType = static_cast<WeaponType>(state.rng.nextBelow(7));
+                    if (newWeaponType == WeaponType::PISTOL) {
+                        newWeaponType = WeaponType::SHOTGUN;  // Replace pistol with shotgun
+                    }
+                    newWeaponsToSpawn.push_back(
+                        std::make_unique<WeaponPickup>(newPos[0].x, newPos[0].y, newWeaponType, false)
+                    );
+                }
+                break;
+            }
+
+            case ColliderCategory::HEALTH: {
+                HealthBoost& healthBoost = *state.healthBoosts[contact.bodyIndex];
+                if (healthBoost.isCollected()) break;
+
+                bool healed = false;
+                // Heal player if not at max health
+                if (state.player->getHealth() < state.player->getMaxHealth()) {
+                    state.player->heal(1);
+                    healed = true;
+                }
+
+                // ALWAYS refill ammo for both weapon slots
+                for (int i = 0; i < 2; i++) {
+                    WeaponType weapon = state.player->getWeaponInSlot(i);
+                    WeaponStats stats = getWeaponStats(weapon);
+                    if (stats.maxAmmo > 0) {
+                        state.player->pickupAmmo(weapon, stats.maxAmmo);
+                    }
+                }
+
+                healthBoost.collect();
+                state.score += 50;  // 50 points for health boost
+                postEvent(state, GameEventType::HEALTH_COLLECTED, healthBoost.getX(), healthBoost.getY(),
+                          state.player->getHealth(), healed ? 1 : 0);
+
+                // Respawn at new random location (always maintain the same count in world)
+                auto newPos = state.maze->getRandomKeyPositions(1, state.rng);
+                if (!newPos.empty()) {
+                    healthBoost.respawn(newPos[0].x, newPos[0].y);
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    // Single collision stage per tick. Live enemies and pickups go into the grid
+    // broadphase, the player and every bullet sweep probe it, and the contacts
+    // are dispatched by category. Bullets must already have been moved; each one
+    // probes the path it covered in its last update.
+    void runCollisionPhase(PlayState& state, Uint32 now) {
+        CollisionWorld& world = state.collisions;
+        world.reset(static_cast<float>(state.maze->getWidth() * Maze::TILE_SIZE),
+                    static_cast<float>(state.maze->getHeight() * Maze::TILE_SIZE));
+
+        for (size_t i = 0; i < state.zombies.size(); i++) {
+            const Zombie& zombie = *state.zombies[i];
+            if (!zombie.isDead()) {
+                world.addBody(ColliderCategory::ZOMBIE, static_cast<int>(i), zombie.getX(), zombie.getY(), zombie.getRadius());
+            }
+        }
+        for (size_t i = 0; i < state.hunters.size(); i++) {
+            const Zombie& hunter = *state.hunters[i];
+            if (!hunter.isDead()) {
+                world.addBody(ColliderCategory::HUNTER, static_cast<int>(i), hunter.getX(), hunter.getY(), hunter.getRadius());
+            }
+        }
+        for (size_t i = 0; i < state.keys.size(); i++) {
+            const Key& key = *state.keys[i];
+            if (!key.isCollected()) {
+                world.addBody(ColliderCategory::KEY, static_cast<int>(i), key.getX(), key.getY(), key.getRadius());
+            }
+        }
+        for (size_t i = 0; i < state.weaponPickups.size(); i++) {
+            const WeaponPickup& weapon = *state.weaponPickups[i];
+            if (!weapon.isCollected()) {
+                world.addBody(ColliderCategory::WEAPON, static_cast<int>(i), weapon.getX(), weapon.getY(), weapon.getRadius());
+            }
+        }
+        for (size_t i = 0; i < state.healthBoosts.size(); i++) {
+            const HealthBoost& healthBoost = *state.healthBoosts[i];
+            if (!healthBoost.isCollected()) {
+                world.addBody(ColliderCategory::HEALTH, static_cast<int>(i), healthBoost.getX(), healthBoost.getY(), healthBoost.getRadius());
+            }
+        }
+        world.build();
+
+        // Probes: the player first (matches the old enemy-then-bullet order), then bullets
+        world.addProbe(ColliderCategory::PLAYER, 0, state.player->getX(), state.player->getY(), state.player->getRadius(),
+                       categoryBit(ColliderCategory::ZOMBIE) | categoryBit(ColliderCategory::HUNTER) |
+                       categoryBit(ColliderCategory::KEY) | categoryBit(ColliderCategory::WEAPON) |
+                       categoryBit(ColliderCategory::HEALTH));
+        for (size_t i = 0; i < state.bullets.size(); i++) {
+            const Bullet& bullet = *state.bullets[i];
+            if (!bullet.isActive()) continue;
+            world.addSweptProbe(ColliderCategory::BULLET, static_cast<int>(i),
+                                bullet.getPrevX(), bullet.getPrevY(), bullet.getX(), bullet.getY(), bullet.getRadius(),
+                                categoryBit(ColliderCategory::ZOMBIE) | categoryBit(ColliderCategory::HUNTER));
+        }
+
+        std::vector<std::unique_ptr<WeaponPickup>> newWeaponsToSpawn;
+        for (const Contact& contact : world.findContacts()) {
+            if (contact.probeCategory == ColliderCategory::BULLET) {
+                handleBulletContact(state, contact);
+            } else {
+                handlePlayerContact(state, contact, now, newWeaponsToSpawn);
+            }
+        }
+
+        applyFlameDamage(state);
+
+        // Bullets that reached a wall without hitting anyone stop there; grenades explode
+        for (auto& bullet : state.bullets) {
+            if (bullet->isActive() && bullet->hasHitWall()) {
+                bullet->deactivate();
+                if (bullet->isExplosive()) {
+                    explode(state, bullet->getX(), bullet->getY(), bullet->getExplosionRadius(), bullet->getDamage());
+                }
+            }
+        }
+
+        // Now safely add new weapons after dispatch is complete
+        for (auto& newWeapon : newWeaponsToSpawn) {
+            state.weaponPickups.push_back(std::move(newWeapon));
+        }
+    }
+}
+
+void initializeGame(PlayState& state, Uint32 now, Difficulty difficulty, MazeType mazeType, bool isLevelProgression) {
+    // Store maze type for infinite mode
+    state.mazeType = mazeType;
+
+    // If this is not a level progression, reset to level 1
+    if (!isLevelProgression) {
+        state.currentLevel = 1;
+    }
+
+    // Apply difficulty settings
+    applyDifficulty(state, difficulty);
+
+    // Scale difficulty for infinite mode levels > 7
+    if (mazeType == MazeType::INFINITE && state.currentLevel > 7) {
+        // Add 3 more zombies per level after 7
+        int bonusZombies = (state.currentLevel - 7) * 3;
+        state.initialZombieCount += bonusZombies;
+        state.maxZombieCount += bonusZombies;
+    }
+
+    if (!state.mazeFile.empty() && !state.bakedMaze) {
+        state.bakedMaze = Maze::load(state.mazeFile);
+        if (state.bakedMaze) {
+            std::cout << "Loaded maze " << state.mazeFile << " (" << state.bakedMaze->getWidth() << "x"
+                      << state.bakedMaze->getHeight() << ")" << std::endl;
+        } else {
+            std::cerr << "Falling back to generated mazes" << std::endl;
+            state.mazeFile.clear();
+        }
+    }
+
+    // Each maze in the session gets its own seed. Take the prefetched
+    // level if it was built from exactly this plan; otherwise (death,
+    // restart, difficulty change) retire it without waiting and build now.
+    LevelPlan plan = makeLevelPlan(state, difficulty, mazeType, state.currentLevel, state.mazesGenerated++);
+    PreparedLevel level;
+    bool endless = mazeType == MazeType::INFINITE && state.endlessWorld;
+    bool prefetched = !endless && state.nextLevel.valid() && state.nextLevelPlan == plan;
+    reapRetiredLevels(state);
+    if (!prefetched && state.nextLevel.valid()) {
+        state.retiredLevels.push_back(std::move(state.nextLevel));
+    }
+    if (endless) {
+        // One unbounded world per life, streamed in around the player
+        state.world = std::make_unique<WorldStream>(plan.mazeSeed);
+        level.plan = plan;
+        level.maze = state.world->buildWindow();
+        level.rng.reseed(Rng::mixSeed(plan.mazeSeed, 1));
+        populateLevel(level, false);
+        std::cout << "Endless world seed: " << plan.mazeSeed << std::endl;
+    } else if (prefetched) {
+        state.world.reset();
+        level = state.nextLevel.get();
+    } else {
+        state.world.reset();
+        level = buildLevel(plan);
+    }
+    if (!endless) {
+        std::cout << "Maze seed: " << level.maze->getSeed() << std::endl;
+    }
+    if (!state.saveMazePath.empty() && level.maze->save(state.saveMazePath)) {
+        std::cout << "Saved maze to " << state.saveMazePath << std::endl;
+        state.saveMazePath.clear();
+    }
+
+    state.maze = std::move(level.maze);
+    state.rng = level.rng;
+    state.effectsRng.reseed(Rng::mixSeed(plan.mazeSeed, 2));
+    state.zombies = std::move(level.zombies);
+    state.keys = std::move(level.keys);
+    rebuildKeyField(state);
+    state.weaponPickups = std::move(level.weaponPickups);
+    state.healthBoosts = std::move(level.healthBoosts);
+    state.totalZombiesSpawned = static_cast<int>(state.zombies.size());
+    state.spawnTimer = 0.0f;
+
+    // Reset player at start position
+    Vec2 startPos = level.startPos;
+    state.player = std::make_unique<Player>(startPos.x, startPos.y);
+
+    // SOLDIER MODE: Special initialization
+    if (mazeType == MazeType::SOLDIER) {
+        // Give player assault rifle with infinite ammo in slot 0
+        state.player->pickupWeapon(WeaponType::ASSAULT_RIFLE);
+        // Give infinite ammo (just a very large amount)
+        state.player->pickupAmmo(WeaponType::ASSAULT_RIFLE, 999999);
+
+        // Initialize wave system
+        state.currentWave = 1;
+        state.waveActive = false;
+        state.waveDelayTimer = state.waveDelay;  // Start first wave after delay
+    }
+    // TESTING MODE: Give player all weapons after creation
+    else if (difficulty == Difficulty::TESTING) {
+        // Give player ALL weapons - cycle through both slots
+        state.player->pickupWeapon(WeaponType::SHOTGUN);
+        state.player->switchWeapon();
+        state.player->pickupWeapon(WeaponType::ASSAULT_RIFLE);
+        state.player->switchWeapon();
+        state.player->pickupWeapon(WeaponType::SMG);
+        state.player->switchWeapon();
+        state.player->pickupWeapon(WeaponType::SNIPER);
+        state.player->switchWeapon();
+        state.player->pickupWeapon(WeaponType::GRENADE_LAUNCHER);
+        state.player->switchWeapon();
+        state.player->pickupWeapon(WeaponType::FLAMETHROWER);
+    }
+
+    // Clear bullets and flames
+    state.bullets.clear();
+    state.flames.clear();
+
+    // Reset game state
+    state.deathTime = 0;
+
+    // Reset current life score (keep totalScore)
+    state.score = 0;
+    state.zombiesKilled = 0;
+    state.gameStartTime = now;
+
+    // Get the next Infinite level going while this one is played
+    if (mazeType == MazeType::INFINITE && !endless) {
+        prefetchNextLevel(state, difficulty);
+    }
+}
+
+TickOutcome stepSimulation(PlayState& state, const TickInput& input, float deltaTime, Uint32 now) {
+    ProfileScope profile(state.profiler, ProfileStage::PLAYER);
+    if (!state.retiredLevels.empty()) {
+        reapRetiredLevels(state);
+    }
+
+    // Handle shooting/melee - use weapon's fire rate, not a hardcoded limit
+    if (input.firing) {
+        float time = static_cast<float>(now) / 1000.0f;
+        WeaponStats currentWeapon = getWeaponStats(state.player->getCurrentWeapon());
+
+        if (currentWeapon.isMelee) {
+            // MELEE ATTACK - check for zombies in range
+            // Check if enough time has passed since last attack
+            if (time - state.lastMeleeTime >= currentWeapon.fireRate) {
+                state.lastMeleeTime = time;
+
+                float playerX = state.player->getX();
+                float playerY = state.player->getY();
+                float angle = state.player->getAngle();
+
+                // Check zombies in front of player within melee range
+                for (auto& zombie : state.zombies) {
+                    if (!zombie->isDead()) {
+                        float dx = zombie->getX() - playerX;
+                        float dy = zombie->getY() - playerY;
+
+                        // Check if zombie is within melee range
+                        if (pointInCircle(zombie->getX(), zombie->getY(), playerX, playerY, currentWeapon.meleeRange)) {
+                            // Check if zombie is in front of player (within 60 degree cone)
+                            float angleToZombie = std::atan2(dy, dx);
+                            float angleDiff = angleToZombie - angle;
+                            // Normalize angle diff
+                            while (angleDiff > M_PI) angleDiff -= 2.0f * M_PI;
+                            while (angleDiff < -M_PI) angleDiff += 2.0f * M_PI;
+
+                            if (std::abs(angleDiff) < M_PI / 6.0f) {  // 60 degree cone
+                                zombie->takeDamage(currentWeapon.damage);
+                                postEvent(state, GameEventType::MELEE_HIT, zombie->getX(), zombie->getY(), currentWeapon.damage);
+                                break;  // Only hit one zombie per swing
+                            }
+                        }
+                    }
+                }
+            }
+        } else {
+            // RANGED ATTACK - shoot bullets
+            float angle = state.player->getAngle();
+            float pitch = state.player->getPitch();
+
+            // Adjust bullet range based on pitch
+            // Looking up = shoot further, looking down = shoot closer
+            // This simulates aiming at where the crosshair intersects the ground
+            float baseRange = 1000.0f;
+            float pitchFactor = 1.0f + pitch;  // pitch is -PI/3 to PI/3, so factor is ~0.0 to 2.0
+            pitchFactor = std::max(0.3f, std::min(3.0f, pitchFactor));  // Clamp to reasonable range
+            float adjustedRange = baseRange * pitchFactor;
+
+            float targetX = state.player->getX() + std::cos(angle) * adjustedRange;
+            float targetY = state.player->getY() + std::sin(angle) * adjustedRange;
+
+            bool shotFired = state.player->shoot(targetX, targetY, state.bullets, time);
+
+            if (shotFired && state.player->getCurrentWeapon() == WeaponType::FLAMETHROWER) {
+                // Flamethrower sprays particles; damage comes from the flame cone
+                state.flames.emit(state.player->getX(), state.player->getY(), angle, state.effectsRng);
+                postEvent(state, GameEventType::FLAME_FIRED, state.player->getX(), state.player->getY());
+            } else if (shotFired) {
+                postEvent(state, GameEventType::SHOT_FIRED, state.player->getX(), state.player->getY(),
+                          0, static_cast<int>(state.player->getCurrentWeapon()));
+            }
+        }
+    }
+
+    // Update player
+    state.player->handleInput(input.keyState);
+    state.player->update(deltaTime, *state.maze);
+    if (state.world) {
+        updateWorldStream(state);
+    }
+
+    profile.next(ProfileStage::SPAWNING);
+
+    // Testing mode: infinite ammo for all weapons
+    if (state.difficulty == Difficulty::TESTING) {
+        for (int i = 0; i < 2; i++) {
+            WeaponStats stats = getWeaponStats(state.player->getWeaponInSlot(i));
+            if (stats.maxAmmo > 0) {
+                state.player->pickupAmmo(state.player->getWeaponInSlot(i), stats.maxAmmo);
+            }
+        }
+    }
+
+    // Soldier mode: infinite ammo for assault rifle
+    if (state.mazeType == MazeType::SOLDIER) {
+        state.player->pickupAmmo(WeaponType::ASSAULT_RIFLE, 999999);
+    }
+
+    // SOLDIER MODE: Wave-based spawning system
+    if (state.mazeType == MazeType::SOLDIER) {
+        // Count alive zombies
+        int aliveZombies = 0;
+        for (const auto& zombie : state.zombies) {
+            if (!zombie->isDead()) {
+                aliveZombies++;
+            }
+        }
+
+        // If wave is complete (all zombies dead), start delay for next wave
+        if (state.waveActive && aliveZombies == 0) {
+            state.waveActive = false;
+            state.waveDelayTimer = state.waveDelay;
+            state.currentWave++;
+            std::cout << "Wave " << (state.currentWave - 1) << " complete! Next wave in " << state.waveDelay << " seconds..." << std::endl;
+        }
+
+        // Update wave delay timer
+        if (!state.waveActive) {
+            state.waveDelayTimer -= deltaTime;
+            if (state.waveDelayTimer <= 0.0f) {
+                // Start new wave!
+                state.waveActive = true;
+                state.zombies.clear();  // Clear any dead zombies
+
+                // Calculate zombies for this wave (increases each wave)
+                int baseZombies = 5;  // Start with 5 zombies per spawn point
+                int zombiesPerSpawn = baseZombies + (state.currentWave - 1) * 2;  // +2 per wave
+
+                // Spawn zombies in the 4 corner maze areas (not in walls!)
+                int mazeWidth = state.maze->getWidth();
+                int mazeHeight = state.maze->getHeight();
+                int arenaLeft = mazeWidth / 4;
+                int arenaRight = 3 * mazeWidth / 4;
+                int arenaTop = mazeHeight / 4;
+                int arenaBottom = 3 * mazeHeight / 4;
+
+                // Define spawn areas in each corner maze (middle of each corner maze)
+                std::vector<Vec2> spawnAreas;
+
+                // Top-left corner maze center
+                int tlX = (2 + arenaLeft - 1) / 2;
+                int tlY = (2 + arenaTop - 1) / 2;
+                spawnAreas.push_back({tlX * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f,
+                                     tlY * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f});
+
+                // Top-right corner maze center
+                int trX = (arenaRight + 2 + mazeWidth - 2) / 2;
+                int trY = (2 + arenaTop - 1) / 2;
+                spawnAreas.push_back({trX * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f,
+                                     trY * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f});
+
+                // Bottom-left corner maze center
+                int blX = (2 + arenaLeft - 1) / 2;
+                int blY = (arenaBottom + 2 + mazeHeight - 2) / 2;
+                spawnAreas.push_back({blX * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f,
+                                     blY * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f});
+
+                // Bottom-right corner maze center
+                int brX = (arenaRight + 2 + mazeWidth - 2) / 2;
+                int brY = (arenaBottom + 2 + mazeHeight - 2) / 2;
+                spawnAreas.push_back({brX * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f,
+                                     brY * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f});
+
+                // Spawn zombies at each spawn area with wider spread
+                for (const auto& spawnArea : spawnAreas) {
+                    for (int i = 0; i < zombiesPerSpawn; i++) {
+                        // Larger random offset within the spawn area (to spread out zombies)
+                        float offsetX = state.rng.nextBelow(120) - 60;
+                        float offsetY = state.rng.nextBelow(120) - 60;
+
+                        // Make sure spawn position is not in a wall
+                        float spawnX = spawnArea.x + offsetX;
+                        float spawnY = spawnArea.y + offsetY;
+                        int tileX = static_cast<int>(spawnX / Maze::TILE_SIZE);
+                        int tileY = static_cast<int>(spawnY / Maze::TILE_SIZE);
+
+                        // If spawning in wall, try center of spawn area instead
+                        if (state.maze->isWall(tileX, tileY)) {
+                            spawnX = spawnArea.x;
+                            spawnY = spawnArea.y;
+                        }
+
+                        ZombieType type = getRandomZombieType(state.rng);
+                        state.zombies.push_back(
+                            std::make_unique<Zombie>(spawnX, spawnY, state.zombieMaxHealth, type, state.rng.nextU64())
+                        );
+                    }
+                }
+
+                int totalSpawned = spawnAreas.size() * zombiesPerSpawn;
+                std::cout << "WAVE " << state.currentWave << " STARTING! " << totalSpawned << " zombies incoming!" << std::endl;
+            }
+        }
+    }
+
+    // === BLOOD MOON EVENT SYSTEM ===
+    state.bloodMoonTimer += deltaTime;
+
+    // Check if Blood Moon should start
+    if (!state.bloodMoonActive && state.bloodMoonTimer >= state.bloodMoonInterval) {
+        state.bloodMoonActive = true;
+        state.bloodMoonTimer = 0.0f;
+        std::cout << "\n=== BLOOD MOON RISING! ===\n" << std::endl;
+        std::cout << "The zombies grow restless..." << std::endl;
+    }
+
+    // Check if Blood Moon should end
+    if (state.bloodMoonActive && state.bloodMoonTimer >= state.bloodMoonDuration) {
+        state.bloodMoonActive = false;
+        state.bloodMoonTimer = 0.0f;
+
+        // Kill half of all zombies when Blood Moon ends
+        int zombiesBeforeCull = 0;
+        int zombiesKilled = 0;
+
+        for (auto& zombie : state.zombies) {
+            if (!zombie->isDead()) {
+                zombiesBeforeCull++;
+                // 50% chance to kill each zombie
+                if (state.rng.nextBelow(2) == 0) {
+                    zombie->takeDamage(999);  // Instant kill
+                    zombiesKilled++;
+                }
+            }
+        }
+
+        std::cout << "\n=== BLOOD MOON FADES ===\n" << std::endl;
+        std::cout << zombiesKilled << " / " << zombiesBeforeCull << " zombies succumb to exhaustion!" << std::endl;
+
+        if (zombiesKilled > 0) {
+            postEvent(state, GameEventType::ZOMBIE_KILLED);
+        }
+    }
+
+    // === BLUE ALERT EVENT SYSTEM (Evacuation) ===
+    // Separate timer from blood moon
+    if (!state.blueAlertActive && !state.hunterPhaseActive) {
+        state.blueEventTimer += deltaTime;
+
+        // Debug: show timer every 30 seconds
+        state.blueEventLogTimer += deltaTime;
+        if (state.blueEventLogTimer >= 30.0f) {
+            std::cout << "[DEBUG] Blue event timer: " << state.blueEventTimer << " / " << state.blueAlertInterval << " seconds" << std::endl;
+            state.blueEventLogTimer = 0.0f;
+        }
+
+        // Trigger blue alert every 3 minutes
+        if (state.blueEventTimer >= state.blueAlertInterval) {
+            state.blueAlertActive = true;
+            state.blueAlertTimer = 0.0f;
+            state.blueEventTimer = 0.0f;  // Reset for next cycle
+            state.safeRoomLocked = false;  // Unlock the room for evacuation
+
+            // Store safe room coordinates
+            Vec2 safePos = state.maze->getSafeRoomPos();
+            state.blueRoomX = (int)(safePos.x / Maze::TILE_SIZE);
+            state.blueRoomY = (int)(safePos.y / Maze::TILE_SIZE);
+
+            // KILL ALL ZOMBIES when blue alert starts
+            int zombiesKilled = 0;
+            for (auto& zombie : state.zombies) {
+                if (!zombie->isDead()) {
+                    while (!zombie->isDead()) {
+                        zombie->takeDamage();
+                    }
+                    zombiesKilled++;
+                }
+            }
+
+            std::cout << "\n=== BLUE ALERT! EVACUATE TO SAFE ROOM! ===\n" << std::endl;
+            std::cout << "All " << zombiesKilled << " zombies eliminated by evacuation protocol!" << std::endl;
+            std::cout << "You have 45 seconds to reach the blue room!" << std::endl;
+        }
+    }
+
+    // During blue alert
+    if (state.blueAlertActive) {
+        state.blueAlertTimer += deltaTime;
+
+        // Check if player is in safe room
+        int playerTileX = (int)(state.player->getX() / Maze::TILE_SIZE);
+        int playerTileY = (int)(state.player->getY() / Maze::TILE_SIZE);
+        state.inSafeRoom = state.maze->isSafeRoom(playerTileX, playerTileY);
+
+        // Timer expired - check if player made it
+        if (state.blueAlertTimer >= state.blueAlertDuration) {
+            // LOCK THE SAFE ROOM after timer expires
+            state.safeRoomLocked = true;
+            std::cout << "\n=== SAFE ROOM SEALED! ===\n" << std::endl;
+
+            if (!state.inSafeRoom && state.difficulty != Difficulty::TESTING && !state.godMode) {
+                // START HUNTER PHASE instead of instant death!
+                state.hunterPhaseActive = true;
+                state.hunterPhaseTimer = 0.0f;
+
+                // Spawn 3-5 fast hunters around the player
+                int numHunters = 3 + state.rng.nextBelow(3);  // 3-5 hunters
+                for (int i = 0; i < numHunters; i++) {
+                    float angle = (float)i * (M_PI * 2.0f / numHunters);
+                    float spawnDist = 200.0f + state.rng.nextBelow(100);  // 200-300 units away
+                    float spawnX = state.player->getX() + cos(angle) * spawnDist;
+                    float spawnY = state.player->getY() + sin(angle) * spawnDist;
+
+                    // Make sure not spawning in wall
+                    int tileX = (int)(spawnX / Maze::TILE_SIZE);
+                    int tileY = (int)(spawnY / Maze::TILE_SIZE);
+                    if (!state.maze->isWall(tileX, tileY)) {
+                        state.hunters.push_back(std::make_unique<Zombie>(spawnX, spawnY, 999, ZombieType::NORMAL, state.rng.nextU64()));
+                    }
+                }
+
+                std::cout << "=== FAILED TO EVACUATE! ===\n" << std::endl;
+                std::cout << "=== HUNTER PHASE ACTIVATED! ===\n" << std::endl;
+                std::cout << numHunters << " dark hunters have been unleashed!" << std::endl;
+                std::cout << "Survive for 60 seconds!" << std::endl;
+            } else if (state.inSafeRoom) {
+                std::cout << "=== EVACUATION SUCCESSFUL! ===\n" << std::endl;
+                std::cout << "You survived the blue alert! The room is now sealed." << std::endl;
+            }
+
+            // End the alert
+            state.blueAlertActive = false;
+            state.blueAlertTimer = 0.0f;
+        }
+    }
+
+    // HUNTER PHASE - 60 seconds of terror!
+    if (state.hunterPhaseActive) {
+        state.hunterPhaseTimer += deltaTime;
+
+        // Check if hunter phase is over
+        if (state.hunterPhaseTimer >= state.hunterPhaseDuration) {
+            // Kill all hunters
+            for (auto& hunter : state.hunters) {
+                if (!hunter->isDead()) {
+                    while (!hunter->isDead()) {
+                        hunter->takeDamage();
+                    }
+                }
+            }
+            state.hunters.clear();
+
+            state.hunterPhaseActive = false;
+            state.hunterPhaseTimer = 0.0f;
+
+            std::cout << "\n=== HUNTER PHASE ENDED! ===\n" << std::endl;
+            std::cout << "You survived! The hunters have retreated." << std::endl;
+        }
+    }
+
+    // Zombie spawning system - spawn reinforcements when zombies are low (SKIP for Soldier mode)
+    if (state.mazeType != MazeType::SOLDIER) {
+        state.spawnTimer += deltaTime;
+        if (state.spawnTimer >= SPAWN_CHECK_INTERVAL) {
+            state.spawnTimer = 0.0f;
+
+            // Count alive zombies
+        int aliveZombies = 0;
+        for (const auto& zombie : state.zombies) {
+            if (!zombie->isDead()) {
+                aliveZombies++;
+            }
+        }
+
+        // Check if all zombies are dead - spawn new wave
+        if (aliveZombies == 0) {
+            std::cout << "All zombies eliminated! Spawning new wave..." << std::endl;
+
+            // Clear dead zombies from the list
+            state.zombies.clear();
+
+            // Spawn a fresh wave (reset spawn counter)
+            state.totalZombiesSpawned = 0;
+            int waveSize = state.initialZombieCount;
+
+            // Get spawn positions
+            Vec2 playerPos = {state.player->getX(), state.player->getY()};
+            auto zombiePositions = state.maze->getRandomZombiePositions(waveSize, playerPos, state.rng);
+
+            for (const auto& pos : zombiePositions) {
+                ZombieType type = getRandomZombieType(state.rng);
+                state.zombies.push_back(std::make_unique<Zombie>(pos.x, pos.y, state.zombieMaxHealth, type, state.rng.nextU64()));
+            }
+            state.totalZombiesSpawned = waveSize;
+
+            std::cout << "New wave spawned! (" << waveSize << " zombies)" << std::endl;
+        }
+        // Spawn new zombies if below minimum and haven't hit max
+        else if (aliveZombies < state.minZombieCount && state.totalZombiesSpawned < state.maxZombieCount) {
+            int baseSpawn = 3;  // Base: Spawn 3 at a time
+
+            // During Blood Moon, spawn 3x more!
+            if (state.bloodMoonActive) {
+                baseSpawn = static_cast<int>(baseSpawn * state.bloodMoonSpawnMultiplier);
+            }
+
+            int toSpawn = std::min(baseSpawn, state.maxZombieCount - state.totalZombiesSpawned);
+
+            // Collect existing zombie positions
+            std::vector<Vec2> existingPositions;
+            for (const auto& zombie : state.zombies) {
+                if (!zombie->isDead()) {
+                    existingPositions.push_back({zombie->getX(), zombie->getY()});
+                }
+            }
+
+            // Spawn new zombies in areas with fewer zombies
+            for (int i = 0; i < toSpawn; i++) {
+                Vec2 spawnPos = state.maze->getSpawnPositionAwayFromZombies(
+                    existingPositions,
+                    {state.player->getX(), state.player->getY()},
+                    state.rng
+                );
+                ZombieType type = getRandomZombieType(state.rng);
+                state.zombies.push_back(std::make_unique<Zombie>(spawnPos.x, spawnPos.y, state.zombieMaxHealth, type, state.rng.nextU64()));
+                existingPositions.push_back(spawnPos);  // Add to list for next spawn
+                state.totalZombiesSpawned++;
+            }
+
+            std::cout << "Zombie reinforcements spawned! (" << toSpawn << " zombies)" << std::endl;
+        }
+    }
+    }  // End of non-Soldier spawning
+
+    profile.next(ProfileStage::ZOMBIES);
+
+    // Update zombies
+    for (auto& zombie : state.zombies) {
+        zombie->update(deltaTime, state.player->getX(), state.player->getY(), *state.maze, &state.zombies);
+
+        // FREQUENTLY play CREEPY zombie groans/moans (much more common now!)
+        if (!zombie->isDead() && state.effectsRng.nextBelow(150) == 0) {  // ~0.67% chance per frame = MUCH more frequent!
+            // Play if zombie is within hearing range (800 units = further!)
+            float distanceSq = distanceSquared(zombie->getX(), zombie->getY(), state.player->getX(), state.player->getY());
+            if (distanceSq < 800.0f * 800.0f) {
+                // Distance to player for volume adjustment
+                float distance = std::sqrt(distanceSq);
+
+                // Choose random sound and adjust volume based on distance
+                // Closer zombies are MUCH louder
+                float volumeFactor = (1.0f - distance / 800.0f);
+                int volume = static_cast<int>(MAX_EVENT_VOLUME * volumeFactor * 1.2f);  // Louder!
+                if (volume > MAX_EVENT_VOLUME) volume = MAX_EVENT_VOLUME;
+
+                postEvent(state, GameEventType::ZOMBIE_GROAN, zombie->getX(), zombie->getY(), volume, state.effectsRng.nextBelow(2));
+            }
+        }
+    }
+
+    // Update hunters (fast, dark entities)
+    for (auto& hunter : state.hunters) {
+        // Store previous position in case hunter tries to enter safe room
+        float prevX = hunter->getX();
+        float prevY = hunter->getY();
+
+        // Hunters move faster than zombies - pass the hunter vector instead of zombie vector
+        hunter->update(deltaTime, state.player->getX(), state.player->getY(), *state.maze, &state.hunters);
+
+        // PREVENT HUNTERS FROM ENTERING BLUE SAFE ROOM
+        int hunterTileX = (int)(hunter->getX() / Maze::TILE_SIZE);
+        int hunterTileY = (int)(hunter->getY() / Maze::TILE_SIZE);
+        if (state.maze->isSafeRoom(hunterTileX, hunterTileY)) {
+            // Hunter tried to enter safe room - push them back!
+            hunter->setPosition(prevX, prevY);
+        }
+
+        // Hunters make scary breathing sounds (no groans)
+        if (!hunter->isDead() && state.effectsRng.nextBelow(200) == 0) {  // Less frequent than zombies
+            float distanceSq = distanceSquared(hunter->getX(), hunter->getY(), state.player->getX(), state.player->getY());
+            if (distanceSq < 600.0f * 600.0f) {
+                float distance = std::sqrt(distanceSq);
+
+                // Play scary sound (using zombie sound for now, but quieter/different)
+                float volumeFactor = (1.0f - distance / 600.0f);
+                int volume = static_cast<int>(MAX_EVENT_VOLUME * volumeFactor * 0.5f);  // Quieter
+                if (volume > MAX_EVENT_VOLUME) volume = MAX_EVENT_VOLUME;
+
+                postEvent(state, GameEventType::HUNTER_BREATH, hunter->getX(), hunter->getY(), volume);
+            }
+        }
+    }
+
+    // Proximity beep system - beep faster as closest zombie gets nearer
+    state.proximityBeepTimer += deltaTime;
+
+    // Find closest alive zombie (compare squared, take one root at the end)
+    float closestDistanceSq = 99999.0f * 99999.0f;
+    for (const auto& zombie : state.zombies) {
+        if (!zombie->isDead()) {
+            float distanceSq = distanceSquared(zombie->getX(), zombie->getY(), state.player->getX(), state.player->getY());
+            if (distanceSq < closestDistanceSq) {
+                closestDistanceSq = distanceSq;
+            }
+        }
+    }
+    float closestDistance = std::sqrt(closestDistanceSq);
+
+    // Calculate beep interval based on distance (closer = faster beeps)
+    // Very close (< 100): 0.2s, Close (< 200): 0.5s, Medium (< 400): 1.0s, Far (< 600): 2.0s, Very far: 3.0s
+    if (closestDistance < 100.0f) {
+        state.proximityBeepInterval = 0.2f;
+    } else if (closestDistance < 200.0f) {
+        state.proximityBeepInterval = 0.5f;
+    } else if (closestDistance < 400.0f) {
+        state.proximityBeepInterval = 1.0f;
+    } else if (closestDistance < 600.0f) {
+        state.proximityBeepInterval = 2.0f;
+    } else {
+        state.proximityBeepInterval = 3.0f;
+    }
+
+    // Play beep if timer exceeds interval
+    if (state.proximityBeepTimer >= state.proximityBeepInterval && closestDistance < 600.0f) {
+        state.proximityBeepTimer = 0.0f;
+        // Adjust volume based on distance (closer = louder)
+        int volume = static_cast<int>(MAX_EVENT_VOLUME * 0.3f * (1.0f - closestDistance / 600.0f));
+        postEvent(state, GameEventType::PROXIMITY_BEEP, 0.0f, 0.0f, volume);
+    }
+
+    profile.next(ProfileStage::BULLETS);
+
+    // Bullets move in their own finer sub-steps so fast rounds can't skip walls
+    for (auto& bullet : state.bullets) {
+        bullet->update(deltaTime, *state.maze);
+    }
+
+    state.flames.update(deltaTime, *state.maze);
+
+    // Bullet hits, explosions, flame damage, enemy contact and pickups
+    profile.next(ProfileStage::COLLISIONS);
+    runCollisionPhase(state, now);
+    bool playerDied = state.player->isDead();
+
+    // Remove inactive bullets
+    state.bullets.erase(
+        std::remove_if(state.bullets.begin(), state.bullets.end(),
+            [](const auto& b) { return !b->isActive(); }),
+        state.bullets.end()
+    );
+
+    // Check if current weapon is out of ammo - convert all matching pickups to ammo
+    if (state.player->isOutOfAmmo()) {
+        WeaponType currentWeapon = state.player->getCurrentWeapon();
+        bool converted = false;
+        for (auto& weapon : state.weaponPickups) {
+            if (!weapon->isCollected() && weapon->getType() == currentWeapon && !weapon->getIsAmmo()) {
+                weapon->convertToAmmo();
+                converted = true;
+            }
+        }
+        if (converted) {
+            WeaponStats stats = getWeaponStats(currentWeapon);
+            std::cout << "Out of ammo! All " << stats.name << " pickups converted to ammo!" << std::endl;
+        }
+    }
+
+    // Check if player reached exit with all keys
+    int exitX = static_cast<int>(state.player->getX() / Maze::TILE_SIZE);
+    int exitY = static_cast<int>(state.player->getY() / Maze::TILE_SIZE);
+    int requiredKeys = state.maze->getRequiredKeyCount(state.currentLevel);
+
+    // ALWAYS require keys to exit - no exceptions for any difficulty!
+    bool hasAllKeys = (state.player->getKeys() >= requiredKeys);
+    bool isOnExit = state.maze->isExit(exitX, exitY);
+
+    // Warn player if they're at exit but don't have all keys
+    if (isOnExit && !hasAllKeys) {
+        if (now - state.lastExitWarningTime > 2000) {  // Show warning every 2 seconds
+            int keysNeeded = requiredKeys - state.player->getKeys();
+            std::cout << "EXIT LOCKED! Need " << keysNeeded << " more key(s) to escape! ("
+                      << state.player->getKeys() << "/" << requiredKeys << ")" << std::endl;
+            state.lastExitWarningTime = now;
+        }
+    }
+
+    if (isOnExit && hasAllKeys) {
+        // Bonus points for completing level
+        state.score += 500;
+
+        // Time bonus (1 point per second)
+        int timeSurvived = (now - state.gameStartTime) / 1000;
+        state.score += timeSurvived;
+
+        state.totalScore += state.score;
+
+        // Check if infinite mode - if so, regenerate and continue
+        if (state.mazeType == MazeType::INFINITE) {
+            state.currentLevel++;
+            std::cout << "Level " << (state.currentLevel - 1) << " Complete! " << std::endl;
+            std::cout << "Score: " << state.score << " | Total: " << state.totalScore << std::endl;
+            std::cout << "Starting Level " << state.currentLevel << "..." << std::endl;
+
+            // Save player health and weapons before regenerating
+            int playerHealth = state.player->getHealth();
+            WeaponType weapon0 = state.player->getWeaponInSlot(0);
+            WeaponType weapon1 = state.player->getWeaponInSlot(1);
+            int ammo0 = state.player->getAmmoInSlot(0);
+            int ammo1 = state.player->getAmmoInSlot(1);
+            int weaponSlot = state.player->getCurrentWeaponSlot();
+
+            // Regenerate the maze (passing true for isLevelProgression)
+            initializeGame(state, now, state.difficulty, state.mazeType, true);
+
+            // Restore player state
+            for (int i = 0; i < playerHealth; i++) {
+                state.player->heal(1);
+            }
+            // Restore weapons (this is a bit hacky but works)
+            if (weapon0 != WeaponType::SHOTGUN || weapon1 != WeaponType::SHOTGUN) {
+                state.player->pickupWeapon(weapon0);
+                state.player->switchWeapon();
+                state.player->pickupWeapon(weapon1);
+                if (weaponSlot == 0) {
+                    state.player->switchWeapon();
+                }
+            }
+            // Note: ammo restoration would require more complex logic, skipping for now
+        } else {
+            // Regular game modes end here; the caller shows the win screen
+            return TickOutcome::LEVEL_WON;
+        }
+    }
+
+    return playerDied ? TickOutcome::PLAYER_DIED : TickOutcome::PLAYING;
+}
@@ -0,0 +1,235 @@
+#ifndef ZOMBIE_SIMULATION_H
+#define ZOMBIE_SIMULATION_H
+
+#include <SDL.h>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include "bullet.h"
+#include "collision.h"
+#include "distance_field.h"
+#include "events.h"
+#include "flame.h"
+#include "healthboost.h"
+#include "key.h"
+#include "maze.h"
+#include "player.h"
+#include "profiler.h"
+#include "rng.h"
+#include "weapon.h"
+#include "world_stream.h"
+#include "zombie.h"
+
+// The game world and its per-tick update, with no window, renderer or audio.
+// Game::run drives it from SDL input and draws the result; headless tools
+// drive it directly. Only SDL types (Uint8, Uint32) are used here, so the
+// simulation links without initialising any SDL subsystem.
+
+enum class Difficulty {
+    EASY,
+    NORMAL,
+    HARD,
+    TESTING
+};
+
+// Everything needed to build a level, fixed before generation starts so
+// the same plan always yields the same level on any thread
+struct LevelPlan {
+    MazeType mazeType = MazeType::STANDARD;
+    int level = 1;
+    int mazeWidth = Maze::DEFAULT_WIDTH;
+    int mazeHeight = Maze::DEFAULT_HEIGHT;
+    std::uint64_t mazeSeed = 0;
+    int initialZombieCount = 0;
+    int zombieMaxHealth = 0;
+    std::shared_ptr<const Maze> bakedMaze;  // Loaded layout to use instead of generating
+
+    bool operator==(const LevelPlan& other) const {
+        return mazeType == other.mazeType && level == other.level && bakedMaze == other.bakedMaze &&
+               mazeWidth == other.mazeWidth && mazeHeight == other.mazeHeight &&
+               mazeSeed == other.mazeSeed && initialZombieCount == other.initialZombieCount &&
+               zombieMaxHealth == other.zombieMaxHealth;
+    }
+};
+
+// A generated level waiting to be moved into PlayState. Built without
+// touching PlayState or SDL, so it can be made on a worker thread.
+struct PreparedLevel {
+    LevelPlan plan;
+    std::unique_ptr<Maze> maze;
+    Vec2 startPos = {0.0f, 0.0f};
+    std::vector<std::unique_ptr<Zombie>> zombies;
+    std::vector<std::unique_ptr<Key>> keys;
+    std::vector<std::unique_ptr<WeaponPickup>> weaponPickups;
+    std::vector<std::unique_ptr<HealthBoost>> healthBoosts;
+    Rng rng;  // Gameplay RNG after the level's spawn rolls
+};
+
+struct PlayState {
+    std::unique_ptr<Maze> maze;
+    std::unique_ptr<Player> player;
+    std::vector<std::unique_ptr<Zombie>> zombies;
+    std::vector<std::unique_ptr<Key>> keys;
+    std::vector<std::unique_ptr<Bullet>> bullets;
+    std::vector<std::unique_ptr<WeaponPickup>> weaponPickups;
+    std::vector<std::unique_ptr<HealthBoost>> healthBoosts;
+    Uint32 deathTime = 0;
+
+    // Score tracking
+    int score = 0;
+    int zombiesKilled = 0;
+    int totalScore = 0;  // Persistent score across respawns
+    Uint32 gameStartTime = 0;
+
+    // Attack and warning cadence (seconds / milliseconds of the tick clock)
+    float lastMeleeTime = 0.0f;
+    Uint32 lastExitWarningTime = 0;
+
+    // Zombie spawning
+    float spawnTimer = 0.0f;
+    int totalZombiesSpawned = 0;
+    int initialZombieCount = 15;
+    int minZombieCount = 8;
+    int maxZombieCount = 25;
+    int zombieMaxHealth = 3;  // Health per zombie based on difficulty
+
+    // Screen shake (presentation only; Game::run sets and decays it)
+    float screenShake = 0.0f;
+    float shakeOffsetX = 0.0f;
+    float shakeOffsetY = 0.0f;
+
+    // How far real time has run past the last tick, in ticks (0..1). The view
+    // draws moving entities this far from their previous to current position.
+    float renderAlpha = 1.0f;
+
+    // Proximity beep system
+    float proximityBeepTimer = 0.0f;
+    float proximityBeepInterval = 2.0f;  // Start at 2 seconds
+
+    // HUD toggles
+    bool showScore = true;
+    bool showMinimap = true;
+    bool showArrow = true;
+    bool showProfiler = false;  // F3 stage timings overlay
+
+    // Infinite mode tracking
+    int currentLevel = 1;  // Track which level/wave the player is on
+    MazeType mazeType = MazeType::STANDARD;  // Track the current maze type
+
+    // Maze size in tiles for every maze this session builds (--maze-size)
+    int mazeWidth = Maze::DEFAULT_WIDTH;
+    int mazeHeight = Maze::DEFAULT_HEIGHT;
+
+    // Deterministic randomness: every maze and its spawns derive from the
+    // session seed (--seed), and all gameplay rolls draw from rng
+    std::uint64_t sessionSeed = Rng::DEFAULT_SEED;
+    std::uint64_t mazesGenerated = 0;
+    Rng rng;
+    // Cosmetic rolls (groans, flame jitter), reseeded with each level so
+    // they repeat with the seed but never shift gameplay draws
+    Rng effectsRng;
+
+    // Pre-baked layout (--maze-file), loaded on first use and then reused
+    // for every level; --save-maze writes out the next generated maze
+    std::string mazeFile;
+    std::shared_ptr<const Maze> bakedMaze;
+    std::string saveMazePath;
+
+    // Endless Infinite mode (--endless): the maze is a window onto world
+    bool endlessWorld = false;
+    std::unique_ptr<WorldStream> world;
+
+    // Infinite mode builds level N+1 in the background while N is played
+    std::future<PreparedLevel> nextLevel;
+    LevelPlan nextLevelPlan;
+    // Prefetches made stale by a death, restart or difficulty change. Left
+    // to finish on their worker (destroying a running std::async future
+    // would block) and dropped once ready.
+    std::vector<std::future<PreparedLevel>> retiredLevels;
+
+    // Soldier mode wave tracking
+    int currentWave = 1;
+    bool waveActive = false;
+    float waveDelayTimer = 0.0f;
+    float waveDelay = 5.0f;  // 5 seconds between waves
+
+    // Difficulty tracking (for testing mode checks)
+    Difficulty difficulty = Difficulty::NORMAL;
+
+    // Testing/Debug panel (F1 to toggle, only works in TESTING mode)
+    bool showTestingPanel = false;
+    bool godMode = false;  // Immortality
+    int selectedWeaponSpawn = 0;  // For weapon spawning dropdown
+    int selectedZombieType = 0;  // For zombie spawning
+    bool spawnAtCrosshair = false;  // If true, spawn at crosshair; if false, spawn at player
+
+    // Blood Moon event (happens every 2 minutes for 30 seconds)
+    float bloodMoonTimer = 0.0f;
+    bool bloodMoonActive = false;
+    float bloodMoonDuration = 30.0f;  // 30 seconds of blood moon
+    float bloodMoonInterval = 120.0f;  // Every 2 minutes (120 seconds)
+    float bloodMoonSpawnMultiplier = 8.0f;  // Spawn 8x more zombies during blood moon!
+
+    // Blue Alert event - player must evacuate to safe room
+    float blueEventTimer = 0.0f;  // Time towards the next alert; runs across restarts
+    float blueEventLogTimer = 0.0f;
+    float blueAlertTimer = 0.0f;
+    bool blueAlertActive = false;
+    float blueAlertDuration = 45.0f;  // 45 seconds to reach safe room
+    float blueAlertInterval = 180.0f;  // Every 3 minutes (180 seconds)
+    int blueRoomX = -1, blueRoomY = -1;  // Safe room coordinates
+    bool inSafeRoom = false;  // Is player currently in safe room
+    bool safeRoomLocked = false;  // Room locks after alert ends
+
+    // Hunter Phase - dark entities chase player after failed evacuation
+    bool hunterPhaseActive = false;
+    float hunterPhaseTimer = 0.0f;
+    float hunterPhaseDuration = 60.0f;  // 1 minute of terror!
+    std::vector<std::unique_ptr<Zombie>> hunters;  // Dark fast entities
+
+    // Route to the nearest uncollected key; rebuilt when keys change
+    DistanceField keyField;
+
+    // Collision phase broadphase (kept here so buffers are reused every tick)
+    CollisionWorld collisions;
+
+    // Flamethrower particles and damage cone
+    FlameSystem flames;
+
+    // Simulation -> presentation events (sounds, log lines, shake, high scores)
+    GameEventQueue events;
+
+    // Stage timer owned by whoever drives the loop; null when nothing is timing
+    FrameProfiler* profiler = nullptr;
+};
+
+// Fixed simulation rate. Game::run spends real time in ticks of this length,
+// however fast it renders, and draws moving entities between the last two.
+constexpr int SIMULATION_HZ = 60;
+constexpr float SIMULATION_STEP = 1.0f / SIMULATION_HZ;  // Seconds
+
+// What the player does this tick
+struct TickInput {
+    const Uint8* keyState = nullptr;  // Indexed by SDL_Scancode, as from SDL_GetKeyboardState
+    bool firing = false;              // Primary attack held
+};
+
+enum class TickOutcome {
+    PLAYING,      // Includes moving on to the next Infinite level
+    PLAYER_DIED,
+    LEVEL_WON     // Reached the exit with all keys in a mode that ends there
+};
+
+// Build a fresh level (or the next Infinite level) into state. now is the
+// tick clock in milliseconds, the same one later passed to stepSimulation.
+void initializeGame(PlayState& state, Uint32 now, Difficulty difficulty,
+                    MazeType mazeType = MazeType::STANDARD, bool isLevelProgression = false);
+
+// Advance the world by one tick of deltaTime seconds (SIMULATION_STEP in the
+// game). now is the tick's clock in milliseconds. Events go to state.events
+// for the caller.
+TickOutcome stepSimulation(PlayState& state, const TickInput& input, float deltaTime, Uint32 now);
+
+#endif
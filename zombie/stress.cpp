@@ -0,0 +1,51 @@
+#include "stress.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // count spawn points at least 8 tiles from the player; a map has fewer
+    // open tiles than a big horde, so they repeat
+    std::vector<Vec2> spawnPositions(const PlayState& state, int count, Rng& rng) {
+        Vec2 playerPos = {state.player->getX(), state.player->getY()};
+        std::vector<Vec2> positions = state.maze->getRandomZombiePositions(count, playerPos, rng);
+        for (int i = static_cast<int>(positions.size()); i < count && !positions.empty(); i++) {
+            positions.push_back(positions[i % positions.size()]);
+        }
+        return positions;
+    }
+
+    template <typename Items, typename Spent>
+    int dropSpent(Items& items, Spent spent) {
+        items.erase(std::remove_if(items.begin(), items.end(), spent), items.end());
+        return static_cast<int>(items.size());
+    }
+}
+
+void Horde::topUp(PlayState& state) {
+    if (!state.player || !state.maze) return;
+    auto dead = [](const auto& zombie) { return zombie->isDead(); };
+
+    int missing = size.zombies - dropSpent(state.zombies, dead);
+    if (missing > 0) {
+        for (Vec2 pos : spawnPositions(state, missing, rng)) {
+            state.zombies.push_back(
+                std::make_unique<Zombie>(pos.x, pos.y, state.zombieMaxHealth, ZombieType::NORMAL, rng.nextU64()));
+        }
+    }
+
+    missing = size.hunters - dropSpent(state.hunters, dead);
+    if (missing > 0) {
+        for (Vec2 pos : spawnPositions(state, missing, rng)) {
+            state.hunters.push_back(std::make_unique<Zombie>(pos.x, pos.y, 999, ZombieType::NORMAL, rng.nextU64()));
+        }
+    }
+
+    missing = size.bullets - dropSpent(state.bullets, [](const auto& bullet) { return !bullet->isActive(); });
+    if (missing > 0) {
+        for (Vec2 pos : spawnPositions(state, missing, rng)) {
+            float angle = rng.nextFloat(-M_PI, M_PI);
+            state.bullets.push_back(
+                std::make_unique<Bullet>(pos.x, pos.y, std::cos(angle), std::sin(angle), BULLET_DAMAGE, BULLET_SPEED));
+        }
+    }
+}
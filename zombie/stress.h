@@ -0,0 +1,40 @@
+#ifndef ZOMBIE_STRESS_H
+#define ZOMBIE_STRESS_H
+
+#include <cstdint>
+#include "rng.h"
+#include "simulation.h"
+
+// Synthetic load for finding where the simulation breaks
+// (zombie_sim_headless --horde / --scaling). Holds the world at a fixed
+// number of zombies, hunters and live bullets, far past what spawning ever
+// produces (maxZombieCount is 35 on Hard, Blood Moon multiplies spawns by 8).
+
+struct HordeSize {
+    int zombies = 0;
+    int hunters = 0;
+    int bullets = 0;  // Flying in random directions from random open tiles
+
+    bool isEmpty() const { return zombies <= 0 && hunters <= 0 && bullets <= 0; }
+};
+
+class Horde {
+public:
+    explicit Horde(const HordeSize& size, std::uint64_t seed = Rng::DEFAULT_SEED) : size(size), rng(seed) {}
+
+    // Drops dead enemies and spent bullets and spawns replacements, so every
+    // tick runs at full size. Call before stepSimulation; draws from its own
+    // RNG, not the gameplay one.
+    void topUp(PlayState& state);
+
+    const HordeSize& getSize() const { return size; }
+
+private:
+    static constexpr int BULLET_DAMAGE = 1;
+    static constexpr float BULLET_SPEED = 400.0f;  // Pistol round
+
+    HordeSize size;
+    Rng rng;
+};
+
+#endif
@@ -0,0 +1,118 @@
+#include "trace.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    std::atomic<TraceRecorder*> activeTrace{nullptr};
+
+    // Small stable id per thread, in order of first use
+    int currentThreadId() {
+        static std::atomic<int> nextId{0};
+        thread_local int id = nextId.fetch_add(1);
+        return id;
+    }
+
+    double microseconds(TraceRecorder::Clock::duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    }
+}
+
+void setActiveTrace(TraceRecorder* trace) {
+    activeTrace.store(trace, std::memory_order_release);
+}
+
+TraceRecorder* getActiveTrace() {
+    return activeTrace.load(std::memory_order_acquire);
+}
+
+TraceRecorder::TraceRecorder(const std::string& path, int frameLimit)
+    : path(path), frameLimit(frameLimit), origin(Clock::now()), gameThread(currentThreadId()) {
+    events.reserve(static_cast<size_t>(std::max(frameLimit, 1)) * 16);  // About one frame's stages each
+}
+
+void TraceRecorder::record(Event event, std::initializer_list<Value> values) {
+    event.thread = currentThreadId();
+    event.valueCount = 0;
+    for (const Value& value : values) {
+        if (event.valueCount == MAX_VALUES) break;
+        event.values[event.valueCount++] = value;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!isRecording()) return;
+    events.push_back(event);
+}
+
+void TraceRecorder::addSpan(const char* name, const char* category, Clock::time_point start, Clock::time_point end,
+                            std::initializer_list<Value> args) {
+    if (!isRecording()) return;
+    record({'X', name, category, 0, start, end - start, {}, 0}, args);
+}
+
+void TraceRecorder::addCounter(const char* name, Clock::time_point at, std::initializer_list<Value> series) {
+    if (!isRecording()) return;
+    record({'C', name, "counter", 0, at, Clock::duration::zero(), {}, 0}, series);
+}
+
+void TraceRecorder::endFrame() {
+    if (!isRecording()) return;
+    if (++frames >= frameLimit) finish();
+}
+
+bool TraceRecorder::finish() {
+    std::vector<Event> recorded;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (written) return true;
+        written = true;
+        recording.store(false, std::memory_order_relaxed);
+        recorded.swap(events);
+    }
+
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Could not write trace to " << path << std::endl;
+        return false;
+    }
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    // Name every thread that recorded something
+    std::vector<int> threads;
+    for (const Event& event : recorded) threads.push_back(event.thread);
+    std::sort(threads.begin(), threads.end());
+    threads.erase(std::unique(threads.begin(), threads.end()), threads.end());
+    bool first = true;
+    for (int thread : threads) {
+        file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread
+             << ",\"args\":{\"name\":\"" << (thread == gameThread ? "game" : "worker") << "\"}}";
+        first = false;
+    }
+
+    for (const Event& event : recorded) {
+        file << (first ? "" : ",\n") << "{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+             << "\",\"ph\":\"" << event.phase << "\",\"pid\":1,\"tid\":" << event.thread
+             << ",\"ts\":" << microseconds(event.start - origin);
+        if (event.phase == 'X') file << ",\"dur\":" << microseconds(event.duration);
+        if (event.valueCount > 0) {
+            file << ",\"args\":{";
+            for (int i = 0; i < event.valueCount; i++) {
+                file << (i ? "," : "") << "\"" << event.values[i].first << "\":" << event.values[i].second;
+            }
+            file << "}";
+        }
+        file << "}";
+        first = false;
+    }
+    file << "\n]}\n";
+
+    if (!file) {
+        std::cerr << "Could not write trace to " << path << std::endl;
+        return false;
+    }
+    std::cout << "Wrote " << recorded.size() << " trace events (" << frames << " frames) to " << path << std::endl;
+    return true;
+}
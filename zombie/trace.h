@@ -0,0 +1,94 @@
+#ifndef ZOMBIE_TRACE_H
+#define ZOMBIE_TRACE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Records a timeline in the Chrome Trace Event format: complete spans ("X")
+// and counter samples ("C") from any thread, written as one JSON file that
+// chrome://tracing and ui.perfetto.dev open directly. Recording stops and the
+// file is written once frameLimit frames have ended (or on finish()).
+//
+// Names and categories must be string literals; they are stored as pointers.
+class TraceRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Value = std::pair<const char*, int>;
+    static constexpr int MAX_VALUES = 4;  // Args per span / series per counter
+
+    // The constructing thread is labelled as the game thread
+    TraceRecorder(const std::string& path, int frameLimit);
+
+    bool isRecording() const { return recording.load(std::memory_order_relaxed); }
+
+    // Thread-safe; ignored once recording has stopped
+    void addSpan(const char* name, const char* category, Clock::time_point start, Clock::time_point end,
+                 std::initializer_list<Value> args = {});
+    void addCounter(const char* name, Clock::time_point at, std::initializer_list<Value> series);
+
+    // Called from the frame loop after each frame; writes the file at the limit
+    void endFrame();
+
+    // Stops recording and writes the file; later calls do nothing. False on I/O error.
+    bool finish();
+
+private:
+    struct Event {
+        char phase;
+        const char* name;
+        const char* category;
+        int thread;
+        Clock::time_point start;
+        Clock::duration duration;
+        std::array<Value, MAX_VALUES> values;
+        int valueCount;
+    };
+
+    void record(Event event, std::initializer_list<Value> values);
+
+    std::string path;
+    int frameLimit;
+    int frames = 0;
+    Clock::time_point origin;
+    int gameThread;
+
+    std::atomic<bool> recording{true};
+    bool written = false;
+    std::mutex mutex;  // Guards events
+    std::vector<Event> events;
+};
+
+// The recorder that stage timers and worker spans report to; null when no
+// trace is being taken. Set before workers start and cleared after they end.
+void setActiveTrace(TraceRecorder* trace);
+TraceRecorder* getActiveTrace();
+
+// Times its scope as a span on the calling thread while a trace is recording
+class TraceSpan {
+public:
+    TraceSpan(const char* name, const char* category) : name(name), category(category) {
+        TraceRecorder* trace = getActiveTrace();
+        if (trace && trace->isRecording()) start = TraceRecorder::Clock::now();
+    }
+    ~TraceSpan() {
+        TraceRecorder* trace = getActiveTrace();
+        if (trace && start != TraceRecorder::Clock::time_point()) {
+            trace->addSpan(name, category, start, TraceRecorder::Clock::now());
+        }
+    }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name;
+    const char* category;
+    TraceRecorder::Clock::time_point start;  // Default (epoch) when not recording
+};
+
+#endif
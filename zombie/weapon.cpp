@@ -1,5 +1,4 @@
 #include "weapon.h"
-#include <cmath>
 
 WeaponPickup::WeaponPickup(float x, float y, WeaponType type, bool isAmmo)
     : x(x), y(y), type(type), collected(false), isAmmo(isAmmo) {}
@@ -276,13 +275,3 @@ void WeaponPickup::render(SDL_Renderer* renderer) const {
         SDL_RenderFillRect(renderer, &aCross);
     }
 }
-
-bool WeaponPickup::checkCollision(float px, float py, float radius) const {
-    if (collected) return false;
-
-    float dx = px - x;
-    float dy = py - y;
-    float dist = std::sqrt(dx*dx + dy*dy);
-
-    return dist < (radius + SIZE);
-}
@@ -2,6 +2,7 @@
 #define ZOMBIE_WEAPON_H
 
 #include <SDL.h>
+#include "allocation.h"
 
 enum class WeaponType {
     SHOTGUN,
@@ -30,12 +31,11 @@ struct WeaponStats {
     const char* name;
 };
 
-class WeaponPickup {
+class WeaponPickup : public TaggedAllocation<AllocationTag::ITEMS> {
 public:
     WeaponPickup(float x, float y, WeaponType type, bool isAmmo = false);
 
     void render(SDL_Renderer* renderer) const;
-    bool checkCollision(float px, float py, float radius) const;
 
     WeaponType getType() const { return type; }
     bool isCollected() const { return collected; }
@@ -45,6 +45,8 @@ public:
 
     float getX() const { return x; }
     float getY() const { return y; }
+    void translate(float dx, float dy) { x += dx; y += dy; }
+    float getRadius() const { return SIZE; }  // Pickup radius for the collision phase
 
 private:
     float x, y;
@@ -0,0 +1,240 @@
+#include "world_stream.h"
+#include "allocation.h"
+#include "trace.h"
+#include "zombie.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+    enum EdgeSalt : std::uint64_t { MAZE_SALT = 0, EAST_EDGE = 1, SOUTH_EDGE = 2 };
+
+    std::uint64_t chunkSeed(std::uint64_t worldSeed, int cx, int cy) {
+        return Rng::mixSeed(Rng::mixSeed(worldSeed, static_cast<std::uint32_t>(cx)), static_cast<std::uint32_t>(cy));
+    }
+
+    // Door rows (or columns) on a chunk's east (or south) edge. The neighbour
+    // derives the same ones for its west (north) edge. Odd offsets line up
+    // with cells the backtracker always carves.
+    std::array<int, WorldStream::DOORS_PER_EDGE> edgeDoors(std::uint64_t worldSeed, int cx, int cy, EdgeSalt edge) {
+        Rng rng(Rng::mixSeed(chunkSeed(worldSeed, cx, cy), edge));
+        std::array<int, WorldStream::DOORS_PER_EDGE> doors;
+        for (int& door : doors) {
+            door = 1 + 2 * rng.nextBelow((WorldStream::CHUNK_SIZE - 2) / 2);
+        }
+        return doors;
+    }
+
+    int floorDiv(float value, float size) {
+        return static_cast<int>(std::floor(value / size));
+    }
+
+    // Done, or deferred (single-threaded web build) so get() runs it inline
+    template <typename Future>
+    bool isSettled(const Future& future) {
+        return future.wait_for(std::chrono::seconds(0)) != std::future_status::timeout;
+    }
+}
+
+WorldStream::WorldStream(std::uint64_t worldSeed) : seed(worldSeed), centerX(0), centerY(0) {
+    requestChunksAround();
+}
+
+std::vector<std::uint8_t> WorldStream::generateChunk(std::uint64_t worldSeed, int cx, int cy) {
+    TraceSpan span("generateChunk", "worker");
+    AllocationScope allocations(AllocationTag::MAZE);
+
+    // Each chunk is an ordinary Infinite maze; only its border is patched
+    Maze maze(MazeType::INFINITE, CHUNK_SIZE, CHUNK_SIZE, Rng::mixSeed(chunkSeed(worldSeed, cx, cy), MAZE_SALT));
+
+    std::vector<std::uint8_t> tiles(CHUNK_SIZE * CHUNK_SIZE);
+    for (int y = 0; y < CHUNK_SIZE; y++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            TileType tile = maze.getTile(x, y);
+            if (tile == TileType::Exit) tile = TileType::Empty;  // Nowhere to exit to
+            tiles[y * CHUNK_SIZE + x] = static_cast<std::uint8_t>(tile);
+        }
+    }
+
+    auto open = [&tiles](int x, int y) { tiles[y * CHUNK_SIZE + x] = static_cast<std::uint8_t>(TileType::Empty); };
+    const int last = CHUNK_SIZE - 1;
+    // The carver leaves the last two columns/rows solid, so east and south
+    // doors cut through both; west and north doors only need the border
+    for (int row : edgeDoors(worldSeed, cx, cy, EAST_EDGE)) {
+        open(last - 1, row);
+        open(last, row);
+    }
+    for (int row : edgeDoors(worldSeed, cx - 1, cy, EAST_EDGE)) {
+        open(0, row);
+    }
+    for (int column : edgeDoors(worldSeed, cx, cy, SOUTH_EDGE)) {
+        open(column, last - 1);
+        open(column, last);
+    }
+    for (int column : edgeDoors(worldSeed, cx, cy - 1, SOUTH_EDGE)) {
+        open(column, 0);
+    }
+    return tiles;
+}
+
+WorldStream::Chunk& WorldStream::chunkAt(int cx, int cy) {
+    std::uint64_t key = chunkKey(cx, cy);
+    auto found = chunks.find(key);
+    if (found != chunks.end()) return found->second;
+
+    Chunk chunk;
+    auto inFlight = pending.find(key);
+    if (inFlight != pending.end()) {
+        chunk.tiles = inFlight->second.get();
+        pending.erase(inFlight);
+    } else {
+        chunk.tiles = generateChunk(seed, cx, cy);
+    }
+    return chunks.emplace(key, std::move(chunk)).first->second;
+}
+
+bool WorldStream::isChunkReady(int cx, int cy) const {
+    std::uint64_t key = chunkKey(cx, cy);
+    if (chunks.count(key)) return true;
+    auto inFlight = pending.find(key);
+    return inFlight != pending.end() && isSettled(inFlight->second);
+}
+
+void WorldStream::requestChunksAround() {
+    reapRetiredChunks();
+    for (int cy = centerY - CACHE_RADIUS; cy <= centerY + CACHE_RADIUS; cy++) {
+        for (int cx = centerX - CACHE_RADIUS; cx <= centerX + CACHE_RADIUS; cx++) {
+            std::uint64_t key = chunkKey(cx, cy);
+            if (chunks.count(key) || pending.count(key)) continue;
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+            // No threads in the single-threaded web build; generate on first use
+            pending.emplace(key, std::async(std::launch::deferred, generateChunk, seed, cx, cy));
+#else
+            pending.emplace(key, std::async(std::launch::async, generateChunk, seed, cx, cy));
+#endif
+        }
+    }
+}
+
+void WorldStream::evictFarChunks() {
+    auto isFar = [this](std::uint64_t key) {
+        int cx = static_cast<std::int32_t>(key >> 32);
+        int cy = static_cast<std::int32_t>(key & 0xffffffffu);
+        return std::max(std::abs(cx - centerX), std::abs(cy - centerY)) > CACHE_RADIUS;
+    };
+    for (auto it = chunks.begin(); it != chunks.end(); ) {
+        it = isFar(it->first) ? chunks.erase(it) : std::next(it);
+    }
+    for (auto it = pending.begin(); it != pending.end(); ) {
+        if (!isFar(it->first)) {
+            ++it;
+            continue;
+        }
+        if (!isSettled(it->second)) retired.push_back(std::move(it->second));
+        it = pending.erase(it);
+    }
+}
+
+void WorldStream::reapRetiredChunks() {
+    retired.erase(std::remove_if(retired.begin(), retired.end(), [](const ChunkFuture& chunk) { return isSettled(chunk); }),
+                  retired.end());
+}
+
+std::unique_ptr<Maze> WorldStream::buildWindow() {
+    AllocationScope allocations(AllocationTag::MAZE);  // Window, and any chunks it had to build here
+    const int size = WINDOW_CHUNKS * CHUNK_SIZE;
+    std::vector<std::uint8_t> tiles(size * size);
+    for (int wy = 0; wy < WINDOW_CHUNKS; wy++) {
+        for (int wx = 0; wx < WINDOW_CHUNKS; wx++) {
+            const Chunk& chunk = chunkAt(originX() + wx, originY() + wy);
+            for (int y = 0; y < CHUNK_SIZE; y++) {
+                std::copy_n(&chunk.tiles[y * CHUNK_SIZE], CHUNK_SIZE,
+                            &tiles[(wy * CHUNK_SIZE + y) * size + wx * CHUNK_SIZE]);
+            }
+        }
+    }
+    return std::make_unique<Maze>(MazeType::INFINITE, size, size, tiles, chunkSeed(seed, centerX, centerY));
+}
+
+bool WorldStream::needsRecenter(float x, float y, int& stepX, int& stepY) const {
+    const int middle = WINDOW_CHUNKS / 2;
+    stepX = std::min(std::max(floorDiv(x, CHUNK_PIXELS) - middle, -1), 1);
+    stepY = std::min(std::max(floorDiv(y, CHUNK_PIXELS) - middle, -1), 1);
+    if (stepX == 0 && stepY == 0) return false;
+
+    // The chunks the moved window would need were requested a recenter ago
+    for (int cy = centerY + stepY - WINDOW_CHUNKS / 2; cy <= centerY + stepY + WINDOW_CHUNKS / 2; cy++) {
+        for (int cx = centerX + stepX - WINDOW_CHUNKS / 2; cx <= centerX + stepX + WINDOW_CHUNKS / 2; cx++) {
+            if (!isChunkReady(cx, cy)) return false;
+        }
+    }
+    return true;
+}
+
+Vec2 WorldStream::recenter(int stepX, int stepY, std::vector<std::unique_ptr<Zombie>>& zombies,
+                           int zombieMaxHealth, int maxActive, Rng& rng) {
+    const int oldOriginX = originX();
+    const int oldOriginY = originY();
+    Vec2 shift = {-stepX * CHUNK_PIXELS, -stepY * CHUNK_PIXELS};
+
+    centerX += stepX;
+    centerY += stepY;
+    requestChunksAround();
+
+    // Shift zombies that stay in view; pack the live ones that do not
+    int active = 0;
+    for (auto it = zombies.begin(); it != zombies.end(); ) {
+        Zombie& zombie = **it;
+        if (inWindow(zombie.getX() + shift.x, zombie.getY() + shift.y)) {
+            zombie.translate(shift.x, shift.y);
+            if (!zombie.isDead()) active++;
+            ++it;
+            continue;
+        }
+
+        if (!zombie.isDead()) {
+            int wx = floorDiv(zombie.getX(), CHUNK_PIXELS);
+            int wy = floorDiv(zombie.getY(), CHUNK_PIXELS);
+            Chunk& chunk = chunkAt(oldOriginX + wx, oldOriginY + wy);
+            if (static_cast<int>(chunk.zombies.size()) < MAX_PACKED_ZOMBIES) {
+                float localX = zombie.getX() - wx * CHUNK_PIXELS;
+                float localY = zombie.getY() - wy * CHUNK_PIXELS;
+                chunk.zombies.push_back({static_cast<std::uint16_t>(localX * 64.0f / Maze::TILE_SIZE),
+                                         static_cast<std::uint16_t>(localY * 64.0f / Maze::TILE_SIZE),
+                                         static_cast<std::uint8_t>(zombie.getType()),
+                                         static_cast<std::uint8_t>(std::min(std::max(zombie.getHealth(), 1), 255))});
+            }
+        }
+        it = zombies.erase(it);
+    }
+
+    evictFarChunks();
+
+    // Bring back zombies of chunks that just came into view
+    for (int wy = 0; wy < WINDOW_CHUNKS; wy++) {
+        for (int wx = 0; wx < WINDOW_CHUNKS; wx++) {
+            int cx = originX() + wx;
+            int cy = originY() + wy;
+            bool wasInView = cx >= oldOriginX && cx < oldOriginX + WINDOW_CHUNKS &&
+                             cy >= oldOriginY && cy < oldOriginY + WINDOW_CHUNKS;
+            auto found = chunks.find(chunkKey(cx, cy));
+            if (wasInView || found == chunks.end()) continue;
+
+            std::vector<PackedZombie>& packed = found->second.zombies;
+            while (!packed.empty() && active < maxActive) {
+                const PackedZombie& entry = packed.back();
+                float x = wx * CHUNK_PIXELS + entry.x * Maze::TILE_SIZE / 64.0f;
+                float y = wy * CHUNK_PIXELS + entry.y * Maze::TILE_SIZE / 64.0f;
+                auto zombie = std::make_unique<Zombie>(x, y, zombieMaxHealth, static_cast<ZombieType>(entry.type), rng.nextU64());
+                int damage = zombie->getMaxHealth() - entry.health;
+                if (damage > 0) zombie->takeDamage(damage);
+                zombies.push_back(std::move(zombie));
+                packed.pop_back();
+                active++;
+            }
+        }
+    }
+    return shift;
+}
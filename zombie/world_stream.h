@@ -0,0 +1,100 @@
+#ifndef ZOMBIE_WORLD_STREAM_H
+#define ZOMBIE_WORLD_STREAM_H
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "maze.h"
+#include "rng.h"
+
+class Zombie;
+
+// Endless world for Infinite mode: an unbounded grid of CHUNK_SIZE maze
+// chunks, each generated from the world seed and its own coordinates, so a
+// place looks the same every time it is visited. The game only ever sees a
+// WINDOW_CHUNKS-square window of chunks as an ordinary Maze. When the player
+// leaves the middle chunk the window moves by one chunk and everything in
+// play is shifted back by the same amount (floating origin), so coordinates
+// stay small however far the player walks.
+//
+// Chunks within CACHE_RADIUS of the middle one are generated ahead on worker
+// threads, and the window only moves once the chunks it moves onto are
+// built, so play never waits on a worker (only the first window does).
+// Farther chunks are evicted together with the zombies packed into them, so
+// memory is bounded by the cache, not by the distance travelled.
+class WorldStream {
+public:
+    static constexpr int CHUNK_SIZE = 32;          // Tiles per chunk side
+    static constexpr int WINDOW_CHUNKS = 3;        // Live window is 3x3 chunks (96x96 tiles)
+    static constexpr int CACHE_RADIUS = 2;         // Chunks kept around the middle one (5x5)
+    static constexpr int DOORS_PER_EDGE = 2;       // Openings between neighbouring chunks
+    static constexpr int MAX_PACKED_ZOMBIES = 64;  // Per chunk; zombies past this are dropped
+    static constexpr float CHUNK_PIXELS = static_cast<float>(CHUNK_SIZE * Maze::TILE_SIZE);
+
+    explicit WorldStream(std::uint64_t seed);
+
+    // The live window as a maze, in window coordinates
+    std::unique_ptr<Maze> buildWindow();
+
+    // True if pos (window coordinates) has left the middle chunk and the
+    // chunks of the window one step over are built; step is the chunk move
+    // (-1, 0 or 1 per axis) that brings it back. While they are still being
+    // generated the window stays put; its walls keep the player inside.
+    bool needsRecenter(float x, float y, int& stepX, int& stepY) const;
+
+    // Move the window by one step and return the pixel offset to add to
+    // everything still in play. Zombies that fall outside the window are
+    // packed into their chunk (and shifted otherwise); packed zombies of
+    // chunks coming into view are restored while fewer than maxActive live.
+    Vec2 recenter(int stepX, int stepY, std::vector<std::unique_ptr<Zombie>>& zombies,
+                  int zombieMaxHealth, int maxActive, Rng& rng);
+
+    static bool inWindow(float x, float y) {
+        const float size = WINDOW_CHUNKS * CHUNK_PIXELS;
+        return x >= 0.0f && y >= 0.0f && x < size && y < size;
+    }
+
+    int getCenterChunkX() const { return centerX; }
+    int getCenterChunkY() const { return centerY; }
+    int getCachedChunkCount() const { return static_cast<int>(chunks.size()); }
+
+private:
+    struct PackedZombie {
+        std::uint16_t x, y;  // Position within the chunk in 1/64 tile units
+        std::uint8_t type;
+        std::uint8_t health;
+    };
+
+    struct Chunk {
+        std::vector<std::uint8_t> tiles;  // CHUNK_SIZE * CHUNK_SIZE TileType values
+        std::vector<PackedZombie> zombies;
+    };
+
+    static std::uint64_t chunkKey(int cx, int cy) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) | static_cast<std::uint32_t>(cy);
+    }
+    static std::vector<std::uint8_t> generateChunk(std::uint64_t worldSeed, int cx, int cy);
+
+    using ChunkFuture = std::future<std::vector<std::uint8_t>>;
+
+    Chunk& chunkAt(int cx, int cy);  // Waits for or builds the chunk if needed
+    bool isChunkReady(int cx, int cy) const;  // chunkAt would not wait
+    void requestChunksAround();      // Start workers for missing chunks in the cache radius
+    void evictFarChunks();
+    void reapRetiredChunks();
+
+    int originX() const { return centerX - WINDOW_CHUNKS / 2; }  // World chunk at the window's top-left
+    int originY() const { return centerY - WINDOW_CHUNKS / 2; }
+
+    std::uint64_t seed;
+    int centerX, centerY;  // World chunk in the middle of the window
+    std::unordered_map<std::uint64_t, Chunk> chunks;
+    std::unordered_map<std::uint64_t, ChunkFuture> pending;
+    // Evicted while still generating: destroying a running std::async future
+    // would block, so they finish on their worker and are dropped once ready
+    std::vector<ChunkFuture> retired;
+};
+
+#endif
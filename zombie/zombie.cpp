@@ -1,14 +1,12 @@
 #include "zombie.h"
 #include "maze.h"
+#include "pathfinding.h"
 #include <cmath>
-#include <queue>
-#include <unordered_map>
 #include <algorithm>
-#include <random>
 
-Zombie::Zombie(float x, float y, int maxHealth, ZombieType type) : x(x), y(y), facingAngle(0.0f), dead(false), health(maxHealth), maxHealth(maxHealth),
+Zombie::Zombie(float x, float y, int maxHealth, ZombieType type, std::uint64_t seed) : x(x), y(y), prevX(x), prevY(y), facingAngle(0.0f), dead(false), health(maxHealth), maxHealth(maxHealth),
     type(type), pathIndex(0), pathUpdateTimer(0.0f),
-    walkAnimTime(0.0f), deathAnimTime(0.0f), isChasing(false), wanderTimer(0.0f) {
+    walkAnimTime(0.0f), deathAnimTime(0.0f), isChasing(false), wanderTimer(0.0f), rng(seed) {
 
     // Set speed multiplier and adjust health based on zombie type
     switch (type) {
@@ -41,120 +39,15 @@ Zombie::Zombie(float x, float y, int maxHealth, ZombieType type) : x(x), y(y), f
 }
 
 void Zombie::findPath(int startX, int startY, int goalX, int goalY, const Maze& maze) {
-    path.clear();
-
-    // Bounds check
-    if (startX < 0 || startX >= Maze::WIDTH || startY < 0 || startY >= Maze::HEIGHT ||
-        goalX < 0 || goalX >= Maze::WIDTH || goalY < 0 || goalY >= Maze::HEIGHT) {
-        return;
-    }
-
-    // A* pathfinding
-    struct Node {
-        int x, y;
-        float g, h;
-        std::pair<int, int> parent;
-
-        float f() const { return g + h; }
-
-        bool operator>(const Node& other) const { return f() > other.f(); }
-    };
-
-    auto heuristic = [](int x1, int y1, int x2, int y2) {
-        return std::abs(x1 - x2) + std::abs(y1 - y2);
-    };
-
-    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> openSet;
-    std::unordered_map<int, Node> closedSet;
-
-    Node start = {startX, startY, 0.0f, static_cast<float>(heuristic(startX, startY, goalX, goalY)), {-1, -1}};
-    openSet.push(start);
-
-    const int dx[] = {0, 0, 1, -1, 1, -1, 1, -1};  // 8 directions
-    const int dy[] = {1, -1, 0, 0, 1, -1, -1, 1};
-    const float cost[] = {1.0f, 1.0f, 1.0f, 1.0f, 1.414f, 1.414f, 1.414f, 1.414f};  // Diagonal cost is sqrt(2)
-
-    while (!openSet.empty()) {
-        Node current = openSet.top();
-        openSet.pop();
-
-        int key = current.y * Maze::WIDTH + current.x;
-
-        if (closedSet.find(key) != closedSet.end()) {
-            continue;
-        }
-
-        closedSet[key] = current;
-
-        // Found goal
-        if (current.x == goalX && current.y == goalY) {
-            // Reconstruct path
-            std::vector<std::pair<int, int>> reconstructed;
-            Node node = current;
-            while (node.parent.first != -1) {
-                reconstructed.push_back({node.x, node.y});
-                int parentKey = node.parent.second * Maze::WIDTH + node.parent.first;
-                node = closedSet[parentKey];
-            }
-            std::reverse(reconstructed.begin(), reconstructed.end());
-            path = reconstructed;
-            pathIndex = 0;
-            return;
-        }
-
-        // Explore neighbors
-        for (int i = 0; i < 8; i++) {
-            int nx = current.x + dx[i];
-            int ny = current.y + dy[i];
-
-            if (nx < 0 || nx >= Maze::WIDTH || ny < 0 || ny >= Maze::HEIGHT) {
-                continue;
-            }
-
-            if (maze.isWall(nx, ny)) {
-                continue;
-            }
-
-            // Prevent diagonal movement through corners
-            if (i >= 4) {  // Diagonal directions
-                // Check if both adjacent cells are walkable
-                int diagX = (i == 4 || i == 6) ? 1 : -1;
-                int diagY = (i == 4 || i == 5) ? 1 : -1;
-
-                if (maze.isWall(current.x + diagX, current.y) ||
-                    maze.isWall(current.x, current.y + diagY)) {
-                    continue;  // Don't cut corners
-                }
-            }
-
-            int nkey = ny * Maze::WIDTH + nx;
-            if (closedSet.find(nkey) != closedSet.end()) {
-                continue;
-            }
-
-            Node neighbor;
-            neighbor.x = nx;
-            neighbor.y = ny;
-            neighbor.g = current.g + cost[i];
-            neighbor.h = heuristic(nx, ny, goalX, goalY);
-            neighbor.parent = {current.x, current.y};
-
-            openSet.push(neighbor);
-        }
-    }
+    findTilePath(maze, startX, startY, goalX, goalY, path);
+    pathIndex = 0;
 }
 
 void Zombie::findRandomWanderTarget(const Maze& maze) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-
     // Try to find a random nearby position
     for (int attempt = 0; attempt < 20; attempt++) {
-        std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * M_PI);
-        std::uniform_real_distribution<float> distDist(50.0f, WANDER_RADIUS);
-
-        float angle = angleDist(gen);
-        float dist = distDist(gen);
+        float angle = rng.nextFloat(0.0f, 2.0f * M_PI);
+        float dist = rng.nextFloat(50.0f, WANDER_RADIUS);
 
         float targetX = x + std::cos(angle) * dist;
         float targetY = y + std::sin(angle) * dist;
@@ -163,8 +56,8 @@ void Zombie::findRandomWanderTarget(const Maze& maze) {
         int targetTileY = static_cast<int>(targetY / Maze::TILE_SIZE);
 
         // Check if target is valid
-        if (targetTileX > 0 && targetTileX < Maze::WIDTH - 1 &&
-            targetTileY > 0 && targetTileY < Maze::HEIGHT - 1 &&
+        if (targetTileX > 0 && targetTileX < maze.getWidth() - 1 &&
+            targetTileY > 0 && targetTileY < maze.getHeight() - 1 &&
             !maze.isWall(targetTileX, targetTileY)) {
 
             int zombieTileX = static_cast<int>(x / Maze::TILE_SIZE);
@@ -200,7 +93,7 @@ bool Zombie::hasLineOfSight(float targetX, float targetY, const Maze& maze) cons
         int tileY = static_cast<int>(checkY / Maze::TILE_SIZE);
 
         // Check bounds
-        if (tileX < 0 || tileX >= Maze::WIDTH || tileY < 0 || tileY >= Maze::HEIGHT) {
+        if (tileX < 0 || tileX >= maze.getWidth() || tileY < 0 || tileY >= maze.getHeight()) {
             return false;
         }
 
@@ -214,6 +107,9 @@ bool Zombie::hasLineOfSight(float targetX, float targetY, const Maze& maze) cons
 }
 
 void Zombie::update(float deltaTime, float playerX, float playerY, const Maze& maze, const std::vector<std::unique_ptr<Zombie>>* allZombies) {
+    AllocationScope allocations(AllocationTag::ZOMBIES);  // Paths
+    prevX = x;
+    prevY = y;
     if (dead) {
         // Update death animation
         if (deathAnimTime < DEATH_ANIM_DURATION) {
@@ -315,10 +211,11 @@ void Zombie::update(float deltaTime, float playerX, float playerY, const Maze& m
                     if (other.get() != this && !other->isDead()) {
                         float otherDx = x - other->getX();
                         float otherDy = y - other->getY();
-                        float otherDist = std::sqrt(otherDx * otherDx + otherDy * otherDy);
+                        float otherDistSq = otherDx * otherDx + otherDy * otherDy;
 
                         // Apply separation force if zombie is too close
-                        if (otherDist > 0 && otherDist < SEPARATION_DISTANCE) {
+                        if (otherDistSq > 0 && otherDistSq < SEPARATION_DISTANCE * SEPARATION_DISTANCE) {
+                            float otherDist = std::sqrt(otherDistSq);
                             float separationFactor = (SEPARATION_DISTANCE - otherDist) / SEPARATION_DISTANCE;
                             separationX += (otherDx / otherDist) * separationFactor;
                             separationY += (otherDy / otherDist) * separationFactor;
@@ -782,13 +679,3 @@ void Zombie::render(SDL_Renderer* renderer) const {
         SDL_RenderDrawRect(renderer, &healthBg);
     }
 }
-
-bool Zombie::checkCollision(float px, float py, float pRadius) const {
-    if (dead) return false;
-
-    float dx = px - x;
-    float dy = py - y;
-    float dist = std::sqrt(dx*dx + dy*dy);
-
-    return dist < (radius + pRadius);
-}
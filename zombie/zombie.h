@@ -5,6 +5,8 @@
 #include <vector>
 #include <utility>
 #include <memory>
+#include "allocation.h"
+#include "rng.h"
 
 class Maze;
 
@@ -15,20 +17,33 @@ enum class ZombieType {
     RUNNER      // Runner zombie: very fast, medium health
 };
 
-class Zombie {
+class Zombie : public TaggedAllocation<AllocationTag::ZOMBIES> {
 public:
-    Zombie(float x, float y, int maxHealth = 3, ZombieType type = ZombieType::NORMAL);
+    // seed drives this zombie's wandering; spawners pass a draw from the game RNG
+    Zombie(float x, float y, int maxHealth = 3, ZombieType type = ZombieType::NORMAL,
+           std::uint64_t seed = Rng::DEFAULT_SEED);
 
     void update(float deltaTime, float playerX, float playerY, const Maze& maze, const std::vector<std::unique_ptr<Zombie>>* allZombies = nullptr);
     void render(SDL_Renderer* renderer) const;
 
-    bool checkCollision(float px, float py, float radius) const;
-
     float getX() const { return x; }
     float getY() const { return y; }
     float getRadius() const { return radius; }
+    // Position alpha of the way from the previous update to the latest, for drawing between ticks
+    float getRenderX(float alpha) const { return prevX + (x - prevX) * alpha; }
+    float getRenderY(float alpha) const { return prevY + (y - prevY) * alpha; }
 
     void setPosition(float newX, float newY) { x = newX; y = newY; }
+    // Shift with the world origin; the tile path is stale afterwards
+    void translate(float dx, float dy) {
+        x += dx;
+        y += dy;
+        prevX += dx;
+        prevY += dy;
+        path.clear();
+        pathIndex = 0;
+        pathUpdateTimer = 0.0f;
+    }
 
     bool isDead() const { return dead; }
     void takeDamage(int damage = 1) {
@@ -45,6 +60,7 @@ public:
 
 private:
     float x, y;
+    float prevX, prevY;  // Position before the last update
     float facingAngle;  // Angle zombie is facing (in radians)
     bool dead;
     int health;
@@ -64,6 +80,7 @@ private:
     // Wandering state
     bool isChasing;
     float wanderTimer;
+    Rng rng;
 
     void findPath(int startX, int startY, int goalX, int goalY, const Maze& maze);
     void findRandomWanderTarget(const Maze& maze);
@@ -0,0 +1,278 @@
+// Microbenchmarks for the per-tick hot paths, built on Google Benchmark:
+// A* paths, zombie AI, line of sight, the bullet broadphase, maze generation,
+// spawn queries and the raycast view (drawn to an offscreen surface).
+//
+// Every input comes from fixed seeds, so two runs measure the same mazes,
+// tiles and zombies. Maze arguments are the width in tiles; the height is
+// three quarters of it, like the default 32x24 map. Usual flags apply, e.g.
+// --benchmark_filter=ZombieUpdate --benchmark_repetitions=5.
+
+#include "collision.h"
+#include "game.h"
+#include "maze.h"
+#include "pathfinding.h"
+#include "render.h"
+#include "rng.h"
+#include "simulation.h"
+#include "zombie.h"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+    const std::uint64_t BENCH_SEED = 0x5eed;
+    const int SAMPLE_COUNT = 256;           // Queries cycled through per benchmark
+    const float TICK_SECONDS = 1.0f / 60.0f;
+
+    const MazeType MAZE_TYPES[] = {MazeType::STANDARD, MazeType::CIRCULAR, MazeType::INFINITE, MazeType::SOLDIER};
+
+    const char* mazeTypeName(MazeType type) {
+        switch (type) {
+            case MazeType::STANDARD: return "Standard";
+            case MazeType::CIRCULAR: return "Circular";
+            case MazeType::INFINITE: return "Infinite";
+            case MazeType::SOLDIER: return "Soldier";
+        }
+        return "Unknown";
+    }
+
+    // Arguments are (maze type index, width); the label names the type
+    std::unique_ptr<Maze> makeMaze(benchmark::State& state) {
+        MazeType type = MAZE_TYPES[state.range(0)];
+        int width = static_cast<int>(state.range(1));
+        state.SetLabel(mazeTypeName(type));
+        return std::make_unique<Maze>(type, width, width * 3 / 4, BENCH_SEED);
+    }
+
+    std::vector<std::pair<int, int>> openTiles(const Maze& maze) {
+        std::vector<std::pair<int, int>> tiles;
+        for (int y = 0; y < maze.getHeight(); y++) {
+            for (int x = 0; x < maze.getWidth(); x++) {
+                if (!maze.isWall(x, y)) tiles.push_back({x, y});
+            }
+        }
+        return tiles;
+    }
+
+    Vec2 tileCenter(std::pair<int, int> tile) {
+        return {tile.first * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f,
+                tile.second * Maze::TILE_SIZE + Maze::TILE_SIZE / 2.0f};
+    }
+
+    // Spawns from the maze's own zombie spawner, repeated if it runs out of tiles
+    std::vector<Vec2> zombiePositions(const Maze& maze, int count, Vec2 playerPos, Rng& rng) {
+        std::vector<Vec2> positions = maze.getRandomZombiePositions(count, playerPos, rng);
+        for (int i = static_cast<int>(positions.size()); i < count && !positions.empty(); i++) {
+            positions.push_back(positions[i % positions.size()]);
+        }
+        return positions;
+    }
+
+    void BM_FindPath(benchmark::State& state) {
+        auto maze = makeMaze(state);
+        std::vector<std::pair<int, int>> tiles = openTiles(*maze);
+        Rng rng(BENCH_SEED);
+        std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>> queries;
+        for (int i = 0; i < SAMPLE_COUNT; i++) {
+            queries.push_back({tiles[rng.nextBelow(static_cast<int>(tiles.size()))],
+                               tiles[rng.nextBelow(static_cast<int>(tiles.size()))]});
+        }
+
+        std::vector<std::pair<int, int>> path;
+        size_t next = 0;
+        int reached = 0;
+        for (auto _ : state) {
+            const auto& [from, to] = queries[next++ % queries.size()];
+            reached += findTilePath(*maze, from.first, from.second, to.first, to.second, path) ? 1 : 0;
+            benchmark::DoNotOptimize(path.data());
+        }
+        state.counters["reached"] = benchmark::Counter(reached, benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_FindPath)->ArgsProduct({{0, 1, 2, 3}, {32, 128}});
+
+    // One tick of every zombie chasing or wandering around a fixed player,
+    // including the all-pairs separation pass. The horde is rebuilt from the
+    // same spawns outside the timing each iteration, so every iteration times
+    // the first tick rather than a crowd that has already converged.
+    void BM_ZombieUpdate(benchmark::State& state) {
+        const int count = static_cast<int>(state.range(0));
+        Maze maze(MazeType::STANDARD, 128, 96, BENCH_SEED);
+        Rng rng(BENCH_SEED);
+        Vec2 playerPos = maze.getPlayerStart(rng);
+
+        std::vector<std::pair<Vec2, std::uint64_t>> spawns;
+        for (Vec2 pos : zombiePositions(maze, count, playerPos, rng)) {
+            spawns.push_back({pos, rng.nextU64()});
+        }
+
+        std::vector<std::unique_ptr<Zombie>> zombies;
+        for (auto _ : state) {
+            state.PauseTiming();
+            zombies.clear();
+            for (const auto& [pos, seed] : spawns) {
+                zombies.push_back(std::make_unique<Zombie>(pos.x, pos.y, 3, ZombieType::NORMAL, seed));
+            }
+            state.ResumeTiming();
+
+            for (auto& zombie : zombies) {
+                zombie->update(TICK_SECONDS, playerPos.x, playerPos.y, maze, &zombies);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+    BENCHMARK(BM_ZombieUpdate)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+    // Segments up to 20 tiles long, the range the view checks sprites over
+    void BM_LineOfSight(benchmark::State& state) {
+        auto maze = makeMaze(state);
+        std::vector<std::pair<int, int>> tiles = openTiles(*maze);
+        Rng rng(BENCH_SEED);
+        std::vector<std::pair<Vec2, Vec2>> segments;
+        while (static_cast<int>(segments.size()) < SAMPLE_COUNT) {
+            Vec2 from = tileCenter(tiles[rng.nextBelow(static_cast<int>(tiles.size()))]);
+            Vec2 to = tileCenter(tiles[rng.nextBelow(static_cast<int>(tiles.size()))]);
+            float dx = to.x - from.x;
+            float dy = to.y - from.y;
+            float length = std::sqrt(dx * dx + dy * dy);
+            if (length > 0.0f && length <= 20.0f * Maze::TILE_SIZE) segments.push_back({from, to});
+        }
+
+        size_t next = 0;
+        int visible = 0;
+        for (auto _ : state) {
+            const auto& [from, to] = segments[next++ % segments.size()];
+            visible += hasLineOfSight(maze.get(), from.x, from.y, to.x, to.y) ? 1 : 0;
+        }
+        state.counters["visible"] = benchmark::Counter(visible, benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_LineOfSight)->ArgsProduct({{0, 1, 2, 3}, {32}});
+
+    // The collision phase's broadphase work: bucket the zombies, sweep every
+    // bullet over its last step and collect the sorted contacts. Each bullet
+    // is aimed at a zombie and stops just short, so about half of them hit.
+    void BM_BulletCollision(benchmark::State& state) {
+        const int zombieCount = static_cast<int>(state.range(0));
+        const int bulletCount = static_cast<int>(state.range(1));
+        const float BULLET_SPEED = 400.0f;
+        const float BULLET_RADIUS = 3.0f;
+        const float ZOMBIE_RADIUS = 12.0f;
+
+        Maze maze(MazeType::STANDARD, 128, 96, BENCH_SEED);
+        Rng rng(BENCH_SEED);
+        std::vector<Vec2> zombies = zombiePositions(maze, zombieCount, maze.getPlayerStart(rng), rng);
+
+        struct Sweep { float x0, y0, x1, y1; };
+        std::vector<Sweep> bullets;
+        for (int i = 0; i < bulletCount; i++) {
+            Vec2 target = zombies[rng.nextBelow(zombieCount)];
+            float angle = rng.nextFloat(0.0f, 2.0f * static_cast<float>(M_PI));
+            float step = BULLET_SPEED * TICK_SECONDS;
+            float end = ZOMBIE_RADIUS + BULLET_RADIUS + rng.nextFloat(-step, step);
+            float x1 = target.x - std::cos(angle) * end;
+            float y1 = target.y - std::sin(angle) * end;
+            bullets.push_back({x1 - std::cos(angle) * step, y1 - std::sin(angle) * step, x1, y1});
+        }
+
+        CollisionWorld world;
+        const std::uint32_t mask = categoryBit(ColliderCategory::ZOMBIE);
+        size_t contacts = 0;
+        for (auto _ : state) {
+            world.reset(static_cast<float>(maze.getWidth() * Maze::TILE_SIZE),
+                        static_cast<float>(maze.getHeight() * Maze::TILE_SIZE));
+            for (int i = 0; i < zombieCount; i++) {
+                world.addBody(ColliderCategory::ZOMBIE, i, zombies[i].x, zombies[i].y, ZOMBIE_RADIUS);
+            }
+            world.build();
+            for (int i = 0; i < bulletCount; i++) {
+                const Sweep& b = bullets[i];
+                world.addSweptProbe(ColliderCategory::BULLET, i, b.x0, b.y0, b.x1, b.y1, BULLET_RADIUS, mask);
+            }
+            contacts = world.findContacts().size();
+            benchmark::DoNotOptimize(contacts);
+        }
+        state.counters["contacts"] = static_cast<double>(contacts);
+    }
+    BENCHMARK(BM_BulletCollision)->Args({25, 10})->Args({100, 50})->Args({1000, 200})->Unit(benchmark::kMicrosecond);
+
+    // Full construction: generation, connectivity repair, spawn index and
+    // distance fields. Cycles through a fixed set of seeds.
+    void BM_MazeGeneration(benchmark::State& state) {
+        MazeType type = MAZE_TYPES[state.range(0)];
+        int width = static_cast<int>(state.range(1));
+        state.SetLabel(mazeTypeName(type));
+
+        std::uint32_t seedIndex = 0;
+        for (auto _ : state) {
+            Maze maze(type, width, width * 3 / 4, Rng::mixSeed(BENCH_SEED, seedIndex++ % 64));
+            benchmark::DoNotOptimize(maze.getExitField().getDistance(1, 1));
+        }
+    }
+    BENCHMARK(BM_MazeGeneration)->ArgsProduct({{0, 1, 2, 3}, {32, 128}})->Unit(benchmark::kMicrosecond);
+
+    // What a level start asks for: the player start, keys and a zombie wave
+    void BM_LevelSpawnQueries(benchmark::State& state) {
+        auto maze = makeMaze(state);
+        Rng rng(BENCH_SEED);
+        for (auto _ : state) {
+            Vec2 start = maze->getPlayerStart(rng);
+            benchmark::DoNotOptimize(maze->getRandomKeyPositions(5, rng));
+            benchmark::DoNotOptimize(maze->getRandomZombiePositions(15, start, rng));
+        }
+    }
+    BENCHMARK(BM_LevelSpawnQueries)->ArgsProduct({{0, 1, 2, 3}, {32, 128}});
+
+    // The respawn timer's query, against a full horde of 25
+    void BM_SpawnAwayFromZombies(benchmark::State& state) {
+        auto maze = makeMaze(state);
+        Rng rng(BENCH_SEED);
+        Vec2 player = maze->getPlayerStart(rng);
+        std::vector<Vec2> existing = zombiePositions(*maze, 25, player, rng);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(maze->getSpawnPositionAwayFromZombies(existing, player, rng));
+        }
+    }
+    BENCHMARK(BM_SpawnAwayFromZombies)->ArgsProduct({{0, 1, 2, 3}, {32, 128}});
+
+    // One frame of the raycast view into a software renderer. The level is
+    // played for a few seconds first so zombies have closed in on the player.
+    void BM_RenderFirstPersonView(benchmark::State& state) {
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, Game::SCREEN_WIDTH, Game::SCREEN_HEIGHT, 32,
+                                                              SDL_PIXELFORMAT_ARGB8888);
+        SDL_Renderer* renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+        if (!renderer) {
+            state.SkipWithError(SDL_GetError());
+            if (surface) SDL_FreeSurface(surface);
+            return;
+        }
+
+        PlayState play;
+        play.sessionSeed = BENCH_SEED;
+        std::cout.setstate(std::ios::failbit);  // Drop the simulation's log lines
+        initializeGame(play, 0, Difficulty::NORMAL, MAZE_TYPES[state.range(0)]);
+        std::array<Uint8, SDL_NUM_SCANCODES> noKeys{};
+        TickInput input;
+        input.keyState = noKeys.data();
+        for (int tick = 1; tick <= 3 * SIMULATION_HZ; tick++) {
+            stepSimulation(play, input, SIMULATION_STEP, static_cast<Uint32>(tick * 1000 / SIMULATION_HZ));
+        }
+        std::cout.clear();
+        state.SetLabel(mazeTypeName(MAZE_TYPES[state.range(0)]));
+
+        std::srand(static_cast<unsigned>(BENCH_SEED));  // Screen shake jitter
+        for (auto _ : state) {
+            renderFirstPersonView(renderer, play);
+        }
+
+        SDL_DestroyRenderer(renderer);
+        SDL_FreeSurface(surface);
+    }
+    BENCHMARK(BM_RenderFirstPersonView)->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_MAIN();